@@ -1,6 +1,7 @@
 #include "ampl_func.h"
 
 #include <assert.h>
+#include <string.h>
 
 #include "ampl_util.h"
 
@@ -40,6 +41,13 @@ typedef struct AmplFuncData
   double* multipliers;
   double* hessian_product;
 
+  // Explicit Lagrangian Hessian, valid for the current primal point
+  // and the multipliers it was evaluated with
+  bool explicit_hessian;
+  bool hessian_valid;
+  SleqpMat* hessian;
+  SleqpVec* hessian_duals;
+
   bool inverted_obj;
   double offset;
 
@@ -48,11 +56,46 @@ typedef struct AmplFuncData
 
 } AmplFuncData;
 
+// Sets up the sparsity pattern of the full (not only upper triangular)
+// Hessian of the Lagrangian
+static SLEQP_RETCODE
+create_hessian(AmplFuncData* data)
+{
+  SleqpAmplData* ampl_data = data->ampl_data;
+  ASL* asl                 = ampl_data->asl;
+
+  const int num_variables = ampl_data->num_variables;
+  const int num_general   = ampl_data->num_constraints - ampl_data->num_linear;
+
+  const int hess_nnz = sphsetup(0, 0, 1, 0);
+
+  const fint* hess_cols = sputinfo->hcolstarts;
+  const fint* hess_rows = sputinfo->hrownos;
+
+  SLEQP_CALL(
+    sleqp_mat_create(&data->hessian, num_variables, num_variables, hess_nnz));
+
+  for (int col = 0; col < num_variables; ++col)
+  {
+    SLEQP_CALL(sleqp_mat_push_col(data->hessian, col));
+
+    for (int k = hess_cols[col]; k < hess_cols[col + 1]; ++k)
+    {
+      SLEQP_CALL(sleqp_mat_push(data->hessian, hess_rows[k], col, 0.));
+    }
+  }
+
+  SLEQP_CALL(sleqp_vec_create_empty(&data->hessian_duals, num_general));
+
+  return SLEQP_OKAY;
+}
+
 static SLEQP_RETCODE
 ampl_func_data_create(AmplFuncData** star,
                       SleqpAmplData* ampl_data,
                       double zero_eps,
-                      bool halt_on_error)
+                      bool halt_on_error,
+                      bool explicit_hessian)
 {
   ASL* asl = ampl_data->asl;
   SLEQP_CALL(sleqp_malloc(star));
@@ -98,6 +141,14 @@ ampl_func_data_create(AmplFuncData** star,
   SLEQP_CALL(sleqp_alloc_array(&data->direction, num_variables));
   SLEQP_CALL(sleqp_alloc_array(&data->hessian_product, num_variables));
 
+  data->explicit_hessian = explicit_hessian;
+  data->hessian_valid    = false;
+
+  if (explicit_hessian)
+  {
+    SLEQP_CALL(create_hessian(data));
+  }
+
   return SLEQP_OKAY;
 }
 
@@ -107,6 +158,9 @@ ampl_func_data_free(void* func_data)
   AmplFuncData* data  = (AmplFuncData*)func_data;
   AmplFuncData** star = &data;
 
+  SLEQP_CALL(sleqp_vec_free(&data->hessian_duals));
+  SLEQP_CALL(sleqp_mat_release(&data->hessian));
+
   sleqp_free(&data->hessian_product);
   sleqp_free(&data->direction);
 
@@ -200,7 +254,8 @@ ampl_func_set(SleqpFunc* func,
 
   SLEQP_CALL(sleqp_vec_to_raw(x, data->x));
 
-  data->evaluated = NONE;
+  data->evaluated     = NONE;
+  data->hessian_valid = false;
 
   // pre-check for possible rejects, cache
   // objective and constraint values
@@ -381,6 +436,108 @@ ensure_eval(AmplFuncData* data)
   return SLEQP_OKAY;
 }
 
+static SLEQP_RETCODE
+set_multipliers(AmplFuncData* data, const SleqpVec* cons_duals)
+{
+  SLEQP_CALL(sleqp_vec_to_raw(cons_duals, data->multipliers));
+
+  if (data->inverted_obj)
+  {
+    const int num_cons = cons_duals->dim;
+
+    for (int i = 0; i < num_cons; ++i)
+    {
+      data->multipliers[i] *= -1.;
+    }
+  }
+
+  return SLEQP_OKAY;
+}
+
+static bool
+same_duals(const SleqpVec* first, const SleqpVec* second)
+{
+  return (first->nnz == second->nnz)
+         && (memcmp(first->indices, second->indices, first->nnz * sizeof(int))
+             == 0)
+         && (memcmp(first->data, second->data, first->nnz * sizeof(double))
+             == 0);
+}
+
+// Evaluates the Hessian at the current primal point and the given
+// multipliers unless it is already up to date
+static SLEQP_RETCODE
+update_hessian(AmplFuncData* data, const SleqpVec* cons_duals)
+{
+  ASL* asl = data->ampl_data->asl;
+
+  if (data->hessian_valid && same_duals(cons_duals, data->hessian_duals))
+  {
+    return SLEQP_OKAY;
+  }
+
+  SLEQP_CALL(set_multipliers(data, cons_duals));
+
+  double* hess_vals  = sleqp_mat_data(data->hessian);
+  const int hess_nnz = sleqp_mat_nnz(data->hessian);
+
+  sphes(hess_vals, 0, NULL, data->multipliers);
+
+  if (data->inverted_obj)
+  {
+    for (int k = 0; k < hess_nnz; ++k)
+    {
+      hess_vals[k] *= -1.;
+    }
+  }
+
+  SLEQP_CALL(sleqp_vec_copy(cons_duals, data->hessian_duals));
+
+  data->hessian_valid = true;
+
+  return SLEQP_OKAY;
+}
+
+static SLEQP_RETCODE
+explicit_hess_product(AmplFuncData* data,
+                      const SleqpVec* direction,
+                      const SleqpVec* cons_duals,
+                      SleqpVec* product)
+{
+  SLEQP_CALL(update_hessian(data, cons_duals));
+
+  const int num_variables = data->ampl_data->num_variables;
+
+  const double* hess_vals = sleqp_mat_data(data->hessian);
+  const int* hess_cols    = sleqp_mat_cols(data->hessian);
+  const int* hess_rows    = sleqp_mat_rows(data->hessian);
+
+  for (int i = 0; i < num_variables; ++i)
+  {
+    data->hessian_product[i] = 0.;
+  }
+
+  // The full Hessian is stored, only the columns
+  // corresponding to nonzero directions are needed
+  for (int k = 0; k < direction->nnz; ++k)
+  {
+    const int col      = direction->indices[k];
+    const double value = direction->data[k];
+
+    for (int j = hess_cols[col]; j < hess_cols[col + 1]; ++j)
+    {
+      data->hessian_product[hess_rows[j]] += hess_vals[j] * value;
+    }
+  }
+
+  SLEQP_CALL(sleqp_vec_set_from_raw(product,
+                                    data->hessian_product,
+                                    num_variables,
+                                    data->zero_eps));
+
+  return SLEQP_OKAY;
+}
+
 static SLEQP_RETCODE
 ampl_func_hess_product(SleqpFunc* func,
                        const SleqpVec* direction,
@@ -395,19 +552,14 @@ ampl_func_hess_product(SleqpFunc* func,
   // have been evaluated at the current primal point
   SLEQP_CALL(ensure_eval(data));
 
-  SLEQP_CALL(sleqp_vec_to_raw(direction, data->direction));
-  SLEQP_CALL(sleqp_vec_to_raw(cons_duals, data->multipliers));
-
-  if (data->inverted_obj)
+  if (data->explicit_hessian)
   {
-    const int num_cons = sleqp_func_num_cons(func);
-
-    for (int i = 0; i < num_cons; ++i)
-    {
-      data->multipliers[i] *= -1.;
-    }
+    return explicit_hess_product(data, direction, cons_duals, product);
   }
 
+  SLEQP_CALL(sleqp_vec_to_raw(direction, data->direction));
+  SLEQP_CALL(set_multipliers(data, cons_duals));
+
   double one = 1.;
 
   hvcomp(data->hessian_product,
@@ -433,7 +585,8 @@ SLEQP_RETCODE
 sleqp_ampl_func_create(SleqpFunc** star,
                        SleqpAmplData* ampl_data,
                        SleqpSettings* settings,
-                       bool halt_on_error)
+                       bool halt_on_error,
+                       bool explicit_hessian)
 {
   AmplFuncData* data;
 
@@ -442,7 +595,11 @@ sleqp_ampl_func_create(SleqpFunc** star,
 
   const double zero_eps = sleqp_settings_real_value(settings, SLEQP_SETTINGS_REAL_ZERO_EPS);
 
-  SLEQP_CALL(ampl_func_data_create(&data, ampl_data, zero_eps, halt_on_error));
+  SLEQP_CALL(ampl_func_data_create(&data,
+                                   ampl_data,
+                                   zero_eps,
+                                   halt_on_error,
+                                   explicit_hessian));
 
   SleqpFuncCallbacks callbacks
     = {.set_value = ampl_func_set,
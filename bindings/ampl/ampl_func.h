@@ -9,6 +9,7 @@ SLEQP_RETCODE
 sleqp_ampl_func_create(SleqpFunc** star,
                        SleqpAmplData* ampl_data,
                        SleqpSettings* settings,
-                       bool halt_on_error);
+                       bool halt_on_error,
+                       bool explicit_hessian);
 
 #endif /* SLEQP_AMPL_FUNC_H */
@@ -24,6 +24,7 @@ enum
   LOG_LEVEL_OUTLEV,
   WANTSOL,
   HALTONERROR,
+  EXPLICITHESSIAN,
   NUM_EXTRA
 };
 
@@ -47,6 +48,7 @@ struct SleqpAmplKeywords
   double time_limit;
   int iteration_limit;
   bool halt_on_error;
+  bool explicit_hessian;
 };
 
 static char*
@@ -241,24 +243,19 @@ kwdfunc_log_level(Option_Info* oi, keyword* kw, char* value)
 }
 
 static char*
-kwdfunc_haltonerror(Option_Info* oi, keyword* kw, char* value)
+kwdfunc_yes_no(Option_Info* oi, keyword* kw, char* value, bool* flag)
 {
-  CallbackData* callback_data = (CallbackData*)kw->info;
-
-  int int_val;
-  kw->info = &int_val;
-
   char* str_val;
   kw->info     = &str_val;
   char* retval = C_val(oi, kw, value);
 
   if (strcmp(str_val, "yes") == 0)
   {
-    callback_data->data.keywords->halt_on_error = true;
+    *flag = true;
   }
   else if (strcmp(str_val, "no") == 0)
   {
-    callback_data->data.keywords->halt_on_error = false;
+    *flag = false;
   }
   else
   {
@@ -272,6 +269,28 @@ kwdfunc_haltonerror(Option_Info* oi, keyword* kw, char* value)
   return retval;
 }
 
+static char*
+kwdfunc_haltonerror(Option_Info* oi, keyword* kw, char* value)
+{
+  CallbackData* callback_data = (CallbackData*)kw->info;
+
+  return kwdfunc_yes_no(oi,
+                        kw,
+                        value,
+                        &callback_data->data.keywords->halt_on_error);
+}
+
+static char*
+kwdfunc_explicithessian(Option_Info* oi, keyword* kw, char* value)
+{
+  CallbackData* callback_data = (CallbackData*)kw->info;
+
+  return kwdfunc_yes_no(oi,
+                        kw,
+                        value,
+                        &callback_data->data.keywords->explicit_hessian);
+}
+
 static int
 compare_kwds(const void* first, const void* second)
 {
@@ -416,6 +435,17 @@ keywords_fill(SleqpAmplKeywords* sleqp_keywords,
                   .desc = strdup("Exit with message on evaluation error")};
   }
 
+  {
+    pos = POS_EXTRA + EXPLICITHESSIAN;
+
+    kwds[pos] = (keyword){
+      .name = strdup("explicit_hessian"),
+      .kf   = kwdfunc_explicithessian,
+      .info = callback_data + pos,
+      .desc = strdup("Evaluate the sparse Hessian once per iterate and "
+                     "multipliers to compute Hessian products")};
+  }
+
   // Keywords must be sorted alphabetically
   qsort(kwds, AMPL_NUM_KEYWORDS, sizeof(keyword), compare_kwds);
 
@@ -432,9 +462,10 @@ sleqp_ampl_keywords_create(SleqpAmplKeywords** star,
 
   (*ampl_keywords) = (SleqpAmplKeywords){0};
 
-  ampl_keywords->time_limit      = SLEQP_NONE;
-  ampl_keywords->iteration_limit = SLEQP_NONE;
-  ampl_keywords->halt_on_error   = false;
+  ampl_keywords->time_limit       = SLEQP_NONE;
+  ampl_keywords->iteration_limit  = SLEQP_NONE;
+  ampl_keywords->halt_on_error    = false;
+  ampl_keywords->explicit_hessian = false;
 
   SLEQP_CALL(sleqp_settings_capture(settings));
   ampl_keywords->settings = settings;
@@ -462,6 +493,12 @@ sleqp_ampl_keywords_halt_on_error(SleqpAmplKeywords* ampl_keywords)
   return ampl_keywords->halt_on_error;
 }
 
+bool
+sleqp_ampl_keywords_explicit_hessian(SleqpAmplKeywords* ampl_keywords)
+{
+  return ampl_keywords->explicit_hessian;
+}
+
 SLEQP_RETCODE
 sleqp_ampl_keywords_get(SleqpAmplKeywords* ampl_keywords,
                         keyword** star,
@@ -488,10 +525,11 @@ sleqp_ampl_keywords_free(SleqpAmplKeywords** star)
 
   keyword* kwds = sleqp_keywords->keywds;
 
+  // Names and descriptions are obtained from strdup
   for (int pos = POS_ENUM; pos < AMPL_NUM_KEYWORDS; ++pos)
   {
-    sleqp_free(&(kwds[pos].name));
-    sleqp_free(&(kwds[pos].desc));
+    free(kwds[pos].name);
+    free(kwds[pos].desc);
   }
 
   sleqp_free(star);
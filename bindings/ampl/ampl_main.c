@@ -80,7 +80,14 @@ ampl_main(int argc, char* argv[])
 
   bool halt_on_error = sleqp_ampl_keywords_halt_on_error(ampl_keywords);
 
-  SLEQP_CALL(sleqp_ampl_problem_create(&problem, data, settings, halt_on_error));
+  bool explicit_hessian
+    = sleqp_ampl_keywords_explicit_hessian(ampl_keywords);
+
+  SLEQP_CALL(sleqp_ampl_problem_create(&problem,
+                                       data,
+                                       settings,
+                                       halt_on_error,
+                                       explicit_hessian));
 
   SleqpVec* x;
   SLEQP_CALL(sleqp_vec_create(&x, n_var, 0));
@@ -100,7 +100,8 @@ SLEQP_RETCODE
 sleqp_ampl_problem_create(SleqpProblem** star,
                           SleqpAmplData* data,
                           SleqpSettings* settings,
-                          bool halt_on_error)
+                          bool halt_on_error,
+                          bool explicit_hessian)
 {
   const int num_variables   = data->num_variables;
   const int num_constraints = data->num_constraints;
@@ -136,7 +137,11 @@ sleqp_ampl_problem_create(SleqpProblem** star,
 
   const int num_linear = n_con - nlc;
 
-  SLEQP_CALL(sleqp_ampl_func_create(&func, data, settings, halt_on_error));
+  SLEQP_CALL(sleqp_ampl_func_create(&func,
+                                    data,
+                                    settings,
+                                    halt_on_error,
+                                    explicit_hessian));
 
   if (num_linear > 0)
   {
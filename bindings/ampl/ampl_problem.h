@@ -10,6 +10,7 @@ SLEQP_RETCODE
 sleqp_ampl_problem_create(SleqpProblem** star,
                           SleqpAmplData* data,
                           SleqpSettings* settings,
-                          bool halt_on_error);
+                          bool halt_on_error,
+                          bool explicit_hessian);
 
 #endif /* SLEQP_AMPL_PROBLEM_H */
@@ -67,7 +67,9 @@ main()
          sleqp_enum_linesearch(),
          sleqp_enum_parametric_cauchy(),
          sleqp_enum_initial_tr(),
-         sleqp_enum_aug_jac_method()};
+         sleqp_enum_aug_jac_method(),
+         sleqp_enum_tr_precond(),
+         sleqp_enum_deriv_check_sampling()};
 
     for (int i = 0; i < SLEQP_NUM_ENUM_SETTINGS; ++i)
     {
@@ -93,10 +93,14 @@
 #define MEX_PARAMETRIC_CAUCHY "parametric_cauchy"
 #define MEX_INITIAL_TR_CHOICE "initial_tr_choice"
 #define MEX_AUG_JAC_METHOD "aug_jac_method"
+#define MEX_TR_PRECOND "tr_precond"
+#define MEX_DERIV_CHECK_SAMPLING "deriv_check_sampling"
 
 #define MEX_NUM_QUASI_NEWTON_ITERATES "num_quasi_newton_iterates"
 #define MEX_MAX_NEWTON_ITERATIONS "max_newton_iterations"
 #define MEX_NUM_THREADS "num_threads"
+#define MEX_DERIV_CHECK_SAMPLES "deriv_check_samples"
+#define MEX_PRECOND_MAX_BLOCK_SIZE "precond_max_block_size"
 
 #define MEX_PERFORM_NEWTON_STEP "perform_newton_step"
 #define MEX_GLOBAL_PENALTY_RESETS "global_penalty_resets"
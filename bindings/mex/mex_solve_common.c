@@ -45,12 +45,16 @@ static const Name enum_option_names[]
      {MEX_LINESEARCH, SLEQP_SETTINGS_ENUM_LINESEARCH},
      {MEX_PARAMETRIC_CAUCHY, SLEQP_SETTINGS_ENUM_PARAMETRIC_CAUCHY},
      {MEX_INITIAL_TR_CHOICE, SLEQP_SETTINGS_ENUM_INITIAL_TR_CHOICE},
-     {MEX_AUG_JAC_METHOD, SLEQP_SETTINGS_ENUM_AUG_JAC_METHOD}};
+     {MEX_AUG_JAC_METHOD, SLEQP_SETTINGS_ENUM_AUG_JAC_METHOD},
+     {MEX_TR_PRECOND, SLEQP_SETTINGS_ENUM_TR_PRECOND},
+     {MEX_DERIV_CHECK_SAMPLING, SLEQP_SETTINGS_ENUM_DERIV_CHECK_SAMPLING}};
 
 static const Name int_option_names[] = {
   {MEX_NUM_QUASI_NEWTON_ITERATES, SLEQP_SETTINGS_INT_NUM_QUASI_NEWTON_ITERATES},
   {MEX_MAX_NEWTON_ITERATIONS, SLEQP_SETTINGS_INT_MAX_NEWTON_ITERATIONS},
-  {MEX_NUM_THREADS, SLEQP_SETTINGS_INT_NUM_THREADS}};
+  {MEX_NUM_THREADS, SLEQP_SETTINGS_INT_NUM_THREADS},
+  {MEX_DERIV_CHECK_SAMPLES, SLEQP_SETTINGS_INT_DERIV_CHECK_SAMPLES},
+  {MEX_PRECOND_MAX_BLOCK_SIZE, SLEQP_SETTINGS_INT_PRECOND_MAX_BLOCK_SIZE}};
 
 static const Name bool_option_names[]
   = {{MEX_PERFORM_NEWTON_STEP, SLEQP_SETTINGS_BOOL_PERFORM_NEWTON_STEP},
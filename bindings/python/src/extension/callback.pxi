@@ -107,20 +107,11 @@ cdef csleqp.SLEQP_RETCODE finished_nogil(csleqp.SleqpSolver* solver,
 
 cdef  get_callback_function_pointer(solver_event, void** pointer):
   if solver_event == SolverEvent.AcceptedIterate:
-    if get_release_gil():
-      pointer[0] = <void*> accepted_iterate_nogil
-    else:
-      pointer[0] = <void*> accepted_iterate
+    pointer[0] = <void*> accepted_iterate_nogil
   elif solver_event == SolverEvent.PerformedIteration:
-    if get_release_gil():
-      pointer[0] = <void*> performed_iteration_nogil
-    else:
-      pointer[0] = <void*> performed_iteration
+    pointer[0] = <void*> performed_iteration_nogil
   elif solver_event == SolverEvent.Finished:
-    if get_release_gil():
-      pointer[0] = <void*> finished_nogil
-    else:
-      pointer[0] = <void*> finished
+    pointer[0] = <void*> finished_nogil
   else:
     pointer[0] = NULL
     return csleqp.SLEQP_ERROR
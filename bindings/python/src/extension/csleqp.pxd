@@ -58,6 +58,11 @@ cdef extern from "sleqp.h":
     SLEQP_DERIV_CHECK_SECOND_EXHAUSTIVE,
     SLEQP_DERIV_CHECK_SECOND_SIMPLE
 
+  ctypedef enum SLEQP_DERIV_CHECK_SAMPLING:
+    SLEQP_DERIV_CHECK_SAMPLING_NONE,
+    SLEQP_DERIV_CHECK_SAMPLING_COORDINATES,
+    SLEQP_DERIV_CHECK_SAMPLING_DIRECTIONS
+
   ctypedef enum SLEQP_HESS_EVAL:
     SLEQP_HESS_EVAL_EXACT,
     SLEQP_HESS_EVAL_SR1,
@@ -99,6 +104,12 @@ cdef extern from "sleqp.h":
     SLEQP_AUG_JAC_REDUCED,
     SLEQP_AUG_JAC_DIRECT
 
+  ctypedef enum SLEQP_TR_PRECOND:
+    SLEQP_TR_PRECOND_NONE,
+    SLEQP_TR_PRECOND_DIAGONAL,
+    SLEQP_TR_PRECOND_QUASI_NEWTON,
+    SLEQP_TR_PRECOND_INCOMPLETE_CHOLESKY
+
   ctypedef enum SLEQP_LINESEARCH:
     SLEQP_LINESEARCH_EXACT
     SLEQP_LINESEARCH_APPROX
@@ -135,7 +146,9 @@ cdef extern from "sleqp.h":
   ctypedef enum SLEQP_SETTINGS_INT:
     SLEQP_SETTINGS_INT_NUM_QUASI_NEWTON_ITERATES,
     SLEQP_SETTINGS_INT_MAX_NEWTON_ITERATIONS,
-    SLEQP_SETTINGS_INT_NUM_THREADS
+    SLEQP_SETTINGS_INT_NUM_THREADS,
+    SLEQP_SETTINGS_INT_DERIV_CHECK_SAMPLES,
+    SLEQP_SETTINGS_INT_PRECOND_MAX_BLOCK_SIZE
 
   ctypedef enum SLEQP_SETTINGS_ENUM:
     SLEQP_SETTINGS_ENUM_DERIV_CHECK,
@@ -150,7 +163,9 @@ cdef extern from "sleqp.h":
     SLEQP_SETTINGS_ENUM_LINESEARCH,
     SLEQP_SETTINGS_ENUM_PARAMETRIC_CAUCHY,
     SLEQP_SETTINGS_ENUM_INITIAL_TR_CHOICE,
-    SLEQP_SETTINGS_ENUM_AUG_JAC_METHOD
+    SLEQP_SETTINGS_ENUM_AUG_JAC_METHOD,
+    SLEQP_SETTINGS_ENUM_TR_PRECOND,
+    SLEQP_SETTINGS_ENUM_DERIV_CHECK_SAMPLING
 
   ctypedef enum SLEQP_SETTINGS_BOOL:
     SLEQP_SETTINGS_BOOL_PERFORM_NEWTON_STEP,
@@ -159,7 +174,9 @@ cdef extern from "sleqp.h":
     SLEQP_SETTINGS_BOOL_USE_QUADRATIC_MODEL,
     SLEQP_SETTINGS_BOOL_ENABLE_RESTORATION_PHASE,
     SLEQP_SETTINGS_BOOL_ENABLE_PREPROCESSOR,
-    SLEQP_SETTINGS_BOOL_LP_RESOLVES
+    SLEQP_SETTINGS_BOOL_LP_RESOLVES,
+    SLEQP_SETTINGS_BOOL_SPECULATIVE_PARAMETRIC_CAUCHY,
+    SLEQP_SETTINGS_BOOL_MEMORY_POOL
 
   ctypedef enum SLEQP_SOLVER_STATE_REAL:
     SLEQP_SOLVER_STATE_REAL_TRUST_RADIUS,
@@ -184,6 +201,28 @@ cdef extern from "sleqp.h":
     SLEQP_SOLVER_STATE_VEC_SCALED_CONS_SLACK_RESIDUALS,
     SLEQP_SOLVER_STATE_VEC_SCALED_VAR_SLACK_RESIDUALS
 
+  ctypedef enum SLEQP_SOLVER_TIMING:
+    SLEQP_SOLVER_TIMING_TOTAL,
+    SLEQP_SOLVER_TIMING_PREPROCESSING,
+    SLEQP_SOLVER_TIMING_FUNC_SET,
+    SLEQP_SOLVER_TIMING_FUNC_OBJ_VAL,
+    SLEQP_SOLVER_TIMING_FUNC_OBJ_GRAD,
+    SLEQP_SOLVER_TIMING_FUNC_CONS_VAL,
+    SLEQP_SOLVER_TIMING_FUNC_CONS_JAC,
+    SLEQP_SOLVER_TIMING_FUNC_HESS_PROD,
+    SLEQP_SOLVER_TIMING_QUASI_NEWTON_PROD,
+    SLEQP_SOLVER_TIMING_QUASI_NEWTON_UPDATE,
+    SLEQP_SOLVER_TIMING_FACTORIZATION,
+    SLEQP_SOLVER_TIMING_SUBSTITUTION,
+    SLEQP_SOLVER_TIMING_EQP,
+    SLEQP_SOLVER_TIMING_LP,
+    SLEQP_SOLVER_TIMING_LINESEARCH
+
+  ctypedef struct SleqpTimingStats:
+    int num_runs
+    double wall_time
+    double cpu_time
+
   ctypedef enum SLEQP_STEPTYPE:
     SLEQP_STEPTYPE_NONE,
     SLEQP_STEPTYPE_ACCEPTED,
@@ -260,6 +299,9 @@ cdef extern from "sleqp.h":
 
   SLEQP_RETCODE sleqp_vec_clear(SleqpVec* vec)
 
+  SLEQP_RETCODE sleqp_vec_copy(const SleqpVec* source,
+                               SleqpVec* target) nogil
+
   SLEQP_RETCODE sleqp_vec_reserve(SleqpVec* vec, int nnz)
 
   SLEQP_RETCODE sleqp_vec_resize(SleqpVec* vec,
@@ -269,6 +311,14 @@ cdef extern from "sleqp.h":
                                          int idx,
                                          double value)
 
+  SLEQP_RETCODE sleqp_vec_set_from_raw(SleqpVec* vec,
+                                       double* values,
+                                       int dim,
+                                       double zero_eps)
+
+  SLEQP_RETCODE sleqp_vec_to_raw(const SleqpVec* vec,
+                                 double* values)
+
   # Sparse matrices
   SLEQP_RETCODE sleqp_mat_create(SleqpMat** matrix,
                                            int num_rows,
@@ -304,10 +354,16 @@ cdef extern from "sleqp.h":
   SLEQP_RETCODE sleqp_mat_push_col(SleqpMat* matrix,
                                                 int col)
 
+  SLEQP_RETCODE sleqp_mat_set_nnz(SleqpMat* matrix,
+                                  int nnz)
+
   SLEQP_RETCODE sleqp_mat_capture(SleqpMat* matrix)
 
   SLEQP_RETCODE sleqp_mat_release(SleqpMat** matrix)
 
+  SLEQP_RETCODE sleqp_mat_copy(const SleqpMat* source,
+                               SleqpMat* target) nogil
+
   # Functions
   ctypedef SLEQP_RETCODE (*SLEQP_FUNC_SET)(SleqpFunc* func,
                                            SleqpVec* x,
@@ -344,17 +400,29 @@ cdef extern from "sleqp.h":
                                                  SleqpVec* product,
                                                  void* func_data)
 
+  ctypedef SLEQP_RETCODE (*SLEQP_FUNC_HESS_PRODS)(SleqpFunc* func,
+                                                  const SleqpMat* directions,
+                                                  const SleqpVec* cons_duals,
+                                                  SleqpMat* products,
+                                                  void* func_data)
+
+  ctypedef SLEQP_RETCODE (*SLEQP_FUNC_CLONE)(SleqpFunc* func,
+                                             SleqpFunc** clone,
+                                             void* func_data)
+
   ctypedef SLEQP_RETCODE (*SLEQP_FUNC_FREE)(void* func_data)
 
   ctypedef struct SleqpFuncCallbacks:
-    SLEQP_FUNC_SET       set_value
-    SLEQP_FUNC_NONZEROS  nonzeros
-    SLEQP_FUNC_OBJ_VAL   obj_val
-    SLEQP_FUNC_OBJ_GRAD  obj_grad
-    SLEQP_FUNC_CONS_VAL  cons_val
-    SLEQP_FUNC_CONS_JAC  cons_jac
-    SLEQP_FUNC_HESS_PROD hess_prod
-    SLEQP_FUNC_FREE      func_free
+    SLEQP_FUNC_SET        set_value
+    SLEQP_FUNC_NONZEROS   nonzeros
+    SLEQP_FUNC_OBJ_VAL    obj_val
+    SLEQP_FUNC_OBJ_GRAD   obj_grad
+    SLEQP_FUNC_CONS_VAL   cons_val
+    SLEQP_FUNC_CONS_JAC   cons_jac
+    SLEQP_FUNC_HESS_PROD  hess_prod
+    SLEQP_FUNC_FREE       func_free
+    SLEQP_FUNC_HESS_PRODS hess_prods
+    SLEQP_FUNC_CLONE      clone
 
   SLEQP_RETCODE sleqp_func_create(SleqpFunc** fstar,
                                   SleqpFuncCallbacks* callbacks,
@@ -615,10 +683,20 @@ cdef extern from "sleqp.h":
 
   SLEQP_RETCODE sleqp_solver_abort(SleqpSolver* solver)
 
+  SLEQP_RETCODE sleqp_solver_warm_start(SleqpSolver* solver,
+                                        const SleqpSolver* source)
+
   int sleqp_solver_iterations(SleqpSolver* solver)
 
   double sleqp_solver_elapsed_seconds(SleqpSolver* solver)
 
+  SLEQP_RETCODE sleqp_solver_set_trace_file(SleqpSolver* solver,
+                                            const char* filename)
+
+  SLEQP_RETCODE sleqp_solver_timing_stats(const SleqpSolver* solver,
+                                          SLEQP_SOLVER_TIMING timing,
+                                          SleqpTimingStats* stats)
+
   SLEQP_RETCODE sleqp_solver_add_callback(SleqpSolver* solver,
                                           SLEQP_SOLVER_EVENT solver_event,
                                           void* callback_func,
@@ -104,43 +104,19 @@ cdef csleqp.SLEQP_RETCODE sleqp_dyn_set_cons_weights_nogil(csleqp.SleqpFunc* fun
 
 
 cdef set_dyn_func_callbacks(csleqp.SleqpDynFuncCallbacks* callbacks):
-  if release_gil:
-    callbacks[0].set_value        = &sleqp_func_set_nogil
-    callbacks[0].nonzeros         = &sleqp_func_nonzeros_nogil
-    callbacks[0].set_error_bound  = &sleqp_dyn_set_error_bound_nogil
-    callbacks[0].set_obj_weight   = &sleqp_dyn_set_obj_weight_nogil
-    callbacks[0].set_cons_weights = &sleqp_dyn_set_cons_weights_nogil
-    callbacks[0].eval             = &sleqp_dyn_eval_nogil
-    callbacks[0].obj_grad         = &sleqp_func_obj_grad_nogil
-    callbacks[0].cons_jac         = &sleqp_func_cons_jac_nogil
-    callbacks[0].hess_prod        = &sleqp_func_hess_prod_nogil
-  else:
-    callbacks[0].set_value        = &sleqp_func_set
-    callbacks[0].nonzeros         = &sleqp_func_nonzeros
-    callbacks[0].set_error_bound  = &sleqp_dyn_set_error_bound
-    callbacks[0].set_obj_weight   = &sleqp_dyn_set_obj_weight
-    callbacks[0].set_cons_weights = &sleqp_dyn_set_cons_weights
-    callbacks[0].eval             = &sleqp_dyn_eval
-    callbacks[0].obj_grad         = &sleqp_func_obj_grad
-    callbacks[0].cons_jac         = &sleqp_func_cons_jac
-    callbacks[0].hess_prod        = &sleqp_func_hess_prod
+  callbacks[0].set_value        = &sleqp_func_set_nogil
+  callbacks[0].nonzeros         = &sleqp_func_nonzeros_nogil
+  callbacks[0].set_error_bound  = &sleqp_dyn_set_error_bound_nogil
+  callbacks[0].set_obj_weight   = &sleqp_dyn_set_obj_weight_nogil
+  callbacks[0].set_cons_weights = &sleqp_dyn_set_cons_weights_nogil
+  callbacks[0].eval             = &sleqp_dyn_eval_nogil
+  callbacks[0].obj_grad         = &sleqp_func_obj_grad_nogil
+  callbacks[0].cons_jac         = &sleqp_func_cons_jac_nogil
+  callbacks[0].hess_prod        = &sleqp_func_hess_prod_nogil
 
   callbacks[0].func_free        = &sleqp_func_free
 
 
-cdef object dyn_funcs = weakref.WeakSet()
-
-cdef update_dyn_func_callbacks():
-  cdef _Func func
-  cdef csleqp.SleqpDynFuncCallbacks callbacks
-
-  set_dyn_func_callbacks(&callbacks)
-
-  for obj in dyn_funcs:
-    func = <_Func> obj
-    csleqp_call(csleqp.sleqp_dyn_func_set_callbacks(func.cfunc,
-                                                    &callbacks))
-
 cdef csleqp.SLEQP_RETCODE create_dyn_func(csleqp.SleqpFunc** cfunc,
                                           object func,
                                           int num_variables,
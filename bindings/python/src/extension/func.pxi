@@ -1,5 +1,7 @@
 #cython: language_level=3
 
+from libc.stdlib cimport calloc, free
+
 cdef store_func_exc(func_obj, exception):
   func_obj.call_exception = exception
 
@@ -272,44 +274,217 @@ cdef csleqp.SLEQP_RETCODE sleqp_func_free(void* func_data):
   return csleqp.SLEQP_OKAY
 
 
-cdef object funcs = weakref.WeakSet()
+# Values evaluated in a batch whenever a new point is set,
+# handed over to the solver without reacquiring the GIL
+cdef struct FuncBatch:
+  void* func_obj
 
+  csleqp.bool has_obj_val
+  csleqp.bool has_obj_grad
+  csleqp.bool has_cons_val
+  csleqp.bool has_cons_jac
 
-cdef set_func_callbacks(csleqp.SleqpFuncCallbacks* callbacks):
-  if release_gil:
-    callbacks[0].set_value = &sleqp_func_set_nogil
-    callbacks[0].nonzeros  = &sleqp_func_nonzeros_nogil
-    callbacks[0].obj_val   = &sleqp_func_obj_val_nogil
-    callbacks[0].obj_grad  = &sleqp_func_obj_grad_nogil
-    callbacks[0].cons_val  = &sleqp_func_cons_val_nogil
-    callbacks[0].cons_jac  = &sleqp_func_cons_jac_nogil
-    callbacks[0].hess_prod = &sleqp_func_hess_prod_nogil
-  else:
-    callbacks[0].set_value = &sleqp_func_set
-    callbacks[0].nonzeros  = &sleqp_func_nonzeros
-    callbacks[0].obj_val   = &sleqp_func_obj_val
-    callbacks[0].obj_grad  = &sleqp_func_obj_grad
-    callbacks[0].cons_val  = &sleqp_func_cons_val
-    callbacks[0].cons_jac  = &sleqp_func_cons_jac
-    callbacks[0].hess_prod = &sleqp_func_hess_prod
+  double obj_val
+  csleqp.SleqpVec* obj_grad
+  csleqp.SleqpVec* cons_val
+  csleqp.SleqpMat* cons_jac
 
-  callbacks.func_free = &sleqp_func_free
 
+cdef csleqp.SLEQP_RETCODE sleqp_func_batch_eval(csleqp.SleqpFunc* func,
+                                                csleqp.SLEQP_VALUE_REASON reason,
+                                                FuncBatch* batch):
+  cdef void* func_obj = batch.func_obj
 
-cdef update_func_callbacks():
-  cdef _Func func
-  cdef csleqp.SleqpFuncCallbacks callbacks
+  cdef csleqp.bool full = (reason == csleqp.SLEQP_VALUE_REASON_INIT or
+                           reason == csleqp.SLEQP_VALUE_REASON_ACCEPTED_ITERATE)
+
+  cdef csleqp.bool trial = (reason == csleqp.SLEQP_VALUE_REASON_TRYING_ITERATE or
+                            reason == csleqp.SLEQP_VALUE_REASON_TRYING_SOC_ITERATE)
+
+  if not (full or trial):
+    return csleqp.SLEQP_OKAY
+
+  if sleqp_func_obj_val(func, &batch.obj_val, func_obj) != csleqp.SLEQP_OKAY:
+    return csleqp.SLEQP_ERROR
+
+  batch.has_obj_val = True
+
+  if sleqp_func_cons_val(func, batch.cons_val, func_obj) != csleqp.SLEQP_OKAY:
+    return csleqp.SLEQP_ERROR
+
+  batch.has_cons_val = True
+
+  if not full:
+    return csleqp.SLEQP_OKAY
+
+  if sleqp_func_obj_grad(func, batch.obj_grad, func_obj) != csleqp.SLEQP_OKAY:
+    return csleqp.SLEQP_ERROR
+
+  batch.has_obj_grad = True
+
+  if sleqp_func_cons_jac(func, batch.cons_jac, func_obj) != csleqp.SLEQP_OKAY:
+    return csleqp.SLEQP_ERROR
+
+  batch.has_cons_jac = True
+
+  return csleqp.SLEQP_OKAY
+
+
+cdef csleqp.SLEQP_RETCODE sleqp_func_set_batch(csleqp.SleqpFunc* func,
+                                               csleqp.SleqpVec* x,
+                                               csleqp.SLEQP_VALUE_REASON reason,
+                                               csleqp.bool* reject,
+                                               void* func_data) nogil:
+  cdef FuncBatch* batch = <FuncBatch*> func_data
+
+  batch.has_obj_val  = False
+  batch.has_obj_grad = False
+  batch.has_cons_val = False
+  batch.has_cons_jac = False
+
+  with gil:
+    if sleqp_func_set(func,
+                      x,
+                      reason,
+                      reject,
+                      batch.func_obj) != csleqp.SLEQP_OKAY:
+      return csleqp.SLEQP_ERROR
+
+    if reject[0]:
+      return csleqp.SLEQP_OKAY
+
+    return sleqp_func_batch_eval(func, reason, batch)
+
+
+cdef csleqp.SLEQP_RETCODE sleqp_func_nonzeros_batch(csleqp.SleqpFunc* func,
+                                                    int* obj_grad_nnz,
+                                                    int* cons_val_nnz,
+                                                    int* cons_jac_nnz,
+                                                    int* hess_prod_nnz,
+                                                    void* func_data) nogil:
+  return sleqp_func_nonzeros_nogil(func,
+                                   obj_grad_nnz,
+                                   cons_val_nnz,
+                                   cons_jac_nnz,
+                                   hess_prod_nnz,
+                                   (<FuncBatch*> func_data).func_obj)
+
+
+cdef csleqp.SLEQP_RETCODE sleqp_func_obj_val_batch(csleqp.SleqpFunc* func,
+                                                   double* obj_val,
+                                                   void* func_data) nogil:
+  cdef FuncBatch* batch = <FuncBatch*> func_data
+
+  if batch.has_obj_val:
+    obj_val[0] = batch.obj_val
+    return csleqp.SLEQP_OKAY
 
-  set_func_callbacks(&callbacks)
+  return sleqp_func_obj_val_nogil(func, obj_val, batch.func_obj)
 
-  for obj in funcs:
-    func = <_Func> obj
 
-    if not func.cfunc:
-      continue
+cdef csleqp.SLEQP_RETCODE sleqp_func_obj_grad_batch(csleqp.SleqpFunc* func,
+                                                    csleqp.SleqpVec* obj_grad,
+                                                    void* func_data) nogil:
+  cdef FuncBatch* batch = <FuncBatch*> func_data
+
+  if batch.has_obj_grad:
+    return csleqp.sleqp_vec_copy(batch.obj_grad, obj_grad)
+
+  return sleqp_func_obj_grad_nogil(func, obj_grad, batch.func_obj)
+
+
+cdef csleqp.SLEQP_RETCODE sleqp_func_cons_val_batch(csleqp.SleqpFunc* func,
+                                                    csleqp.SleqpVec* cons_vals,
+                                                    void* func_data) nogil:
+  cdef FuncBatch* batch = <FuncBatch*> func_data
+
+  if batch.has_cons_val:
+    return csleqp.sleqp_vec_copy(batch.cons_val, cons_vals)
+
+  return sleqp_func_cons_val_nogil(func, cons_vals, batch.func_obj)
+
+
+cdef csleqp.SLEQP_RETCODE sleqp_func_cons_jac_batch(csleqp.SleqpFunc* func,
+                                                    csleqp.SleqpMat* cons_jac,
+                                                    void* func_data) nogil:
+  cdef FuncBatch* batch = <FuncBatch*> func_data
+
+  if batch.has_cons_jac:
+    return csleqp.sleqp_mat_copy(batch.cons_jac, cons_jac)
+
+  return sleqp_func_cons_jac_nogil(func, cons_jac, batch.func_obj)
+
+
+cdef csleqp.SLEQP_RETCODE sleqp_func_hess_prod_batch(csleqp.SleqpFunc* func,
+                                                     const csleqp.SleqpVec* direction,
+                                                     const csleqp.SleqpVec* cons_dual,
+                                                     csleqp.SleqpVec* product,
+                                                     void* func_data) nogil:
+  return sleqp_func_hess_prod_nogil(func,
+                                    direction,
+                                    cons_dual,
+                                    product,
+                                    (<FuncBatch*> func_data).func_obj)
 
-    csleqp_call(csleqp.sleqp_func_set_callbacks(func.cfunc,
-                                                &callbacks))
+
+cdef csleqp.SLEQP_RETCODE sleqp_func_free_batch(void* func_data):
+  cdef FuncBatch* batch = <FuncBatch*> func_data
+
+  if batch == NULL:
+    return csleqp.SLEQP_OKAY
+
+  csleqp_call(csleqp.sleqp_mat_release(&batch.cons_jac))
+  csleqp_call(csleqp.sleqp_vec_free(&batch.cons_val))
+  csleqp_call(csleqp.sleqp_vec_free(&batch.obj_grad))
+
+  free(batch)
+
+  return csleqp.SLEQP_OKAY
+
+
+cdef FuncBatch* create_func_batch(object func,
+                                  int num_vars,
+                                  int num_cons) except NULL:
+  cdef FuncBatch* batch = <FuncBatch*> calloc(1, sizeof(FuncBatch))
+
+  if batch == NULL:
+    raise MemoryError()
+
+  batch.func_obj = <void*> func
+
+  csleqp_call(csleqp.sleqp_vec_create_empty(&batch.obj_grad, num_vars))
+  csleqp_call(csleqp.sleqp_vec_create_empty(&batch.cons_val, num_cons))
+  csleqp_call(csleqp.sleqp_mat_create(&batch.cons_jac, num_cons, num_vars, 0))
+
+  return batch
+
+
+cdef set_func_callbacks(csleqp.SleqpFuncCallbacks* callbacks):
+  callbacks[0].set_value = &sleqp_func_set_nogil
+  callbacks[0].nonzeros  = &sleqp_func_nonzeros_nogil
+  callbacks[0].obj_val   = &sleqp_func_obj_val_nogil
+  callbacks[0].obj_grad  = &sleqp_func_obj_grad_nogil
+  callbacks[0].cons_val  = &sleqp_func_cons_val_nogil
+  callbacks[0].cons_jac  = &sleqp_func_cons_jac_nogil
+  callbacks[0].hess_prod = &sleqp_func_hess_prod_nogil
+
+  callbacks.func_free  = &sleqp_func_free
+  callbacks.hess_prods = NULL
+  callbacks.clone      = NULL
+
+
+cdef set_batch_func_callbacks(csleqp.SleqpFuncCallbacks* callbacks):
+  callbacks[0].set_value = &sleqp_func_set_batch
+  callbacks[0].nonzeros  = &sleqp_func_nonzeros_batch
+  callbacks[0].obj_val   = &sleqp_func_obj_val_batch
+  callbacks[0].obj_grad  = &sleqp_func_obj_grad_batch
+  callbacks[0].cons_val  = &sleqp_func_cons_val_batch
+  callbacks[0].cons_jac  = &sleqp_func_cons_jac_batch
+  callbacks[0].hess_prod = &sleqp_func_hess_prod_batch
+
+  callbacks.func_free  = &sleqp_func_free_batch
+  callbacks.hess_prods = NULL
+  callbacks.clone      = NULL
 
 
 cdef class _Func:
@@ -339,23 +514,21 @@ cdef class _Func:
 cdef csleqp.SLEQP_RETCODE create_func(csleqp.SleqpFunc** cfunc,
                                       object func,
                                       int num_vars,
-                                      int num_cons):
+                                      int num_cons,
+                                      bint batch_eval = False):
   cdef csleqp.SleqpFuncCallbacks callbacks
-  cdef _Func ofunc = _Func()
-  cdef csleqp.SLEQP_RETCODE retcode
+  cdef void* func_data = <void*> func
 
   assert func is not None
 
-  set_func_callbacks(&callbacks)
-
-  retcode = csleqp.sleqp_func_create(cfunc,
-                                     &callbacks,
-                                     num_vars,
-                                     num_cons,
-                                     <void*> func)
-
-  if cfunc[0] != NULL:
-    ofunc.set_func(cfunc[0])
-    funcs.add(ofunc)
+  if batch_eval:
+    set_batch_func_callbacks(&callbacks)
+    func_data = <void*> create_func_batch(func, num_vars, num_cons)
+  else:
+    set_func_callbacks(&callbacks)
 
-  return retcode
+  return csleqp.sleqp_func_create(cfunc,
+                                  &callbacks,
+                                  num_vars,
+                                  num_cons,
+                                  func_data)
@@ -26,10 +26,7 @@ cdef void sleqp_python_handler_nogil(csleqp.SLEQP_LOG_LEVEL level,
 
 
 cdef update_log_handler():
-  if release_gil:
-    csleqp.sleqp_log_set_handler(sleqp_python_handler_nogil)
-  else:
-    csleqp.sleqp_log_set_handler(sleqp_python_handler)
+  csleqp.sleqp_log_set_handler(sleqp_python_handler_nogil)
 
 
 class SleqpLogger(logging.Logger):
@@ -139,40 +139,17 @@ cdef csleqp.SLEQP_RETCODE sleqp_lsq_jac_adjoint_nogil(csleqp.SleqpFunc* func,
 
 
 cdef set_lsq_func_callbacks(csleqp.SleqpLSQCallbacks* callbacks):
-  if release_gil:
-    callbacks.set_value            = &sleqp_func_set_nogil
-    callbacks.lsq_nonzeros         = &sleqp_lsq_nonzeros_nogil
-    callbacks.lsq_residuals        = &sleqp_lsq_residuals_nogil
-    callbacks.lsq_jac_forward      = &sleqp_lsq_jac_forward_nogil
-    callbacks.lsq_jac_adjoint      = &sleqp_lsq_jac_adjoint_nogil
-    callbacks.cons_val             = &sleqp_func_cons_val_nogil
-    callbacks.cons_jac             = &sleqp_func_cons_jac_nogil
-  else:
-    callbacks.set_value            = &sleqp_func_set
-    callbacks.lsq_nonzeros         = &sleqp_lsq_nonzeros
-    callbacks.lsq_residuals        = &sleqp_lsq_residuals
-    callbacks.lsq_jac_forward      = &sleqp_lsq_jac_forward
-    callbacks.lsq_jac_adjoint      = &sleqp_lsq_jac_adjoint
-    callbacks.cons_val             = &sleqp_func_cons_val
-    callbacks.cons_jac             = &sleqp_func_cons_jac
+  callbacks.set_value            = &sleqp_func_set_nogil
+  callbacks.lsq_nonzeros         = &sleqp_lsq_nonzeros_nogil
+  callbacks.lsq_residuals        = &sleqp_lsq_residuals_nogil
+  callbacks.lsq_jac_forward      = &sleqp_lsq_jac_forward_nogil
+  callbacks.lsq_jac_adjoint      = &sleqp_lsq_jac_adjoint_nogil
+  callbacks.cons_val             = &sleqp_func_cons_val_nogil
+  callbacks.cons_jac             = &sleqp_func_cons_jac_nogil
 
   callbacks.func_free = &sleqp_func_free
 
 
-cdef object lsq_funcs = weakref.WeakSet()
-
-cdef update_lsq_func_callbacks():
-  cdef _Func func
-  cdef csleqp.SleqpLSQCallbacks callbacks
-
-  set_lsq_func_callbacks(&callbacks)
-
-  for obj in lsq_funcs:
-    func = <_Func> obj
-
-    csleqp_call(csleqp.sleqp_lsq_func_set_callbacks(func.cfunc,
-                                                    &callbacks))
-
 cdef csleqp.SLEQP_RETCODE create_lsq_func(csleqp.SleqpFunc** cfunc,
                                           object func,
                                           int num_variables,
@@ -259,6 +259,11 @@ cdef class BaseProblem:
 
 
 cdef class Problem(BaseProblem):
+  """
+  Class modeling a general NLP. If the `batch_eval` property is set,
+  all values required at a point are evaluated as soon as the point
+  is set, acquiring the GIL only once per point
+  """
   cdef _Func funcref
 
   def __cinit__(self,
@@ -287,7 +292,8 @@ cdef class Problem(BaseProblem):
     csleqp_call(create_func(&cfunc,
                             func,
                             num_vars,
-                            num_cons))
+                            num_cons,
+                            properties.get('batch_eval', False)))
 
     assert cfunc != NULL
 
@@ -305,7 +311,6 @@ cdef class Problem(BaseProblem):
                                      properties.get('linear_ub', None))
 
       self.funcref.set_func(cfunc)
-      funcs.add(self.funcref)
 
     finally:
       csleqp_call(csleqp.sleqp_func_release(&cfunc))
@@ -386,7 +391,6 @@ cdef class LSQProblem(BaseProblem):
                                      properties.get('linear_ub', None))
 
       self.funcref.set_func(cfunc)
-      lsq_funcs.add(self.funcref)
 
     finally:
       csleqp_call(csleqp.sleqp_func_release(&cfunc))
@@ -457,7 +461,6 @@ cdef class DynProblem(BaseProblem):
                                      properties.get('linear_ub', None))
 
       self.funcref.set_func(cfunc)
-      dyn_funcs.add(self.funcref)
 
       pass
     finally:
@@ -75,11 +75,15 @@ cdef dict opt_prop_map = {
   'enable_restoration':    _Prop.boolean(csleqp.SLEQP_SETTINGS_BOOL_ENABLE_RESTORATION_PHASE),
   'enable_preprocessor':   _Prop.boolean(csleqp.SLEQP_SETTINGS_BOOL_ENABLE_PREPROCESSOR),
   'lp_resolves':           _Prop.boolean(csleqp.SLEQP_SETTINGS_BOOL_LP_RESOLVES),
+  'speculative_parametric_cauchy': _Prop.boolean(csleqp.SLEQP_SETTINGS_BOOL_SPECULATIVE_PARAMETRIC_CAUCHY),
+  'memory_pool':           _Prop.boolean(csleqp.SLEQP_SETTINGS_BOOL_MEMORY_POOL),
 
   # Integer properties
   'num_quasi_newton_iterates': _Prop.integer(csleqp.SLEQP_SETTINGS_INT_NUM_QUASI_NEWTON_ITERATES),
   'max_newton_iterations':     _Prop.integer(csleqp.SLEQP_SETTINGS_INT_MAX_NEWTON_ITERATIONS),
   'num_threads':               _Prop.integer(csleqp.SLEQP_SETTINGS_INT_NUM_THREADS),
+  'deriv_check_samples':       _Prop.integer(csleqp.SLEQP_SETTINGS_INT_DERIV_CHECK_SAMPLES),
+  'precond_max_block_size':    _Prop.integer(csleqp.SLEQP_SETTINGS_INT_PRECOND_MAX_BLOCK_SIZE),
 
   # SLEQP_SETTINGS_INT_FLOAT_WARNING_FLAGS,
   # SLEQP_SETTINGS_INT_FLOAT_ERROR_FLAGS,
@@ -96,6 +100,8 @@ cdef dict opt_prop_map = {
   'linesearch':           _Prop.enumerated(csleqp.SLEQP_SETTINGS_ENUM_LINESEARCH, LineSearch),
   'parametric_cauchy':    _Prop.enumerated(csleqp.SLEQP_SETTINGS_ENUM_PARAMETRIC_CAUCHY, ParametricCauchy),
   'aug_jac_method':       _Prop.enumerated(csleqp.SLEQP_SETTINGS_ENUM_AUG_JAC_METHOD, AugJacMethod),
+  'tr_precond':           _Prop.enumerated(csleqp.SLEQP_SETTINGS_ENUM_TR_PRECOND, TRPrecond),
+  'deriv_check_sampling': _Prop.enumerated(csleqp.SLEQP_SETTINGS_ENUM_DERIV_CHECK_SAMPLING, DerivCheckSampling),
 
   'zero_eps':           _Prop.real(csleqp.SLEQP_SETTINGS_REAL_ZERO_EPS),
   'eps':                _Prop.real(csleqp.SLEQP_SETTINGS_REAL_EPS),
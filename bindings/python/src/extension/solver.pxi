@@ -2,8 +2,6 @@
 
 from libc.stdlib cimport malloc, free
 
-cdef object solvers = weakref.WeakSet()
-
 cdef class Solver:
   """
   Solver class for NLP problems
@@ -18,16 +16,21 @@ cdef class Solver:
 
   cdef list callback_handles
 
+  cdef object _release_gil
+
   def __cinit__(self,
                 object problem,
                 np.ndarray primal,
-                Scaling scaling=None):
+                Scaling scaling=None,
+                object release_gil=None):
 
     cdef csleqp.SleqpVec* primal_vec
     cdef _Problem _problem = <_Problem> problem._get_problem()
 
     self.callback_handles = []
 
+    self._release_gil = release_gil
+
     csleqp_call(csleqp.sleqp_vec_create_empty(&primal_vec,
                                                         problem.num_vars))
 
@@ -44,8 +47,6 @@ cdef class Solver:
 
     self.problem = problem
 
-    solvers.add(self)
-
   def __dealloc__(self):
     assert self.solver
 
@@ -60,13 +61,14 @@ cdef class Solver:
     cdef csleqp.SleqpSolver* solver = self.solver
     cdef csleqp.SLEQP_RETCODE retcode = csleqp.SLEQP_OKAY
     cdef csleqp.SLEQP_ERROR_TYPE error_type
+    cdef bint nogil_solve = self.release_gil
 
     self.problem.func.call_exception = None
 
     for obj in self.callback_handles:
       (<CallbackHandle> obj).call_exception = None
 
-    if release_gil:
+    if nogil_solve:
       with nogil:
         retcode = csleqp.sleqp_solver_solve(self.solver,
                                             max_num_iterations,
@@ -108,6 +110,24 @@ cdef class Solver:
 
     raise exception from _get_exception()
 
+  @property
+  def release_gil(self) -> bool:
+    """
+    Whether or not the GIL is released while solving. Releasing the GIL
+    allows several solvers to run in parallel from different threads,
+    the GIL is only reacquired to call user-provided functions and
+    callbacks. Unless set explicitly, the value of :func:`get_release_gil`
+    is used
+    """
+    if self._release_gil is None:
+      return get_release_gil()
+
+    return self._release_gil
+
+  @release_gil.setter
+  def release_gil(self, value):
+    self._release_gil = value
+
   def info(self) -> str:
     return str(csleqp.sleqp_solver_info(self.solver))
 
@@ -149,6 +169,15 @@ cdef class Solver:
     """
     csleqp_call(csleqp.sleqp_solver_abort(self.solver))
 
+  def warm_start(self, Solver source):
+    """
+    Seeds the next call to solve() with the final state of the
+    given solver, which has to solve a problem with the same
+    structure. Passing the solver itself hot starts it from
+    its last solution.
+    """
+    csleqp_call(csleqp.sleqp_solver_warm_start(self.solver, source.solver))
+
   @property
   def iterations(self) -> int:
     return csleqp.sleqp_solver_iterations(self.solver)
@@ -157,6 +186,17 @@ cdef class Solver:
   def elapsed_seconds(self) -> float:
     return csleqp.sleqp_solver_elapsed_seconds(self.solver)
 
+  cpdef set_trace_file(self, str filename):
+    """
+    Records one row per iteration of subsequent solves in the
+    given file, which can be read using :func:`read_trace`.
+    Passing `None` stops the recording.
+    """
+    if filename is None:
+      csleqp_call(csleqp.sleqp_solver_set_trace_file(self.solver, NULL))
+    else:
+      csleqp_call(csleqp.sleqp_solver_set_trace_file(self.solver, filename))
+
   @property
   def violated_cons(self) -> set:
     num_constraints =  self.problem.num_cons
@@ -225,25 +265,6 @@ cdef class Solver:
 
     self.callback_handles.remove(callback_handle)
 
-  cdef update_callbacks(self):
-    cdef CallbackHandle callback_handle
-
-    for obj in self.callback_handles:
-      callback_handle = <CallbackHandle> obj
-
-      csleqp_call(csleqp.sleqp_solver_remove_callback(self.solver,
-                                                      callback_handle.event.value,
-                                                      callback_handle.function_pointer,
-                                                      <void*> callback_handle))
-
-      csleqp_call(get_callback_function_pointer(callback_handle.event,
-                                                &callback_handle.function_pointer))
-
-      csleqp_call(csleqp.sleqp_solver_add_callback(self.solver,
-                                                   callback_handle.event.value,
-                                                   callback_handle.function_pointer,
-                                                   <void*> callback_handle))
-
   @property
   def states(self):
     """
@@ -291,6 +312,26 @@ cdef class Solver:
       SolverState.ScaledVarSlackResiduals:  vars_slack_residuals
     }
 
+  @property
+  def timings(self):
+    """
+    Return timing statistics of the solver components as dict
+    """
+    cdef csleqp.SleqpTimingStats stats
+
+    timings = {}
+
+    for timing in SolverTiming:
+      csleqp_call(csleqp.sleqp_solver_timing_stats(self.solver,
+                                                   timing.value,
+                                                   &stats))
+
+      timings[timing] = {'runs': stats.num_runs,
+                         'wall_time': stats.wall_time,
+                         'cpu_time': stats.cpu_time}
+
+    return timings
+
   cpdef double _get_solver_real_state(self, int state):
     cdef double value = 0.
     csleqp_call(csleqp.sleqp_solver_real_state(self.solver,
@@ -304,11 +345,3 @@ cdef class Solver:
                                               <csleqp.SLEQP_SOLVER_STATE_INT> state,
                                               &value))
     return value
-
-
-cdef update_solver_callbacks():
-  cdef Solver solver
-  for obj in solvers:
-    solver = <Solver> obj
-
-    solver.update_callbacks()
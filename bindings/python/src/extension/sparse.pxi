@@ -1,11 +1,15 @@
 #cython: language_level=3
 
+from libc.string cimport memcpy
+
 cdef object sleqp_sparse_vec_to_array(const csleqp.SleqpVec* vec):
   assert vec
   values = np.zeros((vec.dim,), dtype=np.float64)
 
-  for k in range(vec.nnz):
-    values[vec.indices[k]] = vec.data[k]
+  cdef double[::1] values_view = values
+
+  if vec.dim > 0:
+    csleqp_call(csleqp.sleqp_vec_to_raw(vec, &values_view[0]))
 
   return values
 
@@ -20,76 +24,43 @@ cdef csleqp.SLEQP_RETCODE array_to_sleqp_sparse_vec(np.ndarray array,
 
   assert array.ndim == 1
 
-  cdef int dim = array.shape[0]
-
-  csleqp_call(csleqp.sleqp_vec_reserve(vec, dim))
-
-  for i in range(dim):
-    if array[i] != 0.:
-      csleqp_call(csleqp.sleqp_vec_push(vec,
-                                                  i,
-                                                  array[i]))
-
-  return csleqp.SLEQP_OKAY
-
-class DenseIterator:
-  def __init__(self, matrix):
-    self.matrix = matrix
-    self.iter = np.nditer(self.matrix,
-                          flags=['multi_index'],
-                          order='F')
-
-  def __iter__(self):
-    while not self.iter.finished:
-      data = self.iter[0]
-      if not data:
-        self.iter.iternext()
-        continue
-
-      yield self.iter.multi_index, data
-
-      self.iter.iternext()
+  # Avoids a copy if the array is already contiguous
+  cdef const double[::1] values = np.ascontiguousarray(array,
+                                                       dtype=np.float64)
 
-  def length_bound(self):
-    return np.prod(self.matrix.shape)
+  cdef int dim = values.shape[0]
 
+  if dim == 0:
+    return csleqp.SLEQP_OKAY
 
-class CSCIterator:
-  def __init__(self, matrix):
-    assert scipy.sparse.isspmatrix_csc(matrix)
-    self.matrix = matrix
-    self._length_bound = -1
-
-  def __iter__(self):
-    for col in range(self.matrix.shape[1]):
-      for ind in range(self.matrix.indptr[col], self.matrix.indptr[col+1]):
-        data = self.matrix.data[ind]
-        if data:
-          yield (self.matrix.indices[ind], col), self.matrix.data[ind]
-
-  def length_bound(self):
-    if self._length_bound != -1:
-      return self._length_bound
-
-    self._length_bound = self.matrix.count_nonzero()
-
-    return self._length_bound
+  csleqp_call(csleqp.sleqp_vec_set_from_raw(vec,
+                                            <double*> &values[0],
+                                            dim,
+                                            0.))
 
-def matrix_iterator(matrix):
-  assert not (matrix is None)
-  assert matrix.ndim == 2
+  return csleqp.SLEQP_OKAY
 
+def canonical_csc_matrix(matrix):
+  """
+  Converts the given dense or sparse matrix into a CSC matrix
+  with sorted row indices and without duplicate or explicit zero
+  entries. The given matrix is never modified, CSC matrices
+  which are already canonical are returned as-is.
+  """
   if not scipy.sparse.issparse(matrix):
-    return DenseIterator(matrix)
-
-  assert scipy.sparse.issparse(matrix)
+    return scipy.sparse.csc_matrix(np.asarray(matrix, dtype=np.float64))
 
   if not scipy.sparse.isspmatrix_csc(matrix):
     matrix = scipy.sparse.csc_matrix(matrix)
+  elif matrix.has_canonical_format and matrix.data.all():
+    return matrix
+
+  matrix = matrix.copy()
 
-  assert scipy.sparse.isspmatrix_csc(matrix)
+  matrix.sum_duplicates()
+  matrix.eliminate_zeros()
 
-  return CSCIterator(matrix)
+  return matrix
 
 cdef csleqp.SLEQP_RETCODE matrix_to_sleqp_sparse_matrix(object mat,
                                                         csleqp.SleqpMat* matrix) \
@@ -101,37 +72,39 @@ cdef csleqp.SLEQP_RETCODE matrix_to_sleqp_sparse_matrix(object mat,
 
   assert mat.ndim == 2
 
-  num_rows = csleqp.sleqp_mat_num_rows(matrix)
-  num_cols = csleqp.sleqp_mat_num_cols(matrix)
+  cdef int num_rows = csleqp.sleqp_mat_num_rows(matrix)
+  cdef int num_cols = csleqp.sleqp_mat_num_cols(matrix)
 
   assert mat.shape == (num_rows, num_cols)
 
   if num_rows == 0 or num_cols == 0:
     return csleqp.SLEQP_OKAY
 
-  cdef int last_col = -1
+  csc_mat = canonical_csc_matrix(mat)
+
+  # Buffers already matching the layout of the matrix
+  # are copied directly, without intermediate conversions
+  cdef const int[::1] cols = np.ascontiguousarray(csc_mat.indptr,
+                                                  dtype=np.intc)
+
+  cdef const int[::1] rows = np.ascontiguousarray(csc_mat.indices,
+                                                  dtype=np.intc)
 
-  matrix_iter = matrix_iterator(mat)
+  cdef const double[::1] data = np.ascontiguousarray(csc_mat.data,
+                                                     dtype=np.float64)
 
-  for (row, col), data in matrix_iter:
-    while last_col != col:
-      last_col += 1
-      csleqp_call(csleqp.sleqp_mat_push_col(matrix, last_col))
+  cdef int nnz = data.shape[0]
 
-    nnz = csleqp.sleqp_mat_nnz(matrix)
-    nnz_max = csleqp.sleqp_mat_nnz_max(matrix)
+  csleqp_call(csleqp.sleqp_mat_reserve(matrix, nnz))
 
-    if nnz == nnz_max:
-      csleqp_call(csleqp.sleqp_mat_reserve(matrix,
-                                           matrix_iter.length_bound()))
+  memcpy(csleqp.sleqp_mat_cols(matrix),
+         &cols[0],
+         (num_cols + 1) * sizeof(int))
 
-    csleqp_call(csleqp.sleqp_mat_push(matrix,
-                                      row,
-                                      col,
-                                      data))
+  if nnz > 0:
+    memcpy(csleqp.sleqp_mat_rows(matrix), &rows[0], nnz * sizeof(int))
+    memcpy(csleqp.sleqp_mat_data(matrix), &data[0], nnz * sizeof(double))
 
-  while last_col < csleqp.sleqp_mat_num_cols(matrix) - 1:
-    last_col += 1
-    csleqp_call(csleqp.sleqp_mat_push_col(matrix, last_col))
+  csleqp_call(csleqp.sleqp_mat_set_nnz(matrix, nnz))
 
   return csleqp.SLEQP_OKAY
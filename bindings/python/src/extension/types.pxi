@@ -39,6 +39,15 @@ class DerivCheck(Flag):
   SecondSimple     = csleqp.SLEQP_DERIV_CHECK_SECOND_SIMPLE
 
 
+class DerivCheckSampling(_DocEnum):
+  """
+  The points along which derivatives are checked
+  """
+  NoSampling  = csleqp.SLEQP_DERIV_CHECK_SAMPLING_NONE, "All coordinates"
+  Coordinates = csleqp.SLEQP_DERIV_CHECK_SAMPLING_COORDINATES, "A random subset of coordinates"
+  Directions  = csleqp.SLEQP_DERIV_CHECK_SAMPLING_DIRECTIONS, "Random directions"
+
+
 class HessianEval(_DocEnum):
   """
   The evaluation method used for Hessian products
@@ -117,6 +126,16 @@ class AugJacMethod(_DocEnum):
   Direct = csleqp.SLEQP_AUG_JAC_DIRECT, "Direct"
 
 
+class TRPrecond(_DocEnum):
+  """
+  Preconditioner of the CG trust-region solver
+  """
+  NoPrecond = csleqp.SLEQP_TR_PRECOND_NONE, "No preconditioning"
+  Diagonal = csleqp.SLEQP_TR_PRECOND_DIAGONAL, "Diagonal (Jacobi) preconditioning"
+  QuasiNewton = csleqp.SLEQP_TR_PRECOND_QUASI_NEWTON, "Limited-memory BFGS preconditioning"
+  IncompleteCholesky = csleqp.SLEQP_TR_PRECOND_INCOMPLETE_CHOLESKY, "Incomplete Cholesky preconditioning"
+
+
 class ValueReason(_DocEnum):
   """
   The reason for setting a new function value
@@ -174,6 +193,24 @@ class SolverState(Enum):
   ScaledVarSlackResiduals  = auto()
 
 
+class SolverTiming(Enum):
+  Total              = csleqp.SLEQP_SOLVER_TIMING_TOTAL
+  Preprocessing      = csleqp.SLEQP_SOLVER_TIMING_PREPROCESSING
+  FuncSet            = csleqp.SLEQP_SOLVER_TIMING_FUNC_SET
+  FuncObjVal         = csleqp.SLEQP_SOLVER_TIMING_FUNC_OBJ_VAL
+  FuncObjGrad        = csleqp.SLEQP_SOLVER_TIMING_FUNC_OBJ_GRAD
+  FuncConsVal        = csleqp.SLEQP_SOLVER_TIMING_FUNC_CONS_VAL
+  FuncConsJac        = csleqp.SLEQP_SOLVER_TIMING_FUNC_CONS_JAC
+  FuncHessProd       = csleqp.SLEQP_SOLVER_TIMING_FUNC_HESS_PROD
+  QuasiNewtonProd    = csleqp.SLEQP_SOLVER_TIMING_QUASI_NEWTON_PROD
+  QuasiNewtonUpdate  = csleqp.SLEQP_SOLVER_TIMING_QUASI_NEWTON_UPDATE
+  Factorization      = csleqp.SLEQP_SOLVER_TIMING_FACTORIZATION
+  Substitution       = csleqp.SLEQP_SOLVER_TIMING_SUBSTITUTION
+  EQP                = csleqp.SLEQP_SOLVER_TIMING_EQP
+  LP                 = csleqp.SLEQP_SOLVER_TIMING_LP
+  Linesearch         = csleqp.SLEQP_SOLVER_TIMING_LINESEARCH
+
+
 class StepType(Enum):
   NoStep       = csleqp.SLEQP_STEPTYPE_NONE
   Accepted     = csleqp.SLEQP_STEPTYPE_ACCEPTED
@@ -2,4 +2,6 @@ from .sleqp import *
 
 from sleqp.minimize import minimize
 
+from sleqp._trace import read_trace
+
 from .sleqp import sleqp_logger as logger
@@ -0,0 +1,49 @@
+import numpy as np
+
+
+_magic = b'SLEQPTRC'
+
+_column_types = {0: np.int32, 1: np.float64}
+
+
+def read_trace(filename):
+  """
+  Reads an iteration trace written by a solver. Returns
+  a dict mapping column names to arrays with one entry
+  per iteration.
+  """
+  with open(filename, 'rb') as f:
+    data = f.read()
+
+  if data[:len(_magic)] != _magic:
+    raise ValueError('Invalid trace file \'{0}\''.format(filename))
+
+  pos = len(_magic)
+
+  (version, num_columns) = np.frombuffer(data, np.int32, 2, pos)
+  pos += 8
+
+  if version != 1:
+    raise ValueError('Unsupported trace version {0}'.format(version))
+
+  columns = []
+
+  for _ in range(num_columns):
+    (column_type, length) = data[pos], data[pos + 1]
+    pos += 2
+    name = data[pos:pos + length].decode('ascii')
+    pos += length
+    columns.append((name, np.dtype(_column_types[column_type])))
+
+  blocks = {name: [] for (name, _) in columns}
+
+  while pos < len(data):
+    num_rows = int(np.frombuffer(data, np.int32, 1, pos)[0])
+    pos += 4
+
+    for (name, dtype) in columns:
+      blocks[name].append(np.frombuffer(data, dtype, num_rows, pos))
+      pos += num_rows * dtype.itemsize
+
+  return {name: np.concatenate(values) if values else np.empty(0, dtype)
+          for ((name, dtype), values) in zip(columns, blocks.values())}
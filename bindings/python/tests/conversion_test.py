@@ -0,0 +1,83 @@
+#!/usr/bin/env python
+
+import numpy as np
+import unittest
+
+import scipy.sparse
+
+import sleqp
+
+class ConversionTest(unittest.TestCase):
+
+  def setUp(self):
+    self.dense = np.array([[1., 0., 2.],
+                           [0., 0., 3.]])
+
+  def assert_canonical(self, matrix):
+    self.assertTrue(scipy.sparse.isspmatrix_csc(matrix))
+    self.assertTrue(matrix.has_canonical_format)
+    self.assertTrue(matrix.data.all())
+    self.assertTrue((matrix.toarray() == self.dense).all())
+
+  def test_dense(self):
+    self.assert_canonical(sleqp.canonical_csc_matrix(self.dense))
+
+  def test_other_formats(self):
+    for matrix in [scipy.sparse.coo_matrix(self.dense),
+                   scipy.sparse.csr_matrix(self.dense)]:
+      self.assert_canonical(sleqp.canonical_csc_matrix(matrix))
+
+  def test_canonical(self):
+    matrix = scipy.sparse.csc_matrix(self.dense)
+
+    self.assertIs(sleqp.canonical_csc_matrix(matrix), matrix)
+
+  def test_explicit_zeros(self):
+    matrix = scipy.sparse.csc_matrix(self.dense)
+    matrix.data[0] = 0.
+
+    converted = sleqp.canonical_csc_matrix(matrix)
+
+    self.assertEqual(matrix.nnz, 3)
+    self.assertEqual(converted.nnz, 2)
+
+  def test_duplicates(self):
+    rows = np.array([0, 1, 0, 1, 0], dtype=np.int64)
+    cols = np.array([0, 2, 2, 2, 0], dtype=np.int64)
+    data = np.array([.5, 1., 2., 2., .5])
+
+    matrix = scipy.sparse.csc_matrix((data, (rows, cols)), shape=(2, 3))
+
+    self.assert_canonical(sleqp.canonical_csc_matrix(matrix))
+
+  def test_linear_coeffs(self):
+    inf = sleqp.inf()
+
+    class Func:
+      def set_value(self, v, reason):
+        pass
+
+      def obj_val(self):
+        return 0.
+
+      def obj_grad(self):
+        return np.zeros((3,))
+
+      def hess_prod(self, direction, cons_dual):
+        return np.zeros((3,))
+
+    matrix = scipy.sparse.csr_matrix(self.dense)
+
+    problem = sleqp.Problem(Func(),
+                            np.array([-inf]*3),
+                            np.array([inf]*3),
+                            np.zeros((0,)),
+                            np.zeros((0,)),
+                            linear_coeffs=matrix,
+                            linear_lb=np.array([-inf]*2),
+                            linear_ub=np.array([inf]*2))
+
+    self.assertEqual(problem.num_cons, 2)
+
+if __name__ == '__main__':
+  unittest.main()
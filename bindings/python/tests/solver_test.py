@@ -1,6 +1,8 @@
 #!/usr/bin/env python
 
 import numpy as np
+import os
+import tempfile
 import unittest
 
 import sleqp
@@ -133,6 +135,37 @@ class SolverTest(unittest.TestCase):
     self.assertTrue(np.allclose(expected_cons_jac,
                                 actual_cons_jac))
 
+  def test_trace(self):
+    with tempfile.TemporaryDirectory() as directory:
+      filename = os.path.join(directory, 'trace.bin')
+
+      solver = self.get_solver()
+
+      solver.set_trace_file(filename)
+
+      solver.solve(max_num_iterations=100)
+
+      self.assertEqual(solver.status, sleqp.Status.Optimal)
+
+      trace = sleqp.read_trace(filename)
+
+      self.assertEqual(len(trace['iteration']), solver.iterations)
+      self.assertTrue((trace['lp_time'] >= 0.).all())
+      self.assertTrue((np.diff(trace['elapsed']) >= 0.).all())
+
+      solver.set_trace_file(None)
+
+  def test_timings(self):
+    solver = self.get_solver()
+
+    solver.solve(max_num_iterations=100)
+
+    timings = solver.timings
+
+    self.assertGreater(timings[sleqp.SolverTiming.LP]['runs'], 0)
+    self.assertGreaterEqual(timings[sleqp.SolverTiming.Total]['wall_time'],
+                            timings[sleqp.SolverTiming.LP]['wall_time'])
+
 
 if __name__ == '__main__':
   import logging
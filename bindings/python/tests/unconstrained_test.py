@@ -1,6 +1,7 @@
 #!/usr/bin/env python
 
 import numpy as np
+import threading
 import unittest
 
 import sleqp
@@ -31,18 +32,87 @@ class UnconstrainedTest(unittest.TestCase):
                                 self.solver.solution.primal))
 
   def test_solve_nogil(self):
-    sleqp.set_release_gil(True)
+    self.solver.release_gil = True
 
-    try:
-      self.solver.solve(100, 3600)
+    self.solver.solve(100, 3600)
 
-      self.assertEqual(self.solver.status, sleqp.Status.Optimal)
+    self.assertEqual(self.solver.status, sleqp.Status.Optimal)
 
-      self.assertTrue(np.allclose(expected_sol,
-                                  self.solver.solution.primal))
+    self.assertTrue(np.allclose(expected_sol,
+                                self.solver.solution.primal))
+
+  def test_warm_start(self):
+    self.solver.solve(100, 3600)
+
+    problem = sleqp.Problem(RosenbrockFunc(),
+                            var_lb,
+                            var_ub,
+                            cons_lb,
+                            cons_ub)
+
+    solver = sleqp.Solver(problem,
+                          initial_sol)
+
+    solver.warm_start(self.solver)
+
+    solver.solve(100, 3600)
+
+    self.assertEqual(solver.status, sleqp.Status.Optimal)
+
+    self.assertLess(solver.iterations, self.solver.iterations)
+
+    self.assertTrue(np.allclose(expected_sol,
+                                solver.solution.primal))
 
-    finally:
-      sleqp.set_release_gil(False)
+  def test_solve_batch(self):
+    problem = sleqp.Problem(RosenbrockFunc(),
+                            var_lb,
+                            var_ub,
+                            cons_lb,
+                            cons_ub,
+                            batch_eval=True)
+
+    solver = sleqp.Solver(problem,
+                          initial_sol)
+
+    solver.solve(100, 3600)
+
+    self.assertEqual(solver.status, sleqp.Status.Optimal)
+
+    self.assertTrue(np.allclose(expected_sol,
+                                solver.solution.primal))
+
+  def test_parallel_solve(self):
+    num_solvers = 4
+
+    solvers = []
+
+    for i in range(num_solvers):
+      problem = sleqp.Problem(RosenbrockFunc(),
+                              var_lb,
+                              var_ub,
+                              cons_lb,
+                              cons_ub,
+                              batch_eval=(i % 2 == 0))
+
+      solvers.append(sleqp.Solver(problem,
+                                  initial_sol,
+                                  release_gil=True))
+
+    threads = [threading.Thread(target=solver.solve, args=(100, 3600))
+               for solver in solvers]
+
+    for thread in threads:
+      thread.start()
+
+    for thread in threads:
+      thread.join()
+
+    for solver in solvers:
+      self.assertEqual(solver.status, sleqp.Status.Optimal)
+
+      self.assertTrue(np.allclose(expected_sol,
+                                  solver.solution.primal))
 
 
 if __name__ == '__main__':
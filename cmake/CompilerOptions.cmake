@@ -23,3 +23,12 @@ check_c_source_compiles(
     "
     SLEQP_HAVE_ATTRIBUTE_FORMAT
 )
+
+check_c_source_compiles(
+    "
+        __attribute__((target_clones(\"avx512f\", \"avx2\", \"default\")))
+        int f(int x) { return x; }
+        int main(void) {return f(0);}
+    "
+    SLEQP_HAVE_ATTRIBUTE_TARGET_CLONES
+)
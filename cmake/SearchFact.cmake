@@ -70,12 +70,14 @@ add_fact(
 add_fact(
   NAME "MA86"
   SOURCES
-  fact/fact_ma86.c)
+  fact/fact_ma86.c
+  fact/fact_threads.c)
 
 add_fact(
   NAME "MA97"
   SOURCES
-  fact/fact_ma97.c)
+  fact/fact_ma97.c
+  fact/fact_threads.c)
 
 add_fact(
   NAME "LAPACK"
@@ -7,6 +7,10 @@ include(SearchCoinHSL)
 
 set(MA86_INCLUDE_DIRS "")
 
+if(NOT(OpenMP_FOUND))
+  find_package(OpenMP)
+endif()
+
 if(METIS_FOUND)
   if(CoinHSL_FOUND)
     set(MA86_LIBRARIES ${CoinHSL_LIBRARIES} ${MEITS_LIBRARY})
@@ -24,3 +28,8 @@ if(METIS_FOUND)
     set(MA86_LIBRARIES ${MA86_LIBRARY} ${METIS_LIBRARIES})
   endif()
 endif()
+
+# Added to the dependencies of sleqp_objects rather than the global flags
+if(OpenMP_FOUND)
+  list(APPEND MA86_LIBRARIES OpenMP::OpenMP_C)
+endif()
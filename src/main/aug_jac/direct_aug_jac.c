@@ -31,8 +31,7 @@ update_dims(AugJacData* aug_jac,
   SLEQP_CALL(sleqp_vec_clear(aug_jac->product));
   SLEQP_CALL(sleqp_vec_resize(aug_jac->product, cons_jac_num_rows));
 
-  sleqp_free(&aug_jac->row_sums);
-  SLEQP_CALL(sleqp_alloc_array(&aug_jac->row_sums, cons_jac_num_rows));
+  SLEQP_CALL(sleqp_realloc(&aug_jac->row_sums, cons_jac_num_rows));
 
   const int num_active_cons = sleqp_working_set_num_active_cons(working_set);
 
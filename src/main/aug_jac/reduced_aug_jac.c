@@ -17,6 +17,9 @@ typedef struct
   SleqpFact* fact;
   bool has_factorization;
 
+  // Problem version of the factorized matrix
+  int factorization_version;
+
   // J^T*J
   SleqpMat* matrix;
 
@@ -258,27 +261,6 @@ fill_system(AugJacData* jacobian,
   return SLEQP_OKAY;
 }
 
-static SLEQP_RETCODE
-reserve_more_and_push(SleqpMat* matrix, int row, int col, double value)
-{
-  const int nnz = sleqp_mat_nnz(matrix);
-
-  if (nnz == sleqp_mat_nnz_max(matrix))
-  {
-    const int num_cols = sleqp_mat_num_cols(matrix);
-    const int num_rows = sleqp_mat_num_rows(matrix);
-
-    const int size = num_cols * num_rows;
-
-    const int next_nnz = SLEQP_MIN(size, 2 * nnz + 1);
-    SLEQP_CALL(sleqp_mat_reserve(matrix, next_nnz));
-  }
-
-  SLEQP_CALL(sleqp_mat_push(matrix, row, col, value));
-
-  return SLEQP_OKAY;
-}
-
 void
 compute_inner_product(const int* rows,
                       const int* cols,
@@ -342,7 +324,7 @@ compute_matrix_lower(AugJacData* jacobian, int num_active_vars)
 
     if (col < num_active_vars)
     {
-      SLEQP_CALL(reserve_more_and_push(matrix, col, col, 1.));
+      SLEQP_CALL(sleqp_mat_push(matrix, col, col, 1.));
     }
     else
     {
@@ -353,7 +335,7 @@ compute_matrix_lower(AugJacData* jacobian, int num_active_vars)
         product += data[col_index] * data[col_index];
       }
 
-      SLEQP_CALL(reserve_more_and_push(matrix, col, col, product));
+      SLEQP_CALL(sleqp_mat_push(matrix, col, col, product));
     }
 
     for (int row = col + 1; row < size; ++row)
@@ -366,7 +348,7 @@ compute_matrix_lower(AugJacData* jacobian, int num_active_vars)
       // push product
       if (nonzero)
       {
-        SLEQP_CALL(reserve_more_and_push(matrix, row, col, product));
+        SLEQP_CALL(sleqp_mat_push(matrix, row, col, product));
       }
     }
   }
@@ -404,7 +386,7 @@ compute_matrix_general(AugJacData* jacobian)
       // push product
       if (nonzero)
       {
-        SLEQP_CALL(reserve_more_and_push(matrix, row, col, product));
+        SLEQP_CALL(sleqp_mat_push(matrix, row, col, product));
       }
     }
   }
@@ -439,6 +421,13 @@ aug_jac_set_iterate(SleqpIterate* iterate, void* data)
 
   const int num_active_vars = sleqp_working_set_num_active_vars(working_set);
 
+  // Fixed Jacobians change along with the linear coefficients
+  if (jacobian->factorization_version
+      != sleqp_problem_version(jacobian->problem))
+  {
+    jacobian->has_factorization = false;
+  }
+
   // Do not recompute for linear problems & unchanged working set
   if (jacobian->working_set)
   {
@@ -471,7 +460,8 @@ aug_jac_set_iterate(SleqpIterate* iterate, void* data)
   SLEQP_CALL(compute_matrix(jacobian, num_active_vars));
 
   SLEQP_CALL(sleqp_fact_set_matrix(jacobian->fact, jacobian->matrix));
-  jacobian->has_factorization = true;
+  jacobian->has_factorization     = true;
+  jacobian->factorization_version = sleqp_problem_version(jacobian->problem);
 
   return SLEQP_OKAY;
 }
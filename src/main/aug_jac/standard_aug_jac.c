@@ -1,5 +1,9 @@
 #include "standard_aug_jac.h"
 
+#include <math.h>
+#include <string.h>
+
+#include "cmp.h"
 #include "fail.h"
 #include "log.h"
 #include "mem.h"
@@ -7,6 +11,27 @@
 #include "working_set.h"
 
 #include "fact/fact.h"
+#include "sparse/vec_kernels.h"
+
+/*
+ * For problems with linear constraints, small changes of the working set
+ * are handled by bordering the factorized base system K0 rather than
+ * refactorizing. Each added row and each removed row of the base working
+ * set contributes one column v to V, yielding the system
+ *
+ *  [ K0   V ] [x]   [r]
+ *  [ V^T  0 ] [z] = [s]
+ *
+ * Added rows are given by v = (a, 0), removed rows at base position p by
+ * v = e_{n + p}, which fixes their multipliers to zero. The system is solved
+ * using the Schur complement C = -V^T K0^{-1} V.
+ */
+
+// Maximum number of rows in which the working set may differ from the base
+static const int max_updates = 8;
+
+// Relative pivot tolerance of the Schur complement
+static const double schur_pivot_tol = 1e-10;
 
 typedef struct
 {
@@ -18,6 +43,9 @@ typedef struct
 
   bool has_factorization;
 
+  // Problem version of the factorized matrix
+  int factorization_version;
+
   SleqpMat* augmented_matrix;
   SleqpFact* fact;
 
@@ -29,6 +57,29 @@ typedef struct
   double condition;
 
   int* col_indices;
+
+  // Low-rank updates, only used for linear constraints
+  SleqpWorkingSet* base_working_set;
+  int base_size;
+  int* base_positions;
+
+  bool use_updates;
+  int num_updates;
+  int* update_contents;
+  int* update_base_positions;
+
+  double* update_cols;
+  double* update_sols;
+
+  double* schur;
+  int* schur_pivots;
+
+  double* dense_rhs;
+  double* dense_sol;
+  double* base_dense;
+
+  SleqpVec* base_rhs;
+  SleqpVec* base_sol;
 } AugJacData;
 
 static SLEQP_RETCODE
@@ -236,6 +287,474 @@ fill_aug_jac(AugJacData* jacobian, SleqpIterate* iterate, bool lower_only)
   return SLEQP_OKAY;
 }
 
+static SLEQP_RETCODE
+set_base(AugJacData* jacobian, SleqpWorkingSet* working_set)
+{
+  SleqpProblem* problem = jacobian->problem;
+
+  const int num_variables   = sleqp_problem_num_vars(problem);
+  const int num_constraints = sleqp_problem_num_cons(problem);
+
+  SLEQP_CALL(sleqp_working_set_copy(working_set, jacobian->base_working_set));
+
+  const int working_set_size = sleqp_working_set_size(working_set);
+
+  jacobian->base_size   = num_variables + working_set_size;
+  jacobian->use_updates = false;
+  jacobian->num_updates = 0;
+
+  for (int k = 0; k < num_variables + num_constraints; ++k)
+  {
+    jacobian->base_positions[k] = SLEQP_NONE;
+  }
+
+  for (int p = 0; p < working_set_size; ++p)
+  {
+    const int content = sleqp_working_set_content(working_set, p);
+
+    jacobian->base_positions[content] = p;
+  }
+
+  return SLEQP_OKAY;
+}
+
+static int
+working_set_position(SleqpWorkingSet* working_set,
+                     int num_variables,
+                     int content)
+{
+  if (content < num_variables)
+  {
+    return sleqp_working_set_var_index(working_set, content);
+  }
+
+  return sleqp_working_set_cons_index(working_set, content - num_variables);
+}
+
+// Collects the rows in which the working set differs from the base
+static bool
+collect_updates(AugJacData* jacobian, SleqpWorkingSet* working_set)
+{
+  SleqpProblem* problem = jacobian->problem;
+
+  SleqpWorkingSet* base_working_set = jacobian->base_working_set;
+
+  const int num_variables = sleqp_problem_num_vars(problem);
+
+  const int base_set_size = sleqp_working_set_size(base_working_set);
+  const int set_size      = sleqp_working_set_size(working_set);
+
+  int num_updates = 0;
+
+  for (int p = 0; p < base_set_size; ++p)
+  {
+    const int content = sleqp_working_set_content(base_working_set, p);
+
+    if (working_set_position(working_set, num_variables, content)
+        != SLEQP_NONE)
+    {
+      continue;
+    }
+
+    if (num_updates == max_updates)
+    {
+      return false;
+    }
+
+    jacobian->update_contents[num_updates]       = content;
+    jacobian->update_base_positions[num_updates] = p;
+    ++num_updates;
+  }
+
+  for (int q = 0; q < set_size; ++q)
+  {
+    const int content = sleqp_working_set_content(working_set, q);
+
+    if (jacobian->base_positions[content] != SLEQP_NONE)
+    {
+      continue;
+    }
+
+    if (num_updates == max_updates)
+    {
+      return false;
+    }
+
+    jacobian->update_contents[num_updates]       = content;
+    jacobian->update_base_positions[num_updates] = SLEQP_NONE;
+    ++num_updates;
+  }
+
+  jacobian->num_updates = num_updates;
+
+  return true;
+}
+
+static SLEQP_RETCODE
+fill_update_cols(AugJacData* jacobian, SleqpIterate* iterate)
+{
+  SleqpProblem* problem = jacobian->problem;
+  SleqpMat* cons_jac    = sleqp_iterate_cons_jac(iterate);
+
+  const int num_variables = sleqp_problem_num_vars(problem);
+  const int base_size     = jacobian->base_size;
+  const int num_updates   = jacobian->num_updates;
+
+  double* update_cols = jacobian->update_cols;
+
+  for (int k = 0; k < base_size * num_updates; ++k)
+  {
+    update_cols[k] = 0.;
+  }
+
+  bool has_added_cons = false;
+
+  for (int l = 0; l < num_updates; ++l)
+  {
+    const int content  = jacobian->update_contents[l];
+    const int base_pos = jacobian->update_base_positions[l];
+    double* update_col = update_cols + l * base_size;
+
+    if (base_pos != SLEQP_NONE)
+    {
+      update_col[num_variables + base_pos] = 1.;
+    }
+    else if (content < num_variables)
+    {
+      update_col[content] = 1.;
+    }
+    else
+    {
+      has_added_cons = true;
+    }
+  }
+
+  if (!has_added_cons)
+  {
+    return SLEQP_OKAY;
+  }
+
+  // Gather the rows of added constraints
+  const int* cons_jac_cols    = sleqp_mat_cols(cons_jac);
+  const int* cons_jac_rows    = sleqp_mat_rows(cons_jac);
+  const double* cons_jac_data = sleqp_mat_data(cons_jac);
+
+  for (int col = 0; col < num_variables; ++col)
+  {
+    for (int index = cons_jac_cols[col]; index < cons_jac_cols[col + 1];
+         ++index)
+    {
+      const int content = num_variables + cons_jac_rows[index];
+
+      for (int l = 0; l < num_updates; ++l)
+      {
+        if (jacobian->update_contents[l] == content
+            && jacobian->update_base_positions[l] == SLEQP_NONE)
+        {
+          update_cols[l * base_size + col] = cons_jac_data[index];
+        }
+      }
+    }
+  }
+
+  return SLEQP_OKAY;
+}
+
+// Solves K0 x = b for dense vectors of the base size
+static SLEQP_RETCODE
+base_solve(AugJacData* jacobian, double* rhs, double* sol)
+{
+  const int base_size = jacobian->base_size;
+
+  SLEQP_CALL(sleqp_vec_set_from_raw(jacobian->base_rhs, rhs, base_size, 0.));
+
+  SLEQP_CALL(sleqp_fact_solve(jacobian->fact, jacobian->base_rhs));
+
+  SLEQP_CALL(sleqp_vec_resize(jacobian->base_sol, base_size));
+
+  SLEQP_CALL(
+    sleqp_fact_solution(jacobian->fact, jacobian->base_sol, 0, base_size, 0.));
+
+  SLEQP_CALL(sleqp_vec_to_raw(jacobian->base_sol, sol));
+
+  return SLEQP_OKAY;
+}
+
+// LU decomposition of the Schur complement with partial pivoting
+static bool
+schur_factor(double* schur, int* pivots, int size)
+{
+  double max_entry = 0.;
+
+  for (int k = 0; k < size * size; ++k)
+  {
+    max_entry = SLEQP_MAX(max_entry, fabs(schur[k]));
+  }
+
+  for (int j = 0; j < size; ++j)
+  {
+    int pivot = j;
+
+    for (int i = j + 1; i < size; ++i)
+    {
+      if (fabs(schur[i * size + j]) > fabs(schur[pivot * size + j]))
+      {
+        pivot = i;
+      }
+    }
+
+    if (fabs(schur[pivot * size + j]) <= schur_pivot_tol * max_entry)
+    {
+      return false;
+    }
+
+    pivots[j] = pivot;
+
+    if (pivot != j)
+    {
+      for (int k = 0; k < size; ++k)
+      {
+        const double value      = schur[j * size + k];
+        schur[j * size + k]     = schur[pivot * size + k];
+        schur[pivot * size + k] = value;
+      }
+    }
+
+    for (int i = j + 1; i < size; ++i)
+    {
+      const double factor = schur[i * size + j] / schur[j * size + j];
+
+      schur[i * size + j] = factor;
+
+      for (int k = j + 1; k < size; ++k)
+      {
+        schur[i * size + k] -= factor * schur[j * size + k];
+      }
+    }
+  }
+
+  return true;
+}
+
+static void
+schur_solve(const double* schur, const int* pivots, int size, double* values)
+{
+  // Rows are swapped entirely during the factorization
+  for (int j = 0; j < size; ++j)
+  {
+    const int pivot = pivots[j];
+
+    if (pivot != j)
+    {
+      const double value = values[j];
+      values[j]          = values[pivot];
+      values[pivot]      = value;
+    }
+  }
+
+  for (int j = 0; j < size; ++j)
+  {
+    for (int i = j + 1; i < size; ++i)
+    {
+      values[i] -= schur[i * size + j] * values[j];
+    }
+  }
+
+  for (int j = size - 1; j >= 0; --j)
+  {
+    for (int k = j + 1; k < size; ++k)
+    {
+      values[j] -= schur[j * size + k] * values[k];
+    }
+
+    values[j] /= schur[j * size + j];
+  }
+}
+
+/*
+ * Attempts to represent the system of the given working set as an update
+ * of the current base factorization
+ */
+static SLEQP_RETCODE
+update_factorization(AugJacData* jacobian,
+                     SleqpIterate* iterate,
+                     bool* success)
+{
+  SleqpWorkingSet* working_set = sleqp_iterate_working_set(iterate);
+
+  *success = false;
+
+  if (!collect_updates(jacobian, working_set))
+  {
+    return SLEQP_OKAY;
+  }
+
+  // Returned to the base working set
+  if (sleqp_working_set_eq(working_set, jacobian->base_working_set))
+  {
+    assert(jacobian->num_updates == 0);
+
+    jacobian->use_updates = false;
+    *success              = true;
+
+    return SLEQP_OKAY;
+  }
+
+  const int base_size   = jacobian->base_size;
+  const int num_updates = jacobian->num_updates;
+
+  SLEQP_CALL(fill_update_cols(jacobian, iterate));
+
+  for (int l = 0; l < num_updates; ++l)
+  {
+    SLEQP_CALL(base_solve(jacobian,
+                          jacobian->update_cols + l * base_size,
+                          jacobian->update_sols + l * base_size));
+  }
+
+  for (int l = 0; l < num_updates; ++l)
+  {
+    for (int m = 0; m < num_updates; ++m)
+    {
+      jacobian->schur[l * num_updates + m]
+        = -sleqp_kernel_dot(jacobian->update_cols + l * base_size,
+                            jacobian->update_sols + m * base_size,
+                            base_size);
+    }
+  }
+
+  *success
+    = schur_factor(jacobian->schur, jacobian->schur_pivots, num_updates);
+
+  jacobian->use_updates = *success;
+
+  if (!(*success))
+  {
+    sleqp_log_debug("Singular Schur complement, refactoring");
+  }
+
+  return SLEQP_OKAY;
+}
+
+/*
+ * Solves the system of the current working set using the Schur complement.
+ * The right hand side is placed at the given offset, the solution is
+ * extracted from the range [begin, end)
+ */
+static SLEQP_RETCODE
+solve_updated(AugJacData* jacobian,
+              const SleqpVec* rhs,
+              int offset,
+              SleqpVec* sol,
+              int begin,
+              int end,
+              double zero_eps)
+{
+  SleqpProblem* problem             = jacobian->problem;
+  SleqpWorkingSet* working_set      = jacobian->working_set;
+  SleqpWorkingSet* base_working_set = jacobian->base_working_set;
+
+  const int num_variables = sleqp_problem_num_vars(problem);
+  const int base_size     = jacobian->base_size;
+  const int num_updates   = jacobian->num_updates;
+  const int set_size      = jacobian->working_set_size;
+  const int total_size    = num_variables + set_size;
+
+  double* dense_rhs  = jacobian->dense_rhs;
+  double* dense_sol  = jacobian->dense_sol;
+  double* base_dense = jacobian->base_dense;
+
+  double* update_rhs = dense_sol + base_size;
+
+  for (int k = 0; k < total_size; ++k)
+  {
+    dense_rhs[k] = 0.;
+  }
+
+  for (int k = 0; k < rhs->nnz; ++k)
+  {
+    dense_rhs[offset + rhs->indices[k]] = rhs->data[k];
+  }
+
+  // Right hand side of the base system, zero for removed rows
+  memcpy(base_dense, dense_rhs, num_variables * sizeof(double));
+
+  for (int p = 0; p < base_size - num_variables; ++p)
+  {
+    const int content = sleqp_working_set_content(base_working_set, p);
+    const int q = working_set_position(working_set, num_variables, content);
+
+    base_dense[num_variables + p]
+      = (q == SLEQP_NONE) ? 0. : dense_rhs[num_variables + q];
+  }
+
+  SLEQP_CALL(base_solve(jacobian, base_dense, dense_sol));
+
+  // z = C^{-1} (s - V^T u)
+  for (int l = 0; l < num_updates; ++l)
+  {
+    const int content = jacobian->update_contents[l];
+
+    double value = 0.;
+
+    if (jacobian->update_base_positions[l] == SLEQP_NONE)
+    {
+      const int q = working_set_position(working_set, num_variables, content);
+
+      value = dense_rhs[num_variables + q];
+    }
+
+    update_rhs[l] = value
+                    - sleqp_kernel_dot(jacobian->update_cols + l * base_size,
+                                       dense_sol,
+                                       base_size);
+  }
+
+  schur_solve(jacobian->schur, jacobian->schur_pivots, num_updates, update_rhs);
+
+  // x = u - K0^{-1} V z
+  for (int l = 0; l < num_updates; ++l)
+  {
+    const double* update_sol = jacobian->update_sols + l * base_size;
+
+    for (int k = 0; k < base_size; ++k)
+    {
+      dense_sol[k] -= update_rhs[l] * update_sol[k];
+    }
+  }
+
+  // Permute into the current working set
+  memcpy(dense_rhs, dense_sol, num_variables * sizeof(double));
+
+  for (int q = 0; q < set_size; ++q)
+  {
+    const int content = sleqp_working_set_content(working_set, q);
+    const int p       = jacobian->base_positions[content];
+
+    if (p != SLEQP_NONE)
+    {
+      dense_rhs[num_variables + q] = dense_sol[num_variables + p];
+    }
+  }
+
+  for (int l = 0; l < num_updates; ++l)
+  {
+    if (jacobian->update_base_positions[l] == SLEQP_NONE)
+    {
+      const int q = working_set_position(working_set,
+                                         num_variables,
+                                         jacobian->update_contents[l]);
+
+      dense_rhs[num_variables + q] = update_rhs[l];
+    }
+  }
+
+  SLEQP_CALL(
+    sleqp_vec_set_from_raw(sol, dense_rhs + begin, end - begin, zero_eps));
+
+  return SLEQP_OKAY;
+}
+
 static SLEQP_RETCODE
 aug_jac_set_iterate(SleqpIterate* iterate, void* data)
 {
@@ -244,6 +763,12 @@ aug_jac_set_iterate(SleqpIterate* iterate, void* data)
   SleqpProblem* problem        = jacobian->problem;
   SleqpWorkingSet* working_set = sleqp_iterate_working_set(iterate);
 
+  // Fixed Jacobians change along with the linear coefficients
+  if (jacobian->factorization_version != sleqp_problem_version(problem))
+  {
+    jacobian->has_factorization = false;
+  }
+
   // Do not recompute for linear problems & unchanged working set
   if (jacobian->working_set)
   {
@@ -262,8 +787,26 @@ aug_jac_set_iterate(SleqpIterate* iterate, void* data)
 
   jacobian->working_set_size = sleqp_working_set_size(working_set);
 
+  // Estimates are only available for factorized matrices
   jacobian->condition = SLEQP_NONE;
 
+  // Linear problems: try to update the base factorization
+  if (jacobian->base_working_set && jacobian->has_factorization)
+  {
+    bool success = false;
+
+    SLEQP_CALL(sleqp_timer_start(jacobian->factorization_timer));
+
+    SLEQP_CALL(update_factorization(jacobian, iterate, &success));
+
+    SLEQP_CALL(sleqp_timer_stop(jacobian->factorization_timer));
+
+    if (success)
+    {
+      return SLEQP_OKAY;
+    }
+  }
+
   const bool lower_only
     = sleqp_fact_flags(jacobian->fact) & SLEQP_FACT_FLAGS_LOWER;
 
@@ -274,10 +817,16 @@ aug_jac_set_iterate(SleqpIterate* iterate, void* data)
 
   SLEQP_CALL(sleqp_fact_set_matrix(jacobian->fact, jacobian->augmented_matrix));
 
-  jacobian->has_factorization = true;
+  jacobian->has_factorization     = true;
+  jacobian->factorization_version = sleqp_problem_version(problem);
 
   SLEQP_CALL(sleqp_timer_stop(jacobian->factorization_timer));
 
+  if (jacobian->base_working_set)
+  {
+    SLEQP_CALL(set_base(jacobian, working_set));
+  }
+
   SLEQP_CALL(sleqp_fact_cond(jacobian->fact, &jacobian->condition));
 
   {
@@ -325,6 +874,21 @@ aug_jac_solve_min_norm(const SleqpVec* _rhs, SleqpVec* sol, void* data)
 
   assert(sol->dim == num_variables);
 
+  if (jacobian->use_updates)
+  {
+    SLEQP_CALL(solve_updated(jacobian,
+                             rhs,
+                             num_variables,
+                             sol,
+                             0,
+                             num_variables,
+                             zero_eps));
+
+    SLEQP_CALL(sleqp_timer_stop(jacobian->substitution_timer));
+
+    return SLEQP_OKAY;
+  }
+
   rhs->dim += num_variables;
 
   for (int k = 0; k < rhs->nnz; ++k)
@@ -371,14 +935,28 @@ aug_jac_solve_lsq(const SleqpVec* _rhs, SleqpVec* sol, void* data)
   const int total_size       = num_variables + working_set_size;
 
   assert(rhs->dim == num_variables);
+  assert(sol->dim == working_set_size);
+
+  if (jacobian->use_updates)
+  {
+    SLEQP_CALL(solve_updated(jacobian,
+                             rhs,
+                             0,
+                             sol,
+                             num_variables,
+                             total_size,
+                             zero_eps));
+
+    SLEQP_CALL(sleqp_timer_stop(jacobian->substitution_timer));
+
+    return SLEQP_OKAY;
+  }
 
   // just add some zeros...
   SLEQP_CALL(sleqp_vec_resize(rhs, total_size));
 
   SLEQP_CALL(sleqp_fact_solve(factorization, rhs));
 
-  assert(sol->dim == working_set_size);
-
   SLEQP_CALL(sleqp_fact_solution(factorization,
                                  sol,
                                  num_variables,
@@ -415,14 +993,28 @@ aug_jac_project_nullspace(const SleqpVec* _rhs, SleqpVec* sol, void* data)
   const int total_size       = num_variables + working_set_size;
 
   assert(rhs->dim == num_variables);
+  assert(sol->dim == num_variables);
+
+  if (jacobian->use_updates)
+  {
+    SLEQP_CALL(solve_updated(jacobian,
+                             rhs,
+                             0,
+                             sol,
+                             0,
+                             num_variables,
+                             zero_eps));
+
+    SLEQP_CALL(sleqp_timer_stop(jacobian->substitution_timer));
+
+    return SLEQP_OKAY;
+  }
 
   // just add some zeros...
   SLEQP_CALL(sleqp_vec_resize(rhs, total_size));
 
   SLEQP_CALL(sleqp_fact_solve(factorization, rhs));
 
-  assert(sol->dim == num_variables);
-
   SLEQP_CALL(
     sleqp_fact_solution(factorization, sol, 0, num_variables, zero_eps));
 
@@ -443,6 +1035,26 @@ aug_jac_free(void* data)
 
   SLEQP_CALL(sleqp_timer_free(&jacobian->factorization_timer));
 
+  SLEQP_CALL(sleqp_vec_free(&jacobian->base_sol));
+  SLEQP_CALL(sleqp_vec_free(&jacobian->base_rhs));
+
+  sleqp_free(&jacobian->base_dense);
+  sleqp_free(&jacobian->dense_sol);
+  sleqp_free(&jacobian->dense_rhs);
+
+  sleqp_free(&jacobian->schur_pivots);
+  sleqp_free(&jacobian->schur);
+
+  sleqp_free(&jacobian->update_sols);
+  sleqp_free(&jacobian->update_cols);
+
+  sleqp_free(&jacobian->update_base_positions);
+  sleqp_free(&jacobian->update_contents);
+
+  sleqp_free(&jacobian->base_positions);
+
+  SLEQP_CALL(sleqp_working_set_release(&jacobian->base_working_set));
+
   sleqp_free(&jacobian->col_indices);
 
   SLEQP_CALL(sleqp_working_set_release(&jacobian->working_set));
@@ -498,6 +1110,31 @@ aug_jac_data_create(AugJacData** star,
   if (fixed_jacobian)
   {
     SLEQP_CALL(sleqp_working_set_create(&jacobian->working_set, problem));
+
+    SLEQP_CALL(sleqp_working_set_create(&jacobian->base_working_set, problem));
+
+    SLEQP_CALL(sleqp_alloc_array(&jacobian->base_positions,
+                                 num_variables + num_constraints));
+
+    SLEQP_CALL(sleqp_alloc_array(&jacobian->update_contents, max_updates));
+    SLEQP_CALL(
+      sleqp_alloc_array(&jacobian->update_base_positions, max_updates));
+
+    SLEQP_CALL(sleqp_alloc_array(&jacobian->update_cols,
+                                 max_num_cols * max_updates));
+    SLEQP_CALL(sleqp_alloc_array(&jacobian->update_sols,
+                                 max_num_cols * max_updates));
+
+    SLEQP_CALL(sleqp_alloc_array(&jacobian->schur, max_updates * max_updates));
+    SLEQP_CALL(sleqp_alloc_array(&jacobian->schur_pivots, max_updates));
+
+    SLEQP_CALL(sleqp_alloc_array(&jacobian->dense_rhs, max_num_cols));
+    SLEQP_CALL(
+      sleqp_alloc_array(&jacobian->dense_sol, max_num_cols + max_updates));
+    SLEQP_CALL(sleqp_alloc_array(&jacobian->base_dense, max_num_cols));
+
+    SLEQP_CALL(sleqp_vec_create_empty(&jacobian->base_rhs, 0));
+    SLEQP_CALL(sleqp_vec_create_empty(&jacobian->base_sol, 0));
   }
 
   SLEQP_CALL(sleqp_alloc_array(&jacobian->col_indices, max_num_cols + 1));
@@ -333,6 +333,12 @@ box_constrained_cauchy_print_stats(double total_elapsed, void* data)
   return SLEQP_OKAY;
 }
 
+static SLEQP_RETCODE
+box_constrained_cauchy_lp_stats(SleqpTimingStats* stats, void* data)
+{
+  return SLEQP_OKAY;
+}
+
 static SLEQP_RETCODE
 box_constrained_cauchy_free(void* data)
 {
@@ -426,6 +432,7 @@ sleqp_box_constrained_cauchy_create(SleqpCauchy** star,
        .set_time_limit     = box_constrained_cauchy_set_time_limit,
        .basis_condition    = box_constrained_cauchy_basis_condition,
        .print_stats        = box_constrained_cauchy_print_stats,
+       .lp_stats           = box_constrained_cauchy_lp_stats,
        .free               = box_constrained_cauchy_free};
 
   SLEQP_CALL(sleqp_cauchy_create(star, &callbacks, (void*)cauchy_data));
@@ -1,6 +1,7 @@
 #include "cauchy.h"
 
 #include "cmp.h"
+#include "error.h"
 #include "feas.h"
 #include "mem.h"
 #include "pub_iterate.h"
@@ -133,6 +134,44 @@ sleqp_cauchy_print_stats(SleqpCauchy* cauchy, double total_elapsed)
   return cauchy->callbacks.print_stats(total_elapsed, cauchy->cauchy_data);
 }
 
+SLEQP_RETCODE
+sleqp_cauchy_lp_stats(SleqpCauchy* cauchy, SleqpTimingStats* stats)
+{
+  return cauchy->callbacks.lp_stats(stats, cauchy->cauchy_data);
+}
+
+int
+sleqp_cauchy_lp_iterations(SleqpCauchy* cauchy)
+{
+  if (!cauchy->callbacks.lp_iterations)
+  {
+    return 0;
+  }
+
+  return cauchy->callbacks.lp_iterations(cauchy->cauchy_data);
+}
+
+bool
+sleqp_cauchy_can_copy_basis(const SleqpCauchy* source,
+                            const SleqpCauchy* target)
+{
+  return source->callbacks.copy_basis
+         && (source->callbacks.copy_basis == target->callbacks.copy_basis);
+}
+
+SLEQP_RETCODE
+sleqp_cauchy_copy_basis(const SleqpCauchy* source, SleqpCauchy* target)
+{
+  if (!sleqp_cauchy_can_copy_basis(source, target))
+  {
+    sleqp_raise(SLEQP_ILLEGAL_ARGUMENT,
+                "Cannot copy bases between the given Cauchy solvers");
+  }
+
+  return source->callbacks.copy_basis(source->cauchy_data,
+                                      target->cauchy_data);
+}
+
 SLEQP_RETCODE
 sleqp_cauchy_compute_criticality_bound(SleqpCauchy* cauchy,
                                        double merit_value,
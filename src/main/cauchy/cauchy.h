@@ -69,6 +69,26 @@ SLEQP_NODISCARD
 SLEQP_RETCODE
 sleqp_cauchy_print_stats(SleqpCauchy* cauchy, double total_elapsed);
 
+SLEQP_NODISCARD
+SLEQP_RETCODE
+sleqp_cauchy_lp_stats(SleqpCauchy* cauchy, SleqpTimingStats* stats);
+
+// Returns the total number of simplex iterations of the solved LPs,
+// or zero if no LPs are solved
+int
+sleqp_cauchy_lp_iterations(SleqpCauchy* cauchy);
+
+// Returns whether bases can be copied between the given solvers
+bool
+sleqp_cauchy_can_copy_basis(const SleqpCauchy* source,
+                            const SleqpCauchy* target);
+
+// Warm-starts the target from the current basis of the source, both of which
+// must have been created by the same method supporting the operation
+SLEQP_NODISCARD
+SLEQP_RETCODE
+sleqp_cauchy_copy_basis(const SleqpCauchy* source, SleqpCauchy* target);
+
 // Bound on the criticality measure used in
 // "On the Convergence of Successive Linear Programming Algorithms"
 SLEQP_NODISCARD
@@ -58,6 +58,17 @@ typedef SLEQP_RETCODE (*SLEQP_CAUCHY_BASIS_CONDITION)(bool* exact,
 typedef SLEQP_RETCODE (*SLEQP_CAUCHY_PRINT_STATS)(double total_elapsed,
                                                   void* cauchy_data);
 
+// Adds the timing statistics of the solved LPs
+typedef SLEQP_RETCODE (*SLEQP_CAUCHY_LP_STATS)(SleqpTimingStats* stats,
+                                               void* cauchy_data);
+
+// Returns the total number of simplex iterations of the solved LPs
+typedef int (*SLEQP_CAUCHY_LP_ITERATIONS)(void* cauchy_data);
+
+// Warm-starts the target from the current basis of the source
+typedef SLEQP_RETCODE (*SLEQP_CAUCHY_COPY_BASIS)(const void* source_data,
+                                                 void* target_data);
+
 typedef SLEQP_RETCODE (*SLEQP_CAUCHY_FREE)(void* cauchy_data);
 
 typedef struct
@@ -74,6 +85,9 @@ typedef struct
   SLEQP_CAUCHY_SET_TIME_LIMIT set_time_limit;
   SLEQP_CAUCHY_BASIS_CONDITION basis_condition;
   SLEQP_CAUCHY_PRINT_STATS print_stats;
+  SLEQP_CAUCHY_LP_STATS lp_stats;
+  SLEQP_CAUCHY_LP_ITERATIONS lp_iterations;
+  SLEQP_CAUCHY_COPY_BASIS copy_basis;
   SLEQP_CAUCHY_FREE free;
 } SleqpCauchyCallbacks;
 
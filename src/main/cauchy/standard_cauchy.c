@@ -1,6 +1,7 @@
 #include "standard_cauchy.h"
 
 #include <math.h>
+#include <string.h>
 
 #include "cmp.h"
 #include "error.h"
@@ -46,13 +47,23 @@ typedef struct
 
   bool first_solve;
   bool has_coefficients;
+
+  // Whether a basis copied from another solver is to be
+  // restored on the next solve
+  bool basis_pending;
   bool use_reduced_interface;
 
+  // Problem version of the current coefficients
+  int coefficients_version;
+
   Components dirty_components;
 
   SleqpLPi* default_interface;
   SleqpLPi* reduced_interface;
 
+  // Coefficients [J, I, -I] of the default interface
+  SleqpMat* lp_coeffs;
+
   SLEQP_BASESTAT* reduced_cons_stats;
 
   double* objective;
@@ -168,12 +179,18 @@ cauchy_data_create(CauchyData** star,
 
   data->first_solve      = true;
   data->has_coefficients = false;
+  data->basis_pending    = false;
 
   SLEQP_CALL(sleqp_lpi_create_default(&data->default_interface,
                                       data->num_lp_variables,
                                       data->num_lp_constraints,
                                       settings));
 
+  SLEQP_CALL(sleqp_mat_create(&data->lp_coeffs,
+                              data->num_lp_constraints,
+                              data->num_lp_variables,
+                              0));
+
   SLEQP_CALL(sleqp_alloc_array(&data->objective, data->num_lp_variables));
 
   SLEQP_CALL(sleqp_alloc_array(&data->cons_lb, data->num_lp_constraints));
@@ -201,32 +218,50 @@ cauchy_data_create(CauchyData** star,
 }
 
 static SLEQP_RETCODE
-append_identities(SleqpMat* cons_jac, int num_variables, int num_constraints)
+rebuild_coefficients(SleqpMat* lp_coeffs,
+                     const SleqpMat* cons_jac,
+                     int num_variables,
+                     int num_constraints)
 {
   assert(num_constraints == sleqp_mat_num_rows(cons_jac));
   assert(num_variables == sleqp_mat_num_cols(cons_jac));
 
-  const int nnz      = sleqp_mat_nnz(cons_jac);
-  const int num_rows = sleqp_mat_num_rows(cons_jac);
-  const int num_cols = sleqp_mat_num_cols(cons_jac);
+  const int nnz = sleqp_mat_nnz(cons_jac);
+
+  const int* jac_cols    = sleqp_mat_cols(cons_jac);
+  const int* jac_rows    = sleqp_mat_rows(cons_jac);
+  const double* jac_data = sleqp_mat_data(cons_jac);
+
+  SLEQP_CALL(sleqp_mat_clear(lp_coeffs));
 
   /*
    * Reserve a litte more so we can add the two
    * identity matrices afterwards
    */
-  SLEQP_CALL(sleqp_mat_reserve(cons_jac, nnz + 2 * num_constraints));
+  SLEQP_CALL(sleqp_mat_reserve(lp_coeffs, nnz + 2 * num_constraints));
 
-  SLEQP_CALL(
-    sleqp_mat_resize(cons_jac, num_rows, num_cols + 2 * num_constraints));
+  SLEQP_CALL(sleqp_mat_resize(lp_coeffs,
+                              num_constraints,
+                              num_variables + 2 * num_constraints));
+
+  for (int col = 0; col < num_variables; ++col)
+  {
+    SLEQP_CALL(sleqp_mat_push_col(lp_coeffs, col));
+
+    for (int k = jac_cols[col]; k < jac_cols[col + 1]; ++k)
+    {
+      SLEQP_CALL(sleqp_mat_push(lp_coeffs, jac_rows[k], col, jac_data[k]));
+    }
+  }
 
   // append the +I
   for (int i = 0; i < num_constraints; ++i)
   {
     const int con = num_variables + i;
 
-    SLEQP_CALL(sleqp_mat_push_col(cons_jac, con));
+    SLEQP_CALL(sleqp_mat_push_col(lp_coeffs, con));
 
-    SLEQP_CALL(sleqp_mat_push(cons_jac, i, con, 1.));
+    SLEQP_CALL(sleqp_mat_push(lp_coeffs, i, con, 1.));
   }
 
   // append the -I
@@ -234,26 +269,46 @@ append_identities(SleqpMat* cons_jac, int num_variables, int num_constraints)
   {
     const int con = num_variables + num_constraints + i;
 
-    SLEQP_CALL(sleqp_mat_push_col(cons_jac, con));
+    SLEQP_CALL(sleqp_mat_push_col(lp_coeffs, con));
 
-    SLEQP_CALL(sleqp_mat_push(cons_jac, i, con, -1.));
+    SLEQP_CALL(sleqp_mat_push(lp_coeffs, i, con, -1.));
   }
 
   return SLEQP_OKAY;
 }
 
+/*
+ * Updates the LP coefficients [J, I, -I] from the given Jacobian.
+ * The identities are kept in place, and if the Jacobian retains
+ * its sparsity pattern, only its values are overwritten.
+ */
 static SLEQP_RETCODE
-remove_identities(SleqpMat* cons_jac, int num_variables, int num_constraints)
+update_coefficients(SleqpMat* lp_coeffs,
+                    const SleqpMat* cons_jac,
+                    int num_variables,
+                    int num_constraints,
+                    bool* same_pattern)
 {
-  const int num_rows = sleqp_mat_num_rows(cons_jac);
-  const int num_cols = sleqp_mat_num_cols(cons_jac);
+  const int nnz = sleqp_mat_nnz(cons_jac);
 
-  assert(num_constraints == num_rows);
-  assert(num_variables + 2 * num_constraints == num_cols);
+  *same_pattern
+    = (sleqp_mat_num_cols(lp_coeffs) == num_variables + 2 * num_constraints)
+      && (sleqp_mat_nnz(lp_coeffs) == nnz + 2 * num_constraints)
+      && sleqp_mat_pattern_eq(lp_coeffs, cons_jac, num_variables);
 
-  SLEQP_CALL(sleqp_mat_resize(cons_jac, num_constraints, num_variables));
+  if (*same_pattern)
+  {
+    memcpy(sleqp_mat_data(lp_coeffs),
+           sleqp_mat_data(cons_jac),
+           nnz * sizeof(double));
 
-  return SLEQP_OKAY;
+    return SLEQP_OKAY;
+  }
+
+  return rebuild_coefficients(lp_coeffs,
+                              cons_jac,
+                              num_variables,
+                              num_constraints);
 }
 
 static SLEQP_RETCODE
@@ -439,22 +494,39 @@ set_default_coefficients(CauchyData* cauchy_data, SleqpMat* cons_jac)
 
   bool fixed_jacobian = !(sleqp_problem_has_nonlinear_cons(problem));
 
-  if (fixed_jacobian && cauchy_data->has_coefficients)
+  if (fixed_jacobian && cauchy_data->has_coefficients
+      && cauchy_data->coefficients_version == sleqp_problem_version(problem))
   {
     return SLEQP_OKAY;
   }
 
-  SLEQP_CALL(append_identities(cons_jac, num_variables, num_constraints));
+  SleqpMat* lp_coeffs = cauchy_data->lp_coeffs;
 
-  assert(sleqp_mat_is_valid(cons_jac));
+  bool same_pattern;
 
-  SLEQP_CALL(sleqp_lpi_set_coeffs(cauchy_data->default_interface, cons_jac));
+  SLEQP_CALL(update_coefficients(lp_coeffs,
+                                 cons_jac,
+                                 num_variables,
+                                 num_constraints,
+                                 &same_pattern));
 
-  SLEQP_CALL(remove_identities(cons_jac, num_variables, num_constraints));
+  assert(sleqp_mat_is_valid(lp_coeffs));
 
-  assert(sleqp_mat_is_valid(cons_jac));
+  // Only the Jacobian values can change if the LP already has the pattern
+  if (same_pattern && cauchy_data->has_coefficients)
+  {
+    SLEQP_CALL(sleqp_lpi_change_coeffs(cauchy_data->default_interface,
+                                       lp_coeffs,
+                                       num_variables));
+  }
+  else
+  {
+    SLEQP_CALL(
+      sleqp_lpi_set_coeffs(cauchy_data->default_interface, lp_coeffs));
+  }
 
-  cauchy_data->has_coefficients = true;
+  cauchy_data->has_coefficients     = true;
+  cauchy_data->coefficients_version = sleqp_problem_version(problem);
 
   return SLEQP_OKAY;
 }
@@ -852,6 +924,15 @@ standard_cauchy_solve(SleqpVec* gradient,
   SLEQP_CALL(sleqp_lpi_set_objective(cauchy_data->default_interface,
                                      cauchy_data->objective));
 
+  if (cauchy_data->basis_pending)
+  {
+    SLEQP_CALL(sleqp_lpi_restore_basis(cauchy_data->default_interface,
+                                       SLEQP_CAUCHY_OBJTYPE_DEFAULT));
+
+    cauchy_data->current_objective = SLEQP_CAUCHY_OBJTYPE_DEFAULT;
+    cauchy_data->basis_pending     = false;
+  }
+
   bool warm_start
     = sleqp_settings_bool_value(cauchy_data->settings,
                                 SLEQP_SETTINGS_BOOL_ALWAYS_WARM_START_LP);
@@ -1507,6 +1588,84 @@ standard_cauchy_print_stats(double total_elapsed, void* data)
   return SLEQP_OKAY;
 }
 
+static SLEQP_RETCODE
+standard_cauchy_lp_stats(SleqpTimingStats* stats, void* data)
+{
+  CauchyData* cauchy_data = (CauchyData*)data;
+
+  SleqpTimer* default_timer
+    = sleqp_lpi_solve_timer(cauchy_data->default_interface);
+
+  SLEQP_CALL(sleqp_timer_add_stats(default_timer, stats));
+
+  if (cauchy_data->reduced_interface)
+  {
+    SleqpTimer* reduced_timer
+      = sleqp_lpi_solve_timer(cauchy_data->reduced_interface);
+
+    SLEQP_CALL(sleqp_timer_add_stats(reduced_timer, stats));
+  }
+
+  return SLEQP_OKAY;
+}
+
+static int
+standard_cauchy_lp_iterations(void* data)
+{
+  CauchyData* cauchy_data = (CauchyData*)data;
+
+  int iterations = sleqp_lpi_iterations(cauchy_data->default_interface);
+
+  if (cauchy_data->reduced_interface)
+  {
+    iterations += sleqp_lpi_iterations(cauchy_data->reduced_interface);
+  }
+
+  return iterations;
+}
+
+static SLEQP_RETCODE
+standard_cauchy_copy_basis(const void* source_data, void* target_data)
+{
+  const CauchyData* source = (const CauchyData*)source_data;
+  CauchyData* target       = (CauchyData*)target_data;
+
+  if (source->num_lp_variables != target->num_lp_variables
+      || source->num_lp_constraints != target->num_lp_constraints)
+  {
+    sleqp_raise(SLEQP_ILLEGAL_ARGUMENT, "Incompatible Cauchy solvers");
+  }
+
+  if (!source->has_basis[SLEQP_CAUCHY_OBJTYPE_DEFAULT])
+  {
+    return SLEQP_OKAY;
+  }
+
+  // Reduced resolves leave the basis of the default interface intact
+  SLEQP_CALL(
+    sleqp_lpi_vars_stats(source->default_interface, target->var_stats));
+
+  SLEQP_CALL(
+    sleqp_lpi_cons_stats(source->default_interface, target->cons_stats));
+
+  SLEQP_CALL(sleqp_lpi_set_basis(target->default_interface,
+                                 SLEQP_CAUCHY_OBJTYPE_DEFAULT,
+                                 target->var_stats,
+                                 target->cons_stats));
+
+  target->has_basis[SLEQP_CAUCHY_OBJTYPE_DEFAULT] = true;
+
+  // Setting the iterate may pass on new coefficients, discarding
+  // the basis, so that it is only restored on the next solve
+  target->basis_pending     = true;
+  target->current_objective = SLEQP_NONE;
+
+  target->first_solve      = false;
+  target->dirty_components = ALL;
+
+  return SLEQP_OKAY;
+}
+
 static SLEQP_RETCODE
 standard_cauchy_free(void* star)
 {
@@ -1525,6 +1684,8 @@ standard_cauchy_free(void* star)
 
   sleqp_free(&cauchy_data->reduced_cons_stats);
 
+  SLEQP_CALL(sleqp_mat_release(&cauchy_data->lp_coeffs));
+
   SLEQP_CALL(sleqp_lpi_release(&cauchy_data->reduced_interface));
   SLEQP_CALL(sleqp_lpi_release(&cauchy_data->default_interface));
 
@@ -1564,6 +1725,9 @@ sleqp_standard_cauchy_create(SleqpCauchy** star,
        .set_time_limit     = standard_cauchy_set_time_limit,
        .basis_condition    = standard_cauchy_basis_condition,
        .print_stats        = standard_cauchy_print_stats,
+       .lp_stats           = standard_cauchy_lp_stats,
+       .lp_iterations      = standard_cauchy_lp_iterations,
+       .copy_basis         = standard_cauchy_copy_basis,
        .free               = standard_cauchy_free};
 
   SLEQP_CALL(sleqp_cauchy_create(star, &callbacks, (void*)cauchy_data));
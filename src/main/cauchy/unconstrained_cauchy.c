@@ -177,6 +177,12 @@ unconstrained_cauchy_print_stats(double total_elapsed, void* data)
   return SLEQP_OKAY;
 }
 
+static SLEQP_RETCODE
+unconstrained_cauchy_lp_stats(SleqpTimingStats* stats, void* data)
+{
+  return SLEQP_OKAY;
+}
+
 static SLEQP_RETCODE
 unconstrained_cauchy_free(void* data)
 {
@@ -245,6 +251,7 @@ sleqp_unconstrained_cauchy_create(SleqpCauchy** star,
        .set_time_limit     = unconstrained_cauchy_set_time_limit,
        .basis_condition    = unconstrained_cauchy_basis_condition,
        .print_stats        = unconstrained_cauchy_print_stats,
+       .lp_stats           = unconstrained_cauchy_lp_stats,
        .free               = unconstrained_cauchy_free};
 
   SLEQP_CALL(sleqp_cauchy_create(star, &callbacks, (void*)cauchy_data));
@@ -1,5 +1,7 @@
 #include "deriv_check.h"
 
+#include <stdint.h>
+
 #include "cmp.h"
 #include "error.h"
 #include "iterate.h"
@@ -8,13 +10,32 @@
 #include "problem.h"
 #include "sparse/mat.h"
 #include "settings.h"
+#include "thread_pool.h"
+
+// Number of directions whose Hessian products are computed at once
+static const int hessian_block_size = 32;
+
+static const uint64_t initial_seed = 0x5EED5EED5EED5EEDull;
 
 struct SleqpDerivChecker
 {
   SleqpProblem* problem;
   SleqpSettings* settings;
 
-  SleqpVec* unit_direction;
+  SLEQP_DERIV_CHECK_SAMPLING sampling;
+
+  // Coordinates (or indices of random directions) to be checked
+  int* samples;
+  int num_samples;
+
+  uint64_t seed;
+  uint64_t state;
+
+  // Direction of the current check
+  SleqpVec* direction;
+
+  // Jacobian product with the current direction
+  double* jac_prod;
 
   SleqpVec* hessian_estimate;
 
@@ -29,6 +50,10 @@ struct SleqpDerivChecker
 
   SleqpMat* hessian_cons_prods;
 
+  SleqpMat* block_directions;
+  SleqpMat* hessian_block;
+  SleqpMat* hessian_block_func;
+
   SleqpVec* cons_grad_iterate;
   SleqpVec* cons_grad_check_iterate;
 
@@ -47,6 +72,141 @@ struct SleqpDerivChecker
   SleqpVec* check_jac_row;
 };
 
+// Advances the given state, returns 64 uniformly distributed random bits
+static uint64_t
+next_random(uint64_t* state)
+{
+  uint64_t value = (*state += 0x9E3779B97F4A7C15ull);
+  value          = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+  value          = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+  return value ^ (value >> 31);
+}
+
+static double
+next_uniform(uint64_t* state)
+{
+  return (next_random(state) >> 11) * (1. / 9007199254740992.);
+}
+
+/*
+ * Chooses the samples to be checked. Random coordinates are drawn
+ * using selection sampling (Knuth, Algorithm S), yielding sorted
+ * coordinates in linear time
+ */
+static SLEQP_RETCODE
+select_samples(SleqpDerivChecker* deriv_checker)
+{
+  SleqpSettings* settings = deriv_checker->settings;
+
+  const int num_variables = sleqp_problem_num_vars(deriv_checker->problem);
+
+  const SLEQP_DERIV_CHECK_SAMPLING sampling
+    = sleqp_settings_enum_value(settings,
+                                SLEQP_SETTINGS_ENUM_DERIV_CHECK_SAMPLING);
+
+  const int num_samples
+    = sleqp_settings_int_value(settings, SLEQP_SETTINGS_INT_DERIV_CHECK_SAMPLES);
+
+  int* samples = deriv_checker->samples;
+
+  deriv_checker->sampling = sampling;
+  deriv_checker->seed     = next_random(&deriv_checker->state);
+
+  if (sampling == SLEQP_DERIV_CHECK_SAMPLING_NONE
+      || num_samples >= num_variables)
+  {
+    deriv_checker->num_samples = num_variables;
+
+    for (int j = 0; j < num_variables; ++j)
+    {
+      samples[j] = j;
+    }
+
+    return SLEQP_OKAY;
+  }
+
+  if (num_samples <= 0)
+  {
+    sleqp_raise(SLEQP_ILLEGAL_ARGUMENT,
+                "Invalid number of derivative check samples: %d",
+                num_samples);
+  }
+
+  deriv_checker->num_samples = num_samples;
+
+  if (sampling == SLEQP_DERIV_CHECK_SAMPLING_DIRECTIONS)
+  {
+    for (int k = 0; k < num_samples; ++k)
+    {
+      samples[k] = k;
+    }
+
+    return SLEQP_OKAY;
+  }
+
+  uint64_t state = deriv_checker->seed;
+
+  int num_selected = 0;
+
+  for (int j = 0; num_selected < num_samples; ++j)
+  {
+    const int remaining = num_variables - j;
+    const int required  = num_samples - num_selected;
+
+    if (remaining * next_uniform(&state) < required)
+    {
+      samples[num_selected++] = j;
+    }
+  }
+
+  return SLEQP_OKAY;
+}
+
+/*
+ * Fills the direction of the sample at the given position: Either
+ * a unit vector or a Rademacher vector, which is determined by the
+ * seed and the sample index, independently of the thread checking it
+ */
+static SLEQP_RETCODE
+fill_direction(SleqpDerivChecker* deriv_checker, int position)
+{
+  SleqpVec* direction = deriv_checker->direction;
+
+  const int sample = deriv_checker->samples[position];
+
+  SLEQP_CALL(sleqp_vec_clear(direction));
+
+  if (deriv_checker->sampling != SLEQP_DERIV_CHECK_SAMPLING_DIRECTIONS)
+  {
+    SLEQP_CALL(sleqp_vec_push(direction, sample, 1.));
+
+    return SLEQP_OKAY;
+  }
+
+  const int num_variables = direction->dim;
+
+  uint64_t state
+    = deriv_checker->seed ^ (((uint64_t)sample + 1u) * 0xD1B54A32D192ED03ull);
+
+  uint64_t bits = 0;
+
+  SLEQP_CALL(sleqp_vec_reserve(direction, num_variables));
+
+  for (int k = 0; k < num_variables; ++k)
+  {
+    if (k % 64 == 0)
+    {
+      bits = next_random(&state);
+    }
+
+    SLEQP_CALL(sleqp_vec_push(direction, k, (bits & 1u) ? 1. : -1.));
+
+    bits >>= 1;
+  }
+
+  return SLEQP_OKAY;
+}
+
 static SLEQP_RETCODE
 restore_iterate(SleqpDerivChecker* deriv_checker, SleqpIterate* iterate)
 {
@@ -84,23 +244,37 @@ set_check_iterate(SleqpDerivChecker* deriv_checker, bool* reject)
   return SLEQP_OKAY;
 }
 
+// Scales the perturbation by the largest primal value along the direction
 static double
 get_perturbation(const SleqpDerivChecker* deriv_checker,
-                 const SleqpIterate* iterate,
-                 int j)
+                 const SleqpIterate* iterate)
 {
   SleqpSettings* settings = deriv_checker->settings;
 
-  SleqpVec* primal = sleqp_iterate_primal(iterate);
+  const SleqpVec* primal    = sleqp_iterate_primal(iterate);
+  const SleqpVec* direction = deriv_checker->direction;
 
   double base_perturbation
     = sleqp_settings_real_value(settings, SLEQP_SETTINGS_REAL_DERIV_PERTURBATION);
 
-  double value = sleqp_vec_value_at(primal, j);
+  double value = 1.;
 
-  value = SLEQP_ABS(value);
+  int k_primal = 0;
 
-  value = SLEQP_MAX(value, 1.);
+  for (int k = 0; k < direction->nnz; ++k)
+  {
+    const int index = direction->indices[k];
+
+    while (k_primal < primal->nnz && primal->indices[k_primal] < index)
+    {
+      ++k_primal;
+    }
+
+    if (k_primal < primal->nnz && primal->indices[k_primal] == index)
+    {
+      value = SLEQP_MAX(value, SLEQP_ABS(primal->data[k_primal]));
+    }
+  }
 
   return value * base_perturbation;
 }
@@ -116,34 +290,15 @@ create_unit_direction(SleqpVec* direction, const int j)
 }
 
 static SLEQP_RETCODE
-create_perturbed_unit_direction(SleqpDerivChecker* deriv_checker,
-                                const SleqpIterate* iterate,
-                                const int j,
-                                double* perturbation)
-{
-  SleqpVec* unit_direction = deriv_checker->unit_direction;
-
-  *perturbation = get_perturbation(deriv_checker, iterate, j);
-
-  SLEQP_CALL(sleqp_vec_clear(unit_direction));
-
-  SLEQP_CALL(sleqp_vec_push(unit_direction, j, *perturbation));
-
-  return SLEQP_OKAY;
-}
-
-static SLEQP_RETCODE
-compute_hessian_cons_products(SleqpDerivChecker* deriv_checker, int j)
+compute_hessian_cons_products(SleqpDerivChecker* deriv_checker)
 {
   SleqpProblem* problem = deriv_checker->problem;
 
-  SleqpVec* unit_direction = deriv_checker->unit_direction;
+  SleqpVec* direction = deriv_checker->direction;
 
   const double zero_eps
     = sleqp_settings_real_value(deriv_checker->settings, SLEQP_SETTINGS_REAL_ZERO_EPS);
 
-  SLEQP_CALL(create_unit_direction(unit_direction, j));
-
   SleqpMat* hessian_prod_matrix = deriv_checker->hessian_cons_prods;
 
   SLEQP_CALL(sleqp_mat_clear(hessian_prod_matrix));
@@ -155,7 +310,7 @@ compute_hessian_cons_products(SleqpDerivChecker* deriv_checker, int j)
     SLEQP_CALL(create_unit_direction(deriv_checker->multipliers, k));
 
     SLEQP_CALL(sleqp_problem_hess_prod(problem,
-                                       unit_direction,
+                                       direction,
                                        deriv_checker->multipliers,
                                        deriv_checker->hessian_prod_cache));
 
@@ -183,42 +338,109 @@ compute_hessian_cons_products(SleqpDerivChecker* deriv_checker, int j)
   return SLEQP_OKAY;
 }
 
+/*
+ * Computes the Hessian products with the directions of the samples
+ * in the given range using a single batched evaluation
+ */
 static SLEQP_RETCODE
-compute_hessian_products(SleqpDerivChecker* deriv_checker,
-                         SLEQP_DERIV_CHECK flags,
-                         SleqpIterate* iterate,
-                         const int j)
+compute_hessian_block(SleqpDerivChecker* deriv_checker,
+                      SLEQP_DERIV_CHECK flags,
+                      SleqpIterate* iterate,
+                      const int begin,
+                      const int end)
 {
   SleqpProblem* problem = deriv_checker->problem;
 
-  SleqpVec* unit_direction = deriv_checker->unit_direction;
+  SleqpMat* block_directions = deriv_checker->block_directions;
+  SleqpVec* direction        = deriv_checker->direction;
+
+  const int num_variables = sleqp_problem_num_vars(problem);
+
+  const int block_size = end - begin;
 
-  SLEQP_CALL(create_unit_direction(unit_direction, j));
+  SLEQP_CALL(sleqp_mat_resize(block_directions, num_variables, block_size));
+
+  SLEQP_CALL(sleqp_mat_clear(block_directions));
+
+  for (int col = 0; col < block_size; ++col)
+  {
+    SLEQP_CALL(fill_direction(deriv_checker, begin + col));
+
+    const int nnz = sleqp_mat_nnz(block_directions);
+
+    SLEQP_CALL(sleqp_mat_reserve(block_directions, nnz + direction->nnz));
+
+    SLEQP_CALL(sleqp_mat_push_col(block_directions, col));
+
+    SLEQP_CALL(sleqp_mat_push_vec(block_directions, col, direction));
+  }
 
   if (flags & SLEQP_DERIV_CHECK_SECOND_CONS
       || flags & SLEQP_DERIV_CHECK_SECOND_OBJ)
   {
     SLEQP_CALL(sleqp_vec_clear(deriv_checker->multipliers));
 
-    SLEQP_CALL(sleqp_problem_hess_prod(problem,
-                                       unit_direction,
-                                       deriv_checker->multipliers,
-                                       deriv_checker->hessian_prod_func));
+    SLEQP_CALL(sleqp_mat_resize(deriv_checker->hessian_block_func,
+                                num_variables,
+                                block_size));
+
+    SLEQP_CALL(sleqp_problem_hess_prods(problem,
+                                        block_directions,
+                                        deriv_checker->multipliers,
+                                        deriv_checker->hessian_block_func));
+  }
+
+  if (flags & SLEQP_DERIV_CHECK_SECOND_SIMPLE)
+  {
+    SleqpVec* multipliers = sleqp_iterate_cons_dual(iterate);
+
+    SLEQP_CALL(sleqp_mat_resize(deriv_checker->hessian_block,
+                                num_variables,
+                                block_size));
+
+    SLEQP_CALL(sleqp_problem_hess_prods(problem,
+                                        block_directions,
+                                        multipliers,
+                                        deriv_checker->hessian_block));
+  }
+
+  return SLEQP_OKAY;
+}
+
+static SLEQP_RETCODE
+compute_hessian_products(SleqpDerivChecker* deriv_checker,
+                         SLEQP_DERIV_CHECK flags,
+                         SleqpIterate* iterate,
+                         const int col)
+{
+  if (!(flags
+        & (SLEQP_DERIV_CHECK_SECOND_SIMPLE
+           | SLEQP_DERIV_CHECK_SECOND_EXHAUSTIVE)))
+  {
+    return SLEQP_OKAY;
+  }
+
+  assert(col >= 0);
+  assert(col < sleqp_mat_num_cols(deriv_checker->block_directions));
+
+  if (flags & SLEQP_DERIV_CHECK_SECOND_CONS
+      || flags & SLEQP_DERIV_CHECK_SECOND_OBJ)
+  {
+    SLEQP_CALL(sleqp_mat_col(deriv_checker->hessian_block_func,
+                             col,
+                             deriv_checker->hessian_prod_func));
   }
 
   if (flags & SLEQP_DERIV_CHECK_SECOND_CONS)
   {
-    SLEQP_CALL(compute_hessian_cons_products(deriv_checker, j));
+    SLEQP_CALL(compute_hessian_cons_products(deriv_checker));
   }
 
   if (flags & SLEQP_DERIV_CHECK_SECOND_SIMPLE)
   {
-    SleqpVec* multipliers = sleqp_iterate_cons_dual(iterate);
-
-    SLEQP_CALL(sleqp_problem_hess_prod(problem,
-                                       unit_direction,
-                                       multipliers,
-                                       deriv_checker->hessian_prod));
+    SLEQP_CALL(sleqp_mat_col(deriv_checker->hessian_block,
+                             col,
+                             deriv_checker->hessian_prod));
   }
 
   return SLEQP_OKAY;
@@ -227,22 +449,21 @@ compute_hessian_products(SleqpDerivChecker* deriv_checker,
 static SLEQP_RETCODE
 create_check_iterate(SleqpDerivChecker* deriv_checker,
                      const SleqpIterate* iterate,
-                     const int j,
                      double* perturbation)
 {
   SleqpIterate* check_iterate = deriv_checker->check_iterate;
-  SleqpVec* unit_direction    = deriv_checker->unit_direction;
 
   const double zero_eps
     = sleqp_settings_real_value(deriv_checker->settings, SLEQP_SETTINGS_REAL_ZERO_EPS);
 
-  SLEQP_CALL(
-    create_perturbed_unit_direction(deriv_checker, iterate, j, perturbation));
+  *perturbation = get_perturbation(deriv_checker, iterate);
 
-  SLEQP_CALL(sleqp_vec_add(sleqp_iterate_primal(iterate),
-                           unit_direction,
-                           zero_eps,
-                           sleqp_iterate_primal(check_iterate)));
+  SLEQP_CALL(sleqp_vec_add_scaled(sleqp_iterate_primal(iterate),
+                                  deriv_checker->direction,
+                                  1.,
+                                  *perturbation,
+                                  zero_eps,
+                                  sleqp_iterate_primal(check_iterate)));
 
   return SLEQP_OKAY;
 }
@@ -309,8 +530,11 @@ check_deriv_func_first_order(SleqpDerivChecker* deriv_checker,
 
   const double actual_value = func_diff / perturbation;
 
-  const double expected_value
-    = sleqp_vec_value_at(sleqp_iterate_obj_grad(iterate), j);
+  double expected_value;
+
+  SLEQP_CALL(sleqp_vec_dot(sleqp_iterate_obj_grad(iterate),
+                           deriv_checker->direction,
+                           &expected_value));
 
   if (!sleqp_is_eq(expected_value, actual_value, tolerance))
   {
@@ -342,9 +566,13 @@ check_deriv_cons_first_order(SleqpDerivChecker* deriv_checker,
   const double tolerance
     = sleqp_settings_real_value(deriv_checker->settings, SLEQP_SETTINGS_REAL_DERIV_TOL);
 
+  SLEQP_CALL(sleqp_mat_mult_vec(cons_jac,
+                                 deriv_checker->direction,
+                                 deriv_checker->jac_prod));
+
   for (int i = 0; i < num_constraints; ++i)
   {
-    const double expected_value = sleqp_mat_value_at(cons_jac, i, j);
+    const double expected_value = deriv_checker->jac_prod[i];
 
     const double lower_value
       = sleqp_vec_value_at(sleqp_iterate_cons_val(iterate), i);
@@ -552,7 +780,7 @@ check_deriv_simple_second_order(SleqpDerivChecker* deriv_checker,
                                  iterate,
                                  deriv_checker->combined_cons_grad_iterate));
 
-    SLEQP_CALL(create_check_iterate(deriv_checker, iterate, j, &perturbation));
+    SLEQP_CALL(create_check_iterate(deriv_checker, iterate, &perturbation));
 
     SLEQP_CALL(compute_combined_cons_grad(
       deriv_checker,
@@ -642,13 +870,24 @@ static SLEQP_RETCODE
 eval_and_check_deriv(SleqpDerivChecker* deriv_checker,
                      SleqpIterate* iterate,
                      SLEQP_DERIV_CHECK flags,
-                     int j)
+                     int position,
+                     int block_col)
 {
   double perturbation;
 
   bool reject = false;
 
-  SLEQP_CALL(create_check_iterate(deriv_checker, iterate, j, &perturbation));
+  const bool valid_deriv = deriv_checker->valid_deriv;
+
+  const int j = deriv_checker->samples[position];
+
+  SLEQP_CALL(fill_direction(deriv_checker, position));
+
+  // Hessian products are evaluated at the original iterate
+  SLEQP_CALL(
+    compute_hessian_products(deriv_checker, flags, iterate, block_col));
+
+  SLEQP_CALL(create_check_iterate(deriv_checker, iterate, &perturbation));
 
   SLEQP_CALL(set_check_iterate(deriv_checker, &reject));
 
@@ -658,18 +897,152 @@ eval_and_check_deriv(SleqpDerivChecker* deriv_checker,
   }
   else
   {
-    SLEQP_CALL(compute_hessian_products(deriv_checker, flags, iterate, j));
-
     SLEQP_CALL(eval_at_check_iterate(deriv_checker, flags));
 
     SLEQP_CALL(check_deriv(deriv_checker, flags, iterate, j, perturbation));
   }
 
+  if (valid_deriv && !deriv_checker->valid_deriv
+      && deriv_checker->sampling == SLEQP_DERIV_CHECK_SAMPLING_DIRECTIONS)
+  {
+    sleqp_log_error("Derivative check failed along random direction %d, "
+                    "indices refer to the direction rather than a coordinate",
+                    j);
+  }
+
   SLEQP_CALL(restore_iterate(deriv_checker, iterate));
 
   return SLEQP_OKAY;
 }
 
+// Checks the samples within the given range of positions
+static SLEQP_RETCODE
+check_samples(SleqpDerivChecker* deriv_checker,
+              SleqpIterate* iterate,
+              SLEQP_DERIV_CHECK flags,
+              int begin,
+              int end)
+{
+  const bool second_order = flags
+                            & (SLEQP_DERIV_CHECK_SECOND_SIMPLE
+                               | SLEQP_DERIV_CHECK_SECOND_EXHAUSTIVE);
+
+  deriv_checker->valid_deriv = true;
+
+  if (second_order)
+  {
+    SLEQP_CALL(restore_iterate(deriv_checker, iterate));
+  }
+
+  for (int position = begin; position < end; ++position)
+  {
+    const int block_col = (position - begin) % hessian_block_size;
+
+    if (second_order && (block_col == 0))
+    {
+      const int block_end = SLEQP_MIN(position + hessian_block_size, end);
+
+      SLEQP_CALL(compute_hessian_block(deriv_checker,
+                                       flags,
+                                       iterate,
+                                       position,
+                                       block_end));
+    }
+
+    SLEQP_CALL(
+      eval_and_check_deriv(deriv_checker, iterate, flags, position, block_col));
+  }
+
+  return SLEQP_OKAY;
+}
+
+typedef struct
+{
+  SleqpDerivChecker** checkers;
+  int num_checkers;
+
+  SleqpIterate* iterate;
+  SLEQP_DERIV_CHECK flags;
+} CheckTask;
+
+static SLEQP_RETCODE
+check_samples_task(int task, void* data)
+{
+  CheckTask* check_task = (CheckTask*)data;
+
+  SleqpDerivChecker* deriv_checker = check_task->checkers[task];
+
+  const int num_samples  = deriv_checker->num_samples;
+  const int num_checkers = check_task->num_checkers;
+
+  const int begin = (int)(((int64_t)num_samples * task) / num_checkers);
+  const int end   = (int)(((int64_t)num_samples * (task + 1)) / num_checkers);
+
+  return check_samples(deriv_checker,
+                       check_task->iterate,
+                       check_task->flags,
+                       begin,
+                       end);
+}
+
+/*
+ * Creates checkers on copies of the problem, one for each additional
+ * thread of the active pool. Each copy evaluates its own function,
+ * so that the checkers can run concurrently. Creates no additional
+ * checkers if the function cannot be copied.
+ */
+static SLEQP_RETCODE
+create_workers(SleqpDerivChecker* deriv_checker,
+               SleqpDerivChecker** checkers,
+               int max_checkers,
+               int* num_checkers)
+{
+  SleqpProblem* problem = deriv_checker->problem;
+
+  const int num_samples = deriv_checker->num_samples;
+
+  checkers[0]   = deriv_checker;
+  *num_checkers = 1;
+
+  for (int k = 1; k < max_checkers; ++k)
+  {
+    SleqpProblem* clone;
+
+    SLEQP_CALL(sleqp_problem_clone(problem, &clone));
+
+    if (!clone)
+    {
+      sleqp_log_debug("Function cannot be copied, checking serially");
+      break;
+    }
+
+    SleqpDerivChecker* worker;
+
+    SLEQP_CALL(
+      sleqp_deriv_checker_create(&worker, clone, deriv_checker->settings));
+
+    SLEQP_CALL(sleqp_problem_release(&clone));
+
+    worker->sampling    = deriv_checker->sampling;
+    worker->seed        = deriv_checker->seed;
+    worker->num_samples = num_samples;
+
+    for (int position = 0; position < num_samples; ++position)
+    {
+      worker->samples[position] = deriv_checker->samples[position];
+    }
+
+    checkers[(*num_checkers)++] = worker;
+  }
+
+  if (*num_checkers > 1)
+  {
+    sleqp_log_debug("Checking derivatives using %d threads", *num_checkers);
+  }
+
+  return SLEQP_OKAY;
+}
+
 SLEQP_RETCODE
 sleqp_deriv_checker_create(SleqpDerivChecker** deriv_checker,
                            SleqpProblem* problem,
@@ -690,8 +1063,16 @@ sleqp_deriv_checker_create(SleqpDerivChecker** deriv_checker,
 
   data->iterate = NULL;
 
-  // this will be a unit vector
-  SLEQP_CALL(sleqp_vec_create(&data->unit_direction, num_variables, 1));
+  data->sampling    = SLEQP_DERIV_CHECK_SAMPLING_NONE;
+  data->num_samples = 0;
+  data->seed        = initial_seed;
+  data->state       = initial_seed;
+
+  SLEQP_CALL(sleqp_alloc_array(&data->samples, num_variables));
+
+  SLEQP_CALL(sleqp_vec_create(&data->direction, num_variables, 1));
+
+  SLEQP_CALL(sleqp_alloc_array(&data->jac_prod, num_constraints));
 
   SLEQP_CALL(sleqp_vec_create_empty(&data->hessian_estimate, num_variables));
 
@@ -712,6 +1093,15 @@ sleqp_deriv_checker_create(SleqpDerivChecker** deriv_checker,
                               num_constraints,
                               0));
 
+  SLEQP_CALL(sleqp_mat_create(&data->block_directions,
+                              num_variables,
+                              0,
+                              hessian_block_size));
+
+  SLEQP_CALL(sleqp_mat_create(&data->hessian_block, num_variables, 0, 0));
+
+  SLEQP_CALL(sleqp_mat_create(&data->hessian_block_func, num_variables, 0, 0));
+
   SLEQP_CALL(sleqp_vec_create_empty(&data->cons_grad_iterate, num_variables));
 
   SLEQP_CALL(
@@ -749,12 +1139,6 @@ sleqp_deriv_check_perform(SleqpDerivChecker* deriv_checker,
     return SLEQP_OKAY;
   }
 
-  deriv_checker->valid_deriv = true;
-
-  SleqpProblem* problem = deriv_checker->problem;
-
-  const int num_variables = sleqp_problem_num_vars(problem);
-
   {
     const bool first_order  = flags & SLEQP_DERIV_CHECK_FIRST;
     const bool second_order = flags
@@ -778,9 +1162,49 @@ sleqp_deriv_check_perform(SleqpDerivChecker* deriv_checker,
     }
   }
 
-  for (int j = 0; j < num_variables; ++j)
+  SLEQP_CALL(select_samples(deriv_checker));
+
+  SleqpThreadPool* pool = sleqp_thread_pool_active();
+
+  const int num_samples = deriv_checker->num_samples;
+
+  const int max_checkers
+    = pool ? SLEQP_MIN(sleqp_thread_pool_num_threads(pool), num_samples) : 1;
+
+  if (max_checkers <= 1)
   {
-    SLEQP_CALL(eval_and_check_deriv(deriv_checker, iterate, flags, j));
+    SLEQP_CALL(check_samples(deriv_checker, iterate, flags, 0, num_samples));
+  }
+  else
+  {
+    SleqpDerivChecker** checkers;
+
+    SLEQP_CALL(sleqp_alloc_array(&checkers, max_checkers));
+
+    CheckTask check_task
+      = {.checkers = checkers, .iterate = iterate, .flags = flags};
+
+    SLEQP_CALL(create_workers(deriv_checker,
+                              checkers,
+                              max_checkers,
+                              &check_task.num_checkers));
+
+    const SLEQP_RETCODE status = sleqp_thread_pool_run(pool,
+                                                       check_task.num_checkers,
+                                                       check_samples_task,
+                                                       &check_task);
+
+    for (int k = 1; k < check_task.num_checkers; ++k)
+    {
+      deriv_checker->valid_deriv
+        = deriv_checker->valid_deriv && checkers[k]->valid_deriv;
+
+      SLEQP_CALL(sleqp_deriv_checker_free(checkers + k));
+    }
+
+    sleqp_free(&checkers);
+
+    SLEQP_CALL(status);
   }
 
   if (!deriv_checker->valid_deriv)
@@ -819,6 +1243,12 @@ sleqp_deriv_checker_free(SleqpDerivChecker** star)
 
   SLEQP_CALL(sleqp_vec_free(&deriv_checker->cons_grad_iterate));
 
+  SLEQP_CALL(sleqp_mat_release(&deriv_checker->hessian_block_func));
+
+  SLEQP_CALL(sleqp_mat_release(&deriv_checker->hessian_block));
+
+  SLEQP_CALL(sleqp_mat_release(&deriv_checker->block_directions));
+
   SLEQP_CALL(sleqp_mat_release(&deriv_checker->hessian_cons_prods));
 
   SLEQP_CALL(sleqp_vec_free(&deriv_checker->hessian_prod_cache));
@@ -835,7 +1265,11 @@ sleqp_deriv_checker_free(SleqpDerivChecker** star)
 
   SLEQP_CALL(sleqp_vec_free(&deriv_checker->hessian_estimate));
 
-  SLEQP_CALL(sleqp_vec_free(&deriv_checker->unit_direction));
+  sleqp_free(&deriv_checker->jac_prod);
+
+  SLEQP_CALL(sleqp_vec_free(&deriv_checker->direction));
+
+  sleqp_free(&deriv_checker->samples);
 
   SLEQP_CALL(sleqp_settings_release(&deriv_checker->settings));
 
@@ -1,6 +1,6 @@
 #include "fact.h"
 
-#include <string.h>
+#include <stdint.h>
 
 #include "fail.h"
 #include "log.h"
@@ -16,6 +16,13 @@ struct SleqpFact
   SleqpFactCallbacks callbacks;
   SLEQP_FACT_FLAGS flags;
   void* fact_data;
+
+  // Pattern of the last analyzed matrix
+  bool has_pattern;
+  int num_rows;
+  int num_cols;
+  int nnz;
+  uint64_t pattern_hash;
 };
 
 SLEQP_RETCODE
@@ -33,8 +40,8 @@ sleqp_fact_create(SleqpFact** star,
 
   *factorization = (SleqpFact){0};
 
-  factorization->name    = strdup(name);
-  factorization->version = strdup(version);
+  SLEQP_CALL(sleqp_strdup(&factorization->name, name));
+  SLEQP_CALL(sleqp_strdup(&factorization->version, version));
 
   factorization->refcount  = 1;
   factorization->callbacks = *callbacks;
@@ -56,6 +63,81 @@ sleqp_factorization_version(SleqpFact* factorization)
   return factorization->version;
 }
 
+// FNV-1a over the column pointers and row indices
+static uint64_t
+pattern_hash(const SleqpMat* matrix)
+{
+  const int num_cols = sleqp_mat_num_cols(matrix);
+  const int nnz      = sleqp_mat_nnz(matrix);
+
+  const int* cols = sleqp_mat_cols(matrix);
+  const int* rows = sleqp_mat_rows(matrix);
+
+  uint64_t hash = UINT64_C(14695981039346656037);
+
+  for (int col = 0; col <= num_cols; ++col)
+  {
+    hash = (hash ^ (uint32_t)cols[col]) * UINT64_C(1099511628211);
+  }
+
+  for (int k = 0; k < nnz; ++k)
+  {
+    hash = (hash ^ (uint32_t)rows[k]) * UINT64_C(1099511628211);
+  }
+
+  return hash;
+}
+
+static bool
+same_pattern(const SleqpFact* factorization,
+             const SleqpMat* matrix,
+             uint64_t hash)
+{
+  return factorization->has_pattern
+         && (factorization->num_rows == sleqp_mat_num_rows(matrix))
+         && (factorization->num_cols == sleqp_mat_num_cols(matrix))
+         && (factorization->nnz == sleqp_mat_nnz(matrix))
+         && (factorization->pattern_hash == hash);
+}
+
+static SLEQP_RETCODE
+factorize(SleqpFact* factorization, SleqpMat* matrix)
+{
+  SleqpFactCallbacks* callbacks = &factorization->callbacks;
+  void* fact_data               = factorization->fact_data;
+
+  if (!callbacks->refactor)
+  {
+    SLEQP_CALL(callbacks->set_matrix(fact_data, matrix));
+
+    return SLEQP_OKAY;
+  }
+
+  const uint64_t hash = pattern_hash(matrix);
+
+  const bool reuse_analysis = same_pattern(factorization, matrix, hash);
+
+  // Force a new analysis after a failure
+  factorization->has_pattern = false;
+
+  if (reuse_analysis)
+  {
+    SLEQP_CALL(callbacks->refactor(fact_data, matrix));
+  }
+  else
+  {
+    SLEQP_CALL(callbacks->set_matrix(fact_data, matrix));
+  }
+
+  factorization->has_pattern  = true;
+  factorization->num_rows     = sleqp_mat_num_rows(matrix);
+  factorization->num_cols     = sleqp_mat_num_cols(matrix);
+  factorization->nnz          = sleqp_mat_nnz(matrix);
+  factorization->pattern_hash = hash;
+
+  return SLEQP_OKAY;
+}
+
 SLEQP_RETCODE
 sleqp_fact_set_matrix(SleqpFact* factorization, SleqpMat* matrix)
 {
@@ -68,8 +150,7 @@ sleqp_fact_set_matrix(SleqpFact* factorization, SleqpMat* matrix)
   }
 #endif
 
-  SLEQP_CALL(
-    factorization->callbacks.set_matrix(factorization->fact_data, matrix));
+  SLEQP_CALL(factorize(factorization, matrix));
 
   return SLEQP_OKAY;
 }
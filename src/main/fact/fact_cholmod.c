@@ -130,6 +130,8 @@ cholmod_fact_set_matrix(void* fact_data, SleqpMat* matrix)
 
   SLEQP_CHOLMOD_ERROR_CHECK(common);
 
+  cholmod_l_free_factor(&cholmod_data->factor, common);
+
   cholmod_data->factor = cholmod_l_analyze(cholmod_data->sparse, common);
 
   SLEQP_CHOLMOD_ERROR_CHECK(common);
@@ -143,6 +145,35 @@ cholmod_fact_set_matrix(void* fact_data, SleqpMat* matrix)
   return SLEQP_OKAY;
 }
 
+static SLEQP_RETCODE
+cholmod_fact_refactor(void* fact_data, SleqpMat* matrix)
+{
+  CHOLMODData* cholmod_data = (CHOLMODData*)fact_data;
+
+  cholmod_common* common = &(cholmod_data->common);
+
+  const int nnz = sleqp_mat_nnz(matrix);
+
+  assert(cholmod_data->factor);
+  assert(sleqp_mat_num_cols(matrix) == cholmod_data->num_cols);
+
+  const double* mat_data = sleqp_mat_data(matrix);
+
+  double* data = cholmod_data->sparse->x;
+
+  for (int index = 0; index < nnz; ++index)
+  {
+    data[index] = mat_data[index];
+  }
+
+  // Reuses the ordering and elimination tree of the analysis
+  cholmod_l_factorize(cholmod_data->sparse, cholmod_data->factor, common);
+
+  SLEQP_CHOLMOD_ERROR_CHECK(common);
+
+  return SLEQP_OKAY;
+}
+
 static SLEQP_RETCODE
 set_cache(double* cache, const SleqpVec* vec)
 {
@@ -257,7 +288,7 @@ cholmod_fact_free(void** star)
 }
 
 static SLEQP_RETCODE
-cholmod_data_create(CHOLMODData** star)
+cholmod_data_create(CHOLMODData** star, int num_threads)
 {
   SLEQP_CALL(sleqp_malloc(star));
 
@@ -270,6 +301,13 @@ cholmod_data_create(CHOLMODData** star)
   cholmod_data->common.error_handler = sleqp_cholmod_report_error;
   cholmod_data->common.dtype         = CHOLMOD_DOUBLE;
 
+#if CHOLMOD_MAIN_VERSION >= 3
+  if (num_threads != SLEQP_NONE)
+  {
+    cholmod_data->common.nthreads_max = num_threads;
+  }
+#endif
+
   cholmod_data->num_cols = SLEQP_NONE;
   cholmod_data->num_rows = SLEQP_NONE;
 
@@ -281,6 +319,7 @@ sleqp_fact_cholmod_create(SleqpFact** star, SleqpSettings* settings)
 {
 
   SleqpFactCallbacks callbacks = {.set_matrix = cholmod_fact_set_matrix,
+                                  .refactor   = cholmod_fact_refactor,
                                   .solve      = cholmod_fact_solve,
                                   .solution   = cholmod_fact_solution,
                                   .condition  = cholmod_fact_condition,
@@ -288,7 +327,10 @@ sleqp_fact_cholmod_create(SleqpFact** star, SleqpSettings* settings)
 
   CHOLMODData* cholmod_data;
 
-  SLEQP_CALL(cholmod_data_create(&cholmod_data));
+  const int num_threads
+    = sleqp_settings_int_value(settings, SLEQP_SETTINGS_INT_NUM_THREADS);
+
+  SLEQP_CALL(cholmod_data_create(&cholmod_data, num_threads));
 
   SLEQP_CALL(sleqp_fact_create(star,
                                SLEQP_FACT_CHOLMOD_NAME,
@@ -391,6 +391,19 @@ ma27_set_matrix(void* fact_data, SleqpMat* matrix)
   return SLEQP_OKAY;
 }
 
+static SLEQP_RETCODE
+ma27_refactor(void* fact_data, SleqpMat* matrix)
+{
+  MA27Data* ma27_data = (MA27Data*)fact_data;
+
+  // Pivot sequence is retained from the symbolic factorization
+  SLEQP_CALL(hsl_matrix_set_values(&(ma27_data->matrix), matrix));
+
+  SLEQP_CALL(ma27_numeric(ma27_data));
+
+  return SLEQP_OKAY;
+}
+
 static MA27_ERROR
 ma27_solve(MA27Data* ma27_data)
 {
@@ -537,6 +550,7 @@ SLEQP_RETCODE
 sleqp_fact_ma27_create(SleqpFact** star, SleqpSettings* settings)
 {
   SleqpFactCallbacks callbacks = {.set_matrix = ma27_set_matrix,
+                                  .refactor   = ma27_refactor,
                                   .solve      = ma27_data_solve,
                                   .solution   = ma27_data_solution,
                                   .condition  = NULL,
@@ -624,6 +624,19 @@ ma57_set_matrix(void* fact_data, SleqpMat* matrix)
   return SLEQP_OKAY;
 }
 
+static SLEQP_RETCODE
+ma57_refactor(void* fact_data, SleqpMat* matrix)
+{
+  MA57Data* ma57_data = (MA57Data*)fact_data;
+
+  // Factor sizes are retained from the symbolic factorization
+  SLEQP_CALL(hsl_matrix_set_values(&(ma57_data->matrix), matrix));
+
+  SLEQP_CALL(ma57_numeric(ma57_data));
+
+  return SLEQP_OKAY;
+}
+
 static SLEQP_RETCODE
 ma57_solve(void* fact_data, const SleqpVec* rhs)
 {
@@ -810,6 +823,7 @@ SLEQP_RETCODE
 sleqp_fact_ma57_create(SleqpFact** star, SleqpSettings* settings)
 {
   SleqpFactCallbacks callbacks = {.set_matrix = ma57_set_matrix,
+                                  .refactor   = ma57_refactor,
                                   .solve      = ma57_solve,
                                   .solution   = ma57_solution,
                                   .condition  = ma57_condition_estimate,
@@ -5,6 +5,7 @@
 
 #include "defs.h"
 #include "error.h"
+#include "fact_threads.h"
 #include "fail.h"
 #include "log.h"
 #include "mem.h"
@@ -132,6 +133,8 @@ typedef struct MA86Data
   struct mc68_control control_c;
   struct mc68_info info_c;
 
+  int num_threads;
+
   int dim;
   int max_dim;
   int* order;
@@ -142,7 +145,7 @@ typedef struct MA86Data
 } MA86Data;
 
 static SLEQP_RETCODE
-ma86_data_create(MA86Data** star)
+ma86_data_create(MA86Data** star, int num_threads)
 {
   SLEQP_CALL(sleqp_malloc(star));
 
@@ -150,6 +153,8 @@ ma86_data_create(MA86Data** star)
 
   *ma86_data = (MA86Data){0};
 
+  ma86_data->num_threads = num_threads;
+
   ma86_default_control(&(ma86_data->control));
 
   // We expect all matrices here to be non-singular,
@@ -171,10 +176,8 @@ ma86_data_create(MA86Data** star)
 }
 
 static SLEQP_RETCODE
-ma86_data_set_matrix(void* fact_data, SleqpMat* matrix)
+factorize(MA86Data* ma86_data, SleqpMat* matrix, bool analyse)
 {
-  MA86Data* ma86_data = (MA86Data*)fact_data;
-
   const int num_cols = sleqp_mat_num_cols(matrix);
   const int num_rows = sleqp_mat_num_rows(matrix);
 
@@ -197,27 +200,28 @@ ma86_data_set_matrix(void* fact_data, SleqpMat* matrix)
   int* rows    = sleqp_mat_rows(matrix);
   double* data = sleqp_mat_data(matrix);
 
-  mc68_order(MC68_ORDER_APX_MINDEG,
-             dim,
-             cols,
-             rows,
-             ma86_data->order,
-             &(ma86_data->control_c),
-             &(ma86_data->info_c));
-
-  MA86_CHECK_ERROR(ma86_data->info_c.stat);
-
-  // order
-
-  ma86_analyse(dim,
+  if (analyse)
+  {
+    mc68_order(MC68_ORDER_APX_MINDEG,
+               dim,
                cols,
                rows,
                ma86_data->order,
-               &(ma86_data->keep),
-               &(ma86_data->control),
-               &(ma86_data->info));
+               &(ma86_data->control_c),
+               &(ma86_data->info_c));
 
-  MA86_CHECK_ERROR(ma86_data->info.stat);
+    MA86_CHECK_ERROR(ma86_data->info_c.stat);
+
+    ma86_analyse(dim,
+                 cols,
+                 rows,
+                 ma86_data->order,
+                 &(ma86_data->keep),
+                 &(ma86_data->control),
+                 &(ma86_data->info));
+
+    MA86_CHECK_ERROR(ma86_data->info.stat);
+  }
 
   ma86_factor(dim,
               cols,
@@ -235,10 +239,36 @@ ma86_data_set_matrix(void* fact_data, SleqpMat* matrix)
 }
 
 static SLEQP_RETCODE
-ma86_data_solve(void* fact_data, const SleqpVec* rhs)
+ma86_data_set_matrix(void* fact_data, SleqpMat* matrix)
 {
   MA86Data* ma86_data = (MA86Data*)fact_data;
 
+  const int num_threads = sleqp_fact_set_omp_threads(ma86_data->num_threads);
+
+  const SLEQP_RETCODE status = factorize(ma86_data, matrix, true);
+
+  sleqp_fact_set_omp_threads(num_threads);
+
+  return status;
+}
+
+static SLEQP_RETCODE
+ma86_data_refactor(void* fact_data, SleqpMat* matrix)
+{
+  MA86Data* ma86_data = (MA86Data*)fact_data;
+
+  const int num_threads = sleqp_fact_set_omp_threads(ma86_data->num_threads);
+
+  const SLEQP_RETCODE status = factorize(ma86_data, matrix, false);
+
+  sleqp_fact_set_omp_threads(num_threads);
+
+  return status;
+}
+
+static SLEQP_RETCODE
+substitute(MA86Data* ma86_data, const SleqpVec* rhs)
+{
   const int job  = 0;
   const int nrhs = 1;
   const int dim  = ma86_data->dim;
@@ -263,6 +293,20 @@ ma86_data_solve(void* fact_data, const SleqpVec* rhs)
   return SLEQP_OKAY;
 }
 
+static SLEQP_RETCODE
+ma86_data_solve(void* fact_data, const SleqpVec* rhs)
+{
+  MA86Data* ma86_data = (MA86Data*)fact_data;
+
+  const int num_threads = sleqp_fact_set_omp_threads(ma86_data->num_threads);
+
+  const SLEQP_RETCODE status = substitute(ma86_data, rhs);
+
+  sleqp_fact_set_omp_threads(num_threads);
+
+  return status;
+}
+
 static SLEQP_RETCODE
 ma86_data_solution(void* fact_data,
                    SleqpVec* sol,
@@ -304,6 +348,7 @@ SLEQP_RETCODE
 sleqp_fact_ma86_create(SleqpFact** star, SleqpSettings* settings)
 {
   SleqpFactCallbacks callbacks = {.set_matrix = ma86_data_set_matrix,
+                                  .refactor   = ma86_data_refactor,
                                   .solve      = ma86_data_solve,
                                   .solution   = ma86_data_solution,
                                   .condition  = NULL,
@@ -311,7 +356,10 @@ sleqp_fact_ma86_create(SleqpFact** star, SleqpSettings* settings)
 
   MA86Data* ma86_data;
 
-  SLEQP_CALL(ma86_data_create(&ma86_data));
+  const int num_threads
+    = sleqp_settings_int_value(settings, SLEQP_SETTINGS_INT_NUM_THREADS);
+
+  SLEQP_CALL(ma86_data_create(&ma86_data, num_threads));
 
   SLEQP_CALL(sleqp_fact_create(star,
                                SLEQP_FACT_MA86_NAME,
@@ -209,6 +209,8 @@ typedef struct MA97Data
   struct mc68_control control_c;
   struct mc68_info info_c;
 
+  int num_threads;
+
   int dim;
   int max_dim;
   int* order;
@@ -220,7 +222,7 @@ typedef struct MA97Data
 } MA97Data;
 
 static SLEQP_RETCODE
-ma97_data_create(MA97Data** star)
+ma97_data_create(MA97Data** star, int num_threads)
 {
   SLEQP_CALL(sleqp_malloc(star));
 
@@ -228,6 +230,8 @@ ma97_data_create(MA97Data** star)
 
   *ma97_data = (MA97Data){0};
 
+  ma97_data->num_threads = num_threads;
+
   ma97_default_control(&(ma97_data->control));
 
   // We expect all matrices here to be non-singular,
@@ -251,10 +255,8 @@ ma97_data_create(MA97Data** star)
 }
 
 static SLEQP_RETCODE
-ma97_data_set_matrix(void* fact_data, SleqpMat* matrix)
+factorize(MA97Data* ma97_data, SleqpMat* matrix, bool analyse)
 {
-  MA97Data* ma97_data = (MA97Data*)fact_data;
-
   const int num_cols = sleqp_mat_num_cols(matrix);
   const int num_rows = sleqp_mat_num_rows(matrix);
 
@@ -277,29 +279,30 @@ ma97_data_set_matrix(void* fact_data, SleqpMat* matrix)
   int* rows    = sleqp_mat_rows(matrix);
   double* data = sleqp_mat_data(matrix);
 
-  mc68_order(MC68_ORDER_APX_MINDEG,
-             dim,
-             cols,
-             rows,
-             ma97_data->order,
-             &(ma97_data->control_c),
-             &(ma97_data->info_c));
-
-  MA97_CHECK_ERROR(ma97_data->info_c.stat);
-
-  // order
-
-  ma97_analyse(ma97_check_matrix,
+  if (analyse)
+  {
+    mc68_order(MC68_ORDER_APX_MINDEG,
                dim,
                cols,
                rows,
-               data,
-               &(ma97_data->akeep),
-               &(ma97_data->control),
-               &(ma97_data->info),
-               ma97_data->order);
-
-  MA97_CHECK_ERROR(ma97_data->info.stat);
+               ma97_data->order,
+               &(ma97_data->control_c),
+               &(ma97_data->info_c));
+
+    MA97_CHECK_ERROR(ma97_data->info_c.stat);
+
+    ma97_analyse(ma97_check_matrix,
+                 dim,
+                 cols,
+                 rows,
+                 data,
+                 &(ma97_data->akeep),
+                 &(ma97_data->control),
+                 &(ma97_data->info),
+                 ma97_data->order);
+
+    MA97_CHECK_ERROR(ma97_data->info.stat);
+  }
 
   ma97_factor(MA97_REAL_INDEF,
               cols,
@@ -321,10 +324,36 @@ ma97_data_set_matrix(void* fact_data, SleqpMat* matrix)
 }
 
 static SLEQP_RETCODE
-ma97_data_solve(void* fact_data, const SleqpVec* rhs)
+ma97_data_set_matrix(void* fact_data, SleqpMat* matrix)
+{
+  MA97Data* ma97_data = (MA97Data*)fact_data;
+
+  const int num_threads = sleqp_fact_set_omp_threads(ma97_data->num_threads);
+
+  const SLEQP_RETCODE status = factorize(ma97_data, matrix, true);
+
+  sleqp_fact_set_omp_threads(num_threads);
+
+  return status;
+}
+
+static SLEQP_RETCODE
+ma97_data_refactor(void* fact_data, SleqpMat* matrix)
 {
   MA97Data* ma97_data = (MA97Data*)fact_data;
 
+  const int num_threads = sleqp_fact_set_omp_threads(ma97_data->num_threads);
+
+  const SLEQP_RETCODE status = factorize(ma97_data, matrix, false);
+
+  sleqp_fact_set_omp_threads(num_threads);
+
+  return status;
+}
+
+static SLEQP_RETCODE
+substitute(MA97Data* ma97_data, const SleqpVec* rhs)
+{
   const int nrhs = 1;
   const int dim  = ma97_data->dim;
 
@@ -346,6 +375,20 @@ ma97_data_solve(void* fact_data, const SleqpVec* rhs)
   return SLEQP_OKAY;
 }
 
+static SLEQP_RETCODE
+ma97_data_solve(void* fact_data, const SleqpVec* rhs)
+{
+  MA97Data* ma97_data = (MA97Data*)fact_data;
+
+  const int num_threads = sleqp_fact_set_omp_threads(ma97_data->num_threads);
+
+  const SLEQP_RETCODE status = substitute(ma97_data, rhs);
+
+  sleqp_fact_set_omp_threads(num_threads);
+
+  return status;
+}
+
 static SLEQP_RETCODE
 ma97_data_solution(void* fact_data,
                    SleqpVec* sol,
@@ -384,6 +427,7 @@ SLEQP_RETCODE
 sleqp_fact_ma97_create(SleqpFact** star, SleqpSettings* settings)
 {
   SleqpFactCallbacks callbacks = {.set_matrix = ma97_data_set_matrix,
+                                  .refactor   = ma97_data_refactor,
                                   .solve      = ma97_data_solve,
                                   .solution   = ma97_data_solution,
                                   .condition  = NULL,
@@ -391,7 +435,10 @@ sleqp_fact_ma97_create(SleqpFact** star, SleqpSettings* settings)
 
   MA97Data* ma97_data;
 
-  SLEQP_CALL(ma97_data_create(&ma97_data));
+  const int num_threads
+    = sleqp_settings_int_value(settings, SLEQP_SETTINGS_INT_NUM_THREADS);
+
+  SLEQP_CALL(ma97_data_create(&ma97_data, num_threads));
 
   SLEQP_CALL(sleqp_fact_create(star,
                                SLEQP_FACT_MA97_NAME,
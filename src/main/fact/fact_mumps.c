@@ -49,7 +49,7 @@ typedef struct SleqpMUMPSData
   } while (0)
 
 static SLEQP_RETCODE
-sleqp_mumps_create(SleqpMUMPSData** star)
+sleqp_mumps_create(SleqpMUMPSData** star, int num_threads)
 {
 #ifdef SLEQP_WITH_MPI
   SLEQP_CALL(sleqp_mpi_initialize());
@@ -80,6 +80,12 @@ sleqp_mumps_create(SleqpMUMPSData** star)
   sleqp_mumps_data->id.job = -1;
   SLEQP_MUMPS_CALL(sleqp_mumps_data->id);
 
+  // Number of OpenMP threads, set after init job resets controls
+  if (num_threads != SLEQP_NONE)
+  {
+    sleqp_mumps_data->id.icntl[15] = num_threads;
+  }
+
   return SLEQP_OKAY;
 }
 
@@ -181,6 +187,24 @@ sleqp_mumps_set_matrix(void* fact_data, SleqpMat* matrix)
   return SLEQP_OKAY;
 }
 
+static SLEQP_RETCODE
+sleqp_mumps_refactor(void* fact_data, SleqpMat* matrix)
+{
+  SleqpMUMPSData* sleqp_mumps_data = (SleqpMUMPSData*)fact_data;
+
+  // Same pattern, arrays passed during analysis remain valid
+  SLEQP_CALL(matrix_fill(sleqp_mumps_data, matrix));
+
+  assert(sleqp_mumps_data->id.a == sleqp_mumps_data->data);
+  assert(sleqp_mumps_data->id.nz == sleqp_mumps_data->nnz);
+
+  // factorization job
+  sleqp_mumps_data->id.job = 2;
+  SLEQP_MUMPS_CALL(sleqp_mumps_data->id);
+
+  return SLEQP_OKAY;
+}
+
 static SLEQP_RETCODE
 sleqp_mumps_solve(void* fact_data, const SleqpVec* rhs)
 {
@@ -245,6 +269,7 @@ SLEQP_RETCODE
 sleqp_fact_mumps_create(SleqpFact** star, SleqpSettings* settings)
 {
   SleqpFactCallbacks callbacks = {.set_matrix = sleqp_mumps_set_matrix,
+                                  .refactor   = sleqp_mumps_refactor,
                                   .solve      = sleqp_mumps_solve,
                                   .solution   = sleqp_mumps_solution,
                                   .condition  = NULL,
@@ -252,7 +277,10 @@ sleqp_fact_mumps_create(SleqpFact** star, SleqpSettings* settings)
 
   SleqpMUMPSData* sleqp_mumps_data;
 
-  SLEQP_CALL(sleqp_mumps_create(&sleqp_mumps_data));
+  const int num_threads
+    = sleqp_settings_int_value(settings, SLEQP_SETTINGS_INT_NUM_THREADS);
+
+  SLEQP_CALL(sleqp_mumps_create(&sleqp_mumps_data, num_threads));
 
   SLEQP_CALL(sleqp_fact_create(star,
                                SLEQP_FACT_MUMPS_NAME,
@@ -1,7 +1,6 @@
 #include "fact_qr.h"
 
 #include <assert.h>
-#include <string.h>
 
 #include "mem.h"
 #include "pub_settings.h"
@@ -35,8 +34,8 @@ sleqp_qr_create(SleqpFactQR** star,
 
   *qr = (SleqpFactQR){0};
 
-  qr->name    = strdup(name);
-  qr->version = strdup(version);
+  SLEQP_CALL(sleqp_strdup(&qr->name, name));
+  SLEQP_CALL(sleqp_strdup(&qr->version, version));
 
   qr->refcount  = 1;
   qr->callbacks = *callbacks;
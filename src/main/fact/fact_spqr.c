@@ -369,7 +369,7 @@ spqr_fact_free(void** star)
 }
 
 static SLEQP_RETCODE
-spqr_data_create(SPQRData** star)
+spqr_data_create(SPQRData** star, SleqpSettings* settings)
 {
   SLEQP_CALL(sleqp_malloc(star));
 
@@ -384,6 +384,17 @@ spqr_data_create(SPQRData** star)
   spqr->num_rows             = SLEQP_NONE;
   spqr->num_cols             = SLEQP_NONE;
 
+  const int num_threads
+    = sleqp_settings_int_value(settings, SLEQP_SETTINGS_INT_NUM_THREADS);
+
+  if (num_threads != SLEQP_NONE)
+  {
+    spqr->common.SPQR_nthreads = num_threads;
+#if CHOLMOD_MAIN_VERSION >= 3
+    spqr->common.nthreads_max = num_threads;
+#endif
+  }
+
   return SLEQP_OKAY;
 }
 
@@ -399,7 +410,7 @@ sleqp_fact_spqr_create(SleqpFactQR** star, SleqpSettings* settings)
 
   SPQRData* spqr_data;
 
-  SLEQP_CALL(spqr_data_create(&spqr_data));
+  SLEQP_CALL(spqr_data_create(&spqr_data, settings));
 
   SLEQP_CALL(sleqp_qr_create(star,
                              SLEQP_FACT_SPQR_NAME,
@@ -421,7 +432,7 @@ sleqp_fact_create_default(SleqpFact** star, SleqpSettings* settings)
 
   SPQRData* spqr_data;
 
-  SLEQP_CALL(spqr_data_create(&spqr_data));
+  SLEQP_CALL(spqr_data_create(&spqr_data, settings));
 
   SLEQP_CALL(sleqp_fact_create(star,
                                SLEQP_FACT_SPQR_NAME,
@@ -0,0 +1,25 @@
+#include "fact_threads.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+int
+sleqp_fact_set_omp_threads(int num_threads)
+{
+#ifdef _OPENMP
+  if (num_threads == SLEQP_NONE)
+  {
+    return SLEQP_NONE;
+  }
+
+  const int previous = omp_get_max_threads();
+
+  omp_set_num_threads(num_threads);
+
+  return previous;
+#else
+  (void)num_threads;
+  return SLEQP_NONE;
+#endif
+}
@@ -0,0 +1,16 @@
+#ifndef SLEQP_FACT_THREADS_H
+#define SLEQP_FACT_THREADS_H
+
+#include "types.h"
+
+/**
+ * Sets the number of OpenMP threads used by parallel regions subsequently
+ * started by the calling thread. Does nothing if `num_threads` is
+ * @ref SLEQP_NONE or if OpenMP is not available.
+ *
+ * @return The previous number of threads, or @ref SLEQP_NONE
+ **/
+int
+sleqp_fact_set_omp_threads(int num_threads);
+
+#endif /* SLEQP_FACT_THREADS_H */
@@ -9,6 +9,15 @@ typedef struct SleqpFact SleqpFact;
 typedef SLEQP_RETCODE (*SLEQP_FACT_SET_MATRIX)(void* fact_data,
                                                SleqpMat* matrix);
 
+/**
+ * Numerically refactors the given matrix, reusing the symbolic analysis
+ * (ordering, elimination tree) computed by the last call to
+ * @ref SLEQP_FACT_SET_MATRIX. Only called if the sparsity pattern
+ * of the matrix is unchanged since then.
+ **/
+typedef SLEQP_RETCODE (*SLEQP_FACT_REFACTOR)(void* fact_data,
+                                             SleqpMat* matrix);
+
 typedef SLEQP_RETCODE (*SLEQP_FACT_SOLVE)(void* fact_data, const SleqpVec* rhs);
 
 typedef SLEQP_RETCODE (*SLEQP_FACT_SOLUTION)(void* fact_data,
@@ -25,6 +34,7 @@ typedef SLEQP_RETCODE (*SLEQP_FACT_FREE)(void** star);
 typedef struct
 {
   SLEQP_FACT_SET_MATRIX set_matrix;
+  SLEQP_FACT_REFACTOR refactor; /**< optional **/
   SLEQP_FACT_SOLVE solve;
   SLEQP_FACT_SOLUTION solution;
   SLEQP_FACT_CONDITION condition;
@@ -101,6 +101,44 @@ umfpack_fact_free_fact(UmfpackData* umfpack)
   return SLEQP_OKAY;
 }
 
+static SLEQP_RETCODE
+umfpack_fact_numeric(UmfpackData* umfpack, SleqpMat* matrix)
+{
+  const int num_rows = sleqp_mat_num_rows(matrix);
+
+  if (umfpack->numeric_factorization)
+  {
+    umfpack_di_free_numeric(&umfpack->numeric_factorization);
+
+    umfpack->numeric_factorization = NULL;
+  }
+
+  umfpack->matrix = matrix;
+
+  UMFPACK_CALL(umfpack_di_numeric(sleqp_mat_cols(matrix),
+                                  sleqp_mat_rows(matrix),
+                                  sleqp_mat_data(matrix),
+                                  umfpack->symbolic_factorization,
+                                  &umfpack->numeric_factorization,
+                                  umfpack->control,
+                                  umfpack->info));
+
+  for (int i = 0; i < num_rows; ++i)
+  {
+    umfpack->rhs[i] = 0.;
+  }
+
+  /*
+  if(sleqp_log_level() >= SLEQP_LOG_DEBUG)
+  {
+    umfpack_di_report_info(umfpack->control,
+                           umfpack->info);
+  }
+  */
+
+  return SLEQP_OKAY;
+}
+
 static SLEQP_RETCODE
 umfpack_fact_set_matrix(void* fact_data, SleqpMat* matrix)
 {
@@ -130,8 +168,7 @@ umfpack_fact_set_matrix(void* fact_data, SleqpMat* matrix)
 
   assert(sleqp_mat_is_quadratic(matrix));
 
-  umfpack->matrix = matrix;
-
+  // The symbolic factorization is kept for subsequent refactorizations
   UMFPACK_CALL(umfpack_di_symbolic(sleqp_mat_num_cols(matrix),
                                    sleqp_mat_num_rows(matrix),
                                    sleqp_mat_cols(matrix),
@@ -141,33 +178,19 @@ umfpack_fact_set_matrix(void* fact_data, SleqpMat* matrix)
                                    umfpack->control,
                                    umfpack->info));
 
-  UMFPACK_CALL(umfpack_di_numeric(sleqp_mat_cols(matrix),
-                                  sleqp_mat_rows(matrix),
-                                  sleqp_mat_data(matrix),
-                                  umfpack->symbolic_factorization,
-                                  &umfpack->numeric_factorization,
-                                  umfpack->control,
-                                  umfpack->info));
+  SLEQP_CALL(umfpack_fact_numeric(umfpack, matrix));
 
-  if (umfpack->symbolic_factorization)
-  {
-    umfpack_di_free_symbolic(&umfpack->symbolic_factorization);
-  }
+  return SLEQP_OKAY;
+}
 
-  umfpack->symbolic_factorization = NULL;
+static SLEQP_RETCODE
+umfpack_fact_refactor(void* fact_data, SleqpMat* matrix)
+{
+  UmfpackData* umfpack = (UmfpackData*)fact_data;
 
-  for (int i = 0; i < num_rows; ++i)
-  {
-    umfpack->rhs[i] = 0.;
-  }
+  assert(umfpack->symbolic_factorization);
 
-  /*
-  if(sleqp_log_level() >= SLEQP_LOG_DEBUG)
-  {
-    umfpack_di_report_info(umfpack->control,
-                           umfpack->info);
-  }
-  */
+  SLEQP_CALL(umfpack_fact_numeric(umfpack, matrix));
 
   return SLEQP_OKAY;
 }
@@ -290,6 +313,7 @@ sleqp_fact_umfpack_create(SleqpFact** star, SleqpSettings* settings)
 {
 
   SleqpFactCallbacks callbacks = {.set_matrix = umfpack_fact_set_matrix,
+                                  .refactor   = umfpack_fact_refactor,
                                   .solve      = umfpack_fact_solve,
                                   .solution   = umfpack_fact_solution,
                                   .condition  = umfpack_fact_condition,
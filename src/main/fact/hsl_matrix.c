@@ -57,6 +57,25 @@ hsl_matrix_set(HSLMatrix* hsl_matrix, SleqpMat* matrix)
   return SLEQP_OKAY;
 }
 
+SLEQP_RETCODE
+hsl_matrix_set_values(HSLMatrix* hsl_matrix, SleqpMat* matrix)
+{
+  const double* matrix_data = sleqp_mat_data(matrix);
+  const int matrix_nnz      = sleqp_mat_nnz(matrix);
+
+  assert(hsl_matrix->dim == sleqp_mat_num_rows(matrix));
+  assert(hsl_matrix->nnz == matrix_nnz);
+
+  double* hsl_data = hsl_matrix->data;
+
+  for (int index = 0; index < matrix_nnz; ++index)
+  {
+    hsl_data[index] = matrix_data[index];
+  }
+
+  return SLEQP_OKAY;
+}
+
 SLEQP_RETCODE
 hsl_matrix_clear(HSLMatrix* hsl_matrix)
 {
@@ -22,6 +22,14 @@ SLEQP_NODISCARD
 SLEQP_RETCODE
 hsl_matrix_set(HSLMatrix* hsl_matrix, SleqpMat* matrix);
 
+/**
+ * Updates the values of a matrix previously passed to @ref hsl_matrix_set
+ * having the same sparsity pattern
+ **/
+SLEQP_NODISCARD
+SLEQP_RETCODE
+hsl_matrix_set_values(HSLMatrix* hsl_matrix, SleqpMat* matrix);
+
 SLEQP_NODISCARD
 SLEQP_RETCODE
 hsl_matrix_clear(HSLMatrix* hsl_matrix);
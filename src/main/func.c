@@ -31,9 +31,16 @@ struct SleqpFunc
 
   SleqpTimer* hess_timer;
 
+  SleqpVec* direction;
   SleqpVec* product;
 
   SleqpHessStruct* hess_struct;
+
+  // Largest numbers of nonzeros encountered during evaluations,
+  // used in place of unknown nonzeros
+  int obj_grad_nnz;
+  int cons_val_nnz;
+  int cons_jac_nnz;
 };
 
 SLEQP_RETCODE
@@ -59,6 +66,10 @@ sleqp_func_create(SleqpFunc** fstar,
   func->data            = func_data;
   func->type            = SLEQP_FUNC_TYPE_REGULAR;
 
+  func->obj_grad_nnz = SLEQP_NONE;
+  func->cons_val_nnz = SLEQP_NONE;
+  func->cons_jac_nnz = SLEQP_NONE;
+
   SLEQP_CALL(sleqp_timer_create(&func->set_timer));
   SLEQP_CALL(sleqp_timer_create(&func->val_timer));
   SLEQP_CALL(sleqp_timer_create(&func->grad_timer));
@@ -68,6 +79,7 @@ sleqp_func_create(SleqpFunc** fstar,
 
   SLEQP_CALL(sleqp_timer_create(&func->hess_timer));
 
+  SLEQP_CALL(sleqp_vec_create_empty(&func->direction, num_variables));
   SLEQP_CALL(sleqp_vec_create_empty(&func->product, num_variables));
 
   SLEQP_CALL(
@@ -123,6 +135,21 @@ sleqp_func_nonzeros(SleqpFunc* func,
                     SLEQP_FUNC_ERROR_NONZEROS);
   }
 
+  if (*obj_grad_nnz == SLEQP_NONE)
+  {
+    *obj_grad_nnz = func->obj_grad_nnz;
+  }
+
+  if (*cons_val_nnz == SLEQP_NONE)
+  {
+    *cons_val_nnz = func->cons_val_nnz;
+  }
+
+  if (*cons_jac_nnz == SLEQP_NONE)
+  {
+    *cons_jac_nnz = func->cons_jac_nnz;
+  }
+
   return SLEQP_OKAY;
 }
 
@@ -166,6 +193,8 @@ sleqp_func_obj_grad(SleqpFunc* func, SleqpVec* obj_grad)
 
     sleqp_assert_msg(sleqp_vec_is_finite(obj_grad),
                      "Returned function gradient is not all-finite");
+
+    func->obj_grad_nnz = SLEQP_MAX(func->obj_grad_nnz, obj_grad->nnz);
   }
 
   return SLEQP_OKAY;
@@ -196,6 +225,8 @@ sleqp_func_cons_val(SleqpFunc* func, SleqpVec* cons_val)
 
     sleqp_assert_msg(sleqp_vec_is_finite(cons_val),
                      "Returned constraint values are not all-finite");
+
+    func->cons_val_nnz = SLEQP_MAX(func->cons_val_nnz, cons_val->nnz);
   }
 
   return SLEQP_OKAY;
@@ -226,6 +257,9 @@ sleqp_func_cons_jac(SleqpFunc* func, SleqpMat* cons_jac)
 
     sleqp_assert_msg(sleqp_mat_is_finite(cons_jac),
                      "Returned constraint Jacobian is not all-finite");
+
+    func->cons_jac_nnz
+      = SLEQP_MAX(func->cons_jac_nnz, sleqp_mat_nnz(cons_jac));
   }
 
   return SLEQP_OKAY;
@@ -407,6 +441,111 @@ sleqp_func_hess_prod(SleqpFunc* func,
   return SLEQP_OKAY;
 }
 
+static SLEQP_RETCODE
+func_hess_prods_fallback(SleqpFunc* func,
+                         const SleqpMat* directions,
+                         const SleqpVec* cons_duals,
+                         SleqpMat* products)
+{
+  const int num_cols = sleqp_mat_num_cols(directions);
+
+  for (int col = 0; col < num_cols; ++col)
+  {
+    SLEQP_CALL(sleqp_mat_col(directions, col, func->direction));
+
+    SLEQP_CALL(sleqp_func_hess_prod(func,
+                                    func->direction,
+                                    cons_duals,
+                                    func->product));
+
+    SLEQP_CALL(sleqp_mat_reserve(products,
+                                 sleqp_mat_nnz(products) + func->product->nnz));
+
+    SLEQP_CALL(sleqp_mat_push_col(products, col));
+
+    SLEQP_CALL(sleqp_mat_push_vec(products, col, func->product));
+  }
+
+  return SLEQP_OKAY;
+}
+
+SLEQP_RETCODE
+sleqp_func_hess_prods(SleqpFunc* func,
+                      const SleqpMat* directions,
+                      const SleqpVec* cons_duals,
+                      SleqpMat* products)
+{
+  assert(func->num_variables == sleqp_mat_num_rows(directions));
+  assert(func->num_variables == sleqp_mat_num_rows(products));
+  assert(sleqp_mat_num_cols(directions) == sleqp_mat_num_cols(products));
+  assert(func->num_constraints == cons_duals->dim);
+
+  assert(sleqp_mat_is_valid(directions));
+  assert(sleqp_mat_is_finite(directions));
+
+  assert(sleqp_vec_is_valid(cons_duals));
+  assert(sleqp_vec_is_finite(cons_duals));
+
+  SLEQP_CALL(sleqp_mat_clear(products));
+
+  if (!func->callbacks.hess_prods)
+  {
+    return func_hess_prods_fallback(func, directions, cons_duals, products);
+  }
+
+  SLEQP_CALL(sleqp_timer_start(func->hess_timer));
+
+  SLEQP_FUNC_CALL(
+    func->callbacks
+      .hess_prods(func, directions, cons_duals, products, func->data),
+    sleqp_func_has_flags(func, SLEQP_FUNC_INTERNAL | SLEQP_FUNC_HESS_INTERNAL),
+    SLEQP_FUNC_ERROR_HESS_PROD);
+
+  SLEQP_CALL(sleqp_timer_stop(func->hess_timer));
+
+  sleqp_assert_msg(sleqp_mat_is_valid(products),
+                   "Returned invalid Hessian products");
+
+  sleqp_assert_msg(sleqp_mat_is_finite(products),
+                   "Returned Hessian products are not all-finite");
+
+  return SLEQP_OKAY;
+}
+
+SLEQP_RETCODE
+sleqp_func_clone(SleqpFunc* func, SleqpFunc** star)
+{
+  *star = NULL;
+
+  if (!func->callbacks.clone)
+  {
+    return SLEQP_OKAY;
+  }
+
+  SLEQP_CALL(func->callbacks.clone(func, star, func->data));
+
+  SleqpFunc* clone = *star;
+
+  if (!clone)
+  {
+    return SLEQP_OKAY;
+  }
+
+  sleqp_assert_msg(clone->num_variables == func->num_variables
+                     && clone->num_constraints == func->num_constraints,
+                   "Function copy has inconsistent dimensions");
+
+  clone->flags = func->flags;
+
+  clone->obj_grad_nnz = func->obj_grad_nnz;
+  clone->cons_val_nnz = func->cons_val_nnz;
+  clone->cons_jac_nnz = func->cons_jac_nnz;
+
+  SLEQP_CALL(sleqp_hess_struct_copy(func->hess_struct, clone->hess_struct));
+
+  return SLEQP_OKAY;
+}
+
 SLEQP_RETCODE
 sleqp_func_hess_bilinear(SleqpFunc* func,
                          const SleqpVec* direction,
@@ -454,6 +593,7 @@ func_free(SleqpFunc** fstar)
   SLEQP_CALL(sleqp_timer_free(&func->set_timer));
 
   SLEQP_CALL(sleqp_vec_free(&func->product));
+  SLEQP_CALL(sleqp_vec_free(&func->direction));
 
   SLEQP_CALL(sleqp_hess_struct_release(&func->hess_struct));
 
@@ -65,6 +65,12 @@ sleqp_func_set_value(SleqpFunc* func,
                      SLEQP_VALUE_REASON reason,
                      bool* reject);
 
+/**
+ * Queries the number of nonzeros at the current input vector.
+ * Numbers not provided by the underlying callback are replaced
+ * by the largest ones encountered during previous evaluations,
+ * remaining @ref SLEQP_NONE before the first evaluation
+ **/
 SLEQP_NODISCARD SLEQP_RETCODE
 sleqp_func_nonzeros(SleqpFunc* func,
                     int* obj_grad_nnz,
@@ -206,6 +212,38 @@ sleqp_func_hess_prod(SleqpFunc* func,
                      const SleqpVec* cons_duals,
                      SleqpVec* product);
 
+/**
+ * Evaluates the products of the Hessian of the Lagrangian of the given
+ * function with the columns of the given matrix. Uses the batched callback
+ * if available, computing products column by column otherwise.
+ *
+ * @param[in]     func              The function
+ * @param[in]     directions        The directions \f$ D \f$
+ * @param[in]     cons_duals        The values \f$ \lambda \f$
+ * @param[out]    products          The resulting products
+ *
+ */
+SLEQP_NODISCARD
+SLEQP_RETCODE
+sleqp_func_hess_prods(SleqpFunc* func,
+                      const SleqpMat* directions,
+                      const SleqpVec* cons_duals,
+                      SleqpMat* products);
+
+/**
+ * Creates an independent copy of the given function using its
+ * @ref SLEQP_FUNC_CLONE callback. The copy shares the flags and the
+ * Hessian structure of the original function.
+ *
+ * @param[in]     func              The function
+ * @param[out]    star              The copy, `NULL` if the function
+ *                                  cannot be copied
+ *
+ */
+SLEQP_NODISCARD
+SLEQP_RETCODE
+sleqp_func_clone(SleqpFunc* func, SleqpFunc** star);
+
 /**
  * Evaluates the bilinear product of the Hessian of the Lagrangian of the given
  * function.
@@ -1,6 +1,7 @@
 #include "iterate.h"
 
 #include <math.h>
+#include <stdatomic.h>
 
 #include "cmp.h"
 #include "fail.h"
@@ -12,7 +13,8 @@
 
 struct SleqpIterate
 {
-  int refcount;
+  // Captured concurrently by speculative Cauchy solves
+  atomic_int refcount;
   /**
    * The current point. Has dimension = num_variables.
    **/
@@ -427,44 +429,10 @@ write_stationarity_resiudals_to_cache(SleqpIterate* iterate,
   const SleqpVec* cons_dual = sleqp_iterate_cons_dual(iterate);
   const SleqpVec* vars_dual = sleqp_iterate_vars_dual(iterate);
 
-  const int num_rows = sleqp_mat_num_rows(cons_jac);
-  const int num_cols = sleqp_mat_num_cols(cons_jac);
+  assert(num_variables == sleqp_mat_num_cols(cons_jac));
+  assert(num_constraints == sleqp_mat_num_rows(cons_jac));
 
-  const int* cons_jac_cols    = sleqp_mat_cols(cons_jac);
-  const int* cons_jac_rows    = sleqp_mat_rows(cons_jac);
-  const double* cons_jac_data = sleqp_mat_data(cons_jac);
-
-  assert(num_variables == num_cols);
-  assert(num_constraints == num_rows);
-
-  for (int j = 0; j < num_variables; ++j)
-  {
-    int k_d = 0;
-    int k_j = cons_jac_cols[j];
-
-    double sum = 0.;
-
-    while (k_d < cons_dual->nnz && k_j < cons_jac_cols[j + 1])
-    {
-      const int d_idx = cons_dual->indices[k_d];
-      const int j_idx = cons_jac_rows[k_j];
-
-      if (d_idx < j_idx)
-      {
-        ++k_d;
-      }
-      else if (d_idx > j_idx)
-      {
-        ++k_j;
-      }
-      else
-      {
-        sum += cons_dual->data[k_d++] * cons_jac_data[k_j++];
-      }
-    }
-
-    cache[j] = sum;
-  }
+  SLEQP_CALL(sleqp_mat_mult_vec_trans_dense(cons_jac, cons_dual, cache));
 
   for (int k = 0; k < vars_dual->nnz; ++k)
   {
@@ -592,7 +560,7 @@ sleqp_iterate_reserve(SleqpIterate* iterate, SleqpProblem* problem)
 
   if (cons_jac_nnz == SLEQP_NONE)
   {
-    cons_jac_nnz = num_vars * num_cons;
+    cons_jac_nnz = sleqp_mat_nnz_estimate(num_cons, num_vars);
   }
 
   SLEQP_CALL(sleqp_vec_reserve(sleqp_iterate_obj_grad(iterate), obj_grad_nnz));
@@ -17,22 +17,65 @@ typedef struct BreakPoint
   double point;
 } BreakPoint;
 
-static int
-compare_breakpoints(const void* first, const void* second)
+// Restores the min-heap property of the breakpoints below the given position
+static void
+sift_down_breakpoint(BreakPoint* breakpoints, int num_breakpoints, int pos)
 {
-  const double first_point  = ((const BreakPoint*)first)->point;
-  const double second_point = ((const BreakPoint*)second)->point;
+  const BreakPoint breakpoint = breakpoints[pos];
 
-  if (first_point < second_point)
+  while (true)
   {
-    return -1;
+    int child = 2 * pos + 1;
+
+    if (child >= num_breakpoints)
+    {
+      break;
+    }
+
+    if (child + 1 < num_breakpoints
+        && breakpoints[child + 1].point < breakpoints[child].point)
+    {
+      ++child;
+    }
+
+    if (breakpoint.point <= breakpoints[child].point)
+    {
+      break;
+    }
+
+    breakpoints[pos] = breakpoints[child];
+    pos              = child;
+  }
+
+  breakpoints[pos] = breakpoint;
+}
+
+static void
+heapify_breakpoints(BreakPoint* breakpoints, int num_breakpoints)
+{
+  for (int pos = num_breakpoints / 2 - 1; pos >= 0; --pos)
+  {
+    sift_down_breakpoint(breakpoints, num_breakpoints, pos);
   }
-  else if (first_point > second_point)
+}
+
+// Removes the smallest breakpoint from the heap
+static BreakPoint
+pop_breakpoint(BreakPoint* breakpoints, int* num_breakpoints)
+{
+  assert(*num_breakpoints > 0);
+
+  const BreakPoint first = breakpoints[0];
+
+  --(*num_breakpoints);
+
+  if (*num_breakpoints > 0)
   {
-    return 1;
+    breakpoints[0] = breakpoints[*num_breakpoints];
+    sift_down_breakpoint(breakpoints, *num_breakpoints, 0);
   }
 
-  return 0;
+  return first;
 }
 
 struct SleqpLineSearch
@@ -782,10 +825,8 @@ compute_breakpoints(SleqpLineSearch* linesearch,
   linesearch->breakpoints[linesearch->num_breakpoints++]
     = (BreakPoint){.point = 1., .slope_change = 0.};
 
-  qsort((void*)linesearch->breakpoints,
-        linesearch->num_breakpoints,
-        sizeof(BreakPoint),
-        compare_breakpoints);
+  // Breakpoints are only extracted in order as far as the search proceeds
+  heapify_breakpoints(linesearch->breakpoints, linesearch->num_breakpoints);
 
   return SLEQP_OKAY;
 }
@@ -947,11 +988,12 @@ sleqp_linesearch_trial_step_exact(SleqpLineSearch* linesearch,
   }
 #endif
 
-  for (int k = 0; k < linesearch->num_breakpoints; ++k)
+  while (linesearch->num_breakpoints > 0)
   {
-    const BreakPoint* breakpoint = linesearch->breakpoints + k;
+    const BreakPoint breakpoint
+      = pop_breakpoint(linesearch->breakpoints, &linesearch->num_breakpoints);
 
-    const double current_point = breakpoint->point;
+    const double current_point = breakpoint.point;
     const double point_diff    = current_point - last_point;
 
     assert(last_point <= current_point);
@@ -1008,9 +1050,17 @@ sleqp_linesearch_trial_step_exact(SleqpLineSearch* linesearch,
     }
 
     offset += point_diff * linear_term;
-    linear_term += penalty_parameter * breakpoint->slope_change;
+    linear_term += penalty_parameter * breakpoint.slope_change;
 
     last_point = current_point;
+
+    // Slope changes are non-negative, so a convex merit is non-decreasing
+    // beyond the first point with a non-negative right derivative
+    if (quadratic_term >= 0.
+        && linear_term + quadratic_term * current_point >= 0.)
+    {
+      break;
+    }
   }
 
   SLEQP_CALL(sleqp_direction_add_scaled(cauchy_direction,
@@ -1,7 +1,5 @@
 #include "lpi.h"
 
-#include <string.h>
-
 #include "fail.h"
 #include "log.h"
 #include "mem.h"
@@ -21,6 +19,15 @@ struct SleqpLPi
 
   double time_limit;
 
+  int num_iterations;
+
+  bool has_coeffs;
+
+  int max_changes;
+  int* changed_rows;
+  int* changed_cols;
+  double* changed_values;
+
   // callbacks
   SleqpLPiCallbacks callbacks;
 };
@@ -42,8 +49,8 @@ sleqp_lpi_create(SleqpLPi** lp_star,
 
   lp_interface->refcount = 1;
 
-  lp_interface->name    = strdup(name);
-  lp_interface->version = strdup(version);
+  SLEQP_CALL(sleqp_strdup(&lp_interface->name, name));
+  SLEQP_CALL(sleqp_strdup(&lp_interface->version, version));
 
   SLEQP_CALL(sleqp_timer_create(&lp_interface->timer));
 
@@ -99,6 +106,12 @@ sleqp_lpi_solve(SleqpLPi* lp_interface)
 
   SLEQP_CALL(sleqp_timer_stop(lp_interface->timer));
 
+  if (lp_interface->callbacks.iterations)
+  {
+    lp_interface->num_iterations
+      += lp_interface->callbacks.iterations(lp_interface->lp_data);
+  }
+
   return retcode;
 }
 
@@ -108,6 +121,12 @@ sleqp_lpi_status(SleqpLPi* lp_interface)
   return lp_interface->callbacks.status(lp_interface->lp_data);
 }
 
+int
+sleqp_lpi_iterations(SleqpLPi* lp_interface)
+{
+  return lp_interface->num_iterations;
+}
+
 SLEQP_RETCODE
 sleqp_lpi_set_bounds(SleqpLPi* lp_interface,
                      double* cons_lb,
@@ -124,13 +143,78 @@ sleqp_lpi_set_bounds(SleqpLPi* lp_interface,
                                             vars_ub);
 }
 
+static SLEQP_RETCODE
+reserve_changes(SleqpLPi* lp_interface, int size)
+{
+  if (size <= lp_interface->max_changes)
+  {
+    return SLEQP_OKAY;
+  }
+
+  SLEQP_CALL(sleqp_realloc(&lp_interface->changed_rows, size));
+  SLEQP_CALL(sleqp_realloc(&lp_interface->changed_cols, size));
+  SLEQP_CALL(sleqp_realloc(&lp_interface->changed_values, size));
+
+  lp_interface->max_changes = size;
+
+  return SLEQP_OKAY;
+}
+
 SLEQP_RETCODE
 sleqp_lpi_set_coeffs(SleqpLPi* lp_interface, SleqpMat* coeff_matrix)
 {
-  return lp_interface->callbacks.set_coeffs(lp_interface->lp_data,
-                                            lp_interface->num_variables,
-                                            lp_interface->num_constraints,
-                                            coeff_matrix);
+  SLEQP_CALL(lp_interface->callbacks.set_coeffs(lp_interface->lp_data,
+                                                lp_interface->num_variables,
+                                                lp_interface->num_constraints,
+                                                coeff_matrix));
+
+  lp_interface->has_coeffs = true;
+
+  return SLEQP_OKAY;
+}
+
+SLEQP_RETCODE
+sleqp_lpi_change_coeffs(SleqpLPi* lp_interface,
+                        SleqpMat* coeff_matrix,
+                        int num_cols)
+{
+  assert(num_cols <= sleqp_mat_num_cols(coeff_matrix));
+
+  if (!(lp_interface->callbacks.change_coeffs && lp_interface->has_coeffs))
+  {
+    return sleqp_lpi_set_coeffs(lp_interface, coeff_matrix);
+  }
+
+  const int* cols    = sleqp_mat_cols(coeff_matrix);
+  const int* rows    = sleqp_mat_rows(coeff_matrix);
+  const double* data = sleqp_mat_data(coeff_matrix);
+
+  const int num_changes = cols[num_cols];
+
+  if (num_changes == 0)
+  {
+    return SLEQP_OKAY;
+  }
+
+  SLEQP_CALL(reserve_changes(lp_interface, num_changes));
+
+  for (int col = 0; col < num_cols; ++col)
+  {
+    for (int k = cols[col]; k < cols[col + 1]; ++k)
+    {
+      lp_interface->changed_rows[k]   = rows[k];
+      lp_interface->changed_cols[k]   = col;
+      lp_interface->changed_values[k] = data[k];
+    }
+  }
+
+  return lp_interface->callbacks.change_coeffs(lp_interface->lp_data,
+                                               lp_interface->num_variables,
+                                               lp_interface->num_constraints,
+                                               num_changes,
+                                               lp_interface->changed_rows,
+                                               lp_interface->changed_cols,
+                                               lp_interface->changed_values);
 }
 
 SLEQP_RETCODE
@@ -243,6 +327,10 @@ lpi_free(SleqpLPi** lp_star)
 
   SLEQP_CALL(sleqp_timer_free(&lp_interface->timer));
 
+  sleqp_free(&lp_interface->changed_values);
+  sleqp_free(&lp_interface->changed_cols);
+  sleqp_free(&lp_interface->changed_rows);
+
   sleqp_free(&lp_interface->version);
   sleqp_free(&lp_interface->name);
 
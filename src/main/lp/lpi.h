@@ -49,6 +49,13 @@ SLEQP_NODISCARD
 SLEQP_LP_STATUS
 sleqp_lpi_status(SleqpLPi* lp_interface);
 
+/**
+ * Returns the total number of simplex iterations performed over all solves,
+ * or zero if the LP solver does not report them
+ **/
+int
+sleqp_lpi_iterations(SleqpLPi* lp_interface);
+
 SLEQP_NODISCARD
 SLEQP_RETCODE
 sleqp_lpi_set_bounds(SleqpLPi* lp_interface,
@@ -61,6 +68,23 @@ SLEQP_NODISCARD
 SLEQP_RETCODE
 sleqp_lpi_set_coeffs(SleqpLPi* lp_interface, SleqpMat* coeff_matrix);
 
+/**
+ * Changes the values of the leading columns of the coefficient matrix.
+ * The sparsity pattern of the matrix must equal the one last passed to
+ * @ref sleqp_lpi_set_coeffs, and the remaining columns must be unchanged.
+ * Falls back to setting all coefficients if the LP solver does not
+ * support incremental updates.
+ *
+ * @param[in] lp_interface   The LP interface
+ * @param[in] coeff_matrix   The coefficient matrix
+ * @param[in] num_cols       The number of leading columns with changed values
+ **/
+SLEQP_NODISCARD
+SLEQP_RETCODE
+sleqp_lpi_change_coeffs(SleqpLPi* lp_interface,
+                        SleqpMat* coeff_matrix,
+                        int num_cols);
+
 SLEQP_NODISCARD
 SLEQP_RETCODE
 sleqp_lpi_set_objective(SleqpLPi* lp_interface, double* objective);
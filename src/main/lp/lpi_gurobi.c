@@ -220,6 +220,21 @@ gurobi_status(void* lp_data)
   return lp_interface->status;
 }
 
+static int
+gurobi_iterations(void* lp_data)
+{
+  SleqpLpiGRB* lp_interface = lp_data;
+
+  double iterations = 0.;
+
+  if (GRBgetdblattr(lp_interface->model, GRB_DBL_ATTR_ITERCOUNT, &iterations))
+  {
+    return 0;
+  }
+
+  return (int)iterations;
+}
+
 static SLEQP_RETCODE
 gurobi_set_bounds(void* lp_data,
                   int num_cols,
@@ -285,6 +300,30 @@ gurobi_set_coefficients(void* lp_data,
   return SLEQP_OKAY;
 }
 
+static SLEQP_RETCODE
+gurobi_change_coefficients(void* lp_data,
+                           int num_cols,
+                           int num_rows,
+                           int num_changes,
+                           const int* rows,
+                           const int* cols,
+                           const double* values)
+{
+  SleqpLpiGRB* lp_interface = lp_data;
+
+  GRBenv* env     = lp_interface->env;
+  GRBmodel* model = lp_interface->model;
+
+  SLEQP_GRB_CALL(GRBchgcoeffs(model,
+                              num_changes,
+                              (int*)rows,
+                              (int*)cols,
+                              (double*)values),
+                 env);
+
+  return SLEQP_OKAY;
+}
+
 static SLEQP_RETCODE
 gurobi_set_objective(void* lp_data,
                      int num_cols,
@@ -690,8 +729,10 @@ sleqp_lpi_gurobi_create(SleqpLPi** lp_star,
   SleqpLPiCallbacks callbacks = {.create_problem = gurobi_create_problem,
                                  .solve          = gurobi_solve,
                                  .status         = gurobi_status,
+                                 .iterations     = gurobi_iterations,
                                  .set_bounds     = gurobi_set_bounds,
                                  .set_coeffs     = gurobi_set_coefficients,
+                                 .change_coeffs  = gurobi_change_coefficients,
                                  .set_obj        = gurobi_set_objective,
                                  .set_basis      = gurobi_set_basis,
                                  .save_basis     = gurobi_save_basis,
@@ -302,6 +302,24 @@ highs_status(void* lp_data)
   return lp_interface->status;
 }
 
+static int
+highs_iterations(void* lp_data)
+{
+  SleqpLpiHIGHS* lp_interface = (SleqpLpiHIGHS*)lp_data;
+
+  int iterations = 0;
+
+  if (Highs_getIntInfoValue(lp_interface->highs,
+                            "simplex_iteration_count",
+                            &iterations)
+      != kHighsStatusOk)
+  {
+    return 0;
+  }
+
+  return iterations;
+}
+
 static double
 adjust_neg_inf(double value)
 {
@@ -383,6 +401,30 @@ highs_set_coeffs(void* lp_data,
   return SLEQP_OKAY;
 }
 
+static SLEQP_RETCODE
+highs_change_coeffs(void* lp_data,
+                    int num_cols,
+                    int num_rows,
+                    int num_changes,
+                    const int* rows,
+                    const int* cols,
+                    const double* values)
+{
+  SleqpLpiHIGHS* lp_interface = (SleqpLpiHIGHS*)lp_data;
+  void* highs                 = lp_interface->highs;
+
+  // coeffs must have been passed before
+  assert(!(lp_interface->dirty & COEFFS));
+
+  for (int k = 0; k < num_changes; ++k)
+  {
+    SLEQP_HIGHS_CALL(Highs_changeCoeff(highs, rows[k], cols[k], values[k]),
+                     highs);
+  }
+
+  return SLEQP_OKAY;
+}
+
 static SLEQP_RETCODE
 highs_set_objective(void* lp_data,
                     int num_cols,
@@ -709,8 +751,10 @@ sleqp_lpi_highs_create(SleqpLPi** lp_star,
   SleqpLPiCallbacks callbacks = {.create_problem = highs_create_problem,
                                  .solve          = highs_solve,
                                  .status         = highs_status,
+                                 .iterations     = highs_iterations,
                                  .set_bounds     = highs_set_bounds,
                                  .set_coeffs     = highs_set_coeffs,
+                                 .change_coeffs  = highs_change_coeffs,
                                  .set_obj        = highs_set_objective,
                                  .set_basis      = highs_set_basis,
                                  .save_basis     = highs_save_basis,
@@ -282,6 +282,15 @@ soplex_status(void* lp_data)
   return spx->status;
 }
 
+static int
+soplex_iterations(void* lp_data)
+{
+  SleqpLpiSoplex* spx    = (SleqpLpiSoplex*)lp_data;
+  soplex::SoPlex& soplex = *(spx->soplex);
+
+  return soplex.numIterations();
+}
+
 static SLEQP_RETCODE
 soplex_set_bounds(void* lp_data,
                   int num_cols,
@@ -357,6 +366,32 @@ soplex_set_coefficients(void* lp_data,
   return SLEQP_OKAY;
 }
 
+static SLEQP_RETCODE
+soplex_change_coefficients(void* lp_data,
+                           int num_cols,
+                           int num_rows,
+                           int num_changes,
+                           const int* rows,
+                           const int* cols,
+                           const double* values)
+{
+  SleqpLpiSoplex* spx    = (SleqpLpiSoplex*)lp_data;
+  soplex::SoPlex& soplex = *(spx->soplex);
+
+  // Note: We save / restore the basis in order to
+  //       warm-start the iteration.
+  soplex.getBasis(spx->current_basis.basis_rows, spx->current_basis.basis_cols);
+
+  for (int k = 0; k < num_changes; ++k)
+  {
+    soplex.changeElementReal(rows[k], cols[k], values[k]);
+  }
+
+  soplex.setBasis(spx->current_basis.basis_rows, spx->current_basis.basis_cols);
+
+  return SLEQP_OKAY;
+}
+
 static SLEQP_RETCODE
 soplex_set_objective(void* lp_data,
                      int num_cols,
@@ -636,8 +671,10 @@ extern "C"
     SleqpLPiCallbacks callbacks = {.create_problem = soplex_create_problem,
                                    .solve          = soplex_solve,
                                    .status         = soplex_status,
+                                   .iterations     = soplex_iterations,
                                    .set_bounds     = soplex_set_bounds,
                                    .set_coeffs     = soplex_set_coefficients,
+                                   .change_coeffs  = soplex_change_coefficients,
                                    .set_obj        = soplex_set_objective,
                                    .set_basis      = soplex_set_basis,
                                    .save_basis     = soplex_save_basis,
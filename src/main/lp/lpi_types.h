@@ -42,6 +42,11 @@ typedef SLEQP_RETCODE (*SLEQP_LPI_SOLVE)(void* lp_data,
 
 typedef SLEQP_LP_STATUS (*SLEQP_LPI_STATUS)(void* lp_data);
 
+/**
+ * Returns the number of simplex iterations performed during the last solve
+ **/
+typedef int (*SLEQP_LPI_ITERATIONS)(void* lp_data);
+
 typedef SLEQP_RETCODE (*SLEQP_LPI_SET_BOUNDS)(void* lp_data,
                                               int num_variables,
                                               int num_constraints,
@@ -55,6 +60,19 @@ typedef SLEQP_RETCODE (*SLEQP_LPI_SET_COEFFS)(void* lp_data,
                                               int num_constraints,
                                               SleqpMat* cons_matrix);
 
+/**
+ * Changes the values of existing entries of the coefficient matrix,
+ * whose sparsity pattern remains the same otherwise. The changes
+ * are given in coordinate format.
+ **/
+typedef SLEQP_RETCODE (*SLEQP_LPI_CHANGE_COEFFS)(void* lp_data,
+                                                 int num_variables,
+                                                 int num_constraints,
+                                                 int num_changes,
+                                                 const int* rows,
+                                                 const int* cols,
+                                                 const double* values);
+
 typedef SLEQP_RETCODE (*SLEQP_LPI_SET_OBJ)(void* lp_data,
                                            int num_variables,
                                            int num_constraints,
@@ -104,8 +122,10 @@ typedef struct
   SLEQP_LPI_CREATE create_problem;
   SLEQP_LPI_SOLVE solve;
   SLEQP_LPI_STATUS status;
+  SLEQP_LPI_ITERATIONS iterations; /**< optional **/
   SLEQP_LPI_SET_BOUNDS set_bounds;
   SLEQP_LPI_SET_COEFFS set_coeffs;
+  SLEQP_LPI_CHANGE_COEFFS change_coeffs; /**< optional **/
   SLEQP_LPI_SET_OBJ set_obj;
   SLEQP_LPI_SET_BASIS set_basis;
   SLEQP_LPI_SAVE_BASIS save_basis;
@@ -0,0 +1,260 @@
+#include "mem.h"
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "cmp.h"
+#include "fail.h"
+#include "log.h"
+
+struct SleqpAllocator
+{
+  // Counts references as well as blocks not yet returned
+  atomic_int refcount;
+
+  SleqpAllocatorCallbacks callbacks;
+  void* allocator_data;
+};
+
+// Precedes every block, retaining the alignment guarantees of malloc
+typedef struct
+{
+  _Alignas(max_align_t) SleqpAllocator* allocator;
+  size_t size;
+} BlockHeader;
+
+static _Thread_local SleqpAllocator* active_allocator = NULL;
+
+SLEQP_RETCODE
+sleqp_allocator_create(SleqpAllocator** star,
+                       SleqpAllocatorCallbacks* callbacks,
+                       void* allocator_data)
+{
+  assert(callbacks->allocate);
+  assert(callbacks->deallocate);
+
+  SLEQP_CALL(sleqp_malloc(star));
+
+  SleqpAllocator* allocator = *star;
+
+  atomic_init(&allocator->refcount, 1);
+
+  allocator->callbacks      = *callbacks;
+  allocator->allocator_data = allocator_data;
+
+  return SLEQP_OKAY;
+}
+
+SleqpAllocator*
+sleqp_allocator_active()
+{
+  return active_allocator;
+}
+
+SleqpAllocator*
+sleqp_allocator_set_active(SleqpAllocator* allocator)
+{
+  SleqpAllocator* previous = active_allocator;
+
+  active_allocator = allocator;
+
+  return previous;
+}
+
+static void*
+raw_allocate(SleqpAllocator* allocator, size_t size)
+{
+  if (!allocator)
+  {
+    return malloc(size);
+  }
+
+  return allocator->callbacks.allocate(size, allocator->allocator_data);
+}
+
+static void
+raw_deallocate(SleqpAllocator* allocator, void* ptr, size_t size)
+{
+  if (!allocator)
+  {
+    free(ptr);
+    return;
+  }
+
+  allocator->callbacks.deallocate(ptr, size, allocator->allocator_data);
+}
+
+static SLEQP_RETCODE
+allocator_free(SleqpAllocator** star)
+{
+  SleqpAllocator* allocator = *star;
+
+  if (allocator->callbacks.free)
+  {
+    SLEQP_CALL(allocator->callbacks.free(allocator->allocator_data));
+  }
+
+  sleqp_free(star);
+
+  return SLEQP_OKAY;
+}
+
+SLEQP_RETCODE
+sleqp_allocator_capture(SleqpAllocator* allocator)
+{
+  atomic_fetch_add(&allocator->refcount, 1);
+
+  return SLEQP_OKAY;
+}
+
+SLEQP_RETCODE
+sleqp_allocator_release(SleqpAllocator** star)
+{
+  SleqpAllocator* allocator = *star;
+
+  if (!allocator)
+  {
+    return SLEQP_OKAY;
+  }
+
+  if (atomic_fetch_sub(&allocator->refcount, 1) == 1)
+  {
+    SLEQP_CALL(allocator_free(star));
+  }
+
+  *star = NULL;
+
+  return SLEQP_OKAY;
+}
+
+void*
+sleqp_allocator_allocate(SleqpAllocator* allocator, size_t size)
+{
+  if (size == 0 || size > SIZE_MAX - sizeof(BlockHeader))
+  {
+    return NULL;
+  }
+
+  BlockHeader* header = raw_allocate(allocator, sizeof(BlockHeader) + size);
+
+  if (!header)
+  {
+    return NULL;
+  }
+
+  if (allocator)
+  {
+    atomic_fetch_add(&allocator->refcount, 1);
+  }
+
+  *header = (BlockHeader){.allocator = allocator, .size = size};
+
+  return header + 1;
+}
+
+size_t
+sleqp_mem_block_overhead()
+{
+  return sizeof(BlockHeader);
+}
+
+void*
+sleqp_mem_allocate(size_t size)
+{
+  return sleqp_allocator_allocate(active_allocator, size);
+}
+
+void*
+sleqp_mem_reallocate(void* ptr, size_t size)
+{
+  if (!ptr)
+  {
+    return sleqp_mem_allocate(size);
+  }
+
+  if (size == 0)
+  {
+    sleqp_mem_deallocate(ptr);
+    return NULL;
+  }
+
+  BlockHeader* header       = ((BlockHeader*)ptr) - 1;
+  SleqpAllocator* allocator = header->allocator;
+  const size_t block_size   = header->size;
+
+  const bool in_place
+    = (allocator == active_allocator)
+      && (!allocator || allocator->callbacks.reallocate)
+      && (size <= SIZE_MAX - sizeof(BlockHeader));
+
+  if (in_place)
+  {
+    const size_t raw_size     = sizeof(BlockHeader) + block_size;
+    const size_t new_raw_size = sizeof(BlockHeader) + size;
+
+    BlockHeader* resized
+      = allocator ? allocator->callbacks.reallocate(header,
+                                                    raw_size,
+                                                    new_raw_size,
+                                                    allocator->allocator_data)
+                  : realloc(header, new_raw_size);
+
+    if (!resized)
+    {
+      return NULL;
+    }
+
+    resized->size = size;
+
+    return resized + 1;
+  }
+
+  // Move the block to the active allocator
+  void* resized = sleqp_mem_allocate(size);
+
+  if (!resized)
+  {
+    return NULL;
+  }
+
+  memcpy(resized, ptr, SLEQP_MIN(block_size, size));
+
+  sleqp_mem_deallocate(ptr);
+
+  return resized;
+}
+
+void
+sleqp_mem_deallocate(void* ptr)
+{
+  if (!ptr)
+  {
+    return;
+  }
+
+  BlockHeader* header       = ((BlockHeader*)ptr) - 1;
+  SleqpAllocator* allocator = header->allocator;
+
+  raw_deallocate(allocator, header, sizeof(BlockHeader) + header->size);
+
+  if (allocator && atomic_fetch_sub(&allocator->refcount, 1) == 1)
+  {
+    if (allocator_free(&allocator) != SLEQP_OKAY)
+    {
+      sleqp_log_error("Failed to free allocator");
+    }
+  }
+}
+
+SLEQP_RETCODE
+sleqp_strdup(char** star, const char* string)
+{
+  const size_t size = strlen(string) + 1;
+
+  SLEQP_CALL(sleqp_alloc_array(star, size));
+
+  memcpy(*star, string, size);
+
+  return SLEQP_OKAY;
+}
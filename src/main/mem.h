@@ -1 +1,24 @@
+#ifndef SLEQP_MEM_H
+#define SLEQP_MEM_H
+
 #include "pub_mem.h"
+
+/**
+ * Allocates a block of the given size from the given allocator
+ * rather than the active one
+ *
+ * @param[in]  allocator       The allocator, or `NULL` to use the C
+ *                             library functions
+ * @param[in]  size            The size of the block in bytes
+ **/
+void*
+sleqp_allocator_allocate(SleqpAllocator* allocator, size_t size);
+
+/**
+ * Returns the number of bytes by which the sizes passed to the callbacks
+ * of an allocator exceed the sizes of the requested blocks
+ **/
+size_t
+sleqp_mem_block_overhead();
+
+#endif /* SLEQP_MEM_H */
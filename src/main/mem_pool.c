@@ -0,0 +1,193 @@
+#include "mem_pool.h"
+
+#include <limits.h>
+#include <pthread.h>
+#include <string.h>
+
+#include "cmp.h"
+#include "fail.h"
+
+// The smallest class holds blocks of 32 bytes
+#define MIN_CLASS 5
+#define NUM_CLASSES ((int)(sizeof(size_t) * CHAR_BIT))
+
+typedef struct PoolBlock
+{
+  struct PoolBlock* next;
+} PoolBlock;
+
+typedef struct
+{
+  SleqpAllocator* upstream;
+
+  pthread_mutex_t lock;
+
+  PoolBlock* free_blocks[NUM_CLASSES];
+} MemPool;
+
+// Blocks of a class hold a power-of-two number of bytes in addition to
+// the headers preceding them, which would otherwise double the size of
+// power-of-two arrays
+static size_t
+class_size(int block_class)
+{
+  return sleqp_mem_block_overhead() + ((size_t)1 << block_class);
+}
+
+// Returns the class of blocks of at least the given size, or -1
+static int
+size_class(size_t size)
+{
+  const size_t overhead = sleqp_mem_block_overhead();
+
+  const size_t block_size = (size > overhead) ? (size - overhead) : 0;
+
+  if (block_size > ((size_t)1 << (NUM_CLASSES - 1)))
+  {
+    return -1;
+  }
+
+  int block_class = MIN_CLASS;
+
+  while (((size_t)1 << block_class) < block_size)
+  {
+    ++block_class;
+  }
+
+  return block_class;
+}
+
+static void*
+pool_allocate(size_t size, void* allocator_data)
+{
+  MemPool* pool = (MemPool*)allocator_data;
+
+  const int block_class = size_class(size);
+
+  if (block_class == -1)
+  {
+    return NULL;
+  }
+
+  pthread_mutex_lock(&pool->lock);
+
+  PoolBlock* block = pool->free_blocks[block_class];
+
+  if (block)
+  {
+    pool->free_blocks[block_class] = block->next;
+  }
+
+  pthread_mutex_unlock(&pool->lock);
+
+  if (block)
+  {
+    return block;
+  }
+
+  return sleqp_allocator_allocate(pool->upstream, class_size(block_class));
+}
+
+static void
+pool_deallocate(void* ptr, size_t size, void* allocator_data)
+{
+  MemPool* pool = (MemPool*)allocator_data;
+
+  const int block_class = size_class(size);
+
+  PoolBlock* block = (PoolBlock*)ptr;
+
+  pthread_mutex_lock(&pool->lock);
+
+  block->next                    = pool->free_blocks[block_class];
+  pool->free_blocks[block_class] = block;
+
+  pthread_mutex_unlock(&pool->lock);
+}
+
+static void*
+pool_reallocate(void* ptr, size_t size, size_t new_size, void* allocator_data)
+{
+  const int new_class = size_class(new_size);
+
+  if (new_class == -1)
+  {
+    return NULL;
+  }
+
+  // Blocks only remain in place within their class, so that they are
+  // returned to the class they were taken from based on the new size
+  if (new_class == size_class(size))
+  {
+    return ptr;
+  }
+
+  void* resized = pool_allocate(new_size, allocator_data);
+
+  if (!resized)
+  {
+    return NULL;
+  }
+
+  memcpy(resized, ptr, SLEQP_MIN(size, new_size));
+
+  pool_deallocate(ptr, size, allocator_data);
+
+  return resized;
+}
+
+static SLEQP_RETCODE
+pool_free(void* allocator_data)
+{
+  MemPool* pool = (MemPool*)allocator_data;
+
+  for (int block_class = 0; block_class < NUM_CLASSES; ++block_class)
+  {
+    PoolBlock* block = pool->free_blocks[block_class];
+
+    while (block)
+    {
+      PoolBlock* next = block->next;
+
+      sleqp_mem_deallocate(block);
+
+      block = next;
+    }
+  }
+
+  pthread_mutex_destroy(&pool->lock);
+
+  SLEQP_CALL(sleqp_allocator_release(&pool->upstream));
+
+  sleqp_free(&pool);
+
+  return SLEQP_OKAY;
+}
+
+SLEQP_RETCODE
+sleqp_mem_pool_create(SleqpAllocator** star)
+{
+  MemPool* pool;
+
+  SLEQP_CALL(sleqp_malloc(&pool));
+
+  *pool = (MemPool){0};
+
+  pool->upstream = sleqp_allocator_active();
+
+  if (pool->upstream)
+  {
+    SLEQP_CALL(sleqp_allocator_capture(pool->upstream));
+  }
+
+  pthread_mutex_init(&pool->lock, NULL);
+
+  SleqpAllocatorCallbacks callbacks = {.allocate   = pool_allocate,
+                                       .reallocate = pool_reallocate,
+                                       .deallocate = pool_deallocate,
+                                       .free       = pool_free};
+
+  SLEQP_CALL(sleqp_allocator_create(star, &callbacks, pool));
+
+  return SLEQP_OKAY;
+}
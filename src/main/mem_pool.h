@@ -0,0 +1,28 @@
+#ifndef SLEQP_MEM_POOL_H
+#define SLEQP_MEM_POOL_H
+
+/**
+ * @file mem_pool.h
+ * @brief Definition of a pooling allocator.
+ *
+ * The pool serves blocks from free lists of size classes, each holding
+ * a power-of-two number of bytes in addition to the block headers.
+ * Returned blocks are kept for reuse rather than handed back, so that the
+ * memory of the pool stays at its high-water mark and recurring allocations
+ * are served without reaching the underlying allocator, which is the one
+ * active when the pool is created. The retained blocks are handed back once
+ * the pool has been released and all of its blocks have been returned.
+ **/
+
+#include "mem.h"
+
+/**
+ * Creates a new pool on top of the active allocator
+ *
+ * @param[out] star            The pool
+ **/
+SLEQP_NODISCARD
+SLEQP_RETCODE
+sleqp_mem_pool_create(SleqpAllocator** star);
+
+#endif /* SLEQP_MEM_POOL_H */
@@ -9,6 +9,9 @@
 #include "log.h"
 #include "mem.h"
 #include "sparse/pub_vec.h"
+#include "thread_pool.h"
+
+#include "cauchy/standard_cauchy.h"
 
 struct SleqpParametricSolver
 {
@@ -31,8 +34,30 @@ struct SleqpParametricSolver
   int max_num_resolves;
 
   double penalty_parameter;
+
+  double time_limit;
+
+  bool speculative;
+
+  // Cauchy solvers used to solve the LPs for several
+  // trust radii in parallel, created on demand
+  SleqpCauchy** candidates;
+  int num_candidates;
+
+  // Whether the candidates hold the current iterate, which
+  // is only set once a speculative batch is launched
+  bool* has_candidate_iterate;
+
+  // Trust radii of the current batch of LPs
+  double* batch_radii;
 };
 
+typedef struct
+{
+  SleqpParametricSolver* solver;
+  SleqpIterate* iterate;
+} CandidateSolve;
+
 SLEQP_RETCODE
 sleqp_parametric_solver_create(SleqpParametricSolver** star,
                                SleqpProblem* problem,
@@ -87,6 +112,38 @@ sleqp_parametric_solver_create(SleqpParametricSolver** star,
     solver->max_num_resolves      = 10;
   }
 
+  solver->time_limit = SLEQP_NONE;
+
+  // The LP-based Cauchy solver is only used in the presence of constraints
+  const bool speculative = sleqp_settings_bool_value(
+    settings,
+    SLEQP_SETTINGS_BOOL_SPECULATIVE_PARAMETRIC_CAUCHY);
+
+  solver->speculative = speculative && (num_constraints > 0);
+
+  solver->num_candidates = 0;
+
+  SLEQP_CALL(sleqp_alloc_array(&solver->candidates, solver->max_num_resolves));
+
+  SLEQP_CALL(sleqp_alloc_array(&solver->has_candidate_iterate,
+                               solver->max_num_resolves));
+
+  for (int k = 0; k < solver->max_num_resolves; ++k)
+  {
+    solver->candidates[k]            = NULL;
+    solver->has_candidate_iterate[k] = false;
+  }
+
+  SLEQP_CALL(sleqp_alloc_array(&solver->batch_radii, solver->max_num_resolves));
+
+  return SLEQP_OKAY;
+}
+
+SLEQP_RETCODE
+sleqp_parametric_solver_set_time_limit(SleqpParametricSolver* solver,
+                                       double time_limit)
+{
+  solver->time_limit = time_limit;
   return SLEQP_OKAY;
 }
 
@@ -149,6 +206,171 @@ has_sufficient_decrease(SleqpParametricSolver* solver,
   return SLEQP_OKAY;
 }
 
+// Sets up the candidates if the LPs are to be solved speculatively
+// using the active pool. The current iterate is only passed on to
+// the candidates once a batch is actually launched
+static SLEQP_RETCODE
+prepare_candidates(SleqpParametricSolver* solver)
+{
+  solver->num_candidates = 0;
+
+  if (!solver->speculative)
+  {
+    return SLEQP_OKAY;
+  }
+
+  const int num_candidates = SLEQP_MIN(sleqp_thread_pool_active_threads(),
+                                       solver->max_num_resolves);
+
+  if (num_candidates <= 1)
+  {
+    return SLEQP_OKAY;
+  }
+
+  for (int k = 0; k < num_candidates; ++k)
+  {
+    SleqpCauchy** candidate = solver->candidates + k;
+
+    if (!(*candidate))
+    {
+      SLEQP_CALL(sleqp_standard_cauchy_create(candidate,
+                                              solver->problem,
+                                              solver->settings));
+    }
+
+    solver->has_candidate_iterate[k] = false;
+  }
+
+  solver->num_candidates = num_candidates;
+
+  return SLEQP_OKAY;
+}
+
+static int
+batch_size(SleqpParametricSolver* solver)
+{
+  return SLEQP_MAX(solver->num_candidates, 1);
+}
+
+// Returns the Cauchy solver holding the LP solution
+// for the given radius of the current batch
+static SleqpCauchy*
+batch_cauchy(SleqpParametricSolver* solver, SleqpCauchy* cauchy_data, int k)
+{
+  return (solver->num_candidates > 0) ? solver->candidates[k] : cauchy_data;
+}
+
+static SLEQP_RETCODE
+solve_candidate_task(int task, void* data)
+{
+  CandidateSolve* candidate_solve = (CandidateSolve*)data;
+  SleqpParametricSolver* solver   = candidate_solve->solver;
+
+  SleqpIterate* iterate  = candidate_solve->iterate;
+  SleqpCauchy* candidate = solver->candidates[task];
+
+  const double trust_radius = solver->batch_radii[task];
+
+  if (!solver->has_candidate_iterate[task])
+  {
+    SLEQP_CALL(sleqp_cauchy_set_iterate(candidate, iterate, trust_radius));
+
+    SLEQP_CALL(sleqp_cauchy_set_time_limit(candidate, solver->time_limit));
+
+    solver->has_candidate_iterate[task] = true;
+  }
+  else
+  {
+    SLEQP_CALL(sleqp_cauchy_set_trust_radius(candidate, trust_radius));
+  }
+
+  SLEQP_CALL(sleqp_cauchy_solve(candidate,
+                                sleqp_iterate_obj_grad(iterate),
+                                solver->penalty_parameter,
+                                SLEQP_CAUCHY_OBJTYPE_DEFAULT));
+
+  return SLEQP_OKAY;
+}
+
+// Solves the LPs for the first trust radii of the batch. Speculative
+// solves are warm-started from the basis of the given Cauchy solver
+static SLEQP_RETCODE
+solve_batch(SleqpParametricSolver* solver,
+            SleqpIterate* iterate,
+            SleqpCauchy* cauchy_data,
+            int num_radii)
+{
+  assert(num_radii <= batch_size(solver));
+
+  if (solver->num_candidates == 0)
+  {
+    SLEQP_CALL(
+      sleqp_cauchy_set_trust_radius(cauchy_data, solver->batch_radii[0]));
+
+    SLEQP_CALL(sleqp_cauchy_solve(cauchy_data,
+                                  sleqp_iterate_obj_grad(iterate),
+                                  solver->penalty_parameter,
+                                  SLEQP_CAUCHY_OBJTYPE_DEFAULT));
+
+    return SLEQP_OKAY;
+  }
+
+  // The basis is only restored when solving, after the candidates
+  // have taken on the current iterate within their tasks
+  for (int k = 0; k < num_radii; ++k)
+  {
+    SLEQP_CALL(sleqp_cauchy_copy_basis(cauchy_data, solver->candidates[k]));
+  }
+
+  CandidateSolve candidate_solve = {.solver = solver, .iterate = iterate};
+
+  SLEQP_CALL(sleqp_thread_pool_run(sleqp_thread_pool_active(),
+                                   num_radii,
+                                   solve_candidate_task,
+                                   (void*)&candidate_solve));
+
+  return SLEQP_OKAY;
+}
+
+// Brings the Cauchy solver into the state of the given LP of the batch.
+// Since the solve starts from an optimal basis, it does not require pivots
+static SLEQP_RETCODE
+select_from_batch(SleqpParametricSolver* solver,
+                  SleqpIterate* iterate,
+                  SleqpCauchy* cauchy_data,
+                  int k)
+{
+  if (solver->num_candidates == 0)
+  {
+    return SLEQP_OKAY;
+  }
+
+  SLEQP_CALL(sleqp_cauchy_copy_basis(solver->candidates[k], cauchy_data));
+
+  SLEQP_CALL(
+    sleqp_cauchy_set_trust_radius(cauchy_data, solver->batch_radii[k]));
+
+  SLEQP_CALL(sleqp_cauchy_solve(cauchy_data,
+                                sleqp_iterate_obj_grad(iterate),
+                                solver->penalty_parameter,
+                                SLEQP_CAUCHY_OBJTYPE_DEFAULT));
+
+  return SLEQP_OKAY;
+}
+
+static void
+fill_batch_radii(SleqpParametricSolver* solver,
+                 double trust_radius,
+                 double factor,
+                 int num_radii)
+{
+  for (int k = 0; k < num_radii; ++k)
+  {
+    solver->batch_radii[k] = trust_radius;
+    trust_radius *= factor;
+  }
+}
+
 SLEQP_RETCODE
 search_forward(SleqpParametricSolver* solver,
                SleqpIterate* iterate,
@@ -171,73 +393,92 @@ search_forward(SleqpParametricSolver* solver,
 
   SLEQP_CALL(sleqp_direction_copy(cauchy_direction, solver->last_direction));
 
-  for (int i = 0; i < solver->max_num_resolves; ++i)
+  for (int i = 0; i < solver->max_num_resolves;)
   {
-    sleqp_log_debug("Resolving with radius %.14e", *trust_radius);
-
-    SLEQP_CALL(sleqp_cauchy_set_trust_radius(cauchy_data, (*trust_radius)));
+    const int num_radii
+      = SLEQP_MIN(batch_size(solver), solver->max_num_resolves - i);
 
-    SLEQP_CALL(sleqp_cauchy_solve(cauchy_data,
-                                  sleqp_iterate_obj_grad(iterate),
-                                  penalty_parameter,
-                                  SLEQP_CAUCHY_OBJTYPE_DEFAULT));
+    fill_batch_radii(solver,
+                     *trust_radius,
+                     solver->trust_radius_increase,
+                     num_radii);
 
-    SLEQP_CALL(sleqp_cauchy_lp_step(cauchy_data, direction_primal));
+    SLEQP_CALL(solve_batch(solver, iterate, cauchy_data, num_radii));
 
+    for (int k = 0; k < num_radii; ++k, ++i)
     {
-      *quadratic_merit = 0.;
+      sleqp_log_debug("Resolving with radius %.14e", *trust_radius);
 
-      SLEQP_CALL(sleqp_merit_linear(solver->merit,
-                                    iterate,
-                                    cauchy_direction,
-                                    penalty_parameter,
-                                    quadratic_merit));
+      SLEQP_CALL(sleqp_cauchy_lp_step(batch_cauchy(solver, cauchy_data, k),
+                                      direction_primal));
 
-      SLEQP_CALL(sleqp_problem_hess_prod(problem,
-                                         direction_primal,
-                                         multipliers,
-                                         direction_hess));
+      {
+        *quadratic_merit = 0.;
 
-      double hessian_dot;
+        SLEQP_CALL(sleqp_merit_linear(solver->merit,
+                                      iterate,
+                                      cauchy_direction,
+                                      penalty_parameter,
+                                      quadratic_merit));
 
-      SLEQP_CALL(sleqp_vec_dot(direction_primal, direction_hess, &hessian_dot));
+        SLEQP_CALL(sleqp_problem_hess_prod(problem,
+                                           direction_primal,
+                                           multipliers,
+                                           direction_hess));
 
-      *quadratic_merit += .5 * hessian_dot;
-    }
+        double hessian_dot;
 
-    if (sleqp_is_lt(*quadratic_merit, last_quadratic_merit, eps))
-    {
-      (*trust_radius) *= solver->trust_radius_increase;
-    }
-    else
-    {
-      // track back...
-      (*trust_radius) /= solver->trust_radius_increase;
+        SLEQP_CALL(
+          sleqp_vec_dot(direction_primal, direction_hess, &hessian_dot));
 
-      *quadratic_merit = last_quadratic_merit;
+        *quadratic_merit += .5 * hessian_dot;
+      }
 
-      sleqp_log_debug(
-        "Accepting trust radius of %.14e with a quadratic merit of %.14e",
-        *trust_radius,
-        last_quadratic_merit);
+      if (sleqp_is_lt(*quadratic_merit, last_quadratic_merit, eps))
+      {
+        (*trust_radius) *= solver->trust_radius_increase;
+      }
+      else
+      {
+        // track back...
+        (*trust_radius) /= solver->trust_radius_increase;
 
-      SLEQP_CALL(sleqp_cauchy_set_trust_radius(cauchy_data, (*trust_radius)));
+        *quadratic_merit = last_quadratic_merit;
 
-      // TODO: Do we need to resolve?
-      SLEQP_CALL(sleqp_cauchy_solve(cauchy_data,
-                                    sleqp_iterate_obj_grad(iterate),
-                                    penalty_parameter,
-                                    SLEQP_CAUCHY_OBJTYPE_DEFAULT));
+        sleqp_log_debug(
+          "Accepting trust radius of %.14e with a quadratic merit of %.14e",
+          *trust_radius,
+          last_quadratic_merit);
 
-      SLEQP_CALL(
-        sleqp_direction_copy(solver->last_direction, cauchy_direction));
+        if (k == 0)
+        {
+          SLEQP_CALL(
+            sleqp_cauchy_set_trust_radius(cauchy_data, (*trust_radius)));
 
-      break;
-    }
+          // TODO: Do we need to resolve?
+          SLEQP_CALL(sleqp_cauchy_solve(cauchy_data,
+                                        sleqp_iterate_obj_grad(iterate),
+                                        penalty_parameter,
+                                        SLEQP_CAUCHY_OBJTYPE_DEFAULT));
+        }
+        else
+        {
+          SLEQP_CALL(select_from_batch(solver, iterate, cauchy_data, k - 1));
+        }
+
+        SLEQP_CALL(
+          sleqp_direction_copy(solver->last_direction, cauchy_direction));
+
+        return SLEQP_OKAY;
+      }
+
+      last_quadratic_merit = *quadratic_merit;
 
-    last_quadratic_merit = *quadratic_merit;
+      SLEQP_CALL(
+        sleqp_direction_copy(cauchy_direction, solver->last_direction));
+    }
 
-    SLEQP_CALL(sleqp_direction_copy(cauchy_direction, solver->last_direction));
+    SLEQP_CALL(select_from_batch(solver, iterate, cauchy_data, num_radii - 1));
   }
 
   return SLEQP_OKAY;
@@ -252,79 +493,85 @@ search_backtracking(SleqpParametricSolver* solver,
                     double* trust_radius,
                     double* quadratic_merit)
 {
-  double penalty_parameter = solver->penalty_parameter;
-
   int i = 0;
 
   SleqpVec* direction_primal = sleqp_direction_primal(cauchy_direction);
 
-  for (; i < solver->max_num_resolves; ++i)
+  while (i < solver->max_num_resolves)
   {
-    sleqp_log_debug("Resolving with radius %.14e", *trust_radius);
+    const int num_radii
+      = SLEQP_MIN(batch_size(solver), solver->max_num_resolves - i);
 
-    SLEQP_CALL(sleqp_cauchy_set_trust_radius(cauchy_data, (*trust_radius)));
+    fill_batch_radii(solver,
+                     *trust_radius,
+                     solver->trust_radius_decrease,
+                     num_radii);
 
-    SLEQP_CALL(sleqp_cauchy_solve(cauchy_data,
-                                  sleqp_iterate_obj_grad(iterate),
-                                  penalty_parameter,
-                                  SLEQP_CAUCHY_OBJTYPE_DEFAULT));
+    SLEQP_CALL(solve_batch(solver, iterate, cauchy_data, num_radii));
 
-    SLEQP_CALL(sleqp_cauchy_lp_step(cauchy_data, direction_primal));
+    for (int k = 0; k < num_radii; ++k, ++i)
+    {
+      sleqp_log_debug("Resolving with radius %.14e", *trust_radius);
 
-    const double zero_eps
-      = sleqp_settings_real_value(solver->settings, SLEQP_SETTINGS_REAL_ZERO_EPS);
+      SLEQP_CALL(sleqp_cauchy_lp_step(batch_cauchy(solver, cauchy_data, k),
+                                      direction_primal));
 
-    SLEQP_CALL(sleqp_direction_reset(cauchy_direction,
-                                     solver->problem,
-                                     iterate,
-                                     multipliers,
-                                     solver->cache,
-                                     zero_eps));
+      const double zero_eps
+        = sleqp_settings_real_value(solver->settings, SLEQP_SETTINGS_REAL_ZERO_EPS);
+
+      SLEQP_CALL(sleqp_direction_reset(cauchy_direction,
+                                       solver->problem,
+                                       iterate,
+                                       multipliers,
+                                       solver->cache,
+                                       zero_eps));
 
 #if SLEQP_DEBUG
-    {
-      const double eps = sleqp_settings_real_value(solver->settings, SLEQP_SETTINGS_REAL_EPS);
+      {
+        const double eps = sleqp_settings_real_value(solver->settings, SLEQP_SETTINGS_REAL_EPS);
 
-      const double step_norm = sleqp_vec_inf_norm(direction_primal);
+        const double step_norm = sleqp_vec_inf_norm(direction_primal);
 
-      SLEQP_NUM_ASSERT_PARAM(eps);
-      SLEQP_NUM_ASSERT_PARAM(step_norm);
+        SLEQP_NUM_ASSERT_PARAM(eps);
+        SLEQP_NUM_ASSERT_PARAM(step_norm);
 
-      sleqp_num_assert(sleqp_is_leq(step_norm, *trust_radius, eps));
-    }
+        sleqp_num_assert(sleqp_is_leq(step_norm, *trust_radius, eps));
+      }
 #endif
 
-    bool sufficient_decrease;
+      bool sufficient_decrease;
 
-    SLEQP_CALL(has_sufficient_decrease(solver,
-                                       iterate,
-                                       cauchy_direction,
-                                       quadratic_merit,
-                                       &sufficient_decrease));
+      SLEQP_CALL(has_sufficient_decrease(solver,
+                                         iterate,
+                                         cauchy_direction,
+                                         quadratic_merit,
+                                         &sufficient_decrease));
 
-    if (sufficient_decrease)
-    {
-      sleqp_log_debug(
-        "Accepting radius %.14e, which provides sufficient decrease",
-        *trust_radius);
+      if (sufficient_decrease)
+      {
+        sleqp_log_debug(
+          "Accepting radius %.14e, which provides sufficient decrease",
+          *trust_radius);
 
-      break;
-    }
-    else
-    {
-      (*trust_radius) *= solver->trust_radius_decrease;
+        SLEQP_CALL(select_from_batch(solver, iterate, cauchy_data, k));
+
+        return SLEQP_OKAY;
+      }
+      else
+      {
+        (*trust_radius) *= solver->trust_radius_decrease;
+      }
     }
+
+    SLEQP_CALL(select_from_batch(solver, iterate, cauchy_data, num_radii - 1));
   }
 
-  if (i == solver->max_num_resolves)
-  {
-    bool full_step;
+  bool full_step;
 
-    SLEQP_CALL(sleqp_linesearch_cauchy_step(solver->linesearch,
-                                            cauchy_direction,
-                                            &full_step,
-                                            quadratic_merit));
-  }
+  SLEQP_CALL(sleqp_linesearch_cauchy_step(solver->linesearch,
+                                          cauchy_direction,
+                                          &full_step,
+                                          quadratic_merit));
 
   return SLEQP_OKAY;
 }
@@ -366,6 +613,8 @@ sleqp_parametric_solver_solve(SleqpParametricSolver* solver,
                                      quadratic_merit_value,
                                      &sufficient_decrease));
 
+  SLEQP_CALL(prepare_candidates(solver));
+
   sleqp_log_debug("Beginning parametric solve, initial trust radius: %.14e, "
                   "quadratic merit: %.14e",
                   *trust_radius,
@@ -433,6 +682,16 @@ parametric_solver_free(SleqpParametricSolver** star)
 {
   SleqpParametricSolver* solver = *star;
 
+  sleqp_free(&solver->batch_radii);
+
+  for (int k = 0; k < solver->max_num_resolves; ++k)
+  {
+    SLEQP_CALL(sleqp_cauchy_release(solver->candidates + k));
+  }
+
+  sleqp_free(&solver->has_candidate_iterate);
+  sleqp_free(&solver->candidates);
+
   SLEQP_CALL(sleqp_direction_release(&solver->last_direction));
 
   SLEQP_CALL(sleqp_vec_free(&solver->combined_cons_val));
@@ -36,6 +36,15 @@ SLEQP_RETCODE
 sleqp_parametric_solver_set_penalty(SleqpParametricSolver* solver,
                                     double penalty_parameter);
 
+/**
+ * Sets the time limit of the LPs solved speculatively for
+ * several trust radii at once
+ **/
+SLEQP_NODISCARD
+SLEQP_RETCODE
+sleqp_parametric_solver_set_time_limit(SleqpParametricSolver* solver,
+                                       double time_limit);
+
 SLEQP_NODISCARD
 SLEQP_RETCODE
 sleqp_parametric_solver_solve(SleqpParametricSolver* solver,
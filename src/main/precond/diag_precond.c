@@ -0,0 +1,305 @@
+#include "diag_precond.h"
+
+#include <math.h>
+
+#include "cmp.h"
+#include "fail.h"
+#include "mem.h"
+
+#include "sparse/mat.h"
+
+// Number of Hessian products used to estimate the diagonal. Hessians
+// whose blocks are at most this large yield the exact diagonal instead
+static const int num_probes = 32;
+
+// Entries below this fraction of the largest entry are raised to it
+static const double diag_floor = 1e-8;
+
+typedef struct
+{
+  SleqpProblem* problem;
+
+  double* diag;
+
+  // Point and multipliers the diagonal was computed at
+  bool has_diag;
+  SleqpVec* point;
+  SleqpVec* multipliers;
+
+  // Whether the probes are the block directions, yielding the exact
+  // diagonal, or Rademacher vectors, yielding an estimate
+  bool exact;
+
+  // Index of the block direction containing each variable
+  int* probe_indices;
+
+  SleqpMat* probes;
+  SleqpMat* products;
+} DiagPrecond;
+
+// Returns the sign of the given entry of the given Rademacher probe
+static double
+probe_sign(int probe, int index)
+{
+  unsigned int hash = ((unsigned int)index) * 2654435761u;
+  hash ^= ((unsigned int)probe + 1u) * 2246822519u;
+  hash ^= hash >> 15;
+  hash *= 2246822519u;
+  hash ^= hash >> 13;
+
+  return (hash & 1u) ? 1. : -1.;
+}
+
+static SLEQP_RETCODE
+create_block_probes(DiagPrecond* precond)
+{
+  const int num_variables = sleqp_problem_num_vars(precond->problem);
+
+  SLEQP_CALL(sleqp_precond_create_block_directions(&precond->probes,
+                                                   precond->problem));
+
+  const SleqpMat* probes = precond->probes;
+
+  const int* cols = sleqp_mat_cols(probes);
+  const int* rows = sleqp_mat_rows(probes);
+
+  for (int j = 0; j < num_variables; ++j)
+  {
+    precond->probe_indices[j] = SLEQP_NONE;
+  }
+
+  for (int probe = 0; probe < sleqp_mat_num_cols(probes); ++probe)
+  {
+    for (int k = cols[probe]; k < cols[probe + 1]; ++k)
+    {
+      precond->probe_indices[rows[k]] = probe;
+    }
+  }
+
+  return SLEQP_OKAY;
+}
+
+// The Hessian vanishes on the linear range, which is left out
+static SLEQP_RETCODE
+create_random_probes(DiagPrecond* precond)
+{
+  const int num_variables = sleqp_problem_num_vars(precond->problem);
+
+  SleqpHessStruct* hess_struct
+    = sleqp_func_hess_struct(sleqp_problem_func(precond->problem));
+
+  int lin_begin, lin_end;
+
+  SLEQP_CALL(sleqp_hess_struct_lin_range(hess_struct, &lin_begin, &lin_end));
+
+  SLEQP_CALL(sleqp_mat_create(&precond->probes,
+                              num_variables,
+                              num_probes,
+                              num_probes * lin_begin));
+
+  SleqpMat* probes = precond->probes;
+
+  for (int probe = 0; probe < num_probes; ++probe)
+  {
+    SLEQP_CALL(sleqp_mat_push_col(probes, probe));
+
+    for (int j = 0; j < lin_begin; ++j)
+    {
+      SLEQP_CALL(sleqp_mat_push(probes, j, probe, probe_sign(probe, j)));
+    }
+  }
+
+  return SLEQP_OKAY;
+}
+
+/*
+ * Reads off the exact diagonal from the products with the block
+ * directions, or estimates it as the average of v * (H v) over
+ * Rademacher vectors v (Bekas, Kokiopoulou, Saad)
+ */
+static SLEQP_RETCODE
+compute_diag(DiagPrecond* precond, const SleqpVec* multipliers)
+{
+  const int num_variables = sleqp_problem_num_vars(precond->problem);
+
+  double* diag = precond->diag;
+
+  for (int j = 0; j < num_variables; ++j)
+  {
+    diag[j] = 0.;
+  }
+
+  SLEQP_CALL(sleqp_problem_hess_prods(precond->problem,
+                                      precond->probes,
+                                      multipliers,
+                                      precond->products));
+
+  const int num_probes_used = sleqp_mat_num_cols(precond->products);
+
+  const int* cols      = sleqp_mat_cols(precond->products);
+  const int* rows      = sleqp_mat_rows(precond->products);
+  const double* values = sleqp_mat_data(precond->products);
+
+  for (int probe = 0; probe < num_probes_used; ++probe)
+  {
+    for (int k = cols[probe]; k < cols[probe + 1]; ++k)
+    {
+      const int j = rows[k];
+
+      if (precond->exact)
+      {
+        if (precond->probe_indices[j] == probe)
+        {
+          diag[j] = values[k];
+        }
+
+        continue;
+      }
+
+      diag[j] += probe_sign(probe, j) * values[k] / num_probes_used;
+    }
+  }
+
+  return SLEQP_OKAY;
+}
+
+static SLEQP_RETCODE
+diag_precond_update(const SleqpVec* multipliers, void* data)
+{
+  DiagPrecond* precond = (DiagPrecond*)data;
+
+  const SleqpVec* point = sleqp_problem_primal(precond->problem);
+
+  // Trust region solves at the same iterate share the diagonal
+  if (precond->has_diag && sleqp_vec_eq(point, precond->point, 0.)
+      && sleqp_vec_eq(multipliers, precond->multipliers, 0.))
+  {
+    return SLEQP_OKAY;
+  }
+
+  SLEQP_CALL(sleqp_vec_copy(point, precond->point));
+  SLEQP_CALL(sleqp_vec_copy(multipliers, precond->multipliers));
+
+  SLEQP_CALL(compute_diag(precond, multipliers));
+
+  precond->has_diag = true;
+
+  const int num_variables = sleqp_problem_num_vars(precond->problem);
+
+  double* diag = precond->diag;
+
+  double max_entry = 0.;
+
+  for (int j = 0; j < num_variables; ++j)
+  {
+    max_entry = SLEQP_MAX(max_entry, diag[j]);
+  }
+
+  // Clamp to positive entries, falling back to
+  // the identity for vanishing Hessians
+  const double min_entry = (max_entry > 0.) ? diag_floor * max_entry : 1.;
+
+  for (int j = 0; j < num_variables; ++j)
+  {
+    diag[j] = SLEQP_MAX(diag[j], min_entry);
+  }
+
+  return SLEQP_OKAY;
+}
+
+static SLEQP_RETCODE
+diag_precond_apply(const SleqpVec* rhs, SleqpVec* result, void* data)
+{
+  DiagPrecond* precond = (DiagPrecond*)data;
+
+  SLEQP_CALL(sleqp_vec_copy(rhs, result));
+
+  for (int k = 0; k < result->nnz; ++k)
+  {
+    result->data[k] /= precond->diag[result->indices[k]];
+  }
+
+  return SLEQP_OKAY;
+}
+
+static SLEQP_RETCODE
+diag_precond_free(void* data)
+{
+  DiagPrecond* precond = (DiagPrecond*)data;
+
+  SLEQP_CALL(sleqp_mat_release(&precond->products));
+  SLEQP_CALL(sleqp_mat_release(&precond->probes));
+
+  sleqp_free(&precond->probe_indices);
+
+  SLEQP_CALL(sleqp_vec_free(&precond->multipliers));
+  SLEQP_CALL(sleqp_vec_free(&precond->point));
+
+  sleqp_free(&precond->diag);
+
+  SLEQP_CALL(sleqp_problem_release(&precond->problem));
+
+  sleqp_free(&precond);
+
+  return SLEQP_OKAY;
+}
+
+SLEQP_RETCODE
+sleqp_diag_precond_create(SleqpPrecond** star,
+                          SleqpProblem* problem,
+                          SleqpSettings* settings)
+{
+  DiagPrecond* precond = NULL;
+
+  const int num_variables = sleqp_problem_num_vars(problem);
+
+  SLEQP_CALL(sleqp_malloc(&precond));
+
+  *precond = (DiagPrecond){0};
+
+  SLEQP_CALL(sleqp_problem_capture(problem));
+  precond->problem = problem;
+
+  SLEQP_CALL(sleqp_alloc_array(&precond->diag, num_variables));
+
+  for (int j = 0; j < num_variables; ++j)
+  {
+    precond->diag[j] = 1.;
+  }
+
+  SLEQP_CALL(sleqp_vec_create_full(&precond->point, num_variables));
+
+  SLEQP_CALL(sleqp_vec_create_full(&precond->multipliers,
+                                   sleqp_problem_num_cons(problem)));
+
+  int max_block_size;
+
+  SLEQP_CALL(sleqp_precond_max_block_size(problem, &max_block_size));
+
+  precond->exact = (max_block_size <= num_probes);
+
+  if (precond->exact)
+  {
+    SLEQP_CALL(sleqp_alloc_array(&precond->probe_indices, num_variables));
+
+    SLEQP_CALL(create_block_probes(precond));
+  }
+  else
+  {
+    SLEQP_CALL(create_random_probes(precond));
+  }
+
+  SLEQP_CALL(sleqp_mat_create(&precond->products,
+                              num_variables,
+                              sleqp_mat_num_cols(precond->probes),
+                              0));
+
+  SleqpPrecondCallbacks callbacks = {.update = diag_precond_update,
+                                     .apply  = diag_precond_apply,
+                                     .push   = NULL,
+                                     .free   = diag_precond_free};
+
+  SLEQP_CALL(sleqp_precond_create(star, &callbacks, (void*)precond));
+
+  return SLEQP_OKAY;
+}
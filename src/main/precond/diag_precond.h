@@ -0,0 +1,20 @@
+#ifndef SLEQP_DIAG_PRECOND_H
+#define SLEQP_DIAG_PRECOND_H
+
+#include "precond.h"
+
+/**
+ * Creates a diagonal (Jacobi) preconditioner. If the blocks of the Hessian
+ * structure are small, the exact diagonal is computed from one product
+ * per variable of the largest block. Otherwise, the diagonal is estimated
+ * from a fixed number of products with random probing vectors. Entries
+ * are clamped to be positive, and the diagonal is only recomputed once the
+ * point or the multipliers change.
+ **/
+SLEQP_NODISCARD
+SLEQP_RETCODE
+sleqp_diag_precond_create(SleqpPrecond** star,
+                          SleqpProblem* problem,
+                          SleqpSettings* settings);
+
+#endif /* SLEQP_DIAG_PRECOND_H */
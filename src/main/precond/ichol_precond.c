@@ -0,0 +1,501 @@
+#include "ichol_precond.h"
+
+#include <math.h>
+
+#include "cmp.h"
+#include "fail.h"
+#include "log.h"
+#include "mem.h"
+
+#include "sparse/mat.h"
+
+// Off-diagonal entries below this fraction of the diagonal are dropped
+static const double drop_tol = 1e-8;
+
+// Initial diagonal shift relative to the largest diagonal entry
+static const double initial_shift = 1e-3;
+
+static const int max_shifts = 10;
+
+typedef struct
+{
+  SleqpProblem* problem;
+  SleqpSettings* settings;
+
+  // Lower triangle of the Hessian
+  SleqpMat* hessian;
+
+  // Incomplete factor, same pattern as the Hessian
+  SleqpMat* factor;
+
+  bool has_factor;
+
+  // Point and multipliers the Hessian was assembled at
+  bool has_hessian;
+  SleqpVec* point;
+  SleqpVec* multipliers;
+
+  // Blocks of the Hessian structure
+  int num_blocks;
+  int* block_begins;
+
+  // Products yield the columns of all blocks at once
+  SleqpMat* directions;
+  SleqpMat* products;
+
+  int* cursors;
+  int* positions;
+  double* dense_vec;
+} ICholPrecond;
+
+static SLEQP_RETCODE
+create_directions(ICholPrecond* precond, SleqpHessStruct* hess_struct)
+{
+  const int num_blocks = sleqp_hess_struct_num_blocks(hess_struct);
+
+  precond->num_blocks = num_blocks;
+
+  SLEQP_CALL(sleqp_alloc_array(&precond->block_begins, num_blocks + 1));
+
+  precond->block_begins[0] = 0;
+
+  for (int block = 0; block < num_blocks; ++block)
+  {
+    int begin, end;
+
+    SLEQP_CALL(sleqp_hess_struct_block_range(hess_struct, block, &begin, &end));
+
+    precond->block_begins[block]     = begin;
+    precond->block_begins[block + 1] = end;
+  }
+
+  SLEQP_CALL(sleqp_precond_create_block_directions(&precond->directions,
+                                                   precond->problem));
+
+  const int num_variables  = sleqp_problem_num_vars(precond->problem);
+  const int max_block_size = sleqp_mat_num_cols(precond->directions);
+
+  SLEQP_CALL(sleqp_mat_create(&precond->products,
+                              num_variables,
+                              max_block_size,
+                              sleqp_mat_nnz(precond->directions)));
+
+  SLEQP_CALL(sleqp_alloc_array(&precond->cursors, max_block_size));
+
+  return SLEQP_OKAY;
+}
+
+static SLEQP_RETCODE
+assemble_hessian(ICholPrecond* precond, const SleqpVec* multipliers)
+{
+  SleqpMat* hessian  = precond->hessian;
+  SleqpMat* products = precond->products;
+
+  const int num_variables = sleqp_problem_num_vars(precond->problem);
+
+  SLEQP_CALL(sleqp_problem_hess_prods(precond->problem,
+                                      precond->directions,
+                                      multipliers,
+                                      products));
+
+  const int* prod_cols      = sleqp_mat_cols(products);
+  const int* prod_rows      = sleqp_mat_rows(products);
+  const double* prod_values = sleqp_mat_data(products);
+
+  int* cursors = precond->cursors;
+
+  for (int j = 0; j < sleqp_mat_num_cols(products); ++j)
+  {
+    cursors[j] = prod_cols[j];
+  }
+
+  SLEQP_CALL(sleqp_mat_clear(hessian));
+
+  SLEQP_CALL(
+    sleqp_mat_reserve(hessian, sleqp_mat_nnz(products) + num_variables));
+
+  const int num_blocks = precond->num_blocks;
+  const int lin_begin  = precond->block_begins[num_blocks];
+
+  for (int block = 0; block < num_blocks; ++block)
+  {
+    const int begin = precond->block_begins[block];
+    const int end   = precond->block_begins[block + 1];
+
+    for (int col = begin; col < end; ++col)
+    {
+      const int j = col - begin;
+
+      const int col_end = prod_cols[j + 1];
+
+      // Entries of previous blocks and above the diagonal
+      int k = cursors[j];
+
+      while (k < col_end && prod_rows[k] < col)
+      {
+        ++k;
+      }
+
+      double diag_value = 0.;
+
+      if (k < col_end && prod_rows[k] == col)
+      {
+        diag_value = prod_values[k++];
+      }
+
+      SLEQP_CALL(sleqp_mat_push_col(hessian, col));
+
+      // Diagonal first, always present
+      SLEQP_CALL(sleqp_mat_push(hessian, col, col, diag_value));
+
+      for (; k < col_end && prod_rows[k] < end; ++k)
+      {
+        if (prod_values[k] != 0.)
+        {
+          SLEQP_CALL(
+            sleqp_mat_push(hessian, prod_rows[k], col, prod_values[k]));
+        }
+      }
+
+      cursors[j] = k;
+    }
+  }
+
+  // The Hessian vanishes on the linear range
+  for (int col = lin_begin; col < num_variables; ++col)
+  {
+    SLEQP_CALL(sleqp_mat_push_col(hessian, col));
+    SLEQP_CALL(sleqp_mat_push(hessian, col, col, 0.));
+  }
+
+  return SLEQP_OKAY;
+}
+
+// Drops small off-diagonal entries relative to the diagonal
+static SLEQP_RETCODE
+sparsify_hessian(ICholPrecond* precond)
+{
+  SleqpMat* hessian = precond->hessian;
+
+  const int num_cols = sleqp_mat_num_cols(hessian);
+
+  int* cols    = sleqp_mat_cols(hessian);
+  int* rows    = sleqp_mat_rows(hessian);
+  double* data = sleqp_mat_data(hessian);
+
+  double* diag = precond->dense_vec;
+
+  for (int col = 0; col < num_cols; ++col)
+  {
+    diag[col] = fabs(data[cols[col]]);
+  }
+
+  int nnz = 0;
+
+  for (int col = 0; col < num_cols; ++col)
+  {
+    const int begin = cols[col];
+    const int end   = cols[col + 1];
+
+    cols[col] = nnz;
+
+    for (int index = begin; index < end; ++index)
+    {
+      const int row = rows[index];
+
+      if (row != col
+          && fabs(data[index]) <= drop_tol * sqrt(diag[row] * diag[col]))
+      {
+        continue;
+      }
+
+      rows[nnz] = row;
+      data[nnz] = data[index];
+      ++nnz;
+    }
+  }
+
+  cols[num_cols] = nnz;
+
+  SLEQP_CALL(sleqp_mat_set_nnz(hessian, nnz));
+
+  return SLEQP_OKAY;
+}
+
+/*
+ * Right-looking IC(0) factorization with the given diagonal shift.
+ * Fails if a nonpositive pivot is encountered.
+ */
+static SLEQP_RETCODE
+factorize(ICholPrecond* precond, double shift, bool* success)
+{
+  SleqpMat* factor = precond->factor;
+
+  SLEQP_CALL(sleqp_mat_copy(precond->hessian, factor));
+
+  const int num_cols = sleqp_mat_num_cols(factor);
+
+  const int* cols = sleqp_mat_cols(factor);
+  const int* rows = sleqp_mat_rows(factor);
+  double* data    = sleqp_mat_data(factor);
+
+  int* positions = precond->positions;
+
+  *success = false;
+
+  for (int col = 0; col < num_cols; ++col)
+  {
+    data[cols[col]] += shift;
+  }
+
+  for (int col = 0; col < num_cols; ++col)
+  {
+    const int diag_index = cols[col];
+
+    if (data[diag_index] <= 0.)
+    {
+      return SLEQP_OKAY;
+    }
+
+    const double pivot = sqrt(data[diag_index]);
+
+    data[diag_index] = pivot;
+
+    for (int index = diag_index + 1; index < cols[col + 1]; ++index)
+    {
+      data[index] /= pivot;
+    }
+
+    // Update the trailing columns within the pattern
+    for (int index = diag_index + 1; index < cols[col + 1]; ++index)
+    {
+      const int other_col = rows[index];
+
+      for (int k = cols[other_col]; k < cols[other_col + 1]; ++k)
+      {
+        positions[rows[k]] = k;
+      }
+
+      for (int other = index; other < cols[col + 1]; ++other)
+      {
+        const int position = positions[rows[other]];
+
+        if (position != SLEQP_NONE)
+        {
+          data[position] -= data[other] * data[index];
+        }
+      }
+
+      for (int k = cols[other_col]; k < cols[other_col + 1]; ++k)
+      {
+        positions[rows[k]] = SLEQP_NONE;
+      }
+    }
+  }
+
+  *success = true;
+
+  return SLEQP_OKAY;
+}
+
+static SLEQP_RETCODE
+ichol_precond_update(const SleqpVec* multipliers, void* data)
+{
+  ICholPrecond* precond = (ICholPrecond*)data;
+
+  const SleqpVec* point = sleqp_problem_primal(precond->problem);
+
+  // Trust region solves at the same iterate share the factor
+  if (precond->has_hessian && sleqp_vec_eq(point, precond->point, 0.)
+      && sleqp_vec_eq(multipliers, precond->multipliers, 0.))
+  {
+    return SLEQP_OKAY;
+  }
+
+  SLEQP_CALL(sleqp_vec_copy(point, precond->point));
+  SLEQP_CALL(sleqp_vec_copy(multipliers, precond->multipliers));
+
+  SLEQP_CALL(assemble_hessian(precond, multipliers));
+
+  precond->has_hessian = true;
+
+  SLEQP_CALL(sparsify_hessian(precond));
+
+  const int num_cols = sleqp_mat_num_cols(precond->hessian);
+
+  const int* cols         = sleqp_mat_cols(precond->hessian);
+  const double* hess_data = sleqp_mat_data(precond->hessian);
+
+  double max_diag = 0.;
+  double min_diag = 0.;
+
+  for (int col = 0; col < num_cols; ++col)
+  {
+    const double value = hess_data[cols[col]];
+
+    max_diag = SLEQP_MAX(max_diag, fabs(value));
+    min_diag = (col == 0) ? value : SLEQP_MIN(min_diag, value);
+  }
+
+  // Shifting strategy of Lin and More
+  double shift = (min_diag > 0.) ? 0. : (initial_shift * max_diag - min_diag);
+
+  if (max_diag == 0.)
+  {
+    shift = 1.;
+  }
+
+  for (int attempt = 0; attempt < max_shifts; ++attempt)
+  {
+    SLEQP_CALL(factorize(precond, shift, &precond->has_factor));
+
+    if (precond->has_factor)
+    {
+      return SLEQP_OKAY;
+    }
+
+    shift = SLEQP_MAX(2. * shift, initial_shift * max_diag);
+  }
+
+  sleqp_log_debug("Failed to compute incomplete Cholesky factorization");
+
+  return SLEQP_OKAY;
+}
+
+static SLEQP_RETCODE
+ichol_precond_apply(const SleqpVec* rhs, SleqpVec* result, void* data)
+{
+  ICholPrecond* precond = (ICholPrecond*)data;
+
+  if (!precond->has_factor)
+  {
+    SLEQP_CALL(sleqp_vec_copy(rhs, result));
+    return SLEQP_OKAY;
+  }
+
+  const double zero_eps
+    = sleqp_settings_real_value(precond->settings,
+                                SLEQP_SETTINGS_REAL_ZERO_EPS);
+
+  const SleqpMat* factor = precond->factor;
+
+  const int num_cols = sleqp_mat_num_cols(factor);
+
+  const int* cols      = sleqp_mat_cols(factor);
+  const int* rows      = sleqp_mat_rows(factor);
+  const double* values = sleqp_mat_data(factor);
+
+  double* vec = precond->dense_vec;
+
+  SLEQP_CALL(sleqp_vec_to_raw(rhs, vec));
+
+  // Solve L y = b
+  for (int col = 0; col < num_cols; ++col)
+  {
+    vec[col] /= values[cols[col]];
+
+    for (int index = cols[col] + 1; index < cols[col + 1]; ++index)
+    {
+      vec[rows[index]] -= values[index] * vec[col];
+    }
+  }
+
+  // Solve L^T x = y
+  for (int col = num_cols - 1; col >= 0; --col)
+  {
+    for (int index = cols[col] + 1; index < cols[col + 1]; ++index)
+    {
+      vec[col] -= values[index] * vec[rows[index]];
+    }
+
+    vec[col] /= values[cols[col]];
+  }
+
+  SLEQP_CALL(sleqp_vec_set_from_raw(result, vec, num_cols, zero_eps));
+
+  return SLEQP_OKAY;
+}
+
+static SLEQP_RETCODE
+ichol_precond_free(void* data)
+{
+  ICholPrecond* precond = (ICholPrecond*)data;
+
+  sleqp_free(&precond->dense_vec);
+  sleqp_free(&precond->positions);
+  sleqp_free(&precond->cursors);
+
+  SLEQP_CALL(sleqp_mat_release(&precond->products));
+  SLEQP_CALL(sleqp_mat_release(&precond->directions));
+
+  sleqp_free(&precond->block_begins);
+
+  SLEQP_CALL(sleqp_vec_free(&precond->multipliers));
+  SLEQP_CALL(sleqp_vec_free(&precond->point));
+
+  SLEQP_CALL(sleqp_mat_release(&precond->factor));
+  SLEQP_CALL(sleqp_mat_release(&precond->hessian));
+
+  SLEQP_CALL(sleqp_settings_release(&precond->settings));
+  SLEQP_CALL(sleqp_problem_release(&precond->problem));
+
+  sleqp_free(&precond);
+
+  return SLEQP_OKAY;
+}
+
+SLEQP_RETCODE
+sleqp_ichol_precond_create(SleqpPrecond** star,
+                           SleqpProblem* problem,
+                           SleqpSettings* settings)
+{
+  ICholPrecond* precond = NULL;
+
+  const int num_variables = sleqp_problem_num_vars(problem);
+
+  SLEQP_CALL(sleqp_malloc(&precond));
+
+  *precond = (ICholPrecond){0};
+
+  SLEQP_CALL(sleqp_problem_capture(problem));
+  precond->problem = problem;
+
+  SLEQP_CALL(sleqp_settings_capture(settings));
+  precond->settings = settings;
+
+  SLEQP_CALL(sleqp_mat_create(&precond->hessian,
+                              num_variables,
+                              num_variables,
+                              num_variables));
+
+  SLEQP_CALL(sleqp_mat_create(&precond->factor,
+                              num_variables,
+                              num_variables,
+                              num_variables));
+
+  SLEQP_CALL(sleqp_vec_create_full(&precond->point, num_variables));
+
+  SLEQP_CALL(sleqp_vec_create_full(&precond->multipliers,
+                                   sleqp_problem_num_cons(problem)));
+
+  SLEQP_CALL(create_directions(
+    precond,
+    sleqp_func_hess_struct(sleqp_problem_func(problem))));
+
+  SLEQP_CALL(sleqp_alloc_array(&precond->positions, num_variables));
+  SLEQP_CALL(sleqp_alloc_array(&precond->dense_vec, num_variables));
+
+  for (int j = 0; j < num_variables; ++j)
+  {
+    precond->positions[j] = SLEQP_NONE;
+  }
+
+  SleqpPrecondCallbacks callbacks = {.update = ichol_precond_update,
+                                     .apply  = ichol_precond_apply,
+                                     .push   = NULL,
+                                     .free   = ichol_precond_free};
+
+  SLEQP_CALL(sleqp_precond_create(star, &callbacks, (void*)precond));
+
+  return SLEQP_OKAY;
+}
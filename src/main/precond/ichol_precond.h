@@ -0,0 +1,22 @@
+#ifndef SLEQP_ICHOL_PRECOND_H
+#define SLEQP_ICHOL_PRECOND_H
+
+#include "precond.h"
+
+/**
+ * Creates an incomplete Cholesky preconditioner. The Hessian is assembled
+ * from products with sums of unit vectors spanning all blocks of the
+ * Hessian structure, requiring one product per variable of the largest
+ * block. The factor is only recomputed once the point or the multipliers
+ * change. Problems without a declared block structure require one product
+ * per variable. @ref sleqp_precond_create_default therefore falls back to
+ * a diagonal preconditioner for blocks larger than
+ * @ref SLEQP_SETTINGS_INT_PRECOND_MAX_BLOCK_SIZE.
+ **/
+SLEQP_NODISCARD
+SLEQP_RETCODE
+sleqp_ichol_precond_create(SleqpPrecond** star,
+                           SleqpProblem* problem,
+                           SleqpSettings* settings);
+
+#endif /* SLEQP_ICHOL_PRECOND_H */
@@ -0,0 +1,282 @@
+#include "lbfgs_precond.h"
+
+#include <math.h>
+
+#include "cmp.h"
+#include "fail.h"
+#include "mem.h"
+#include "sparse/vec_kernels.h"
+
+// Minimum relative curvature s^T y / (||s|| ||y||) of accepted pairs
+static const double curvature_tol = 1e-8;
+
+/*
+ * A set of curvature pairs (s_k, y_k), stored densely in
+ * a ring buffer, oldest pair first
+ */
+typedef struct
+{
+  double* point_diffs;
+  double* grad_diffs;
+  double* inv_dots;
+
+  int len;
+  int curr;
+} PairSet;
+
+/*
+ * Pairs are recorded during a solve and become active once the
+ * preconditioner is updated, keeping it fixed during each solve
+ */
+typedef struct
+{
+  SleqpSettings* settings;
+
+  int num_variables;
+  int num;
+
+  PairSet active;
+  PairSet recorded;
+
+  double* dense_point_diff;
+  double* dense_grad_diff;
+
+  double* dense_vec;
+  double* alphas;
+} LBFGSPrecond;
+
+static SLEQP_RETCODE
+pair_set_create_at(PairSet* pairs, int num_variables, int num)
+{
+  *pairs = (PairSet){0};
+
+  SLEQP_CALL(sleqp_alloc_array(&pairs->point_diffs, num * num_variables));
+  SLEQP_CALL(sleqp_alloc_array(&pairs->grad_diffs, num * num_variables));
+  SLEQP_CALL(sleqp_alloc_array(&pairs->inv_dots, num));
+
+  pairs->curr = -1;
+
+  return SLEQP_OKAY;
+}
+
+static void
+pair_set_free_at(PairSet* pairs)
+{
+  sleqp_free(&pairs->inv_dots);
+  sleqp_free(&pairs->grad_diffs);
+  sleqp_free(&pairs->point_diffs);
+}
+
+// Returns the storage position of the i-th oldest pair
+static int
+pair_index(const LBFGSPrecond* precond, const PairSet* pairs, int i)
+{
+  const int first = pairs->curr - pairs->len + 1;
+
+  return (first + i + precond->num) % precond->num;
+}
+
+static SLEQP_RETCODE
+lbfgs_precond_update(const SleqpVec* multipliers, void* data)
+{
+  LBFGSPrecond* precond = (LBFGSPrecond*)data;
+
+  if (precond->recorded.len == 0)
+  {
+    return SLEQP_OKAY;
+  }
+
+  const PairSet active = precond->active;
+
+  precond->active   = precond->recorded;
+  precond->recorded = active;
+
+  precond->recorded.len  = 0;
+  precond->recorded.curr = -1;
+
+  return SLEQP_OKAY;
+}
+
+/*
+ * Two-loop recursion, see "Numerical Optimization", Algorithm 7.4
+ */
+static SLEQP_RETCODE
+lbfgs_precond_apply(const SleqpVec* rhs, SleqpVec* result, void* data)
+{
+  LBFGSPrecond* precond = (LBFGSPrecond*)data;
+  const PairSet* pairs  = &precond->active;
+
+  const int num_variables = precond->num_variables;
+
+  const double zero_eps
+    = sleqp_settings_real_value(precond->settings,
+                                SLEQP_SETTINGS_REAL_ZERO_EPS);
+
+  if (pairs->len == 0)
+  {
+    SLEQP_CALL(sleqp_vec_copy(rhs, result));
+    return SLEQP_OKAY;
+  }
+
+  double* vec    = precond->dense_vec;
+  double* alphas = precond->alphas;
+
+  SLEQP_CALL(sleqp_vec_to_raw(rhs, vec));
+
+  for (int i = pairs->len - 1; i >= 0; --i)
+  {
+    const int index = pair_index(precond, pairs, i);
+
+    const double* point_diff = pairs->point_diffs + index * num_variables;
+    const double* grad_diff  = pairs->grad_diffs + index * num_variables;
+
+    alphas[i] = pairs->inv_dots[index]
+                * sleqp_kernel_dot(point_diff, vec, num_variables);
+
+    sleqp_kernel_axpby(vec, grad_diff, 1., -alphas[i], vec, num_variables);
+  }
+
+  {
+    const double* point_diff
+      = pairs->point_diffs + pairs->curr * num_variables;
+    const double* grad_diff = pairs->grad_diffs + pairs->curr * num_variables;
+
+    const double scale = sleqp_kernel_dot(point_diff, grad_diff, num_variables)
+                         / sleqp_kernel_norm_sq(grad_diff, num_variables);
+
+    sleqp_kernel_scale(vec, scale, vec, num_variables);
+  }
+
+  for (int i = 0; i < pairs->len; ++i)
+  {
+    const int index = pair_index(precond, pairs, i);
+
+    const double* point_diff = pairs->point_diffs + index * num_variables;
+    const double* grad_diff  = pairs->grad_diffs + index * num_variables;
+
+    const double beta = pairs->inv_dots[index]
+                        * sleqp_kernel_dot(grad_diff, vec, num_variables);
+
+    sleqp_kernel_axpby(vec,
+                       point_diff,
+                       1.,
+                       alphas[i] - beta,
+                       vec,
+                       num_variables);
+  }
+
+  SLEQP_CALL(sleqp_vec_set_from_raw(result, vec, num_variables, zero_eps));
+
+  return SLEQP_OKAY;
+}
+
+static SLEQP_RETCODE
+lbfgs_precond_push(const SleqpVec* direction,
+                   const SleqpVec* product,
+                   void* data)
+{
+  LBFGSPrecond* precond = (LBFGSPrecond*)data;
+  PairSet* pairs        = &precond->recorded;
+
+  const int num_variables = precond->num_variables;
+
+  double* point_diff = precond->dense_point_diff;
+  double* grad_diff  = precond->dense_grad_diff;
+
+  SLEQP_CALL(sleqp_vec_to_raw(direction, point_diff));
+  SLEQP_CALL(sleqp_vec_to_raw(product, grad_diff));
+
+  const double dot = sleqp_kernel_dot(point_diff, grad_diff, num_variables);
+
+  const double point_nrm
+    = sqrt(sleqp_kernel_norm_sq(point_diff, num_variables));
+  const double grad_nrm = sqrt(sleqp_kernel_norm_sq(grad_diff, num_variables));
+
+  if (dot <= curvature_tol * point_nrm * grad_nrm)
+  {
+    return SLEQP_OKAY;
+  }
+
+  pairs->curr = (pairs->curr + 1) % precond->num;
+  pairs->len  = SLEQP_MIN(pairs->len + 1, precond->num);
+
+  const int offset = pairs->curr * num_variables;
+
+  for (int j = 0; j < num_variables; ++j)
+  {
+    pairs->point_diffs[offset + j] = point_diff[j];
+    pairs->grad_diffs[offset + j]  = grad_diff[j];
+  }
+
+  pairs->inv_dots[pairs->curr] = 1. / dot;
+
+  return SLEQP_OKAY;
+}
+
+static SLEQP_RETCODE
+lbfgs_precond_free(void* data)
+{
+  LBFGSPrecond* precond = (LBFGSPrecond*)data;
+
+  sleqp_free(&precond->alphas);
+  sleqp_free(&precond->dense_vec);
+  sleqp_free(&precond->dense_grad_diff);
+  sleqp_free(&precond->dense_point_diff);
+
+  pair_set_free_at(&precond->recorded);
+  pair_set_free_at(&precond->active);
+
+  SLEQP_CALL(sleqp_settings_release(&precond->settings));
+
+  sleqp_free(&precond);
+
+  return SLEQP_OKAY;
+}
+
+SLEQP_RETCODE
+sleqp_lbfgs_precond_create(SleqpPrecond** star,
+                           SleqpProblem* problem,
+                           SleqpSettings* settings)
+{
+  LBFGSPrecond* precond = NULL;
+
+  const int num_variables = sleqp_problem_num_vars(problem);
+
+  const int num = sleqp_settings_int_value(
+    settings,
+    SLEQP_SETTINGS_INT_NUM_QUASI_NEWTON_ITERATES);
+
+  if (num <= 0)
+  {
+    sleqp_raise(SLEQP_ILLEGAL_ARGUMENT,
+                "Invalid number of quasi-Newton iterates: %d",
+                num);
+  }
+
+  SLEQP_CALL(sleqp_malloc(&precond));
+
+  *precond = (LBFGSPrecond){0};
+
+  SLEQP_CALL(sleqp_settings_capture(settings));
+  precond->settings = settings;
+
+  precond->num_variables = num_variables;
+  precond->num           = num;
+
+  SLEQP_CALL(pair_set_create_at(&precond->active, num_variables, num));
+  SLEQP_CALL(pair_set_create_at(&precond->recorded, num_variables, num));
+
+  SLEQP_CALL(sleqp_alloc_array(&precond->dense_point_diff, num_variables));
+  SLEQP_CALL(sleqp_alloc_array(&precond->dense_grad_diff, num_variables));
+  SLEQP_CALL(sleqp_alloc_array(&precond->dense_vec, num_variables));
+  SLEQP_CALL(sleqp_alloc_array(&precond->alphas, num));
+
+  SleqpPrecondCallbacks callbacks = {.update = lbfgs_precond_update,
+                                     .apply  = lbfgs_precond_apply,
+                                     .push   = lbfgs_precond_push,
+                                     .free   = lbfgs_precond_free};
+
+  SLEQP_CALL(sleqp_precond_create(star, &callbacks, (void*)precond));
+
+  return SLEQP_OKAY;
+}
@@ -0,0 +1,18 @@
+#ifndef SLEQP_LBFGS_PRECOND_H
+#define SLEQP_LBFGS_PRECOND_H
+
+#include "precond.h"
+
+/**
+ * Creates a limited-memory BFGS preconditioner approximating the inverse
+ * Hessian based on the curvature pairs observed during previous solves.
+ * The number of pairs is given by
+ * @ref SLEQP_SETTINGS_INT_NUM_QUASI_NEWTON_ITERATES.
+ **/
+SLEQP_NODISCARD
+SLEQP_RETCODE
+sleqp_lbfgs_precond_create(SleqpPrecond** star,
+                           SleqpProblem* problem,
+                           SleqpSettings* settings);
+
+#endif /* SLEQP_LBFGS_PRECOND_H */
@@ -0,0 +1,261 @@
+#include "precond.h"
+
+#include "cmp.h"
+#include "fail.h"
+#include "log.h"
+#include "mem.h"
+
+#include "sparse/mat.h"
+
+#include "diag_precond.h"
+#include "ichol_precond.h"
+#include "lbfgs_precond.h"
+
+struct SleqpPrecond
+{
+  int refcount;
+
+  SleqpPrecondCallbacks callbacks;
+  void* precond_data;
+};
+
+SLEQP_RETCODE
+sleqp_precond_create(SleqpPrecond** star,
+                     SleqpPrecondCallbacks* callbacks,
+                     void* precond_data)
+{
+  SLEQP_CALL(sleqp_malloc(star));
+
+  SleqpPrecond* precond = *star;
+
+  *precond = (SleqpPrecond){0};
+
+  precond->refcount = 1;
+
+  precond->callbacks    = *callbacks;
+  precond->precond_data = precond_data;
+
+  return SLEQP_OKAY;
+}
+
+SLEQP_RETCODE
+sleqp_precond_create_default(SleqpPrecond** star,
+                             SleqpProblem* problem,
+                             SleqpSettings* settings)
+{
+  const SLEQP_TR_PRECOND precond_type
+    = sleqp_settings_enum_value(settings, SLEQP_SETTINGS_ENUM_TR_PRECOND);
+
+  switch (precond_type)
+  {
+  case SLEQP_TR_PRECOND_NONE:
+    *star = NULL;
+    break;
+  case SLEQP_TR_PRECOND_DIAGONAL:
+    SLEQP_CALL(sleqp_diag_precond_create(star, problem, settings));
+    break;
+  case SLEQP_TR_PRECOND_QUASI_NEWTON:
+    SLEQP_CALL(sleqp_lbfgs_precond_create(star, problem, settings));
+    break;
+  case SLEQP_TR_PRECOND_INCOMPLETE_CHOLESKY:
+  {
+    int max_block_size;
+
+    SLEQP_CALL(sleqp_precond_max_block_size(problem, &max_block_size));
+
+    const int max_assembled_size
+      = sleqp_settings_int_value(settings,
+                                 SLEQP_SETTINGS_INT_PRECOND_MAX_BLOCK_SIZE);
+
+    if (max_block_size > max_assembled_size)
+    {
+      sleqp_log_warn("Hessian block of size %d exceeds the limit of %d, "
+                     "using diagonal preconditioner instead",
+                     max_block_size,
+                     max_assembled_size);
+
+      SLEQP_CALL(sleqp_diag_precond_create(star, problem, settings));
+      break;
+    }
+
+    SLEQP_CALL(sleqp_ichol_precond_create(star, problem, settings));
+    break;
+  }
+  default:
+    sleqp_raise(SLEQP_ILLEGAL_ARGUMENT,
+                "Invalid preconditioner type %d",
+                precond_type);
+  }
+
+  return SLEQP_OKAY;
+}
+
+SLEQP_RETCODE
+sleqp_precond_update(SleqpPrecond* precond, const SleqpVec* multipliers)
+{
+  SLEQP_CALL(precond->callbacks.update(multipliers, precond->precond_data));
+
+  return SLEQP_OKAY;
+}
+
+SLEQP_RETCODE
+sleqp_precond_apply(SleqpPrecond* precond,
+                    const SleqpVec* rhs,
+                    SleqpVec* result)
+{
+  SLEQP_CALL(precond->callbacks.apply(rhs, result, precond->precond_data));
+
+  return SLEQP_OKAY;
+}
+
+SLEQP_RETCODE
+sleqp_precond_push(SleqpPrecond* precond,
+                   const SleqpVec* direction,
+                   const SleqpVec* product)
+{
+  if (precond->callbacks.push)
+  {
+    SLEQP_CALL(
+      precond->callbacks.push(direction, product, precond->precond_data));
+  }
+
+  return SLEQP_OKAY;
+}
+
+SLEQP_RETCODE
+sleqp_precond_max_block_size(SleqpProblem* problem, int* max_block_size)
+{
+  SleqpHessStruct* hess_struct
+    = sleqp_func_hess_struct(sleqp_problem_func(problem));
+
+  const int num_blocks = sleqp_hess_struct_num_blocks(hess_struct);
+
+  *max_block_size = 0;
+
+  for (int block = 0; block < num_blocks; ++block)
+  {
+    int begin, end;
+
+    SLEQP_CALL(sleqp_hess_struct_block_range(hess_struct, block, &begin, &end));
+
+    *max_block_size = SLEQP_MAX(*max_block_size, end - begin);
+  }
+
+  return SLEQP_OKAY;
+}
+
+SLEQP_RETCODE
+sleqp_precond_create_block_directions(SleqpMat** star, SleqpProblem* problem)
+{
+  SleqpHessStruct* hess_struct
+    = sleqp_func_hess_struct(sleqp_problem_func(problem));
+
+  const int num_variables = sleqp_problem_num_vars(problem);
+  const int num_blocks    = sleqp_hess_struct_num_blocks(hess_struct);
+
+  int max_block_size, lin_begin, lin_end;
+
+  SLEQP_CALL(sleqp_precond_max_block_size(problem, &max_block_size));
+
+  SLEQP_CALL(sleqp_hess_struct_lin_range(hess_struct, &lin_begin, &lin_end));
+
+  SLEQP_CALL(
+    sleqp_mat_create(star, num_variables, max_block_size, lin_begin));
+
+  SleqpMat* directions = *star;
+
+  int* cols    = sleqp_mat_cols(directions);
+  int* rows    = sleqp_mat_rows(directions);
+  double* data = sleqp_mat_data(directions);
+
+  for (int j = 0; j <= max_block_size; ++j)
+  {
+    cols[j] = 0;
+  }
+
+  // Count the blocks containing a j-th variable
+  for (int block = 0; block < num_blocks; ++block)
+  {
+    int begin, end;
+
+    SLEQP_CALL(sleqp_hess_struct_block_range(hess_struct, block, &begin, &end));
+
+    for (int j = 0; j < end - begin; ++j)
+    {
+      ++cols[j + 1];
+    }
+  }
+
+  for (int j = 0; j < max_block_size; ++j)
+  {
+    cols[j + 1] += cols[j];
+  }
+
+  // Blocks are ordered, so are the rows of each direction. Column
+  // starts are advanced while filling and shifted back afterwards
+  for (int block = 0; block < num_blocks; ++block)
+  {
+    int begin, end;
+
+    SLEQP_CALL(sleqp_hess_struct_block_range(hess_struct, block, &begin, &end));
+
+    for (int row = begin; row < end; ++row)
+    {
+      const int index = cols[row - begin]++;
+
+      rows[index] = row;
+      data[index] = 1.;
+    }
+  }
+
+  for (int j = max_block_size; j > 0; --j)
+  {
+    cols[j] = cols[j - 1];
+  }
+
+  cols[0] = 0;
+
+  SLEQP_CALL(sleqp_mat_set_nnz(directions, lin_begin));
+
+  return SLEQP_OKAY;
+}
+
+SLEQP_RETCODE
+sleqp_precond_capture(SleqpPrecond* precond)
+{
+  ++precond->refcount;
+
+  return SLEQP_OKAY;
+}
+
+static SLEQP_RETCODE
+precond_free(SleqpPrecond** star)
+{
+  SleqpPrecond* precond = *star;
+
+  SLEQP_CALL(precond->callbacks.free(precond->precond_data));
+
+  sleqp_free(star);
+
+  return SLEQP_OKAY;
+}
+
+SLEQP_RETCODE
+sleqp_precond_release(SleqpPrecond** star)
+{
+  SleqpPrecond* precond = *star;
+
+  if (!precond)
+  {
+    return SLEQP_OKAY;
+  }
+
+  if (--precond->refcount == 0)
+  {
+    SLEQP_CALL(precond_free(star));
+  }
+
+  *star = NULL;
+
+  return SLEQP_OKAY;
+}
@@ -0,0 +1,77 @@
+#ifndef SLEQP_PRECOND_H
+#define SLEQP_PRECOND_H
+
+/**
+ * @file precond.h
+ * @brief Definition of preconditioners for the Hessian of the Lagrangian.
+ *
+ * A preconditioner is a positive definite approximation \f$ M \f$ of the
+ * Hessian of the Lagrangian. It is updated once per iterate and
+ * subsequently used to compute products \f$ M^{-1} r \f$.
+ **/
+
+#include "problem.h"
+#include "settings.h"
+
+#include "precond_types.h"
+
+typedef struct SleqpPrecond SleqpPrecond;
+
+SLEQP_NODISCARD
+SLEQP_RETCODE
+sleqp_precond_create(SleqpPrecond** star,
+                     SleqpPrecondCallbacks* callbacks,
+                     void* precond_data);
+
+/**
+ * Creates the preconditioner chosen by @ref SLEQP_SETTINGS_ENUM_TR_PRECOND,
+ * sets `*star` to `NULL` if no preconditioning is requested
+ **/
+SLEQP_NODISCARD
+SLEQP_RETCODE
+sleqp_precond_create_default(SleqpPrecond** star,
+                             SleqpProblem* problem,
+                             SleqpSettings* settings);
+
+SLEQP_NODISCARD
+SLEQP_RETCODE
+sleqp_precond_update(SleqpPrecond* precond, const SleqpVec* multipliers);
+
+SLEQP_NODISCARD
+SLEQP_RETCODE
+sleqp_precond_apply(SleqpPrecond* precond,
+                    const SleqpVec* rhs,
+                    SleqpVec* result);
+
+SLEQP_NODISCARD
+SLEQP_RETCODE
+sleqp_precond_push(SleqpPrecond* precond,
+                   const SleqpVec* direction,
+                   const SleqpVec* product);
+
+/**
+ * Computes the size of the largest block of the Hessian structure,
+ * i.e., the number of Hessian products required to assemble all blocks
+ **/
+SLEQP_NODISCARD
+SLEQP_RETCODE
+sleqp_precond_max_block_size(SleqpProblem* problem, int* max_block_size);
+
+/**
+ * Creates the directions whose Hessian products yield the columns of all
+ * blocks of the Hessian structure at once. The j-th direction is the sum
+ * of the j-th unit vectors of all blocks
+ **/
+SLEQP_NODISCARD
+SLEQP_RETCODE
+sleqp_precond_create_block_directions(SleqpMat** star, SleqpProblem* problem);
+
+SLEQP_NODISCARD
+SLEQP_RETCODE
+sleqp_precond_capture(SleqpPrecond* precond);
+
+SLEQP_NODISCARD
+SLEQP_RETCODE
+sleqp_precond_release(SleqpPrecond** star);
+
+#endif /* SLEQP_PRECOND_H */
@@ -0,0 +1,49 @@
+#ifndef SLEQP_PRECOND_TYPES_H
+#define SLEQP_PRECOND_TYPES_H
+
+#include "sparse/vec.h"
+
+/**
+ * Updates the preconditioner to approximate the Hessian of the Lagrangian
+ * at the current iterate
+ *
+ * @param[in]     multipliers     The constraint multipliers
+ * @param[in,out] precond_data    The preconditioner data
+ **/
+typedef SLEQP_RETCODE (*SLEQP_PRECOND_UPDATE)(const SleqpVec* multipliers,
+                                              void* precond_data);
+
+/**
+ * Applies the inverse of the preconditioner to the given vector
+ *
+ * @param[in]     rhs             The vector
+ * @param[out]    result          The product
+ * @param[in,out] precond_data    The preconditioner data
+ **/
+typedef SLEQP_RETCODE (*SLEQP_PRECOND_APPLY)(const SleqpVec* rhs,
+                                             SleqpVec* result,
+                                             void* precond_data);
+
+/**
+ * Records a pair of a direction and its product with the Hessian
+ * of the Lagrangian, may be used to build up curvature information
+ *
+ * @param[in]     direction       The direction
+ * @param[in]     product         The product
+ * @param[in,out] precond_data    The preconditioner data
+ **/
+typedef SLEQP_RETCODE (*SLEQP_PRECOND_PUSH)(const SleqpVec* direction,
+                                            const SleqpVec* product,
+                                            void* precond_data);
+
+typedef SLEQP_RETCODE (*SLEQP_PRECOND_FREE)(void* precond_data);
+
+typedef struct
+{
+  SLEQP_PRECOND_UPDATE update;
+  SLEQP_PRECOND_APPLY apply;
+  SLEQP_PRECOND_PUSH push;
+  SLEQP_PRECOND_FREE free;
+} SleqpPrecondCallbacks;
+
+#endif /* SLEQP_PRECOND_TYPES_H */
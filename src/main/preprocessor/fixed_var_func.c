@@ -23,6 +23,11 @@ typedef struct FixedVarFuncData
   SleqpVec* direction;
   SleqpVec* product;
 
+  SleqpVec* reduced_vec;
+
+  SleqpMat* directions;
+  SleqpMat* products;
+
   SleqpMat* jacobian;
 
 } FixedVarFuncData;
@@ -84,7 +89,7 @@ fixed_var_func_nonzeros(SleqpFunc* func,
   }
   else
   {
-    const int jac_nnz = num_orig_vars * num_cons;
+    const int jac_nnz = sleqp_mat_nnz_estimate(num_cons, num_orig_vars);
     SLEQP_CALL(sleqp_mat_reserve(func_data->jacobian, jac_nnz));
   }
 
@@ -174,6 +179,63 @@ fixed_var_hess_prod(SleqpFunc* func,
   return SLEQP_OKAY;
 }
 
+static SLEQP_RETCODE
+fixed_var_hess_prods(SleqpFunc* func,
+                     const SleqpMat* directions,
+                     const SleqpVec* cons_duals,
+                     SleqpMat* products,
+                     void* data)
+{
+  FixedVarFuncData* func_data = (FixedVarFuncData*)data;
+
+  const int num_variables = sleqp_func_num_vars(func_data->func);
+  const int num_cols      = sleqp_mat_num_cols(directions);
+
+  SLEQP_CALL(sleqp_mat_resize(func_data->directions, num_variables, num_cols));
+  SLEQP_CALL(sleqp_mat_resize(func_data->products, num_variables, num_cols));
+
+  SLEQP_CALL(sleqp_mat_clear(func_data->directions));
+  SLEQP_CALL(
+    sleqp_mat_reserve(func_data->directions, sleqp_mat_nnz(directions)));
+
+  for (int col = 0; col < num_cols; ++col)
+  {
+    SLEQP_CALL(sleqp_mat_col(directions, col, func_data->reduced_vec));
+
+    SLEQP_CALL(
+      sleqp_preprocessing_add_zero_entries(func_data->reduced_vec,
+                                           func_data->direction,
+                                           func_data->num_fixed,
+                                           func_data->fixed_indices));
+
+    SLEQP_CALL(sleqp_mat_push_col(func_data->directions, col));
+    SLEQP_CALL(
+      sleqp_mat_push_vec(func_data->directions, col, func_data->direction));
+  }
+
+  SLEQP_CALL(sleqp_func_hess_prods(func_data->func,
+                                   func_data->directions,
+                                   cons_duals,
+                                   func_data->products));
+
+  SLEQP_CALL(sleqp_mat_reserve(products, sleqp_mat_nnz(func_data->products)));
+
+  for (int col = 0; col < num_cols; ++col)
+  {
+    SLEQP_CALL(sleqp_mat_col(func_data->products, col, func_data->product));
+
+    SLEQP_CALL(sleqp_vec_remove_entries(func_data->product,
+                                        func_data->reduced_vec,
+                                        func_data->fixed_indices,
+                                        func_data->num_fixed));
+
+    SLEQP_CALL(sleqp_mat_push_col(products, col));
+    SLEQP_CALL(sleqp_mat_push_vec(products, col, func_data->reduced_vec));
+  }
+
+  return SLEQP_OKAY;
+}
+
 static SLEQP_RETCODE
 fixed_func_free(void* data)
 {
@@ -181,6 +243,11 @@ fixed_func_free(void* data)
 
   SLEQP_CALL(sleqp_mat_release(&func_data->jacobian));
 
+  SLEQP_CALL(sleqp_mat_release(&func_data->products));
+  SLEQP_CALL(sleqp_mat_release(&func_data->directions));
+
+  SLEQP_CALL(sleqp_vec_free(&func_data->reduced_vec));
+
   SLEQP_CALL(sleqp_vec_free(&func_data->product));
 
   SLEQP_CALL(sleqp_vec_free(&func_data->direction));
@@ -435,12 +502,45 @@ create_fixed_var_func_data(FixedVarFuncData** star,
 
   SLEQP_CALL(sleqp_vec_create_full(&func_data->product, num_variables));
 
+  SLEQP_CALL(sleqp_vec_create_empty(&func_data->reduced_vec,
+                                    num_variables - num_fixed));
+
+  SLEQP_CALL(sleqp_mat_create(&func_data->directions, num_variables, 0, 0));
+  SLEQP_CALL(sleqp_mat_create(&func_data->products, num_variables, 0, 0));
+
   SLEQP_CALL(
     sleqp_mat_create(&func_data->jacobian, num_constraints, num_variables, 0));
 
   return SLEQP_OKAY;
 }
 
+static SLEQP_RETCODE
+fixed_var_func_clone(SleqpFunc* func, SleqpFunc** clone, void* data)
+{
+  FixedVarFuncData* func_data = (FixedVarFuncData*)data;
+
+  SleqpFunc* inner_clone;
+
+  *clone = NULL;
+
+  SLEQP_CALL(sleqp_func_clone(func_data->func, &inner_clone));
+
+  if (!inner_clone)
+  {
+    return SLEQP_OKAY;
+  }
+
+  SLEQP_CALL(sleqp_fixed_var_func_create(clone,
+                                         inner_clone,
+                                         func_data->num_fixed,
+                                         func_data->fixed_indices,
+                                         func_data->fixed_values));
+
+  SLEQP_CALL(sleqp_func_release(&inner_clone));
+
+  return SLEQP_OKAY;
+}
+
 SLEQP_RETCODE
 sleqp_fixed_var_func_create(SleqpFunc** star,
                             SleqpFunc* func,
@@ -464,14 +564,16 @@ sleqp_fixed_var_func_create(SleqpFunc** star,
                                         fixed_indices,
                                         fixed_values));
 
-  SleqpFuncCallbacks callbacks = {.set_value = fixed_var_func_set,
-                                  .nonzeros  = fixed_var_func_nonzeros,
-                                  .obj_val   = fixed_var_obj_val,
-                                  .obj_grad  = fixed_var_obj_grad,
-                                  .cons_val  = fixed_var_cons_val,
-                                  .cons_jac  = fixed_var_cons_jac,
-                                  .hess_prod = fixed_var_hess_prod,
-                                  .func_free = fixed_func_free};
+  SleqpFuncCallbacks callbacks = {.set_value  = fixed_var_func_set,
+                                  .nonzeros   = fixed_var_func_nonzeros,
+                                  .obj_val    = fixed_var_obj_val,
+                                  .obj_grad   = fixed_var_obj_grad,
+                                  .cons_val   = fixed_var_cons_val,
+                                  .cons_jac   = fixed_var_cons_jac,
+                                  .hess_prod  = fixed_var_hess_prod,
+                                  .func_free  = fixed_func_free,
+                                  .hess_prods = fixed_var_hess_prods,
+                                  .clone      = fixed_var_func_clone};
 
   SLEQP_CALL(sleqp_func_create(star,
                                &callbacks,
@@ -769,6 +769,53 @@ sleqp_preprocessor_result(SleqpPreprocessor* preprocessor)
   return SLEQP_PREPROCESSING_RESULT_FAILURE;
 }
 
+bool
+sleqp_preprocessor_eq(SleqpPreprocessor* first, SleqpPreprocessor* second)
+{
+  SleqpProblem* first_problem  = first->original_problem;
+  SleqpProblem* second_problem = second->original_problem;
+
+  const int num_variables = sleqp_problem_num_vars(first_problem);
+  const int num_linear    = sleqp_problem_num_lin_cons(first_problem);
+
+  if (num_variables != sleqp_problem_num_vars(second_problem)
+      || num_linear != sleqp_problem_num_lin_cons(second_problem)
+      || first->infeasible != second->infeasible)
+  {
+    return false;
+  }
+
+  const SleqpVariableState* first_var_states
+    = sleqp_preprocessing_state_variable_states(first->preprocessing_state);
+  const SleqpVariableState* second_var_states
+    = sleqp_preprocessing_state_variable_states(second->preprocessing_state);
+
+  for (int j = 0; j < num_variables; ++j)
+  {
+    if (first_var_states[j].state != second_var_states[j].state)
+    {
+      return false;
+    }
+  }
+
+  const SleqpConstraintState* first_cons_states
+    = sleqp_preprocessing_state_linear_constraint_states(
+      first->preprocessing_state);
+  const SleqpConstraintState* second_cons_states
+    = sleqp_preprocessing_state_linear_constraint_states(
+      second->preprocessing_state);
+
+  for (int i = 0; i < num_linear; ++i)
+  {
+    if (first_cons_states[i].state != second_cons_states[i].state)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 SleqpProblem*
 sleqp_preprocessor_transformed_problem(SleqpPreprocessor* preprocessor)
 {
@@ -20,6 +20,15 @@ sleqp_preprocessor_create(SleqpPreprocessor** star,
 SLEQP_PREPROCESSING_RESULT
 sleqp_preprocessor_result(SleqpPreprocessor* preprocessor);
 
+/**
+ * Returns whether both preprocessors transform their problems in the
+ * same way, i.e., remove the same variables and linear constraints.
+ * Transformed primal and dual vectors of one preprocessor are then
+ * valid for the other one.
+ **/
+bool
+sleqp_preprocessor_eq(SleqpPreprocessor* first, SleqpPreprocessor* second);
+
 SleqpProblem*
 sleqp_preprocessor_transformed_problem(SleqpPreprocessor* preprocessor);
 
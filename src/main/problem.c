@@ -1,6 +1,7 @@
 #include "problem.h"
 
 #include <math.h>
+#include <string.h>
 
 #include "cmp.h"
 #include "error.h"
@@ -12,6 +13,10 @@
 #include "sparse/mat.h"
 #include "sparse/pub_mat.h"
 
+// Number of Jacobians (e.g., of the current and trial iterates)
+// whose linear rows are kept in place
+#define NUM_STACKED_JACS 4
+
 typedef struct SleqpProblem
 {
   int refcount;
@@ -42,12 +47,24 @@ typedef struct SleqpProblem
   double* dense_cache;
 
   SleqpVec* general_cons_val;
-  SleqpVec* linear_cons_val;
 
   SleqpVec* general_cons_duals;
 
   SleqpMat* general_cons_jac;
 
+  // Column pointers of the general Jacobian at the last stacking
+  int* general_jac_cols;
+  bool has_general_jac_cols;
+
+  // Stacked Jacobians whose linear rows are up to date,
+  // along with their pattern versions
+  SleqpMat* stacked_jacs[NUM_STACKED_JACS];
+  uint64_t stacked_versions[NUM_STACKED_JACS];
+  int next_stacked_jac;
+
+  // Incremented whenever bounds or coefficients are changed
+  int version;
+
 } SleqpProblem;
 
 static SLEQP_RETCODE
@@ -257,6 +274,8 @@ problem_create(SleqpProblem** star,
   SLEQP_CALL(
     sleqp_mat_create(&problem->linear_coeffs, 0, problem->num_variables, 0));
 
+  SLEQP_CALL(sleqp_vec_create_full(&problem->primal, num_variables));
+
   SLEQP_CALL(sleqp_vec_create_empty(&problem->cons_lb, 0));
 
   SLEQP_CALL(sleqp_vec_create_empty(&problem->cons_ub, 0));
@@ -341,19 +360,17 @@ sleqp_problem_create(SleqpProblem** star,
                                 num_variables,
                                 0));
 
-    SLEQP_CALL(sleqp_vec_create_full(&problem->primal, num_variables));
-
-    SLEQP_CALL(sleqp_vec_create_empty(&problem->general_cons_val,
-                                      problem->num_general_constraints));
-
-    SLEQP_CALL(sleqp_vec_create_empty(&problem->linear_cons_val,
-                                      num_linear_constraints));
+    SLEQP_CALL(sleqp_vec_create_full(&problem->general_cons_val,
+                                     problem->num_general_constraints));
 
     SLEQP_CALL(sleqp_vec_create_empty(&problem->general_cons_duals,
                                       problem->num_general_constraints));
 
     SLEQP_CALL(
       sleqp_alloc_array(&problem->dense_cache, num_linear_constraints));
+
+    SLEQP_CALL(
+      sleqp_alloc_array(&problem->general_jac_cols, num_variables + 1));
   }
 
   SLEQP_CALL(stack_bounds(problem));
@@ -361,6 +378,36 @@ sleqp_problem_create(SleqpProblem** star,
   return SLEQP_OKAY;
 }
 
+SLEQP_RETCODE
+sleqp_problem_clone(SleqpProblem* problem, SleqpProblem** star)
+{
+  SleqpFunc* func;
+
+  *star = NULL;
+
+  SLEQP_CALL(sleqp_func_clone(problem->func, &func));
+
+  if (!func)
+  {
+    return SLEQP_OKAY;
+  }
+
+  SLEQP_CALL(sleqp_problem_create(star,
+                                  func,
+                                  sleqp_problem_vars_lb(problem),
+                                  sleqp_problem_vars_ub(problem),
+                                  sleqp_problem_general_lb(problem),
+                                  sleqp_problem_general_ub(problem),
+                                  sleqp_problem_linear_coeffs(problem),
+                                  sleqp_problem_linear_lb(problem),
+                                  sleqp_problem_linear_ub(problem),
+                                  problem->settings));
+
+  SLEQP_CALL(sleqp_func_release(&func));
+
+  return SLEQP_OKAY;
+}
+
 SleqpSettings*
 sleqp_problem_settings(SleqpProblem* problem)
 {
@@ -465,14 +512,17 @@ sleqp_problem_set_value(SleqpProblem* problem,
 {
   SLEQP_CALL(sleqp_func_set_value(problem->func, x, reason, reject));
 
-  if (problem->primal)
-  {
-    SLEQP_CALL(sleqp_vec_copy(x, problem->primal));
-  }
+  SLEQP_CALL(sleqp_vec_copy(x, problem->primal));
 
   return SLEQP_OKAY;
 }
 
+const SleqpVec*
+sleqp_problem_primal(const SleqpProblem* problem)
+{
+  return problem->primal;
+}
+
 SLEQP_NODISCARD SLEQP_RETCODE
 sleqp_problem_nonzeros(SleqpProblem* problem,
                        int* obj_grad_nnz,
@@ -568,21 +618,119 @@ sleqp_problem_cons_val(SleqpProblem* problem, SleqpVec* cons_val)
                                   problem->num_linear_constraints,
                                   zero_eps);
   }
-  else
+
+  const SleqpVec* general_cons_val = problem->general_cons_val;
+
+  SLEQP_CALL(sleqp_func_cons_val(problem->func, problem->general_cons_val));
+
+  // Append the linear values directly instead of concatenating
+  SLEQP_CALL(sleqp_vec_clear(cons_val));
+  SLEQP_CALL(sleqp_vec_reserve(cons_val,
+                               general_cons_val->nnz
+                                 + problem->num_linear_constraints));
+
+  for (int k = 0; k < general_cons_val->nnz; ++k)
   {
-    SLEQP_CALL(sleqp_vec_set_from_raw(problem->linear_cons_val,
-                                      problem->dense_cache,
-                                      problem->num_linear_constraints,
-                                      zero_eps));
+    SLEQP_CALL(sleqp_vec_push(cons_val,
+                              general_cons_val->indices[k],
+                              general_cons_val->data[k]));
+  }
+
+  const int offset = problem->num_general_constraints;
 
-    SLEQP_CALL(sleqp_func_cons_val(problem->func, problem->general_cons_val));
+  for (int i = 0; i < problem->num_linear_constraints; ++i)
+  {
+    const double value = problem->dense_cache[i];
 
-    return sleqp_vec_concat(problem->general_cons_val,
-                            problem->linear_cons_val,
-                            cons_val);
+    if (!sleqp_is_zero(value, zero_eps))
+    {
+      SLEQP_CALL(sleqp_vec_push(cons_val, offset + i, value));
+    }
   }
+
+  return SLEQP_OKAY;
+}
+
+static int
+stacked_jac_index(const SleqpProblem* problem, const SleqpMat* cons_jac)
+{
+  for (int index = 0; index < NUM_STACKED_JACS; ++index)
+  {
+    if (problem->stacked_jacs[index] == cons_jac
+        && problem->stacked_versions[index] == sleqp_mat_version(cons_jac))
+    {
+      return index;
+    }
+  }
+
+  return SLEQP_NONE;
+}
+
+static SLEQP_RETCODE
+add_stacked_jac(SleqpProblem* problem, SleqpMat* cons_jac)
+{
+  int index = SLEQP_NONE;
+
+  for (int other = 0; other < NUM_STACKED_JACS; ++other)
+  {
+    if (problem->stacked_jacs[other] == cons_jac)
+    {
+      index = other;
+    }
+  }
+
+  if (index == SLEQP_NONE)
+  {
+    index                     = problem->next_stacked_jac;
+    problem->next_stacked_jac = (index + 1) % NUM_STACKED_JACS;
+  }
+
+  SLEQP_CALL(sleqp_mat_capture(cons_jac));
+  SLEQP_CALL(sleqp_mat_release(problem->stacked_jacs + index));
+
+  problem->stacked_jacs[index]     = cons_jac;
+  problem->stacked_versions[index] = sleqp_mat_version(cons_jac);
+
+  return SLEQP_OKAY;
+}
+
+static SLEQP_RETCODE
+clear_stacked_jacs(SleqpProblem* problem)
+{
+  for (int index = 0; index < NUM_STACKED_JACS; ++index)
+  {
+    SLEQP_CALL(sleqp_mat_release(problem->stacked_jacs + index));
+  }
+
+  return SLEQP_OKAY;
+}
+
+// Returns whether the general Jacobian has as many entries per column
+// as it had during the last stacking, saving the current counts otherwise
+static bool
+update_general_jac_cols(SleqpProblem* problem)
+{
+  const int* cols = sleqp_mat_cols(problem->general_cons_jac);
+
+  const size_t size = sizeof(int) * (problem->num_variables + 1);
+
+  if (problem->has_general_jac_cols
+      && memcmp(problem->general_jac_cols, cols, size) == 0)
+  {
+    return true;
+  }
+
+  memcpy(problem->general_jac_cols, cols, size);
+  problem->has_general_jac_cols = true;
+
+  return false;
 }
 
+/*
+ * The linear rows of the Jacobian are constant. Once stacked into a
+ * Jacobian, only the general rows are overwritten in subsequent
+ * evaluations, as long as the Jacobian is not modified otherwise.
+ */
 SLEQP_RETCODE
 sleqp_problem_cons_jac(SleqpProblem* problem, SleqpMat* cons_jac)
 {
@@ -591,16 +739,41 @@ sleqp_problem_cons_jac(SleqpProblem* problem, SleqpMat* cons_jac)
     return sleqp_func_cons_jac(problem->func, cons_jac);
   }
 
+  const int index = stacked_jac_index(problem, cons_jac);
+
   if (problem->num_general_constraints == 0)
   {
-    return sleqp_mat_copy(problem->linear_coeffs, cons_jac);
+    if (index == SLEQP_NONE)
+    {
+      SLEQP_CALL(sleqp_mat_copy(problem->linear_coeffs, cons_jac));
+      SLEQP_CALL(add_stacked_jac(problem, cons_jac));
+    }
+
+    return SLEQP_OKAY;
   }
 
   SLEQP_CALL(sleqp_func_cons_jac(problem->func, problem->general_cons_jac));
 
-  return sleqp_mat_vstack(problem->general_cons_jac,
-                          problem->linear_coeffs,
-                          cons_jac);
+  if (!update_general_jac_cols(problem))
+  {
+    SLEQP_CALL(clear_stacked_jacs(problem));
+  }
+  else if (index != SLEQP_NONE)
+  {
+    SLEQP_CALL(sleqp_mat_vstack_update(problem->general_cons_jac, cons_jac));
+
+    problem->stacked_versions[index] = sleqp_mat_version(cons_jac);
+
+    return SLEQP_OKAY;
+  }
+
+  SLEQP_CALL(sleqp_mat_vstack(problem->general_cons_jac,
+                              problem->linear_coeffs,
+                              cons_jac));
+
+  SLEQP_CALL(add_stacked_jac(problem, cons_jac));
+
+  return SLEQP_OKAY;
 }
 
 static SLEQP_RETCODE
@@ -650,6 +823,28 @@ sleqp_problem_hess_prod(SleqpProblem* problem,
                               product);
 }
 
+SLEQP_RETCODE
+sleqp_problem_hess_prods(SleqpProblem* problem,
+                         const SleqpMat* directions,
+                         const SleqpVec* cons_duals,
+                         SleqpMat* products)
+{
+  if (problem->num_linear_constraints == 0)
+  {
+    return sleqp_func_hess_prods(problem->func,
+                                 directions,
+                                 cons_duals,
+                                 products);
+  }
+
+  SLEQP_CALL(prepare_cons_duals(problem, cons_duals));
+
+  return sleqp_func_hess_prods(problem->func,
+                               directions,
+                               problem->general_cons_duals,
+                               products);
+}
+
 SLEQP_RETCODE
 sleqp_problem_hess_bilinear(SleqpProblem* problem,
                             const SleqpVec* direction,
@@ -694,6 +889,98 @@ vec_has_finite(const SleqpVec* vec)
   return false;
 }
 
+SLEQP_RETCODE
+sleqp_problem_set_vars_bounds(SleqpProblem* problem,
+                              const SleqpVec* var_lb,
+                              const SleqpVec* var_ub)
+{
+  SLEQP_CALL(check_bounds(var_lb, var_ub, false));
+
+  SLEQP_CALL(convert_lb(var_lb, problem->num_variables, &problem->var_lb));
+  SLEQP_CALL(convert_ub(var_ub, problem->num_variables, &problem->var_ub));
+
+  ++problem->version;
+
+  return SLEQP_OKAY;
+}
+
+SLEQP_RETCODE
+sleqp_problem_set_general_bounds(SleqpProblem* problem,
+                                 const SleqpVec* general_lb,
+                                 const SleqpVec* general_ub)
+{
+  const int num_general = problem->num_general_constraints;
+
+  SLEQP_CALL(check_bounds(general_lb, general_ub, true));
+
+  SLEQP_CALL(convert_lb(general_lb, num_general, &problem->general_lb));
+  SLEQP_CALL(convert_ub(general_ub, num_general, &problem->general_ub));
+
+  SLEQP_CALL(stack_bounds(problem));
+
+  ++problem->version;
+
+  return SLEQP_OKAY;
+}
+
+SLEQP_RETCODE
+sleqp_problem_set_linear_bounds(SleqpProblem* problem,
+                                const SleqpVec* linear_lb,
+                                const SleqpVec* linear_ub)
+{
+  const int num_linear = problem->num_linear_constraints;
+
+  SLEQP_CALL(check_bounds(linear_lb, linear_ub, true));
+
+  SLEQP_CALL(convert_lb(linear_lb, num_linear, &problem->linear_lb));
+  SLEQP_CALL(convert_ub(linear_ub, num_linear, &problem->linear_ub));
+
+  SLEQP_CALL(stack_bounds(problem));
+
+  ++problem->version;
+
+  return SLEQP_OKAY;
+}
+
+SLEQP_RETCODE
+sleqp_problem_set_linear_coeffs(SleqpProblem* problem,
+                                const SleqpMat* linear_coeffs)
+{
+  sleqp_assert_msg(sleqp_mat_num_rows(linear_coeffs)
+                       == problem->num_linear_constraints
+                     && sleqp_mat_num_cols(linear_coeffs)
+                          == problem->num_variables,
+                   "Linear constraint dimensions are inconsistent");
+
+  sleqp_assert_msg(sleqp_mat_is_valid(linear_coeffs),
+                   "Linear coefficient matrix is invalid");
+
+  sleqp_assert_msg(sleqp_mat_is_finite(linear_coeffs),
+                   "Linear coefficient matrix is not all-finite");
+
+  SLEQP_CALL(sleqp_mat_copy(linear_coeffs, problem->linear_coeffs));
+
+  SLEQP_CALL(sleqp_problem_invalidate(problem));
+
+  return SLEQP_OKAY;
+}
+
+SLEQP_RETCODE
+sleqp_problem_invalidate(SleqpProblem* problem)
+{
+  SLEQP_CALL(clear_stacked_jacs(problem));
+
+  ++problem->version;
+
+  return SLEQP_OKAY;
+}
+
+int
+sleqp_problem_version(const SleqpProblem* problem)
+{
+  return problem->version;
+}
+
 bool
 sleqp_problem_is_unconstrained(SleqpProblem* problem)
 {
@@ -713,12 +1000,14 @@ problem_free(SleqpProblem** star)
     return SLEQP_OKAY;
   }
 
+  SLEQP_CALL(clear_stacked_jacs(problem));
+
+  sleqp_free(&problem->general_jac_cols);
+
   SLEQP_CALL(sleqp_mat_release(&problem->general_cons_jac));
 
   SLEQP_CALL(sleqp_vec_free(&problem->general_cons_val));
 
-  SLEQP_CALL(sleqp_vec_free(&problem->linear_cons_val));
-
   SLEQP_CALL(sleqp_vec_free(&problem->general_cons_duals));
 
   sleqp_free(&problem->dense_cache);
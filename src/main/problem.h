@@ -13,6 +13,18 @@ sleqp_problem_settings(SleqpProblem* problem);
 bool
 sleqp_problem_has_nonlinear_cons(SleqpProblem* problem);
 
+/**
+ * Creates a copy of the given problem based on a copy of its function,
+ * see @ref sleqp_func_clone. The copy may be evaluated concurrently with
+ * the original problem.
+ *
+ * @param[in]  problem   The problem
+ * @param[out] star      The copy, `NULL` if the function cannot be copied
+ **/
+SLEQP_NODISCARD
+SLEQP_RETCODE
+sleqp_problem_clone(SleqpProblem* problem, SleqpProblem** star);
+
 SLEQP_NODISCARD
 SLEQP_RETCODE
 sleqp_problem_set_value(SleqpProblem* problem,
@@ -20,6 +32,12 @@ sleqp_problem_set_value(SleqpProblem* problem,
                         SLEQP_VALUE_REASON reason,
                         bool* reject);
 
+/**
+ * Returns the point most recently passed to @ref sleqp_problem_set_value
+ **/
+const SleqpVec*
+sleqp_problem_primal(const SleqpProblem* problem);
+
 SLEQP_NODISCARD SLEQP_RETCODE
 sleqp_problem_nonzeros(SleqpProblem* problem,
                        int* obj_grad_nnz,
@@ -58,6 +76,13 @@ sleqp_problem_hess_prod(SleqpProblem* problem,
                         const SleqpVec* cons_duals,
                         SleqpVec* product);
 
+SLEQP_NODISCARD
+SLEQP_RETCODE
+sleqp_problem_hess_prods(SleqpProblem* problem,
+                         const SleqpMat* directions,
+                         const SleqpVec* cons_duals,
+                         SleqpMat* products);
+
 SLEQP_NODISCARD
 SLEQP_RETCODE
 sleqp_problem_hess_bilinear(SleqpProblem* problem,
@@ -68,4 +93,19 @@ sleqp_problem_hess_bilinear(SleqpProblem* problem,
 bool
 sleqp_problem_is_unconstrained(SleqpProblem* problem);
 
+/**
+ * Invalidates data derived from the bounds and the linear coefficients
+ * after they have been modified in place
+ **/
+SLEQP_NODISCARD
+SLEQP_RETCODE
+sleqp_problem_invalidate(SleqpProblem* problem);
+
+/**
+ * Returns a counter which changes whenever the bounds or the linear
+ * coefficients of the problem are updated
+ **/
+int
+sleqp_problem_version(const SleqpProblem* problem);
+
 #endif /* SLEQP_PROBLEM_H */
@@ -8,6 +8,7 @@
 #include "lsq.h"
 #include "math_error.h"
 #include "mem.h"
+#include "problem.h"
 #include "sparse/mat.h"
 
 struct SleqpProblemScaling
@@ -26,6 +27,9 @@ struct SleqpProblemScaling
 
   SleqpVec* scaled_direction;
 
+  SleqpMat* unscaled_directions;
+  SleqpMat* unscaled_products;
+
   double* scaled_cons_weights;
   SleqpVec* scaled_cons_duals;
 };
@@ -186,6 +190,84 @@ scaled_func_hess_prod(SleqpFunc* func,
   return SLEQP_OKAY;
 }
 
+static SLEQP_RETCODE
+scaled_func_hess_prods(SleqpFunc* func,
+                       const SleqpMat* directions,
+                       const SleqpVec* cons_duals,
+                       SleqpMat* products,
+                       void* func_data)
+{
+  SleqpProblemScaling* problem_scaling = (SleqpProblemScaling*)func_data;
+  SleqpScaling* scaling                = problem_scaling->scaling;
+
+  SleqpVec* direction           = problem_scaling->scaled_direction;
+  SleqpMat* unscaled_directions = problem_scaling->unscaled_directions;
+  SleqpMat* unscaled_products   = problem_scaling->unscaled_products;
+
+  const int num_variables = sleqp_mat_num_rows(directions);
+  const int num_cols      = sleqp_mat_num_cols(directions);
+
+  const int error_flags
+    = sleqp_settings_enum_value(problem_scaling->settings,
+                               SLEQP_SETTINGS_ENUM_FLOAT_ERROR_FLAGS);
+
+  const int warn_flags
+    = sleqp_settings_enum_value(problem_scaling->settings,
+                               SLEQP_SETTINGS_ENUM_FLOAT_WARNING_FLAGS);
+
+  SLEQP_CALL(sleqp_mat_resize(unscaled_directions, num_variables, num_cols));
+  SLEQP_CALL(sleqp_mat_resize(unscaled_products, num_variables, num_cols));
+
+  SLEQP_CALL(sleqp_mat_clear(unscaled_directions));
+  SLEQP_CALL(sleqp_mat_reserve(unscaled_directions, sleqp_mat_nnz(directions)));
+
+  for (int col = 0; col < num_cols; ++col)
+  {
+    SLEQP_CALL(sleqp_mat_col(directions, col, direction));
+
+    SLEQP_CALL(sleqp_vec_copy(cons_duals, problem_scaling->scaled_cons_duals));
+
+    {
+      SLEQP_INIT_MATH_CHECK;
+
+      SLEQP_CALL(
+        sleqp_unscale_hessian_direction(scaling,
+                                        direction,
+                                        problem_scaling->scaled_cons_duals));
+
+      SLEQP_MATH_CHECK(error_flags, warn_flags);
+    }
+
+    SLEQP_CALL(sleqp_mat_push_col(unscaled_directions, col));
+    SLEQP_CALL(sleqp_mat_push_vec(unscaled_directions, col, direction));
+  }
+
+  SLEQP_CALL(sleqp_func_hess_prods(problem_scaling->func,
+                                   unscaled_directions,
+                                   problem_scaling->scaled_cons_duals,
+                                   unscaled_products));
+
+  SLEQP_CALL(sleqp_mat_reserve(products, sleqp_mat_nnz(unscaled_products)));
+
+  for (int col = 0; col < num_cols; ++col)
+  {
+    SLEQP_CALL(sleqp_mat_col(unscaled_products, col, direction));
+
+    {
+      SLEQP_INIT_MATH_CHECK;
+
+      SLEQP_CALL(sleqp_scale_hessian_product(scaling, direction));
+
+      SLEQP_MATH_CHECK(error_flags, warn_flags);
+    }
+
+    SLEQP_CALL(sleqp_mat_push_col(products, col));
+    SLEQP_CALL(sleqp_mat_push_vec(products, col, direction));
+  }
+
+  return SLEQP_OKAY;
+}
+
 static SLEQP_RETCODE
 scaled_lsq_func_nonzeros(SleqpFunc* func,
                          int* residual_nnz,
@@ -338,6 +420,75 @@ scaled_dyn_func_set_cons_weights(SleqpFunc* func,
   return SLEQP_OKAY;
 }
 
+static SLEQP_RETCODE
+scaled_func_clone(SleqpFunc* func, SleqpFunc** clone, void* func_data);
+
+static SleqpFuncCallbacks
+scaled_func_callbacks(SLEQP_FUNC_FREE func_free)
+{
+  return (SleqpFuncCallbacks){.set_value  = scaled_func_set_value,
+                              .nonzeros   = scaled_func_nonzeros,
+                              .obj_val    = scaled_func_obj_val,
+                              .obj_grad   = scaled_func_obj_grad,
+                              .cons_val   = scaled_func_cons_val,
+                              .cons_jac   = scaled_func_cons_jac,
+                              .hess_prod  = scaled_func_hess_prod,
+                              .func_free  = func_free,
+                              .hess_prods = scaled_func_hess_prods,
+                              .clone      = scaled_func_clone};
+}
+
+static SLEQP_RETCODE
+scaled_func_clone_free(void* func_data)
+{
+  SleqpProblemScaling* problem_scaling = (SleqpProblemScaling*)func_data;
+
+  SLEQP_CALL(sleqp_problem_scaling_release(&problem_scaling));
+
+  return SLEQP_OKAY;
+}
+
+/*
+ * Copies wrap a copy of the unscaled problem in a separate problem
+ * scaling. To avoid a reference cycle, the separate scaling does not
+ * keep the copied function but is released alongside it.
+ */
+static SLEQP_RETCODE
+scaled_func_clone(SleqpFunc* func, SleqpFunc** clone, void* func_data)
+{
+  SleqpProblemScaling* problem_scaling = (SleqpProblemScaling*)func_data;
+
+  SleqpProblem* problem;
+  SleqpProblemScaling* clone_scaling;
+
+  *clone = NULL;
+
+  SLEQP_CALL(sleqp_problem_clone(problem_scaling->problem, &problem));
+
+  if (!problem)
+  {
+    return SLEQP_OKAY;
+  }
+
+  SLEQP_CALL(sleqp_problem_scaling_create(&clone_scaling,
+                                          problem_scaling->scaling,
+                                          problem,
+                                          problem_scaling->settings));
+
+  SLEQP_CALL(sleqp_problem_release(&problem));
+
+  SLEQP_CALL(sleqp_problem_release(&clone_scaling->scaled_problem));
+
+  *clone                     = clone_scaling->scaled_func;
+  clone_scaling->scaled_func = NULL;
+
+  SleqpFuncCallbacks callbacks = scaled_func_callbacks(scaled_func_clone_free);
+
+  SLEQP_CALL(sleqp_func_set_callbacks(*clone, &callbacks));
+
+  return SLEQP_OKAY;
+}
+
 static SLEQP_RETCODE
 func_create(SleqpProblemScaling* problem_scaling)
 {
@@ -346,14 +497,7 @@ func_create(SleqpProblemScaling* problem_scaling)
   const int num_variables   = sleqp_problem_num_vars(problem);
   const int num_constraints = sleqp_problem_num_cons(problem);
 
-  SleqpFuncCallbacks callbacks = {.set_value = scaled_func_set_value,
-                                  .nonzeros  = scaled_func_nonzeros,
-                                  .obj_val   = scaled_func_obj_val,
-                                  .obj_grad  = scaled_func_obj_grad,
-                                  .cons_val  = scaled_func_cons_val,
-                                  .cons_jac  = scaled_func_cons_jac,
-                                  .hess_prod = scaled_func_hess_prod,
-                                  .func_free = NULL};
+  SleqpFuncCallbacks callbacks = scaled_func_callbacks(NULL);
 
   SLEQP_CALL(sleqp_func_create(&(problem_scaling->scaled_func),
                                &callbacks,
@@ -526,6 +670,16 @@ sleqp_problem_scaling_create(SleqpProblemScaling** star,
   SLEQP_CALL(sleqp_vec_create_empty(&(problem_scaling->scaled_cons_duals),
                                     num_constraints));
 
+  SLEQP_CALL(sleqp_mat_create(&(problem_scaling->unscaled_directions),
+                              num_variables,
+                              0,
+                              0));
+
+  SLEQP_CALL(sleqp_mat_create(&(problem_scaling->unscaled_products),
+                              num_variables,
+                              0,
+                              0));
+
   return SLEQP_OKAY;
 }
 
@@ -609,6 +763,8 @@ sleqp_problem_scaling_flush(SleqpProblemScaling* problem_scaling)
 
   SLEQP_MATH_CHECK(error_flags, warn_flags);
 
+  SLEQP_CALL(sleqp_problem_invalidate(scaled_problem));
+
   return SLEQP_OKAY;
 }
 
@@ -624,6 +780,9 @@ problem_scaling_free(SleqpProblemScaling** star)
 
   SLEQP_CALL(sleqp_vec_free(&(problem_scaling->scaled_cons_duals)));
 
+  SLEQP_CALL(sleqp_mat_release(&(problem_scaling->unscaled_products)));
+  SLEQP_CALL(sleqp_mat_release(&(problem_scaling->unscaled_directions)));
+
   sleqp_free(&problem_scaling->scaled_cons_weights);
 
   SLEQP_CALL(sleqp_vec_free(&(problem_scaling->scaled_direction)));
@@ -122,6 +122,27 @@ sleqp_problem_solver_reset(SleqpProblemSolver* solver)
   return SLEQP_OKAY;
 }
 
+SLEQP_RETCODE
+sleqp_problem_solver_warm_start(SleqpProblemSolver* solver,
+                                const SleqpProblemSolver* source)
+{
+  if (source == solver)
+  {
+    return SLEQP_OKAY;
+  }
+
+  SLEQP_CALL(sleqp_iterate_copy(source->iterate, solver->iterate));
+
+  solver->trust_radius      = source->trust_radius;
+  solver->lp_trust_radius   = source->lp_trust_radius;
+  solver->penalty_parameter = source->penalty_parameter;
+
+  SLEQP_CALL(sleqp_trial_point_solver_copy_basis(source->trial_point_solver,
+                                                 solver->trial_point_solver));
+
+  return SLEQP_OKAY;
+}
+
 SLEQP_RETCODE
 sleqp_problem_solver_abort(SleqpProblemSolver* solver)
 {
@@ -150,6 +171,12 @@ sleqp_problem_solver_elapsed_seconds(const SleqpProblemSolver* solver)
   return sleqp_timer_get_ttl(solver->elapsed_timer);
 }
 
+int
+sleqp_problem_solver_lp_iterations(const SleqpProblemSolver* solver)
+{
+  return sleqp_trial_point_solver_lp_iterations(solver->trial_point_solver);
+}
+
 SLEQP_RETCODE
 sleqp_problem_solver_set_cons_weights(SleqpProblemSolver* solver)
 {
@@ -185,6 +212,8 @@ problem_solver_free(SleqpProblemSolver** star)
     SLEQP_CALL(sleqp_callback_handler_release(solver->callback_handlers + i));
   }
 
+  SLEQP_CALL(sleqp_trace_release(&solver->trace));
+
   SLEQP_CALL(sleqp_merit_release(&solver->merit));
 
   SLEQP_CALL(sleqp_deriv_checker_free(&solver->deriv_checker));
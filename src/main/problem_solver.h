@@ -7,6 +7,7 @@
 #include "callback_handler.h"
 #include "deriv_check.h"
 #include "problem_solver_types.h"
+#include "trace.h"
 #include "trial_point.h"
 
 #include "step/step_rule.h"
@@ -83,6 +84,11 @@ struct SleqpProblemSolver
   double current_merit_value;
 
   bool abort_on_local_infeasibility;
+
+  SleqpTrace* trace;
+
+  // Total times at the last traced iteration
+  SleqpTraceRow trace_times;
 };
 
 SLEQP_NODISCARD
@@ -110,6 +116,16 @@ SLEQP_NODISCARD
 SLEQP_RETCODE
 sleqp_problem_solver_reset(SleqpProblemSolver* solver);
 
+/**
+ * Adopts the current iterate, including its multipliers and
+ * working set, the trust radii, the penalty parameter, and
+ * the LP basis of the source
+ **/
+SLEQP_NODISCARD
+SLEQP_RETCODE
+sleqp_problem_solver_warm_start(SleqpProblemSolver* solver,
+                                const SleqpProblemSolver* source);
+
 SLEQP_NODISCARD
 SLEQP_RETCODE
 sleqp_problem_solver_abort(SleqpProblemSolver* solver);
@@ -124,6 +140,9 @@ sleqp_problem_solver_elapsed_iterations(const SleqpProblemSolver* solver);
 double
 sleqp_problem_solver_elapsed_seconds(const SleqpProblemSolver* solver);
 
+int
+sleqp_problem_solver_lp_iterations(const SleqpProblemSolver* solver);
+
 SLEQP_NODISCARD
 SLEQP_RETCODE
 sleqp_problem_solver_set_cons_weights(SleqpProblemSolver* solver);
@@ -138,6 +157,15 @@ SLEQP_NODISCARD
 SLEQP_RETCODE
 sleqp_problem_solver_print_stats(const SleqpProblemSolver* solver);
 
+/**
+ * Adds the timing statistics of the solver, indexed by
+ * @ref SLEQP_SOLVER_TIMING
+ **/
+SLEQP_NODISCARD
+SLEQP_RETCODE
+sleqp_problem_solver_add_timing_stats(const SleqpProblemSolver* solver,
+                                      SleqpTimingStats* stats);
+
 SLEQP_NODISCARD
 SLEQP_RETCODE
 sleqp_problem_solver_set_func_value(SleqpProblemSolver* solver,
@@ -189,6 +217,21 @@ sleqp_problem_solver_print_initial_line(SleqpProblemSolver* solver);
 SLEQP_RETCODE
 sleqp_problem_solver_print_line(SleqpProblemSolver* solver);
 
+/**
+ * Sets the trace receiving one row per iteration, may be `NULL`
+ **/
+SLEQP_NODISCARD
+SLEQP_RETCODE
+sleqp_problem_solver_set_trace(SleqpProblemSolver* solver, SleqpTrace* trace);
+
+SLEQP_NODISCARD
+SLEQP_RETCODE
+sleqp_problem_solver_trace_reset(SleqpProblemSolver* solver);
+
+SLEQP_NODISCARD
+SLEQP_RETCODE
+sleqp_problem_solver_trace_line(SleqpProblemSolver* solver);
+
 SLEQP_NODISCARD
 SLEQP_RETCODE
 sleqp_problem_solver_perform_iteration(SleqpProblemSolver* solver);
@@ -573,6 +573,10 @@ sleqp_problem_solver_perform_iteration(SleqpProblemSolver* solver)
 
   SLEQP_CALL(sleqp_problem_solver_print_line(solver));
 
+#ifdef SLEQP_ENABLE_TRACE
+  SLEQP_CALL(sleqp_problem_solver_trace_line(solver));
+#endif
+
   SLEQP_CALL(update_trust_radii(solver,
                                 reduction_ratio,
                                 trial_step_norm,
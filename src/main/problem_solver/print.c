@@ -268,3 +268,14 @@ sleqp_problem_solver_print_stats(const SleqpProblemSolver* solver)
 
   return SLEQP_OKAY;
 }
+
+SLEQP_RETCODE
+sleqp_problem_solver_add_timing_stats(const SleqpProblemSolver* solver,
+                                      SleqpTimingStats* stats)
+{
+  SLEQP_CALL(
+    sleqp_trial_point_solver_add_timing_stats(solver->trial_point_solver,
+                                              stats));
+
+  return SLEQP_OKAY;
+}
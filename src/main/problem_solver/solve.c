@@ -147,6 +147,8 @@ sleqp_problem_solver_solve(SleqpProblemSolver* solver,
 
   SLEQP_CALL(sleqp_timer_reset(solver->elapsed_timer));
 
+  SLEQP_CALL(sleqp_problem_solver_trace_reset(solver));
+
   const double deadpoint_bound
     = sleqp_settings_real_value(solver->settings,
                                 SLEQP_SETTINGS_REAL_DEADPOINT_BOUND);
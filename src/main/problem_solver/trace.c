@@ -0,0 +1,112 @@
+#include "problem_solver.h"
+
+#include "func.h"
+
+static double
+func_time(SleqpFunc* func)
+{
+  return sleqp_timer_get_ttl(sleqp_func_get_set_timer(func))
+         + sleqp_timer_get_ttl(sleqp_func_get_val_timer(func))
+         + sleqp_timer_get_ttl(sleqp_func_get_grad_timer(func))
+         + sleqp_timer_get_ttl(sleqp_func_get_cons_val_timer(func))
+         + sleqp_timer_get_ttl(sleqp_func_get_cons_jac_timer(func))
+         + sleqp_timer_get_ttl(sleqp_func_get_hess_timer(func));
+}
+
+// Collects the total times spent so far into the given row
+static SLEQP_RETCODE
+collect_times(SleqpProblemSolver* solver, SleqpTraceRow* row)
+{
+  SleqpTimingStats stats[SLEQP_SOLVER_NUM_TIMINGS] = {0};
+
+  SLEQP_CALL(sleqp_problem_solver_add_timing_stats(solver, stats));
+
+  row->func_time = func_time(sleqp_problem_func(solver->problem));
+  row->lp_time   = stats[SLEQP_SOLVER_TIMING_LP].wall_time;
+  row->eqp_time  = stats[SLEQP_SOLVER_TIMING_EQP].wall_time;
+  row->fact_time = stats[SLEQP_SOLVER_TIMING_FACTORIZATION].wall_time
+                   + stats[SLEQP_SOLVER_TIMING_SUBSTITUTION].wall_time;
+  row->linesearch_time = stats[SLEQP_SOLVER_TIMING_LINESEARCH].wall_time;
+
+  return SLEQP_OKAY;
+}
+
+SLEQP_RETCODE
+sleqp_problem_solver_set_trace(SleqpProblemSolver* solver, SleqpTrace* trace)
+{
+  if (trace)
+  {
+    SLEQP_CALL(sleqp_trace_capture(trace));
+  }
+
+  SLEQP_CALL(sleqp_trace_release(&solver->trace));
+
+  solver->trace = trace;
+
+  SLEQP_CALL(sleqp_problem_solver_trace_reset(solver));
+
+  return SLEQP_OKAY;
+}
+
+SLEQP_RETCODE
+sleqp_problem_solver_trace_reset(SleqpProblemSolver* solver)
+{
+  if (!solver->trace)
+  {
+    return SLEQP_OKAY;
+  }
+
+  SLEQP_CALL(collect_times(solver, &solver->trace_times));
+
+  return SLEQP_OKAY;
+}
+
+SLEQP_RETCODE
+sleqp_problem_solver_trace_line(SleqpProblemSolver* solver)
+{
+  SleqpTrace* trace = solver->trace;
+
+  if (!trace)
+  {
+    return SLEQP_OKAY;
+  }
+
+  SleqpWorkingSet* working_set
+    = sleqp_iterate_working_set(solver->trial_iterate);
+
+  SleqpTraceRow times;
+
+  SLEQP_CALL(collect_times(solver, &times));
+
+  const SleqpTraceRow* last_times = &solver->trace_times;
+
+  const SleqpTraceRow row = {
+    .iteration       = solver->iteration,
+    .phase           = solver->solver_phase,
+    .step_type       = solver->last_step_type,
+    .boundary_step   = solver->boundary_step,
+    .num_active_vars = sleqp_working_set_num_active_vars(working_set),
+    .num_active_cons = sleqp_working_set_num_active_cons(working_set),
+    .obj_val         = sleqp_iterate_obj_val(solver->iterate),
+    .merit_val       = solver->current_merit_value,
+    .feas_res        = solver->feas_res,
+    .slack_res       = solver->slack_res,
+    .stat_res        = solver->stat_res,
+    .penalty_param   = solver->penalty_parameter,
+    .trust_radius    = solver->trust_radius,
+    .lp_trust_radius = solver->lp_trust_radius,
+    .primal_step     = solver->primal_diff_norm,
+    .dual_step       = solver->dual_diff_norm,
+    .func_time       = times.func_time - last_times->func_time,
+    .lp_time         = times.lp_time - last_times->lp_time,
+    .eqp_time        = times.eqp_time - last_times->eqp_time,
+    .fact_time       = times.fact_time - last_times->fact_time,
+    .linesearch_time = times.linesearch_time - last_times->linesearch_time,
+    .elapsed         = sleqp_trace_elapsed(trace)};
+
+  SLEQP_CALL(sleqp_trace_add_row(trace, &row));
+
+  solver->trace_times = times;
+
+  return SLEQP_OKAY;
+}
@@ -171,6 +171,48 @@ typedef SLEQP_RETCODE (*SLEQP_FUNC_HESS_PROD)(SleqpFunc* func,
                                               SleqpVec* product,
                                               void* func_data);
 
+/**
+ * Evaluates the products of the Hessian of the Lagrangian function
+ * with a block of directions \f$ D = (d_1, \ldots, d_k) \f$, given
+ * as the columns of a matrix. The products \f$ \nabla_{xx} L(x, \lambda) D
+ * \f$ are to be stored column-wise in the resulting matrix, which has
+ * already been cleared and has the same dimensions as the directions.
+ * The callback is responsible for reserving sufficient space in the products.
+ *
+ * This callback is optional. If it is not provided, the products
+ * are computed column by column using @ref SLEQP_FUNC_HESS_PROD.
+ *
+ * @param[in]     func              The function
+ * @param[in]     directions        The directions \f$ D \f$
+ * @param[in]     cons_duals        The values \f$ \lambda \f$
+ * @param[out]    products          The resulting products
+ * @param[in,out] func_data         The function data
+ *
+ **/
+typedef SLEQP_RETCODE (*SLEQP_FUNC_HESS_PRODS)(SleqpFunc* func,
+                                               const SleqpMat* directions,
+                                               const SleqpVec* cons_duals,
+                                               SleqpMat* products,
+                                               void* func_data);
+
+/**
+ * Creates an independent copy of the function, which may be evaluated
+ * concurrently with the original one from a different thread. The copy
+ * should be created using @ref sleqp_func_create with the same callbacks
+ * and its own function data.
+ *
+ * This callback is optional. Functions which cannot be copied are always
+ * evaluated on the calling thread.
+ *
+ * @param[in]     func              The function
+ * @param[out]    clone             The copy of the function
+ * @param[in,out] func_data         The function data
+ *
+ **/
+typedef SLEQP_RETCODE (*SLEQP_FUNC_CLONE)(SleqpFunc* func,
+                                          SleqpFunc** clone,
+                                          void* func_data);
+
 /**
  * Cleans up any allocated memory stored in the function data.
  *
@@ -189,6 +231,8 @@ typedef struct
   SLEQP_FUNC_CONS_JAC cons_jac;
   SLEQP_FUNC_HESS_PROD hess_prod;
   SLEQP_FUNC_FREE func_free;
+  SLEQP_FUNC_HESS_PRODS hess_prods;
+  SLEQP_FUNC_CLONE clone;
 } SleqpFuncCallbacks;
 
 /**
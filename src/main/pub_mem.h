@@ -4,6 +4,12 @@
 /**
  * @file pub_mem.h
  * @brief Definition of memory (de-)allocation functions.
+ *
+ * All memory is obtained from the allocator which is active on the
+ * calling thread, defaulting to the C library functions. Each block
+ * remembers the allocator it was obtained from, so that it is always
+ * returned to that allocator, regardless of which allocator is active
+ * when it is freed.
  **/
 
 #include <stdlib.h>
@@ -11,8 +17,132 @@
 #include "pub_error.h"
 #include "pub_types.h"
 
+typedef struct SleqpAllocator SleqpAllocator;
+
+/**
+ * Allocates a block of memory
+ *
+ * @param[in]     size            The size of the block in bytes
+ * @param[in,out] allocator_data  The allocator data
+ *
+ * @return The block, or `NULL` if the allocation failed
+ **/
+typedef void* (*SLEQP_ALLOCATOR_ALLOCATE)(size_t size, void* allocator_data);
+
+/**
+ * Resizes a block of memory previously obtained from the allocator,
+ * preserving its content up to the smaller of both sizes
+ *
+ * This callback is optional. If it is not provided, blocks are resized
+ * by allocating a new block and copying the content.
+ *
+ * @param[in]     ptr             The block
+ * @param[in]     size            The current size of the block in bytes
+ * @param[in]     new_size        The requested size of the block in bytes
+ * @param[in,out] allocator_data  The allocator data
+ *
+ * @return The resized block, or `NULL` if the allocation failed,
+ *         in which case the original block remains valid
+ **/
+typedef void* (*SLEQP_ALLOCATOR_REALLOCATE)(void* ptr,
+                                            size_t size,
+                                            size_t new_size,
+                                            void* allocator_data);
+
+/**
+ * Returns a block of memory previously obtained from the allocator
+ *
+ * @param[in]     ptr             The block
+ * @param[in]     size            The size of the block in bytes
+ * @param[in,out] allocator_data  The allocator data
+ **/
+typedef void (*SLEQP_ALLOCATOR_DEALLOCATE)(void* ptr,
+                                           size_t size,
+                                           void* allocator_data);
+
+/**
+ * Cleans up the allocator data once the allocator has been released
+ * and all of its blocks have been returned
+ *
+ * @param[in,out] allocator_data  The allocator data
+ **/
+typedef SLEQP_RETCODE (*SLEQP_ALLOCATOR_FREE)(void* allocator_data);
+
+typedef struct
+{
+  SLEQP_ALLOCATOR_ALLOCATE allocate;
+  SLEQP_ALLOCATOR_REALLOCATE reallocate;
+  SLEQP_ALLOCATOR_DEALLOCATE deallocate;
+  SLEQP_ALLOCATOR_FREE free;
+} SleqpAllocatorCallbacks;
+
+/**
+ * Creates a new allocator. Allocators may be used from several threads
+ * at once, the callbacks must be thread-safe accordingly. The allocator
+ * is kept alive for as long as any of its blocks has not been returned.
+ *
+ * @param[out] star            The allocator
+ * @param[in]  callbacks       The callbacks
+ * @param[in]  allocator_data  The allocator data
+ **/
+SLEQP_EXPORT SLEQP_NODISCARD SLEQP_RETCODE
+sleqp_allocator_create(SleqpAllocator** star,
+                       SleqpAllocatorCallbacks* callbacks,
+                       void* allocator_data);
+
+/**
+ * Returns the allocator which is active on the calling thread,
+ * or `NULL` if the C library functions are used
+ **/
+SLEQP_EXPORT SleqpAllocator*
+sleqp_allocator_active();
+
+/**
+ * Sets the allocator which is active on the calling thread
+ *
+ * @param[in]  allocator       The allocator, or `NULL` to use the C
+ *                             library functions
+ *
+ * @return The previously active allocator
+ **/
+SLEQP_EXPORT SleqpAllocator*
+sleqp_allocator_set_active(SleqpAllocator* allocator);
+
+SLEQP_EXPORT SLEQP_NODISCARD SLEQP_RETCODE
+sleqp_allocator_capture(SleqpAllocator* allocator);
+
+SLEQP_EXPORT SLEQP_NODISCARD SLEQP_RETCODE
+sleqp_allocator_release(SleqpAllocator** star);
+
+/**
+ * Allocates a block of the given size from the active allocator,
+ * returns `NULL` if the size is zero or the allocation failed
+ **/
+SLEQP_EXPORT void*
+sleqp_mem_allocate(size_t size);
+
+/**
+ * Resizes a block obtained from @ref sleqp_mem_allocate. Blocks owned
+ * by an allocator other than the active one are moved to the active one
+ **/
+SLEQP_EXPORT void*
+sleqp_mem_reallocate(void* ptr, size_t size);
+
+/**
+ * Returns a block obtained from @ref sleqp_mem_allocate to its allocator
+ **/
+SLEQP_EXPORT void
+sleqp_mem_deallocate(void* ptr);
+
+/**
+ * Copies a null-terminated string into memory obtained from the
+ * active allocator
+ **/
+SLEQP_EXPORT SLEQP_NODISCARD SLEQP_RETCODE
+sleqp_strdup(char** star, const char* string);
+
 #define sleqp_allocate_memory(ptr, size)                                       \
-  (*(ptr) = ((size) > 0) ? malloc((size)) : NULL),                             \
+  (*(ptr) = sleqp_mem_allocate((size))),                                       \
     (((size) > 0) && (*(ptr) == NULL))                                         \
       ? (sleqp_set_error(__FILE__,                                             \
                          __LINE__,                                             \
@@ -24,7 +154,8 @@
       : SLEQP_OKAY
 
 #define sleqp_reallocate_memory(ptr, size)                                     \
-  (*ptr = realloc(*ptr, size), (((size) > 0) && (*(ptr) == NULL)))             \
+  (*ptr = sleqp_mem_reallocate(*ptr, size),                                    \
+   (((size) > 0) && (*(ptr) == NULL)))                                         \
     ? (sleqp_set_error(__FILE__,                                               \
                        __LINE__,                                               \
                        __PRETTY_FUNCTION__,                                    \
@@ -46,7 +177,7 @@ sleqp_free(void** ptr);
   sleqp_reallocate_memory(ptr, ((count) * sizeof(**ptr)))
 
 #define sleqp_free(ptr)                                                        \
-  free(*ptr);                                                                  \
+  sleqp_mem_deallocate(*ptr);                                                  \
   *ptr = NULL
 
 #endif /* SLEQP_PUB_MEM_H */
@@ -200,6 +200,42 @@ sleqp_problem_cons_lb(SleqpProblem* problem);
 SLEQP_EXPORT SleqpVec*
 sleqp_problem_cons_ub(SleqpProblem* problem);
 
+/**
+ * Replaces the variable bounds \f$ l_x, u_x \f$ of the problem
+ * in place. Solvers of the problem pick up the changes at the
+ * beginning of their next solve.
+ **/
+SLEQP_EXPORT SLEQP_NODISCARD SLEQP_RETCODE
+sleqp_problem_set_vars_bounds(SleqpProblem* problem,
+                              const SleqpVec* var_lb,
+                              const SleqpVec* var_ub);
+
+/**
+ * Replaces the bounds \f$ l_{\nonlin}, u_{\nonlin} \f$ of the
+ * general constraints of the problem in place.
+ **/
+SLEQP_EXPORT SLEQP_NODISCARD SLEQP_RETCODE
+sleqp_problem_set_general_bounds(SleqpProblem* problem,
+                                 const SleqpVec* general_lb,
+                                 const SleqpVec* general_ub);
+
+/**
+ * Replaces the bounds \f$ l_{\lin}, u_{\lin} \f$ of the
+ * linear constraints of the problem in place.
+ **/
+SLEQP_EXPORT SLEQP_NODISCARD SLEQP_RETCODE
+sleqp_problem_set_linear_bounds(SleqpProblem* problem,
+                                const SleqpVec* linear_lb,
+                                const SleqpVec* linear_ub);
+
+/**
+ * Replaces the linear coefficient matrix \f$ A \f$ of the problem
+ * in place. The dimensions of the matrix must remain the same.
+ **/
+SLEQP_EXPORT SLEQP_NODISCARD SLEQP_RETCODE
+sleqp_problem_set_linear_coeffs(SleqpProblem* problem,
+                                const SleqpMat* linear_coeffs);
+
 SLEQP_EXPORT SLEQP_NODISCARD SLEQP_RETCODE
 sleqp_problem_capture(SleqpProblem* problem);
 
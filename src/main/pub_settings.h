@@ -24,6 +24,8 @@ typedef enum
   SLEQP_SETTINGS_ENUM_PARAMETRIC_CAUCHY,
   SLEQP_SETTINGS_ENUM_INITIAL_TR_CHOICE,
   SLEQP_SETTINGS_ENUM_AUG_JAC_METHOD,
+  SLEQP_SETTINGS_ENUM_TR_PRECOND,
+  SLEQP_SETTINGS_ENUM_DERIV_CHECK_SAMPLING,
   SLEQP_NUM_ENUM_SETTINGS
 } SLEQP_SETTINGS_ENUM;
 
@@ -32,6 +34,8 @@ typedef enum
   SLEQP_SETTINGS_INT_NUM_QUASI_NEWTON_ITERATES = 0,
   SLEQP_SETTINGS_INT_MAX_NEWTON_ITERATIONS,
   SLEQP_SETTINGS_INT_NUM_THREADS,
+  SLEQP_SETTINGS_INT_DERIV_CHECK_SAMPLES,
+  SLEQP_SETTINGS_INT_PRECOND_MAX_BLOCK_SIZE,
   SLEQP_NUM_INT_SETTINGS
 } SLEQP_SETTINGS_INT;
 
@@ -45,6 +49,8 @@ typedef enum
   SLEQP_SETTINGS_BOOL_ENABLE_RESTORATION_PHASE,
   SLEQP_SETTINGS_BOOL_ENABLE_PREPROCESSOR,
   SLEQP_SETTINGS_BOOL_LP_RESOLVES,
+  SLEQP_SETTINGS_BOOL_SPECULATIVE_PARAMETRIC_CAUCHY,
+  SLEQP_SETTINGS_BOOL_MEMORY_POOL,
   SLEQP_NUM_BOOL_SETTINGS
 } SLEQP_SETTINGS_BOOL;
 
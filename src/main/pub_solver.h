@@ -55,6 +55,43 @@ sleqp_solver_solve(SleqpSolver* solver,
                    int max_num_iterations,
                    double time_limit);
 
+/**
+ * Solves a batch of independent problems in parallel, creating one solver
+ * per problem. The solves are distributed dynamically among the threads
+ * of a pool, each solver runs its own computations serially. Problems may
+ * share their settings, and the given scaling is shared among all solvers,
+ * whereas functions must not be shared between problems.
+ *
+ * The solvers are returned in the order of the problems and have to be
+ * released by the caller. A failing problem does not affect the others:
+ * Its return code is recorded, while the remaining problems are still
+ * solved. The solver of a failing problem is `NULL` if its creation
+ * failed, its status is available via @ref sleqp_solver_status otherwise.
+ *
+ * @param[in]  num_problems     The number of problems
+ * @param[in]  problems         The problems
+ * @param[in]  primals          The initial solutions of the problems
+ * @param[in]  scaling_data     The scaling to be used (may be `NULL`)
+ * @param[in]  num_threads      The number of threads, or @ref SLEQP_NONE to
+ *                              use all available processors
+ * @param[in]  num_iterations   The number of iterations to be performed per
+ *                              problem, or @ref SLEQP_NONE
+ * @param[in]  time_limit       A time limit in seconds per problem, or @ref
+ *                              SLEQP_NONE
+ * @param[out] solvers          The solvers of the problems
+ * @param[out] retcodes         The return codes of the problems
+ **/
+SLEQP_EXPORT SLEQP_NODISCARD SLEQP_RETCODE
+sleqp_solver_solve_batch(int num_problems,
+                         SleqpProblem** problems,
+                         SleqpVec** primals,
+                         SleqpScaling* scaling_data,
+                         int num_threads,
+                         int max_num_iterations,
+                         double time_limit,
+                         SleqpSolver** solvers,
+                         SLEQP_RETCODE* retcodes);
+
 SLEQP_EXPORT SLEQP_NODISCARD SLEQP_RETCODE
 sleqp_solver_real_state(const SleqpSolver* solver,
                         SLEQP_SOLVER_STATE_REAL state,
@@ -70,6 +107,34 @@ sleqp_solver_vec_state(const SleqpSolver* solver,
                        SLEQP_SOLVER_STATE_VEC value,
                        SleqpVec* result);
 
+/**
+ * Records one row per iteration of subsequent solves in a binary
+ * columnar trace file. The rows contain the trust radii, residuals,
+ * merit values, step types, working set sizes, and the times spent
+ * in the different components of the solver. Passing `NULL` stops
+ * the recording. Requires traces to be enabled at compile time.
+ *
+ * @param[in]  solver           The solver
+ * @param[in]  filename         The name of the trace file
+ **/
+SLEQP_EXPORT SLEQP_NODISCARD SLEQP_RETCODE
+sleqp_solver_set_trace_file(SleqpSolver* solver, const char* filename);
+
+/**
+ * Returns timing statistics of a component of the solver, accumulated
+ * over all calls to @ref sleqp_solver_solve. Times are measured using
+ * a monotonic wall clock, CPU times refer to the threads performing
+ * the timed runs.
+ *
+ * @param[in]  solver           The solver
+ * @param[in]  timing           The component
+ * @param[out] stats            The statistics of the component
+ **/
+SLEQP_EXPORT SLEQP_NODISCARD SLEQP_RETCODE
+sleqp_solver_timing_stats(const SleqpSolver* solver,
+                          SLEQP_SOLVER_TIMING timing,
+                          SleqpTimingStats* stats);
+
 SLEQP_EXPORT
 const char*
 sleqp_solver_info(const SleqpSolver* solver);
@@ -89,6 +154,26 @@ sleqp_solver_status(const SleqpSolver* solver);
 SLEQP_EXPORT SLEQP_NODISCARD SLEQP_RETCODE
 sleqp_solver_reset(SleqpSolver* solver);
 
+/**
+ * Seeds the next call to @ref sleqp_solver_solve with the final state of
+ * a previous solve of a problem with the same structure. The solve starts
+ * from the final primal solution of the source, keeping its multipliers,
+ * working set, trust radii, penalty parameter, quasi-Newton memory, and
+ * the basis of its last LP, if supported by the Cauchy method. Both solvers should use the same settings. Their scalings and the
+ * preprocessing of their problems must coincide, since the state is
+ * transferred in the scaled and preprocessed space.
+ *
+ * Passing the solver itself as source hot starts the solver from its own
+ * last solution. In this case, all LP bases and factorizations of the
+ * previous solve are reused as well, whereas factorizations cannot be
+ * transferred between different solvers.
+ *
+ * @param[in]  solver           The solver
+ * @param[in]  source           The solver of the previous solve
+ **/
+SLEQP_EXPORT SLEQP_NODISCARD SLEQP_RETCODE
+sleqp_solver_warm_start(SleqpSolver* solver, const SleqpSolver* source);
+
 /**
  * Aborts the solver after the next iteration. To be used from callback
  *functions
@@ -123,6 +208,18 @@ SLEQP_EXPORT
 int
 sleqp_solver_iterations(const SleqpSolver* solver);
 
+/**
+ * Returns the total number of simplex iterations performed by the LP solver
+ * over all calls to @ref sleqp_solver_solve, or zero if the LP solver does
+ * not report them
+ *
+ * @param[in]  solver           The solver
+ *
+ **/
+SLEQP_EXPORT
+int
+sleqp_solver_lp_iterations(const SleqpSolver* solver);
+
 /**
  * Returns the number of seconds elapsed during the last call to @ref
  *sleqp_solver_solve
@@ -95,6 +95,13 @@ typedef enum
     = (SLEQP_DERIV_CHECK_SECOND_OBJ | SLEQP_DERIV_CHECK_SECOND_CONS),
 } SLEQP_DERIV_CHECK;
 
+typedef enum
+{
+  SLEQP_DERIV_CHECK_SAMPLING_NONE = 0,
+  SLEQP_DERIV_CHECK_SAMPLING_COORDINATES,
+  SLEQP_DERIV_CHECK_SAMPLING_DIRECTIONS
+} SLEQP_DERIV_CHECK_SAMPLING;
+
 typedef enum
 {
   SLEQP_HESS_EVAL_EXACT = 0,
@@ -133,6 +140,14 @@ typedef enum
   SLEQP_TR_SOLVER_AUTO
 } SLEQP_TR_SOLVER;
 
+typedef enum
+{
+  SLEQP_TR_PRECOND_NONE = 0,
+  SLEQP_TR_PRECOND_DIAGONAL,
+  SLEQP_TR_PRECOND_QUASI_NEWTON,
+  SLEQP_TR_PRECOND_INCOMPLETE_CHOLESKY
+} SLEQP_TR_PRECOND;
+
 typedef enum
 {
   SLEQP_POLISHING_NONE = 0,
@@ -218,6 +233,39 @@ typedef enum
   SLEQP_SOLVER_STATE_VEC_SCALED_VAR_SLACK_RESIDUALS,
 } SLEQP_SOLVER_STATE_VEC;
 
+typedef enum
+{
+  SLEQP_SOLVER_TIMING_TOTAL,
+  SLEQP_SOLVER_TIMING_PREPROCESSING,
+  SLEQP_SOLVER_TIMING_FUNC_SET,
+  SLEQP_SOLVER_TIMING_FUNC_OBJ_VAL,
+  SLEQP_SOLVER_TIMING_FUNC_OBJ_GRAD,
+  SLEQP_SOLVER_TIMING_FUNC_CONS_VAL,
+  SLEQP_SOLVER_TIMING_FUNC_CONS_JAC,
+  SLEQP_SOLVER_TIMING_FUNC_HESS_PROD,
+  SLEQP_SOLVER_TIMING_QUASI_NEWTON_PROD,
+  SLEQP_SOLVER_TIMING_QUASI_NEWTON_UPDATE,
+  SLEQP_SOLVER_TIMING_FACTORIZATION,
+  SLEQP_SOLVER_TIMING_SUBSTITUTION,
+  SLEQP_SOLVER_TIMING_EQP,
+  SLEQP_SOLVER_TIMING_LP,
+  SLEQP_SOLVER_TIMING_LINESEARCH,
+  SLEQP_SOLVER_NUM_TIMINGS
+} SLEQP_SOLVER_TIMING;
+
+/**
+ * Timing statistics of a component of the solver
+ **/
+typedef struct
+{
+  /** The number of timed runs **/
+  int num_runs;
+  /** The total wall-clock time of all runs in seconds **/
+  double wall_time;
+  /** The total CPU time of the threads performing the runs in seconds **/
+  double cpu_time;
+} SleqpTimingStats;
+
 /**None value to be used in place of integer parameters **/
 #define SLEQP_NONE (-1)
 
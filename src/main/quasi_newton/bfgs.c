@@ -6,7 +6,10 @@
 #include "fail.h"
 #include "mem.h"
 #include "sparse/mat.h"
+#include "sparse/vec_kernels.h"
+#include "thread_pool.h"
 
+#include "compact.h"
 #include "quasi_newton.h"
 
 static const double damping_factor = 0.2;
@@ -17,54 +20,30 @@ static const double damped_initial_scale_max = 1.;
 
 /**
  * We follow the notation in "Numerical Optimization"
+ *
+ * The pairs are kept in a compact representation (see compact.h).
+ * The products \f$ B_k s_k \f$ and the damped vectors \f$ r_k \f$
+ * are represented by their coefficients with respect to the stored pairs,
+ * so that recomputing the approximation only involves the Gram matrix
+ * of the pairs.
  **/
 
 typedef struct
 {
   int dimension;
 
-  // The vectors \f$ s_k \f$
-  SleqpVec** point_diffs;
-  // The vectors \f$ y_k \f$
-  SleqpVec** grad_diffs;
-
-  // The products \f$ B_k s_k \f$
-  SleqpVec** point_products;
-
-  // The vectors \f$ r_k \f$
-  SleqpVec** damped_grad_diffs;
-
-  // The products \f$ s_k^{T} r_k \f$
-  double* damped_grad_point_diff_dots;
-
-  // The products \f$ s_k^{T} y_k \f$
-  double* grad_point_diff_dots;
-
-  // The products \f$ s_k^{T} s_k \f$
-  double* point_diff_inner_dots;
-
-  // The products \f$ s_k^{T} B_k s_k \f$
-  double* bidir_products;
-
-  SleqpVec* inner_cache;
-
-  SleqpVec* prod_cache;
-
-  double initial_scale;
-
-  double* sizing_factors;
-
-  // max size
-  int num;
-  // curr size
-  int len;
-  // curr index
-  int curr;
+  SleqpCompact* compact;
 
   bool damped;
 
   SLEQP_BFGS_SIZING sizing;
 
+  // Coefficients of the steps \f$ s_k \f$, the products \f$ B_k s_k \f$,
+  // and the vectors \f$ r_k \f$
+  double* point_coeffs;
+  double* product_coeffs;
+  double* damped_coeffs;
+
 } BFGSBlock;
 
 typedef struct
@@ -78,25 +57,40 @@ typedef struct
   int num_blocks;
   BFGSBlock* blocks;
 
+  // The first variable of each block, followed by the number of variables
+  int* block_offsets;
+
+  // Work of a pass over all blocks
+  int work;
+
   SleqpVec* grad_diff;
   SleqpVec* point_diff;
 
   SleqpVec* previous_grad;
   SleqpVec* current_grad;
 
-  SleqpVec* block_grad_diff;
-  SleqpVec* block_point_diff;
-
   SleqpVec* prod_cache;
 
-  SleqpVec* block_direction;
-  SleqpVec* block_prod;
+  // Dense copies, each block works on its own range
+  double* dense_grad_diff;
+  double* dense_point_diff;
+
+  double* dense_direction;
+  double* dense_prod;
 } BFGS;
 
+typedef SLEQP_RETCODE (*BFGS_BLOCK_FUNC)(BFGS* bfgs, int block);
+
+typedef struct
+{
+  BFGS* bfgs;
+  BFGS_BLOCK_FUNC func;
+  int num_tasks;
+} BFGSBlocks;
+
 static SLEQP_RETCODE
 bfgs_block_create_at(BFGSBlock* block,
                      int dimension,
-                     SleqpSettings* settings,
                      int num,
                      bool damped,
                      SLEQP_BFGS_SIZING sizing)
@@ -108,50 +102,16 @@ bfgs_block_create_at(BFGSBlock* block,
 
   block->dimension = dimension;
 
-  block->num    = num;
-  block->len    = 0;
-  block->curr   = -1;
   block->damped = damped;
   block->sizing = sizing;
 
-  SLEQP_CALL(sleqp_alloc_array(&(block->point_diffs), num));
+  SLEQP_CALL(sleqp_compact_create(&block->compact, dimension, num));
 
-  SLEQP_CALL(sleqp_alloc_array(&(block->grad_diffs), num));
+  SLEQP_CALL(sleqp_alloc_array(&block->point_coeffs, 2 * num));
 
-  SLEQP_CALL(sleqp_alloc_array(&(block->point_products), num));
+  SLEQP_CALL(sleqp_alloc_array(&block->product_coeffs, 2 * num));
 
-  SLEQP_CALL(sleqp_alloc_array(&(block->damped_grad_diffs), num));
-
-  SLEQP_CALL(sleqp_alloc_array(&(block->damped_grad_point_diff_dots), num));
-
-  if (sizing != SLEQP_BFGS_SIZING_NONE)
-  {
-    SLEQP_CALL(sleqp_alloc_array(&(block->grad_point_diff_dots), num));
-
-    SLEQP_CALL(sleqp_alloc_array(&(block->point_diff_inner_dots), num));
-  }
-
-  SLEQP_CALL(sleqp_alloc_array(&(block->bidir_products), num));
-
-  SLEQP_CALL(sleqp_alloc_array(&(block->sizing_factors), num));
-
-  for (int i = 0; i < num; ++i)
-  {
-    SLEQP_CALL(sleqp_vec_create_empty(block->point_diffs + i, dimension));
-
-    SLEQP_CALL(sleqp_vec_create_empty(block->grad_diffs + i, dimension));
-
-    SLEQP_CALL(sleqp_vec_create_empty(block->point_products + i, dimension));
-
-    SLEQP_CALL(sleqp_vec_create_empty(block->damped_grad_diffs + i, dimension));
-
-    block->damped_grad_point_diff_dots[i] = 0.;
-    block->sizing_factors[i]              = 1.;
-  }
-
-  SLEQP_CALL(sleqp_vec_create_empty(&(block->inner_cache), dimension));
-
-  SLEQP_CALL(sleqp_vec_create_empty(&(block->prod_cache), dimension));
+  SLEQP_CALL(sleqp_alloc_array(&block->damped_coeffs, 2 * num));
 
   return SLEQP_OKAY;
 }
@@ -159,36 +119,11 @@ bfgs_block_create_at(BFGSBlock* block,
 static SLEQP_RETCODE
 bfgs_block_free_at(BFGSBlock* block)
 {
-  const int num = block->num;
-
-  SLEQP_CALL(sleqp_vec_free(&(block->prod_cache)));
-
-  SLEQP_CALL(sleqp_vec_free(&(block->inner_cache)));
-
-  for (int i = 0; i < num; ++i)
-  {
-    SLEQP_CALL(sleqp_vec_free(block->damped_grad_diffs + i));
-    SLEQP_CALL(sleqp_vec_free(block->point_products + i));
-
-    SLEQP_CALL(sleqp_vec_free(block->grad_diffs + i));
-    SLEQP_CALL(sleqp_vec_free(block->point_diffs + i));
-  }
-
-  sleqp_free(&block->damped_grad_diffs);
-  sleqp_free(&block->point_products);
-
-  sleqp_free(&block->point_diff_inner_dots);
-
-  sleqp_free(&block->grad_point_diff_dots);
-
-  sleqp_free(&block->damped_grad_point_diff_dots);
-
-  sleqp_free(&block->sizing_factors);
+  sleqp_free(&block->damped_coeffs);
+  sleqp_free(&block->product_coeffs);
+  sleqp_free(&block->point_coeffs);
 
-  sleqp_free(&block->bidir_products);
-
-  sleqp_free(&block->grad_diffs);
-  sleqp_free(&block->point_diffs);
+  SLEQP_CALL(sleqp_compact_free(&block->compact));
 
   return SLEQP_OKAY;
 }
@@ -235,8 +170,13 @@ bfgs_create(BFGS** star,
   data->num_variables = num_variables;
   data->num_blocks    = num_blocks;
 
+  // Entries of the panels and middle matrices per product
+  data->work = 2 * num * (num_variables + 2 * num * num_blocks);
+
   SLEQP_CALL(sleqp_alloc_array(&data->blocks, num_blocks));
 
+  SLEQP_CALL(sleqp_alloc_array(&data->block_offsets, num_blocks + 1));
+
   for (int block = 0; block < num_blocks; ++block)
   {
     int begin, end;
@@ -246,14 +186,17 @@ bfgs_create(BFGS** star,
 
     int block_dimension = end - begin;
 
+    data->block_offsets[block] = begin;
+
     SLEQP_CALL(bfgs_block_create_at(data->blocks + block,
                                     block_dimension,
-                                    settings,
                                     num,
                                     damped,
                                     sizing));
   }
 
+  data->block_offsets[num_blocks] = num_variables;
+
   SLEQP_CALL(sleqp_vec_create_full(&data->grad_diff, num_variables));
 
   SLEQP_CALL(sleqp_vec_create_full(&data->point_diff, num_variables));
@@ -262,221 +205,219 @@ bfgs_create(BFGS** star,
 
   SLEQP_CALL(sleqp_vec_create_full(&data->current_grad, num_variables));
 
-  SLEQP_CALL(sleqp_vec_create_full(&data->block_grad_diff, num_variables));
+  SLEQP_CALL(sleqp_vec_create_full(&data->prod_cache, num_variables));
+
+  SLEQP_CALL(sleqp_alloc_array(&data->dense_grad_diff, num_variables));
 
-  SLEQP_CALL(sleqp_vec_create_full(&data->block_point_diff, num_variables));
+  SLEQP_CALL(sleqp_alloc_array(&data->dense_point_diff, num_variables));
 
-  SLEQP_CALL(sleqp_vec_create_full(&data->prod_cache, num_variables));
+  SLEQP_CALL(sleqp_alloc_array(&data->dense_direction, num_variables));
 
-  SLEQP_CALL(sleqp_vec_create_full(&data->block_direction, num_variables));
+  SLEQP_CALL(sleqp_alloc_array(&data->dense_prod, num_variables));
 
-  SLEQP_CALL(sleqp_vec_create_full(&data->block_prod, num_variables));
+  // Blocks only write their own ranges, keeping the linear range zero
+  sleqp_kernel_fill(data->dense_prod, 0., num_variables);
 
   return SLEQP_OKAY;
 }
 
-static int
-data_index(BFGSBlock* block, int index)
+static SLEQP_RETCODE
+bfgs_blocks_task(int task, void* data)
 {
-  if (block->len == 0)
+  BFGSBlocks* blocks = (BFGSBlocks*)data;
+  BFGS* bfgs         = blocks->bfgs;
+
+  int begin, end;
+
+  sleqp_thread_pool_partition(bfgs->block_offsets,
+                              bfgs->num_blocks,
+                              task,
+                              blocks->num_tasks,
+                              &begin,
+                              &end);
+
+  for (int block = begin; block < end; ++block)
   {
-    return 0;
+    SLEQP_CALL(blocks->func(bfgs, block));
   }
 
-  int current_index = index % (block->num);
-
-  return (current_index < 0) ? (current_index + block->num) : current_index;
+  return SLEQP_OKAY;
 }
 
+// Calls the function for all blocks, in parallel if worthwhile
 static SLEQP_RETCODE
-bfgs_hess_prod_range(BFGSBlock* block,
-                     SleqpSettings* settings,
-                     const SleqpVec* direction,
-                     SleqpVec* product,
-                     int final)
+bfgs_for_each_block(BFGS* bfgs, BFGS_BLOCK_FUNC func)
 {
-  const double zero_eps = sleqp_settings_real_value(settings, SLEQP_SETTINGS_REAL_ZERO_EPS);
-  const int begin       = block->curr - block->len + 1;
+  const int num_blocks = bfgs->num_blocks;
 
-  // Initially apply scaled identity
+  if (num_blocks == 1 || !sleqp_thread_pool_parallelize(bfgs->work))
   {
-    SLEQP_CALL(sleqp_vec_copy(direction, product));
+    for (int block = 0; block < num_blocks; ++block)
+    {
+      SLEQP_CALL(func(bfgs, block));
+    }
 
-    SLEQP_CALL(sleqp_vec_scale(product, block->initial_scale));
+    return SLEQP_OKAY;
   }
 
-  // invariant: after iteration k, "product" contains
-  // product of given "direction" with the approximate
-  // Hessian consisting of the first k terms
-  for (int prev = begin; prev <= final; ++prev)
-  {
-    int j = data_index(block, prev);
-
-    SleqpVec* current_point_product    = block->point_products[j];
-    SleqpVec* current_damped_grad_diff = block->damped_grad_diffs[j];
-    const double sizing_factor         = block->sizing_factors[j];
-    const double bidir_product         = block->bidir_products[j];
-
-    double direction_product_dot, direction_damped_grad_dot;
-
-    SLEQP_CALL(
-      sleqp_vec_dot(current_point_product, direction, &direction_product_dot));
-
-    SLEQP_CALL(sleqp_vec_dot(current_damped_grad_diff,
-                             direction,
-                             &direction_damped_grad_dot));
+  BFGSBlocks blocks
+    = {.bfgs      = bfgs,
+       .func      = func,
+       .num_tasks = SLEQP_MIN(sleqp_thread_pool_active_tasks(), num_blocks)};
 
-    SLEQP_CALL(sleqp_vec_add_scaled(product,
-                                    current_point_product,
-                                    1.,
-                                    -1. * direction_product_dot / bidir_product,
-                                    zero_eps,
-                                    block->inner_cache));
-
-    SLEQP_CALL(sleqp_vec_add_scaled(block->inner_cache,
-                                    current_damped_grad_diff,
-                                    sizing_factor,
-                                    direction_damped_grad_dot
-                                      / block->damped_grad_point_diff_dots[j],
-                                    zero_eps,
-                                    product));
-  }
+  SLEQP_CALL(sleqp_thread_pool_run(sleqp_thread_pool_active(),
+                                   blocks.num_tasks,
+                                   bfgs_blocks_task,
+                                   (void*)&blocks));
 
   return SLEQP_OKAY;
 }
 
-static SLEQP_RETCODE
+static double
 bfgs_initial_scale(BFGSBlock* block,
-                   SleqpVec* point_diff,
-                   SleqpVec* grad_diff,
-                   double* initial_scale)
+                   double grad_point_dot,
+                   double point_diff_normsq)
 {
-  double grad_point_dot;
-
-  SLEQP_CALL(sleqp_vec_dot(grad_diff, point_diff, &grad_point_dot));
-
-  const double point_diff_normsq = sleqp_vec_norm_sq(point_diff);
-
   assert(point_diff_normsq >= 0.);
 
   if (grad_point_dot == 0.)
   {
-    (*initial_scale) = 1.;
-    return SLEQP_OKAY;
+    return 1.;
   }
 
-  (*initial_scale) = point_diff_normsq / grad_point_dot;
+  double initial_scale = point_diff_normsq / grad_point_dot;
 
-  (*initial_scale) = SLEQP_MAX((*initial_scale), initial_scale_min);
+  initial_scale = SLEQP_MAX(initial_scale, initial_scale_min);
 
   if (block->damped)
   {
     // TODO: Find out if there is smoe better way
     // of applying the damping to the initial approximation
-    (*initial_scale) = SLEQP_MIN((*initial_scale), damped_initial_scale_max);
+    initial_scale = SLEQP_MIN(initial_scale, damped_initial_scale_max);
   }
 
-  return SLEQP_OKAY;
+  return initial_scale;
 }
 
-static SLEQP_RETCODE
-bfgs_compute_sizing(BFGSBlock* block, const int val)
+// Quantities of a pair required for the sizing
+typedef struct
 {
-  const int begin = block->curr - block->len + 1;
-
-  const int j = data_index(block, val);
-
-  // First one...
-  if (begin == val)
-  {
-    block->sizing_factors[j] = 1.;
+  // The product \f$ s_k^{T} r_k \f$
+  double damped_grad_point_diff_dot;
 
-    return SLEQP_OKAY;
-  }
+  // The product \f$ s_k^{T} y_k \f$
+  double grad_point_diff_dot;
 
-  block->sizing_factors[j] = 1.;
+  // The product \f$ s_k^{T} s_k \f$
+  double point_diff_inner_dot;
 
-  assert(begin < val);
+  // The product \f$ s_k^{T} B_k s_k \f$
+  double bidir_product;
+} PairDots;
 
-  const int i = data_index(block, val - 1);
+static double
+bfgs_compute_sizing(BFGSBlock* block,
+                    const PairDots* previous,
+                    const PairDots* current)
+{
+  double sizing_factor = 1.;
 
-  assert(i != j);
+  // First one...
+  if (!previous)
+  {
+    return sizing_factor;
+  }
 
   if (block->sizing == SLEQP_BFGS_SIZING_CENTERED_OL)
   {
     const double factor = .5;
 
-    const double numerator = (1. - factor) * (block->grad_point_diff_dots[i])
-                               / (block->point_diff_inner_dots[i])
-                             + (factor) * (block->grad_point_diff_dots[j])
-                                 / (block->point_diff_inner_dots[j]);
+    const double numerator = (1. - factor) * (previous->grad_point_diff_dot)
+                               / (previous->point_diff_inner_dot)
+                             + (factor) * (current->grad_point_diff_dot)
+                                 / (current->point_diff_inner_dot);
 
     const double denominator = (1. - factor)
-                                 * (block->damped_grad_point_diff_dots[i])
-                                 / (block->point_diff_inner_dots[i])
-                               + (factor) * (block->bidir_products[j]);
+                                 * (previous->damped_grad_point_diff_dot)
+                                 / (previous->point_diff_inner_dot)
+                               + (factor) * (current->bidir_product);
 
-    block->sizing_factors[j] = numerator / denominator;
+    sizing_factor = numerator / denominator;
 
-    block->sizing_factors[j]
-      = SLEQP_MAX(block->sizing_factors[j], sizing_cutoff);
+    sizing_factor = SLEQP_MAX(sizing_factor, sizing_cutoff);
 
-    block->sizing_factors[j] = SLEQP_MIN(block->sizing_factors[j], 1.);
+    sizing_factor = SLEQP_MIN(sizing_factor, 1.);
   }
 
-  assert(block->sizing_factors[j] >= 0.);
+  assert(sizing_factor >= 0.);
 
-  return SLEQP_OKAY;
+  return sizing_factor;
 }
 
 static SLEQP_RETCODE
-bfgs_compute_products(BFGSBlock* block, SleqpSettings* settings)
+bfgs_compute_products(BFGS* bfgs, BFGSBlock* block)
 {
-  const double eps = sleqp_settings_real_value(settings, SLEQP_SETTINGS_REAL_EPS);
+  SleqpSettings* settings = bfgs->settings;
+
+  const double eps
+    = sleqp_settings_real_value(settings, SLEQP_SETTINGS_REAL_EPS);
 
   SLEQP_NUM_ASSERT_PARAM(eps);
 
-  const double zero_eps = sleqp_settings_real_value(settings, SLEQP_SETTINGS_REAL_ZERO_EPS);
+  SleqpCompact* compact = block->compact;
+
+  const int len = sleqp_compact_len(compact);
 
-  assert(block->len > 0);
+  assert(len > 0);
+
+  const int num_coeffs = sleqp_compact_num_coeffs(compact);
 
   {
-    SLEQP_CALL(bfgs_initial_scale(block,
-                                  block->point_diffs[block->curr],
-                                  block->grad_diffs[block->curr],
-                                  &block->initial_scale));
+    const int point = sleqp_compact_step_index(compact, len - 1);
+    const int grad  = sleqp_compact_grad_index(compact, len - 1);
+
+    const double initial_scale
+      = bfgs_initial_scale(block,
+                           sleqp_compact_gram(compact, grad, point),
+                           sleqp_compact_gram(compact, point, point));
 
-    sleqp_assert_is_pos(block->initial_scale, eps);
+    sleqp_assert_is_pos(initial_scale, eps);
+
+    sleqp_compact_reset_operator(compact, initial_scale);
   }
 
-  const int begin = block->curr - block->len + 1;
+  double* point_coeffs   = block->point_coeffs;
+  double* product_coeffs = block->product_coeffs;
+  double* damped_coeffs  = block->damped_coeffs;
 
-  for (int val = begin; val <= block->curr; ++val)
-  {
-    const int i = data_index(block, val);
+  PairDots previous = {0}, current;
 
-    const SleqpVec* current_point_diff = block->point_diffs[i];
-    const SleqpVec* current_grad_diff  = block->grad_diffs[i];
+  // invariant: after iteration k, the compact representation
+  // contains the approximate Hessian consisting of the first k terms
+  for (int pos = 0; pos < len; ++pos)
+  {
+    const int point = sleqp_compact_step_index(compact, pos);
+    const int grad  = sleqp_compact_grad_index(compact, pos);
 
-    const SleqpVec* direction = current_point_diff;
-    SleqpVec* product         = block->prod_cache;
+    for (int k = 0; k < num_coeffs; ++k)
+    {
+      point_coeffs[k] = 0.;
+    }
 
-    SLEQP_CALL(
-      bfgs_hess_prod_range(block, settings, direction, product, val - 1));
+    point_coeffs[point] = 1.;
 
-    double bidir_product;
+    sleqp_compact_operator_coeffs(compact, point_coeffs, product_coeffs);
 
-    SLEQP_CALL(sleqp_vec_dot(product, direction, &bidir_product));
+    const double bidir_product
+      = sleqp_compact_index_dot(compact, product_coeffs, point);
 
     assert(bidir_product > 0);
 
-    double dot_product;
+    double dot_product = sleqp_compact_gram(compact, grad, point);
 
-    SLEQP_CALL(
-      sleqp_vec_dot(current_grad_diff, current_point_diff, &dot_product));
-
-    SleqpVec* current_point_product    = block->point_products[i];
-    SleqpVec* current_damped_grad_diff = block->damped_grad_diffs[i];
+    current.grad_point_diff_dot  = dot_product;
+    current.point_diff_inner_dot = sleqp_compact_gram(compact, point, point);
+    current.bidir_product        = bidir_product;
 
     bool is_damped = false;
 
@@ -488,94 +429,87 @@ bfgs_compute_products(BFGSBlock* block, SleqpSettings* settings)
       sleqp_assert_is_pos(combination_factor, eps);
       sleqp_assert_is_lt(combination_factor, 1., eps);
 
-      SLEQP_CALL(sleqp_vec_add_scaled(current_grad_diff,
-                                      product,
-                                      combination_factor,
-                                      1. - combination_factor,
-                                      zero_eps,
-                                      current_damped_grad_diff));
+      for (int k = 0; k < num_coeffs; ++k)
+      {
+        damped_coeffs[k] = (1. - combination_factor) * product_coeffs[k];
+      }
+
+      damped_coeffs[grad] += combination_factor;
 
-      SLEQP_CALL(sleqp_vec_dot(current_damped_grad_diff,
-                               current_point_diff,
-                               &dot_product));
+      dot_product = sleqp_compact_index_dot(compact, damped_coeffs, point);
 
       is_damped = true;
     }
     else
     {
-      SLEQP_CALL(sleqp_vec_copy(current_grad_diff, current_damped_grad_diff));
-    }
-
-    // save dot product
-    {
-      assert(dot_product > 0);
+      for (int k = 0; k < num_coeffs; ++k)
+      {
+        damped_coeffs[k] = 0.;
+      }
 
-      block->damped_grad_point_diff_dots[i] = dot_product;
+      damped_coeffs[grad] = 1.;
     }
 
-    // set point product
-    {
-      SLEQP_CALL(sleqp_vec_copy(product, current_point_product));
+    assert(dot_product > 0);
 
-      // SLEQP_CALL(sleqp_vec_scale(current_point_product, 1./bidir_product));
+    current.damped_grad_point_diff_dot = dot_product;
 
-      block->bidir_products[i] = bidir_product;
-    }
+    double sizing_factor = 1.;
 
     if (block->sizing != SLEQP_BFGS_SIZING_NONE)
     {
-      SLEQP_CALL(bfgs_compute_sizing(block, val));
+      sizing_factor
+        = bfgs_compute_sizing(block, (pos > 0) ? &previous : NULL, &current);
     }
 
+    sleqp_compact_add_term(compact, product_coeffs, -1. / bidir_product);
+
+    sleqp_compact_scale_operator(compact, sizing_factor);
+
+    sleqp_compact_add_term(compact, damped_coeffs, 1. / dot_product);
+
 #if SLEQP_DEBUG
     if (!is_damped)
     {
       // check that secant equation is satisfied
-      const int i = data_index(block, val);
-
-      SLEQP_CALL(bfgs_hess_prod_range(block,
-                                      settings,
-                                      block->point_diffs[i],
-                                      block->prod_cache,
-                                      val));
+      sleqp_compact_operator_coeffs(compact, point_coeffs, product_coeffs);
 
       sleqp_num_assert(
-        sleqp_vec_eq(block->prod_cache, block->grad_diffs[i], eps));
+        sleqp_is_eq(sleqp_compact_index_dot(compact, product_coeffs, point),
+                    current.grad_point_diff_dot,
+                    eps));
     }
 #endif
+
+    previous = current;
   }
 
   return SLEQP_OKAY;
 }
 
 static SLEQP_RETCODE
-bfgs_block_push(BFGSBlock* block,
-                SleqpSettings* settings,
-                const SleqpVec* point_diff,
-                const SleqpVec* grad_diff)
+bfgs_block_push(BFGS* bfgs, int index)
 {
-  const int next = data_index(block, block->curr + 1);
-
-  SLEQP_CALL(sleqp_vec_copy(point_diff, block->point_diffs[next]));
+  BFGSBlock* block = bfgs->blocks + index;
+  const int offset = bfgs->block_offsets[index];
 
-  SLEQP_CALL(sleqp_vec_copy(grad_diff, block->grad_diffs[next]));
+  const double eps
+    = sleqp_settings_real_value(bfgs->settings, SLEQP_SETTINGS_REAL_EPS);
 
-  if (block->sizing != SLEQP_BFGS_SIZING_NONE)
-  {
-    block->point_diff_inner_dots[next] = sleqp_vec_norm_sq(point_diff);
+  const double* point_diff = bfgs->dense_point_diff + offset;
+  const double* grad_diff  = bfgs->dense_grad_diff + offset;
 
-    SLEQP_CALL(
-      sleqp_vec_dot(point_diff, grad_diff, block->grad_point_diff_dots + next));
-  }
+  const double point_normsq
+    = sleqp_kernel_norm_sq(point_diff, block->dimension);
 
-  if (block->len < block->num)
+  if (sleqp_is_zero(point_normsq, eps))
   {
-    ++block->len;
+    return SLEQP_OKAY;
   }
 
-  block->curr = next;
+  sleqp_compact_push(block->compact, point_diff, grad_diff);
 
-  SLEQP_CALL(bfgs_compute_products(block, settings));
+  SLEQP_CALL(bfgs_compute_products(bfgs, block));
 
   return SLEQP_OKAY;
 }
@@ -588,12 +522,9 @@ bfgs_push(const SleqpIterate* previous_iterate,
 {
   BFGS* bfgs = (BFGS*)data;
 
-  const double eps = sleqp_settings_real_value(bfgs->settings, SLEQP_SETTINGS_REAL_EPS);
   const double zero_eps
     = sleqp_settings_real_value(bfgs->settings, SLEQP_SETTINGS_REAL_ZERO_EPS);
 
-  const int num_blocks = bfgs->num_blocks;
-
   // Compute gradient difference
   {
     SLEQP_CALL(
@@ -637,58 +568,13 @@ bfgs_push(const SleqpIterate* previous_iterate,
                                   zero_eps,
                                   bfgs->point_diff));
 
-  int k_point = 0;
-  int k_grad  = 0;
-
-  int offset = 0;
-
-  for (int i = 0; i < num_blocks; ++i)
-  {
-    BFGSBlock* block = bfgs->blocks + i;
-
-    int next_offset = offset + block->dimension;
-
-    SLEQP_CALL(sleqp_vec_clear(bfgs->block_grad_diff));
-    SLEQP_CALL(sleqp_vec_clear(bfgs->block_point_diff));
-
-    bfgs->block_grad_diff->dim  = block->dimension;
-    bfgs->block_point_diff->dim = block->dimension;
-
-    while (k_point < bfgs->point_diff->nnz
-           && bfgs->point_diff->indices[k_point] < next_offset)
-    {
-      SLEQP_CALL(sleqp_vec_push(bfgs->block_point_diff,
-                                bfgs->point_diff->indices[k_point] - offset,
-                                bfgs->point_diff->data[k_point]));
-
-      ++k_point;
-    }
-
-    while (k_grad < bfgs->grad_diff->nnz
-           && bfgs->grad_diff->indices[k_grad] < next_offset)
-    {
-      SLEQP_CALL(sleqp_vec_push(bfgs->block_grad_diff,
-                                bfgs->grad_diff->indices[k_grad] - offset,
-                                bfgs->grad_diff->data[k_grad]));
-
-      ++k_grad;
-    }
+  assert(sleqp_vec_is_finite(bfgs->point_diff));
+  assert(sleqp_vec_is_finite(bfgs->grad_diff));
 
-    const double point_normsq = sleqp_vec_norm_sq(bfgs->block_point_diff);
+  SLEQP_CALL(sleqp_vec_to_raw(bfgs->point_diff, bfgs->dense_point_diff));
+  SLEQP_CALL(sleqp_vec_to_raw(bfgs->grad_diff, bfgs->dense_grad_diff));
 
-    assert(sleqp_vec_is_finite(bfgs->block_point_diff));
-    assert(sleqp_vec_is_finite(bfgs->block_grad_diff));
-
-    if (!sleqp_is_zero(point_normsq, eps))
-    {
-      SLEQP_CALL(bfgs_block_push(block,
-                                 bfgs->settings,
-                                 bfgs->block_point_diff,
-                                 bfgs->block_grad_diff));
-    }
-
-    offset = next_offset;
-  }
+  SLEQP_CALL(bfgs_for_each_block(bfgs, bfgs_block_push));
 
   return SLEQP_OKAY;
 }
@@ -702,82 +588,78 @@ bfgs_reset(void* data)
 
   for (int i = 0; i < num_blocks; ++i)
   {
-    BFGSBlock* block = bfgs->blocks + i;
-    block->len       = 0;
+    sleqp_compact_reset(bfgs->blocks[i].compact);
   }
 
   return SLEQP_OKAY;
 }
 
 static SLEQP_RETCODE
-bfgs_hess_prod(const SleqpVec* direction, SleqpVec* product, void* data)
+bfgs_block_copy(const BFGSBlock* source, BFGSBlock* target)
 {
-  BFGS* bfgs = (BFGS*)data;
+  if (source->dimension != target->dimension
+      || source->damped != target->damped || source->sizing != target->sizing)
+  {
+    sleqp_raise(SLEQP_ILLEGAL_ARGUMENT, "Incompatible BFGS blocks");
+  }
 
-  const int num_blocks = bfgs->num_blocks;
+  SLEQP_CALL(sleqp_compact_copy(source->compact, target->compact));
 
-  int offset      = 0;
-  int k_direction = 0, k_product = 0;
+  return SLEQP_OKAY;
+}
 
-  SLEQP_CALL(sleqp_vec_reserve(product, bfgs->num_variables));
+static SLEQP_RETCODE
+bfgs_copy(const void* source_data, void* target_data)
+{
+  const BFGS* source = (const BFGS*)source_data;
+  BFGS* target       = (BFGS*)target_data;
 
-  for (int i = 0; i < num_blocks; ++i)
+  if (source->num_blocks != target->num_blocks)
   {
-    BFGSBlock* block = bfgs->blocks + i;
+    sleqp_raise(SLEQP_ILLEGAL_ARGUMENT,
+                "Cannot copy BFGS data between %d and %d blocks",
+                source->num_blocks,
+                target->num_blocks);
+  }
 
-    int next_offset = offset + block->dimension;
+  const int num_blocks = source->num_blocks;
 
-    if (block->len == 0)
-    {
-      while (k_direction < direction->nnz
-             && direction->indices[k_direction] < next_offset)
-      {
-        SLEQP_CALL(sleqp_vec_push(product,
-                                  direction->indices[k_direction],
-                                  direction->data[k_direction]));
+  for (int i = 0; i < num_blocks; ++i)
+  {
+    SLEQP_CALL(bfgs_block_copy(source->blocks + i, target->blocks + i));
+  }
 
-        ++k_direction;
-        ++k_product;
-      }
-    }
-    else
-    {
-      bfgs->block_direction->dim = block->dimension;
-      bfgs->block_prod->dim      = block->dimension;
+  return SLEQP_OKAY;
+}
 
-      SLEQP_CALL(sleqp_vec_clear(bfgs->block_direction));
-      SLEQP_CALL(sleqp_vec_clear(bfgs->block_prod));
+static SLEQP_RETCODE
+bfgs_block_hess_prod(BFGS* bfgs, int index)
+{
+  const int offset = bfgs->block_offsets[index];
 
-      while (k_direction < direction->nnz
-             && direction->indices[k_direction] < next_offset)
-      {
-        SLEQP_CALL(sleqp_vec_push(bfgs->block_direction,
-                                  direction->indices[k_direction] - offset,
-                                  direction->data[k_direction]));
+  sleqp_compact_hess_prod(bfgs->blocks[index].compact,
+                          bfgs->dense_direction + offset,
+                          bfgs->dense_prod + offset);
 
-        ++k_direction;
-      }
+  return SLEQP_OKAY;
+}
+
+static SLEQP_RETCODE
+bfgs_hess_prod(const SleqpVec* direction, SleqpVec* product, void* data)
+{
+  BFGS* bfgs = (BFGS*)data;
 
-      SLEQP_CALL(bfgs_hess_prod_range(block,
-                                      bfgs->settings,
-                                      bfgs->block_direction,
-                                      bfgs->block_prod,
-                                      block->curr));
+  const double zero_eps
+    = sleqp_settings_real_value(bfgs->settings, SLEQP_SETTINGS_REAL_ZERO_EPS);
 
-      for (int k_block_prod = 0; k_block_prod < bfgs->block_prod->nnz;
-           ++k_block_prod)
-      {
-        SLEQP_CALL(
-          sleqp_vec_push(product,
-                         bfgs->block_prod->indices[k_block_prod] + offset,
-                         bfgs->block_prod->data[k_block_prod]));
+  SLEQP_CALL(sleqp_vec_to_raw(direction, bfgs->dense_direction));
 
-        ++k_product;
-      }
-    }
+  SLEQP_CALL(bfgs_for_each_block(bfgs, bfgs_block_hess_prod));
 
-    offset = next_offset;
-  }
+  SLEQP_CALL(sleqp_vec_set_from_raw(product,
+                                    bfgs->dense_prod,
+                                    bfgs->num_variables,
+                                    zero_eps));
 
   return SLEQP_OKAY;
 }
@@ -792,16 +674,13 @@ bfgs_free(void* data)
     return SLEQP_OKAY;
   }
 
-  SLEQP_CALL(sleqp_vec_free(&bfgs->block_prod));
-  SLEQP_CALL(sleqp_vec_free(&bfgs->block_direction));
-
-  SLEQP_CALL(sleqp_vec_free(&bfgs->prod_cache));
+  sleqp_free(&bfgs->dense_prod);
+  sleqp_free(&bfgs->dense_direction);
 
-  SLEQP_CALL(sleqp_vec_free(&bfgs->block_prod));
-  SLEQP_CALL(sleqp_vec_free(&bfgs->block_prod));
+  sleqp_free(&bfgs->dense_point_diff);
+  sleqp_free(&bfgs->dense_grad_diff);
 
-  SLEQP_CALL(sleqp_vec_free(&bfgs->block_point_diff));
-  SLEQP_CALL(sleqp_vec_free(&bfgs->block_grad_diff));
+  SLEQP_CALL(sleqp_vec_free(&bfgs->prod_cache));
 
   SLEQP_CALL(sleqp_vec_free(&bfgs->current_grad));
   SLEQP_CALL(sleqp_vec_free(&bfgs->previous_grad));
@@ -816,6 +695,8 @@ bfgs_free(void* data)
     SLEQP_CALL(bfgs_block_free_at(bfgs->blocks + block));
   }
 
+  sleqp_free(&bfgs->block_offsets);
+
   sleqp_free(&bfgs->blocks);
 
   SLEQP_CALL(sleqp_settings_release(&bfgs->settings));
@@ -834,6 +715,7 @@ sleqp_bfgs_create(SleqpQuasiNewton** star,
     .push      = bfgs_push,
     .reset     = bfgs_reset,
     .hess_prod = bfgs_hess_prod,
+    .copy      = bfgs_copy,
     .free      = bfgs_free,
   };
 
@@ -0,0 +1,379 @@
+#include "compact.h"
+
+#include <string.h>
+
+#include "error.h"
+#include "fail.h"
+#include "mem.h"
+#include "sparse/vec_kernels.h"
+
+struct SleqpCompact
+{
+  int dimension;
+
+  // max size
+  int num;
+  // curr size
+  int len;
+  // curr index
+  int curr;
+
+  // Leading dimension of the small matrices
+  int ld;
+
+  // Column-major panel with columns s_0, y_0, s_1, y_1, ...
+  double* panel;
+
+  // Gram matrix of the panel
+  double* gram;
+
+  // Middle matrix of the represented matrix
+  double* middle;
+
+  double scale;
+
+  double* coeff_cache;
+  double* prod_cache;
+};
+
+SLEQP_RETCODE
+sleqp_compact_create(SleqpCompact** star, int dimension, int num)
+{
+  assert(dimension > 0);
+  assert(num > 0);
+
+  SLEQP_CALL(sleqp_malloc(star));
+
+  SleqpCompact* compact = *star;
+
+  *compact = (SleqpCompact){0};
+
+  compact->dimension = dimension;
+  compact->num       = num;
+  compact->ld        = 2 * num;
+
+  const int ld = compact->ld;
+
+  SLEQP_CALL(sleqp_alloc_array(&compact->panel, dimension * ld));
+
+  SLEQP_CALL(sleqp_alloc_array(&compact->gram, ld * ld));
+
+  SLEQP_CALL(sleqp_alloc_array(&compact->middle, ld * ld));
+
+  SLEQP_CALL(sleqp_alloc_array(&compact->coeff_cache, ld));
+
+  SLEQP_CALL(sleqp_alloc_array(&compact->prod_cache, ld));
+
+  sleqp_kernel_fill(compact->gram, 0., ld * ld);
+
+  sleqp_compact_reset(compact);
+
+  return SLEQP_OKAY;
+}
+
+static double*
+panel_column(SleqpCompact* compact, int index)
+{
+  return compact->panel + (size_t)index * compact->dimension;
+}
+
+void
+sleqp_compact_push(SleqpCompact* compact,
+                   const double* step_diff,
+                   const double* grad_diff)
+{
+  const int dimension = compact->dimension;
+
+  const int next
+    = (compact->len == 0) ? 0 : (compact->curr + 1) % compact->num;
+
+  const int step_index = 2 * next;
+  const int grad_index = step_index + 1;
+
+  memcpy(panel_column(compact, step_index),
+         step_diff,
+         sizeof(double) * dimension);
+
+  memcpy(panel_column(compact, grad_index),
+         grad_diff,
+         sizeof(double) * dimension);
+
+  if (compact->len < compact->num)
+  {
+    ++compact->len;
+  }
+
+  compact->curr = next;
+
+  // Update the rows / columns of the Gram matrix belonging to the new pair
+  const int ld         = compact->ld;
+  const int num_coeffs = sleqp_compact_num_coeffs(compact);
+
+  double* gram = compact->gram;
+
+  for (int index = step_index; index <= grad_index; ++index)
+  {
+    double* gram_col = gram + (size_t)index * ld;
+
+    sleqp_kernel_gemv_trans(compact->panel,
+                            dimension,
+                            num_coeffs,
+                            panel_column(compact, index),
+                            gram_col);
+
+    for (int j = 0; j < num_coeffs; ++j)
+    {
+      gram[index + (size_t)j * ld] = gram_col[j];
+    }
+  }
+}
+
+void
+sleqp_compact_reset(SleqpCompact* compact)
+{
+  compact->len  = 0;
+  compact->curr = -1;
+
+  sleqp_compact_reset_operator(compact, 1.);
+}
+
+int
+sleqp_compact_len(const SleqpCompact* compact)
+{
+  return compact->len;
+}
+
+int
+sleqp_compact_num_coeffs(const SleqpCompact* compact)
+{
+  // The first "len" slots are occupied
+  return 2 * compact->len;
+}
+
+static int
+slot_index(const SleqpCompact* compact, int pos)
+{
+  assert(pos >= 0);
+  assert(pos < compact->len);
+
+  const int slot = (compact->curr - compact->len + 1 + pos) % compact->num;
+
+  return (slot < 0) ? (slot + compact->num) : slot;
+}
+
+int
+sleqp_compact_step_index(const SleqpCompact* compact, int pos)
+{
+  return 2 * slot_index(compact, pos);
+}
+
+int
+sleqp_compact_grad_index(const SleqpCompact* compact, int pos)
+{
+  return 2 * slot_index(compact, pos) + 1;
+}
+
+double
+sleqp_compact_gram(const SleqpCompact* compact, int first, int second)
+{
+  return compact->gram[first + (size_t)second * compact->ld];
+}
+
+double
+sleqp_compact_index_dot(const SleqpCompact* compact,
+                        const double* coeffs,
+                        int index)
+{
+  const double* gram_col = compact->gram + (size_t)index * compact->ld;
+
+  return sleqp_kernel_dot(coeffs, gram_col, sleqp_compact_num_coeffs(compact));
+}
+
+// result = G coeffs
+static void
+gram_prod(const SleqpCompact* compact, const double* coeffs, double* result)
+{
+  const int num_coeffs = sleqp_compact_num_coeffs(compact);
+
+  for (int i = 0; i < num_coeffs; ++i)
+  {
+    result[i] = sleqp_compact_index_dot(compact, coeffs, i);
+  }
+}
+
+double
+sleqp_compact_dot(SleqpCompact* compact,
+                  const double* first,
+                  const double* second)
+{
+  gram_prod(compact, second, compact->coeff_cache);
+
+  return sleqp_kernel_dot(first,
+                          compact->coeff_cache,
+                          sleqp_compact_num_coeffs(compact));
+}
+
+void
+sleqp_compact_reset_operator(SleqpCompact* compact, double scale)
+{
+  compact->scale = scale;
+
+  sleqp_kernel_fill(compact->middle, 0., compact->ld * compact->ld);
+}
+
+void
+sleqp_compact_add_term(SleqpCompact* compact,
+                       const double* coeffs,
+                       double weight)
+{
+  const int ld         = compact->ld;
+  const int num_coeffs = sleqp_compact_num_coeffs(compact);
+
+  for (int j = 0; j < num_coeffs; ++j)
+  {
+    const double factor = weight * coeffs[j];
+
+    if (factor == 0.)
+    {
+      continue;
+    }
+
+    double* middle_col = compact->middle + (size_t)j * ld;
+
+    for (int i = 0; i < num_coeffs; ++i)
+    {
+      middle_col[i] += factor * coeffs[i];
+    }
+  }
+}
+
+void
+sleqp_compact_scale_operator(SleqpCompact* compact, double factor)
+{
+  const int ld         = compact->ld;
+  const int num_coeffs = sleqp_compact_num_coeffs(compact);
+
+  compact->scale *= factor;
+
+  for (int j = 0; j < num_coeffs; ++j)
+  {
+    double* middle_col = compact->middle + (size_t)j * ld;
+
+    sleqp_kernel_scale(middle_col, factor, middle_col, num_coeffs);
+  }
+}
+
+// result = scale * first + K second
+static void
+middle_prod(const SleqpCompact* compact,
+            const double* first,
+            const double* second,
+            double* result)
+{
+  const int num_coeffs = sleqp_compact_num_coeffs(compact);
+
+  sleqp_kernel_scale(first, compact->scale, result, num_coeffs);
+
+  sleqp_kernel_gemv(compact->middle, compact->ld, num_coeffs, second, result);
+}
+
+void
+sleqp_compact_operator_coeffs(SleqpCompact* compact,
+                              const double* coeffs,
+                              double* result)
+{
+  assert(coeffs != result);
+
+  // B (P c) = scale P c + P K P^T P c = P (scale c + K G c)
+  gram_prod(compact, coeffs, compact->coeff_cache);
+
+  middle_prod(compact, coeffs, compact->coeff_cache, result);
+}
+
+void
+sleqp_compact_hess_prod(SleqpCompact* compact,
+                        const double* direction,
+                        double* product)
+{
+  const int dimension  = compact->dimension;
+  const int num_coeffs = sleqp_compact_num_coeffs(compact);
+
+  sleqp_kernel_scale(direction, compact->scale, product, dimension);
+
+  if (num_coeffs == 0)
+  {
+    return;
+  }
+
+  double* panel_dots = compact->coeff_cache;
+  double* weights    = compact->prod_cache;
+
+  sleqp_kernel_gemv_trans(compact->panel,
+                          dimension,
+                          num_coeffs,
+                          direction,
+                          panel_dots);
+
+  sleqp_kernel_fill(weights, 0., num_coeffs);
+
+  sleqp_kernel_gemv(compact->middle,
+                    compact->ld,
+                    num_coeffs,
+                    panel_dots,
+                    weights);
+
+  sleqp_kernel_gemv(compact->panel, dimension, num_coeffs, weights, product);
+}
+
+SLEQP_RETCODE
+sleqp_compact_copy(const SleqpCompact* source, SleqpCompact* target)
+{
+  if (source->dimension != target->dimension || source->num != target->num)
+  {
+    sleqp_raise(SLEQP_ILLEGAL_ARGUMENT,
+                "Incompatible compact representations");
+  }
+
+  const int ld         = source->ld;
+  const int num_coeffs = sleqp_compact_num_coeffs(source);
+
+  memcpy(target->panel,
+         source->panel,
+         sizeof(double) * source->dimension * num_coeffs);
+
+  memcpy(target->gram, source->gram, sizeof(double) * ld * ld);
+
+  memcpy(target->middle, source->middle, sizeof(double) * ld * ld);
+
+  target->scale = source->scale;
+
+  target->len  = source->len;
+  target->curr = source->curr;
+
+  return SLEQP_OKAY;
+}
+
+SLEQP_RETCODE
+sleqp_compact_free(SleqpCompact** star)
+{
+  SleqpCompact* compact = *star;
+
+  if (!compact)
+  {
+    return SLEQP_OKAY;
+  }
+
+  sleqp_free(&compact->prod_cache);
+
+  sleqp_free(&compact->coeff_cache);
+
+  sleqp_free(&compact->middle);
+
+  sleqp_free(&compact->gram);
+
+  sleqp_free(&compact->panel);
+
+  sleqp_free(star);
+
+  return SLEQP_OKAY;
+}
@@ -0,0 +1,152 @@
+#ifndef SLEQP_COMPACT_H
+#define SLEQP_COMPACT_H
+
+/**
+ * @file compact.h
+ * @brief Compact representation of limited-memory quasi-Newton matrices.
+ *
+ * The most recent pairs \f$ (s_i, y_i) \f$ are stored as the columns of a
+ * dense column-major panel \f$ P = [s_0, y_0, s_1, y_1, \ldots] \f$ together
+ * with its Gram matrix \f$ G = P^{T} P \f$, which is updated incrementally
+ * whenever a pair is pushed. The quasi-Newton matrix is represented as
+ *
+ * \f[ B = \gamma I + P K P^{T}, \f]
+ *
+ * where the symmetric middle matrix \f$ K \f$ is assembled by the respective
+ * method from terms \f$ w c c^{T} \f$. The coefficient vectors \f$ c \f$
+ * represent the vectors \f$ P c \f$ in the span of the stored pairs, so that
+ * methods can carry out their recursions without touching the panel.
+ * Products with \f$ B \f$ then require two passes over the panel.
+ **/
+
+#include "types.h"
+
+typedef struct SleqpCompact SleqpCompact;
+
+/**
+ * Creates a new compact representation
+ *
+ * @param[out] star       The representation
+ * @param[in]  dimension  The dimension of the pairs
+ * @param[in]  num        The maximum number of stored pairs
+ **/
+SLEQP_NODISCARD
+SLEQP_RETCODE
+sleqp_compact_create(SleqpCompact** star, int dimension, int num);
+
+/**
+ * Pushes a new pair given by dense arrays, replacing the oldest one
+ * if the memory is exhausted
+ **/
+void
+sleqp_compact_push(SleqpCompact* compact,
+                   const double* step_diff,
+                   const double* grad_diff);
+
+/**
+ * Discards all stored pairs
+ **/
+void
+sleqp_compact_reset(SleqpCompact* compact);
+
+/**
+ * Returns the number of currently stored pairs
+ **/
+int
+sleqp_compact_len(const SleqpCompact* compact);
+
+/**
+ * Returns the number of entries of the coefficient vectors,
+ * i.e., twice the number of currently stored pairs
+ **/
+int
+sleqp_compact_num_coeffs(const SleqpCompact* compact);
+
+/**
+ * Returns the coefficient index of the step of the
+ * pair at the given position, where 0 denotes the oldest pair
+ **/
+int
+sleqp_compact_step_index(const SleqpCompact* compact, int pos);
+
+/**
+ * Returns the coefficient index of the gradient difference of the
+ * pair at the given position, where 0 denotes the oldest pair
+ **/
+int
+sleqp_compact_grad_index(const SleqpCompact* compact, int pos);
+
+/**
+ * Returns the inner product of two stored vectors
+ * given by their coefficient indices
+ **/
+double
+sleqp_compact_gram(const SleqpCompact* compact, int first, int second);
+
+/**
+ * Returns the inner product of the vector given by the coefficients
+ * with the stored vector given by its coefficient index
+ **/
+double
+sleqp_compact_index_dot(const SleqpCompact* compact,
+                        const double* coeffs,
+                        int index);
+
+/**
+ * Returns the inner product of two vectors given by their coefficients
+ **/
+double
+sleqp_compact_dot(SleqpCompact* compact,
+                  const double* first,
+                  const double* second);
+
+/**
+ * Sets the represented matrix to \f$ B = \gamma I \f$
+ **/
+void
+sleqp_compact_reset_operator(SleqpCompact* compact, double scale);
+
+/**
+ * Updates the represented matrix to \f$ B \leftarrow B + w (P c) (P c)^{T} \f$
+ **/
+void
+sleqp_compact_add_term(SleqpCompact* compact,
+                       const double* coeffs,
+                       double weight);
+
+/**
+ * Updates the represented matrix to \f$ B \leftarrow \sigma B \f$
+ **/
+void
+sleqp_compact_scale_operator(SleqpCompact* compact, double factor);
+
+/**
+ * Computes the coefficients of \f$ B (P c) \f$ given the coefficients
+ * \f$ c \f$. The input and output must not overlap
+ **/
+void
+sleqp_compact_operator_coeffs(SleqpCompact* compact,
+                              const double* coeffs,
+                              double* result);
+
+/**
+ * Computes the product of the represented matrix with a dense direction
+ **/
+void
+sleqp_compact_hess_prod(SleqpCompact* compact,
+                        const double* direction,
+                        double* product);
+
+/**
+ * Replaces the content of the target by that of the source,
+ * both of which must have the same dimension and size
+ **/
+SLEQP_NODISCARD
+SLEQP_RETCODE
+sleqp_compact_copy(const SleqpCompact* source, SleqpCompact* target);
+
+SLEQP_NODISCARD
+SLEQP_RETCODE
+sleqp_compact_free(SleqpCompact** star);
+
+#endif /* SLEQP_COMPACT_H */
@@ -1,5 +1,6 @@
 #include "quasi_newton.h"
 
+#include "error.h"
 #include "func.h"
 #include "mem.h"
 
@@ -173,6 +174,27 @@ sleqp_quasi_newton_hess_prod(SleqpQuasiNewton* quasi_newton,
   return SLEQP_OKAY;
 }
 
+SLEQP_RETCODE
+sleqp_quasi_newton_copy(const SleqpQuasiNewton* source,
+                        SleqpQuasiNewton* target)
+{
+  if (source == target)
+  {
+    return SLEQP_OKAY;
+  }
+
+  if (source->callbacks.copy != target->callbacks.copy)
+  {
+    sleqp_raise(SLEQP_ILLEGAL_ARGUMENT,
+                "Cannot copy between different quasi-Newton methods");
+  }
+
+  SLEQP_CALL(source->callbacks.copy(source->quasi_newton_data,
+                                    target->quasi_newton_data));
+
+  return SLEQP_OKAY;
+}
+
 SleqpTimer*
 sleqp_quasi_newton_update_timer(SleqpQuasiNewton* quasi_newton)
 {
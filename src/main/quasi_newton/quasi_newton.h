@@ -35,6 +35,16 @@ sleqp_quasi_newton_hess_prod(SleqpQuasiNewton* quasi_newton,
                              const SleqpVec* direction,
                              SleqpVec* product);
 
+/**
+ * Replaces the memory of the target by that of the source,
+ * both of which must use the same method on the same
+ * Hessian structure
+ **/
+SLEQP_NODISCARD
+SLEQP_RETCODE
+sleqp_quasi_newton_copy(const SleqpQuasiNewton* source,
+                        SleqpQuasiNewton* target);
+
 SleqpTimer*
 sleqp_quasi_newton_update_timer(SleqpQuasiNewton* quasi_newton);
 
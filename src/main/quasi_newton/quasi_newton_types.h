@@ -17,6 +17,10 @@ typedef SLEQP_RETCODE (*SLEQP_QUASI_NEWTON_HESS_PROD)(const SleqpVec* direction,
                                                       SleqpVec* product,
                                                       void* quasi_newton_data);
 
+// Copies the memory of a compatible quasi-Newton method
+typedef SLEQP_RETCODE (*SLEQP_QUASI_NEWTON_COPY)(const void* source_data,
+                                                 void* target_data);
+
 typedef SLEQP_RETCODE (*SLEQP_QUASI_NEWTON_FREE)(void* quasi_newton_data);
 
 typedef struct
@@ -24,6 +28,7 @@ typedef struct
   SLEQP_QUASI_NEWTON_PUSH push;
   SLEQP_QUASI_NEWTON_RESET reset;
   SLEQP_QUASI_NEWTON_HESS_PROD hess_prod;
+  SLEQP_QUASI_NEWTON_COPY copy;
   SLEQP_QUASI_NEWTON_FREE free;
 } SleqpQuasiNewtonCallbacks;
 
@@ -6,7 +6,10 @@
 #include "log.h"
 #include "mem.h"
 #include "sparse/mat.h"
+#include "sparse/vec_kernels.h"
+#include "thread_pool.h"
 
+#include "compact.h"
 #include "quasi_newton.h"
 
 /*
@@ -38,26 +41,27 @@
  * "An SR1/BFGS SQP algorithm for nonconvex nonlinear
  *  programs with block-diagonal Hessian matrix"
  *
+ * The pairs are kept in a compact representation (see compact.h).
+ * The vectors \f$ a_i \f$ are never formed explicitly, instead they are
+ * represented by their coefficients with respect to the stored pairs,
+ * so that the recomputation only involves the Gram matrix of the pairs.
  */
 
 static const double safeguard_factor = 1e-8;
 
+// Squared norms of the vectors a_i below this fraction of their
+// squared magnitude are dominated by cancellation
+static const double cancellation_factor = 1e-12;
+
 typedef struct
 {
   int dimension;
 
-  SleqpVec** step_diffs;
-  SleqpVec** grad_diffs;
-
-  SleqpVec** inner_prods;
-
-  double* inner_dots;
+  SleqpCompact* compact;
 
-  double initial_scale;
-
-  int num;
-  int len;
-  int curr;
+  // Coefficients of the vectors a_i and of the steps s_i
+  double* inner_coeffs;
+  double* step_coeffs;
 
 } SR1Block;
 
@@ -73,22 +77,35 @@ typedef struct
   SleqpVec* previous_grad;
   SleqpVec* current_grad;
 
-  SleqpVec* block_grad_diff;
-  SleqpVec* block_step_diff;
-
   SleqpVec* prod_cache;
 
-  SleqpVec* inner_cache;
-  SleqpVec* outer_cache;
+  // Dense copies, each block works on its own range
+  double* dense_grad_diff;
+  double* dense_step_diff;
 
-  SleqpVec* block_direction;
-  SleqpVec* block_prod;
+  double* dense_direction;
+  double* dense_prod;
 
   SR1Block* blocks;
   int num_blocks;
 
+  // The first variable of each block, followed by the number of variables
+  int* block_offsets;
+
+  // Work of a pass over all blocks
+  int work;
+
 } SR1;
 
+typedef SLEQP_RETCODE (*SR1_BLOCK_FUNC)(SR1* sr1, int block);
+
+typedef struct
+{
+  SR1* sr1;
+  SR1_BLOCK_FUNC func;
+  int num_tasks;
+} SR1Blocks;
+
 static SLEQP_RETCODE
 sr1_block_create_at(SR1Block* block, int dimension, int num)
 {
@@ -97,28 +114,13 @@ sr1_block_create_at(SR1Block* block, int dimension, int num)
 
   *block = (SR1Block){0};
 
-  block->num       = num;
   block->dimension = dimension;
 
-  block->len  = 0;
-  block->curr = -1;
-
-  SLEQP_CALL(sleqp_alloc_array(&(block->step_diffs), num));
-
-  SLEQP_CALL(sleqp_alloc_array(&(block->grad_diffs), num));
-
-  SLEQP_CALL(sleqp_alloc_array(&(block->inner_prods), num));
-
-  SLEQP_CALL(sleqp_alloc_array(&(block->inner_dots), num));
-
-  for (int i = 0; i < num; ++i)
-  {
-    SLEQP_CALL(sleqp_vec_create_empty(block->step_diffs + i, dimension));
+  SLEQP_CALL(sleqp_compact_create(&block->compact, dimension, num));
 
-    SLEQP_CALL(sleqp_vec_create_empty(block->grad_diffs + i, dimension));
+  SLEQP_CALL(sleqp_alloc_array(&block->inner_coeffs, 2 * num));
 
-    SLEQP_CALL(sleqp_vec_create_empty(block->inner_prods + i, dimension));
-  }
+  SLEQP_CALL(sleqp_alloc_array(&block->step_coeffs, 2 * num));
 
   return SLEQP_OKAY;
 }
@@ -152,8 +154,13 @@ sr1_create(SR1** star,
   data->num_blocks    = num_blocks;
   data->num_variables = num_variables;
 
+  // Entries of the panels and middle matrices per product
+  data->work = 2 * num_iter * (num_variables + 2 * num_iter * num_blocks);
+
   SLEQP_CALL(sleqp_alloc_array(&data->blocks, num_blocks));
 
+  SLEQP_CALL(sleqp_alloc_array(&data->block_offsets, num_blocks + 1));
+
   for (int block = 0; block < num_blocks; ++block)
   {
     int begin, end;
@@ -163,10 +170,14 @@ sr1_create(SR1** star,
 
     int block_dimension = end - begin;
 
+    data->block_offsets[block] = begin;
+
     SLEQP_CALL(
       sr1_block_create_at(data->blocks + block, block_dimension, num_iter));
   }
 
+  data->block_offsets[num_blocks] = num_variables;
+
   SLEQP_CALL(sleqp_vec_create_full(&(data->grad_diff), num_variables));
 
   SLEQP_CALL(sleqp_vec_create_full(&(data->step_diff), num_variables));
@@ -175,179 +186,199 @@ sr1_create(SR1** star,
 
   SLEQP_CALL(sleqp_vec_create_full(&(data->current_grad), num_variables));
 
-  SLEQP_CALL(sleqp_vec_create_full(&(data->block_grad_diff), num_variables));
-
-  SLEQP_CALL(sleqp_vec_create_full(&(data->block_step_diff), num_variables));
-
   SLEQP_CALL(sleqp_vec_create_full(&(data->prod_cache), num_variables));
 
-  SLEQP_CALL(sleqp_vec_create_full(&(data->inner_cache), num_variables));
+  SLEQP_CALL(sleqp_alloc_array(&(data->dense_grad_diff), num_variables));
 
-  SLEQP_CALL(sleqp_vec_create_full(&(data->outer_cache), num_variables));
+  SLEQP_CALL(sleqp_alloc_array(&(data->dense_step_diff), num_variables));
 
-  SLEQP_CALL(sleqp_vec_create_full(&(data->block_direction), num_variables));
+  SLEQP_CALL(sleqp_alloc_array(&(data->dense_direction), num_variables));
 
-  SLEQP_CALL(sleqp_vec_create_full(&(data->block_prod), num_variables));
+  SLEQP_CALL(sleqp_alloc_array(&(data->dense_prod), num_variables));
+
+  // Blocks only write their own ranges, keeping the linear range zero
+  sleqp_kernel_fill(data->dense_prod, 0., num_variables);
 
   return SLEQP_OKAY;
 }
 
-static int
-data_index(SR1Block* block, int index)
+static double
+sr1_initial_scale(double grad_step_dot, double grad_diff_normsq)
 {
-  if (block->len == 0)
+  assert(grad_diff_normsq >= 0.);
+
+  if (grad_step_dot > 0)
   {
-    return 0;
+    return grad_diff_normsq / grad_step_dot;
   }
 
-  int current_index = index % (block->num);
-
-  return (current_index < 0) ? (current_index + block->num) : current_index;
+  return 1e-4;
 }
 
 static SLEQP_RETCODE
-sr1_initial_scale(SleqpVec* step_diff,
-                  SleqpVec* grad_diff,
-                  double* initial_scale)
+sr1_blocks_task(int task, void* data)
 {
-  double grad_step_dot;
+  SR1Blocks* blocks = (SR1Blocks*)data;
+  SR1* sr1          = blocks->sr1;
 
-  SLEQP_CALL(sleqp_vec_dot(grad_diff, step_diff, &grad_step_dot));
+  int begin, end;
 
-  const double grad_diff_normsq = sleqp_vec_norm_sq(grad_diff);
-
-  assert(grad_diff_normsq >= 0.);
+  sleqp_thread_pool_partition(sr1->block_offsets,
+                              sr1->num_blocks,
+                              task,
+                              blocks->num_tasks,
+                              &begin,
+                              &end);
 
-  if (grad_step_dot > 0)
+  for (int block = begin; block < end; ++block)
   {
-    (*initial_scale) = grad_diff_normsq / grad_step_dot;
+    SLEQP_CALL(blocks->func(sr1, block));
   }
-  else
+
+  return SLEQP_OKAY;
+}
+
+// Calls the function for all blocks, in parallel if worthwhile
+static SLEQP_RETCODE
+sr1_for_each_block(SR1* sr1, SR1_BLOCK_FUNC func)
+{
+  const int num_blocks = sr1->num_blocks;
+
+  if (num_blocks == 1 || !sleqp_thread_pool_parallelize(sr1->work))
   {
-    (*initial_scale) = 1e-4;
+    for (int block = 0; block < num_blocks; ++block)
+    {
+      SLEQP_CALL(func(sr1, block));
+    }
+
+    return SLEQP_OKAY;
   }
 
+  SR1Blocks blocks
+    = {.sr1       = sr1,
+       .func      = func,
+       .num_tasks = SLEQP_MIN(sleqp_thread_pool_active_tasks(), num_blocks)};
+
+  SLEQP_CALL(sleqp_thread_pool_run(sleqp_thread_pool_active(),
+                                   blocks.num_tasks,
+                                   sr1_blocks_task,
+                                   (void*)&blocks));
+
   return SLEQP_OKAY;
 }
 
 static SLEQP_RETCODE
-sr1_compute_inner_products(SR1* sr1, SR1Block* block)
+sr1_compute_inner_products(SR1Block* block)
 {
-  assert(block->len > 0);
+  SleqpCompact* compact = block->compact;
 
-  const int first = block->curr - block->len + 1;
+  const int len = sleqp_compact_len(compact);
 
-  const double zero_eps = sleqp_settings_real_value(sr1->settings, SLEQP_SETTINGS_REAL_ZERO_EPS);
+  assert(len > 0);
+
+  const int num_coeffs = sleqp_compact_num_coeffs(compact);
 
   {
-    int i = data_index(block, block->curr);
+    const int step = sleqp_compact_step_index(compact, len - 1);
+    const int grad = sleqp_compact_grad_index(compact, len - 1);
+
+    const double initial_scale
+      = sr1_initial_scale(sleqp_compact_gram(compact, grad, step),
+                          sleqp_compact_gram(compact, grad, grad));
 
-    SLEQP_CALL(sr1_initial_scale(block->step_diffs[i],
-                                 block->grad_diffs[i],
-                                 &block->initial_scale));
+    sleqp_compact_reset_operator(compact, initial_scale);
   }
 
-  sr1->inner_cache->dim = block->dimension;
-  sr1->outer_cache->dim = block->dimension;
+  double* inner_coeffs = block->inner_coeffs;
+  double* step_coeffs  = block->step_coeffs;
 
-  for (int val = first; val <= block->curr; ++val)
+  for (int pos = 0; pos < len; ++pos)
   {
-    int i = data_index(block, val);
-
-    SleqpVec* current_step_diff = block->step_diffs[i];
-    SleqpVec* current_grad_diff = block->grad_diffs[i];
-
-    SleqpVec* current_inner_prod = block->inner_prods[i];
+    const int step = sleqp_compact_step_index(compact, pos);
+    const int grad = sleqp_compact_grad_index(compact, pos);
 
+    for (int k = 0; k < num_coeffs; ++k)
     {
-      SLEQP_CALL(sleqp_vec_copy(block->step_diffs[i], sr1->outer_cache));
-
-      SLEQP_CALL(sleqp_vec_scale(sr1->outer_cache, block->initial_scale));
+      step_coeffs[k] = 0.;
     }
 
-    for (int prev = first; prev < val; ++prev)
+    step_coeffs[step] = 1.;
+
+    // a_i = y_i - B_i s_i
+    sleqp_compact_operator_coeffs(compact, step_coeffs, inner_coeffs);
+
+    for (int k = 0; k < num_coeffs; ++k)
     {
-      int j = data_index(block, prev);
+      inner_coeffs[k] = -inner_coeffs[k];
+    }
 
-      if (block->inner_dots[j] == 0.)
-      {
-        // this marks that the safeguard tripped
-        continue;
-      }
+    inner_coeffs[grad] += 1.;
 
-      SleqpVec* inner_prod = block->inner_prods[j];
+    // Check the safeguard
+    const double inner_dot
+      = sleqp_compact_index_dot(compact, inner_coeffs, step);
 
-      double inner_step_dot;
+    const double current_inner_normsq
+      = sleqp_compact_dot(compact, inner_coeffs, inner_coeffs);
 
-      SLEQP_CALL(sleqp_vec_dot(current_step_diff, inner_prod, &inner_step_dot));
+    const double current_step_normsq = sleqp_compact_gram(compact, step, step);
 
-      double combined_factor = inner_step_dot / (block->inner_dots[j]);
+    // Upper bound on the norm of a_i, attained without cancellation
+    double current_inner_magnitude = 0.;
 
-      SLEQP_CALL(sleqp_vec_add_scaled(sr1->outer_cache,
-                                      inner_prod,
-                                      1.,
-                                      combined_factor,
-                                      zero_eps,
-                                      sr1->inner_cache));
+    for (int k = 0; k < num_coeffs; ++k)
+    {
+      current_inner_magnitude
+        += fabs(inner_coeffs[k]) * sqrt(sleqp_compact_gram(compact, k, k));
+    }
 
-      SLEQP_CALL(sleqp_vec_copy(sr1->inner_cache, sr1->outer_cache));
+    // a_i vanishes up to rounding errors, the pair contains
+    // no new information
+    if (current_inner_normsq
+        <= cancellation_factor * current_inner_magnitude
+             * current_inner_magnitude)
+    {
+      continue;
     }
 
-    SLEQP_CALL(sleqp_vec_add_scaled(sr1->outer_cache,
-                                    current_grad_diff,
-                                    -1.,
-                                    1.,
-                                    zero_eps,
-                                    current_inner_prod));
+    const double current_inner_norm = sqrt(current_inner_normsq);
+    const double current_step_norm  = sqrt(current_step_normsq);
 
-    // Check the safeguard
+    if (fabs(inner_dot)
+        < safeguard_factor * current_inner_norm * current_step_norm)
     {
-      double inner_dot;
-
-      SLEQP_CALL(
-        sleqp_vec_dot(current_step_diff, current_inner_prod, &inner_dot));
-
-      double current_inner_norm = sleqp_vec_norm(current_inner_prod);
-      double current_step_norm  = sleqp_vec_norm(current_step_diff);
-
-      assert(current_inner_norm >= 0.);
-      assert(current_step_norm >= 0.);
-
-      if (fabs(inner_dot)
-          < safeguard_factor * current_inner_norm * current_step_norm)
-      {
-        block->inner_dots[i] = 0.;
-      }
-      else
-      {
-        block->inner_dots[i] = inner_dot;
-      }
+      // this marks that the safeguard tripped
+      continue;
     }
+
+    sleqp_compact_add_term(compact, inner_coeffs, 1. / inner_dot);
   }
 
   return SLEQP_OKAY;
 }
 
 static SLEQP_RETCODE
-sr1_block_push(SR1* sr1,
-               SR1Block* block,
-               SleqpVec* step_diff,
-               SleqpVec* grad_diff)
+sr1_block_push(SR1* sr1, int index)
 {
-  const int next = data_index(block, block->curr + 1);
+  SR1Block* block  = sr1->blocks + index;
+  const int offset = sr1->block_offsets[index];
 
-  SLEQP_CALL(sleqp_vec_copy(step_diff, block->step_diffs[next]));
+  const double eps
+    = sleqp_settings_real_value(sr1->settings, SLEQP_SETTINGS_REAL_EPS);
 
-  SLEQP_CALL(sleqp_vec_copy(grad_diff, block->grad_diffs[next]));
+  const double* step_diff = sr1->dense_step_diff + offset;
+  const double* grad_diff = sr1->dense_grad_diff + offset;
 
-  if (block->len < block->num)
+  const double step_normsq = sleqp_kernel_norm_sq(step_diff, block->dimension);
+
+  if (sleqp_is_zero(step_normsq, eps))
   {
-    ++block->len;
+    return SLEQP_OKAY;
   }
 
-  block->curr = next;
+  sleqp_compact_push(block->compact, step_diff, grad_diff);
 
-  SLEQP_CALL(sr1_compute_inner_products(sr1, block));
+  SLEQP_CALL(sr1_compute_inner_products(block));
 
   return SLEQP_OKAY;
 }
@@ -360,12 +391,8 @@ sr1_push(const SleqpIterate* previous_iterate,
 {
   SR1* sr1 = (SR1*)data;
 
-  const double eps = sleqp_settings_real_value(sr1->settings, SLEQP_SETTINGS_REAL_EPS);
-
   const double zero_eps = sleqp_settings_real_value(sr1->settings, SLEQP_SETTINGS_REAL_ZERO_EPS);
 
-  const int num_blocks = sr1->num_blocks;
-
   // Compute gradient difference
   {
     SLEQP_CALL(
@@ -409,56 +436,13 @@ sr1_push(const SleqpIterate* previous_iterate,
                                   zero_eps,
                                   sr1->step_diff));
 
-  int k_step = 0;
-  int k_grad = 0;
-
-  int offset = 0;
-
-  for (int i = 0; i < num_blocks; ++i)
-  {
-    SR1Block* block = sr1->blocks + i;
-
-    int next_offset = offset + block->dimension;
-
-    SLEQP_CALL(sleqp_vec_clear(sr1->block_grad_diff));
-    SLEQP_CALL(sleqp_vec_clear(sr1->block_step_diff));
-
-    sr1->block_grad_diff->dim = block->dimension;
-    sr1->block_step_diff->dim = block->dimension;
-
-    while (k_step < sr1->step_diff->nnz
-           && sr1->step_diff->indices[k_step] < next_offset)
-    {
-      SLEQP_CALL(sleqp_vec_push(sr1->block_step_diff,
-                                sr1->step_diff->indices[k_step] - offset,
-                                sr1->step_diff->data[k_step]));
-
-      ++k_step;
-    }
-
-    while (k_grad < sr1->grad_diff->nnz
-           && sr1->grad_diff->indices[k_grad] < next_offset)
-    {
-      SLEQP_CALL(sleqp_vec_push(sr1->block_grad_diff,
-                                sr1->grad_diff->indices[k_grad] - offset,
-                                sr1->grad_diff->data[k_grad]));
-
-      ++k_grad;
-    }
-
-    const double step_normsq = sleqp_vec_norm_sq(sr1->block_step_diff);
-
-    assert(sleqp_vec_is_finite(sr1->block_step_diff));
-    assert(sleqp_vec_is_finite(sr1->block_grad_diff));
+  assert(sleqp_vec_is_finite(sr1->step_diff));
+  assert(sleqp_vec_is_finite(sr1->grad_diff));
 
-    if (!sleqp_is_zero(step_normsq, eps))
-    {
-      SLEQP_CALL(
-        sr1_block_push(sr1, block, sr1->block_step_diff, sr1->block_grad_diff));
-    }
+  SLEQP_CALL(sleqp_vec_to_raw(sr1->step_diff, sr1->dense_step_diff));
+  SLEQP_CALL(sleqp_vec_to_raw(sr1->grad_diff, sr1->dense_grad_diff));
 
-    offset = next_offset;
-  }
+  SLEQP_CALL(sr1_for_each_block(sr1, sr1_block_push));
 
   return SLEQP_OKAY;
 }
@@ -472,62 +456,57 @@ sr1_reset(void* data)
 
   for (int i = 0; i < num_blocks; ++i)
   {
-    SR1Block* block = sr1->blocks + i;
-    block->len      = 0;
+    sleqp_compact_reset(sr1->blocks[i].compact);
   }
 
   return SLEQP_OKAY;
 }
 
 static SLEQP_RETCODE
-sr1_block_hess_prod(SR1* sr1,
-                    SR1Block* block,
-                    const SleqpVec* direction,
-                    SleqpVec* product)
+sr1_block_copy(const SR1Block* source, SR1Block* target)
 {
-  SLEQP_CALL(sleqp_vec_copy(direction, product));
-
-  if (block->len == 0)
+  if (source->dimension != target->dimension)
   {
-    // If we have not acquired any information yet,
-    // then we simply use the identity without any scaling.
-
-    return SLEQP_OKAY;
+    sleqp_raise(SLEQP_ILLEGAL_ARGUMENT, "Incompatible SR1 blocks");
   }
 
-  const double zero_eps = sleqp_settings_real_value(sr1->settings, SLEQP_SETTINGS_REAL_ZERO_EPS);
+  SLEQP_CALL(sleqp_compact_copy(source->compact, target->compact));
 
-  // Note: We have already computed the required inner products / dots
+  return SLEQP_OKAY;
+}
 
-  SLEQP_CALL(sleqp_vec_scale(product, block->initial_scale));
+static SLEQP_RETCODE
+sr1_copy(const void* source_data, void* target_data)
+{
+  const SR1* source = (const SR1*)source_data;
+  SR1* target       = (SR1*)target_data;
 
-  for (int val = block->curr - block->len + 1; val <= block->curr; ++val)
+  if (source->num_blocks != target->num_blocks)
   {
-    int i = data_index(block, val);
-
-    if (block->inner_dots[i] == 0.)
-    {
-      // this marks that the safeguard tripped
-      continue;
-    }
-
-    SleqpVec* current_inner_prod = block->inner_prods[i];
+    sleqp_raise(SLEQP_ILLEGAL_ARGUMENT,
+                "Cannot copy SR1 data between %d and %d blocks",
+                source->num_blocks,
+                target->num_blocks);
+  }
 
-    double direction_dot;
+  const int num_blocks = source->num_blocks;
 
-    SLEQP_CALL(sleqp_vec_dot(current_inner_prod, direction, &direction_dot));
+  for (int i = 0; i < num_blocks; ++i)
+  {
+    SLEQP_CALL(sr1_block_copy(source->blocks + i, target->blocks + i));
+  }
 
-    double combined_factor = direction_dot / (block->inner_dots[i]);
+  return SLEQP_OKAY;
+}
 
-    SLEQP_CALL(sleqp_vec_add_scaled(product,
-                                    current_inner_prod,
-                                    1.,
-                                    combined_factor,
-                                    zero_eps,
-                                    sr1->inner_cache));
+static SLEQP_RETCODE
+sr1_block_hess_prod(SR1* sr1, int index)
+{
+  const int offset = sr1->block_offsets[index];
 
-    SLEQP_CALL(sleqp_vec_copy(sr1->inner_cache, product));
-  }
+  sleqp_compact_hess_prod(sr1->blocks[index].compact,
+                          sr1->dense_direction + offset,
+                          sr1->dense_prod + offset);
 
   return SLEQP_OKAY;
 }
@@ -537,76 +516,21 @@ sr1_hess_prod(const SleqpVec* direction, SleqpVec* product, void* data)
 {
   SR1* sr1 = (SR1*)data;
 
-  const int num_blocks = sr1->num_blocks;
-
-  int offset      = 0;
-  int k_direction = 0, k_product = 0;
-
-  SLEQP_CALL(sleqp_vec_clear(product));
-  SLEQP_CALL(sleqp_vec_reserve(product, sr1->num_variables));
-
-  for (int i = 0; i < num_blocks; ++i)
-  {
-    SR1Block* block = sr1->blocks + i;
-
-    int next_offset = offset + block->dimension;
-
-    if (block->len == 0)
-    {
-      while (k_direction < direction->nnz
-             && direction->indices[k_direction] < next_offset)
-      {
-        assert(direction->indices[k_direction] >= offset);
-
-        SLEQP_CALL(sleqp_vec_push(product,
-                                  direction->indices[k_direction],
-                                  direction->data[k_direction]));
-
-        ++k_direction;
-        ++k_product;
-      }
-    }
-    else
-    {
-      sr1->block_direction->dim = block->dimension;
-      sr1->block_prod->dim      = block->dimension;
-
-      SLEQP_CALL(sleqp_vec_clear(sr1->block_direction));
-      SLEQP_CALL(sleqp_vec_clear(sr1->block_prod));
-
-      while (k_direction < direction->nnz
-             && direction->indices[k_direction] < next_offset)
-      {
-        SLEQP_CALL(sleqp_vec_push(sr1->block_direction,
-                                  direction->indices[k_direction] - offset,
-                                  direction->data[k_direction]));
+  const double zero_eps
+    = sleqp_settings_real_value(sr1->settings, SLEQP_SETTINGS_REAL_ZERO_EPS);
 
-        ++k_direction;
-      }
+  assert(sleqp_vec_is_finite(direction));
 
-      assert(sleqp_vec_is_finite(sr1->block_direction));
+  SLEQP_CALL(sleqp_vec_to_raw(direction, sr1->dense_direction));
 
-      SLEQP_CALL(
-        sr1_block_hess_prod(sr1, block, sr1->block_direction, sr1->block_prod));
+  SLEQP_CALL(sr1_for_each_block(sr1, sr1_block_hess_prod));
 
-      assert(sleqp_vec_is_finite(sr1->block_prod));
-
-      for (int k_block_prod = 0; k_block_prod < sr1->block_prod->nnz;
-           ++k_block_prod)
-      {
-        assert(sr1->block_prod->indices[k_block_prod] + offset < next_offset);
-
-        SLEQP_CALL(
-          sleqp_vec_push(product,
-                         sr1->block_prod->indices[k_block_prod] + offset,
-                         sr1->block_prod->data[k_block_prod]));
-
-        ++k_product;
-      }
-    }
+  SLEQP_CALL(sleqp_vec_set_from_raw(product,
+                                    sr1->dense_prod,
+                                    sr1->num_variables,
+                                    zero_eps));
 
-    offset = next_offset;
-  }
+  assert(sleqp_vec_is_finite(product));
 
   return SLEQP_OKAY;
 }
@@ -614,22 +538,10 @@ sr1_hess_prod(const SleqpVec* direction, SleqpVec* product, void* data)
 static SLEQP_RETCODE
 sr1_block_free_at(SR1Block* block)
 {
-  const int num = block->num;
-
-  for (int i = 0; i < num; ++i)
-  {
-    SLEQP_CALL(sleqp_vec_free(block->inner_prods + i));
-
-    SLEQP_CALL(sleqp_vec_free(block->grad_diffs + i));
-    SLEQP_CALL(sleqp_vec_free(block->step_diffs + i));
-  }
+  sleqp_free(&block->step_coeffs);
+  sleqp_free(&block->inner_coeffs);
 
-  sleqp_free(&(block->inner_dots));
-
-  sleqp_free(&block->inner_prods);
-
-  sleqp_free(&block->grad_diffs);
-  sleqp_free(&block->step_diffs);
+  SLEQP_CALL(sleqp_compact_free(&block->compact));
 
   return SLEQP_OKAY;
 }
@@ -651,19 +563,18 @@ sr1_free(void* data)
     SLEQP_CALL(sr1_block_free_at(sr1->blocks + block));
   }
 
+  sleqp_free(&sr1->block_offsets);
+
   sleqp_free(&sr1->blocks);
 
-  SLEQP_CALL(sleqp_vec_free(&(sr1->block_prod)));
-  SLEQP_CALL(sleqp_vec_free(&(sr1->block_direction)));
+  sleqp_free(&(sr1->dense_prod));
+  sleqp_free(&(sr1->dense_direction));
 
-  SLEQP_CALL(sleqp_vec_free(&(sr1->outer_cache)));
-  SLEQP_CALL(sleqp_vec_free(&(sr1->inner_cache)));
+  sleqp_free(&(sr1->dense_step_diff));
+  sleqp_free(&(sr1->dense_grad_diff));
 
   SLEQP_CALL(sleqp_vec_free(&(sr1->prod_cache)));
 
-  SLEQP_CALL(sleqp_vec_free(&(sr1->block_step_diff)));
-  SLEQP_CALL(sleqp_vec_free(&(sr1->block_grad_diff)));
-
   SLEQP_CALL(sleqp_vec_free(&(sr1->current_grad)));
   SLEQP_CALL(sleqp_vec_free(&(sr1->previous_grad)));
 
@@ -686,6 +597,7 @@ sleqp_sr1_create(SleqpQuasiNewton** star,
     .push      = sr1_push,
     .reset     = sr1_reset,
     .hess_prod = sr1_hess_prod,
+    .copy      = sr1_copy,
     .free      = sr1_free,
   };
 
@@ -2,12 +2,14 @@
 
 #include <fenv.h>
 #include <math.h>
+#include <stdatomic.h>
 
 #include "cmp.h"
 #include "error.h"
 #include "fail.h"
 #include "log.h"
 #include "mem.h"
+#include "thread_pool.h"
 
 #define MAX_WEIGHT 30
 
@@ -18,7 +20,8 @@ const int min_weight = -(MAX_WEIGHT);
 
 struct SleqpScaling
 {
-  int refcount;
+  // Scalings may be shared among solvers running in parallel
+  atomic_int refcount;
 
   int num_variables;
   int num_constraints;
@@ -72,6 +75,86 @@ apply_scaling(SleqpVec* vec, int* scales, int offset)
   return SLEQP_OKAY;
 }
 
+typedef struct
+{
+  SleqpMat* matrix;
+  const int* row_weights;
+  const int* col_weights;
+  int sign;
+  int num_blocks;
+} MatrixScaling;
+
+// Multiplies the entries in the columns [begin, end) of the matrix by
+// 2^(sign * (col_weight - row_weight))
+static void
+scale_matrix_cols(const MatrixScaling* scaling, int begin, int end)
+{
+  const int* cols = sleqp_mat_cols(scaling->matrix);
+  const int* rows = sleqp_mat_rows(scaling->matrix);
+  double* data    = sleqp_mat_data(scaling->matrix);
+
+  const int sign = scaling->sign;
+
+  for (int col = begin; col < end; ++col)
+  {
+    const int col_weight = scaling->col_weights[col];
+
+    for (int index = cols[col]; index < cols[col + 1]; ++index)
+    {
+      const int row_weight = scaling->row_weights[rows[index]];
+
+      data[index] = ldexp(data[index], sign * (col_weight - row_weight));
+    }
+  }
+}
+
+static SLEQP_RETCODE
+scale_matrix_task(int block, void* data)
+{
+  const MatrixScaling* scaling = (const MatrixScaling*)data;
+
+  int begin, end;
+
+  sleqp_thread_pool_partition(sleqp_mat_cols(scaling->matrix),
+                              sleqp_mat_num_cols(scaling->matrix),
+                              block,
+                              scaling->num_blocks,
+                              &begin,
+                              &end);
+
+  scale_matrix_cols(scaling, begin, end);
+
+  return SLEQP_OKAY;
+}
+
+static SLEQP_RETCODE
+scale_matrix(SleqpMat* matrix,
+             const int* row_weights,
+             const int* col_weights,
+             int sign)
+{
+  MatrixScaling scaling = {.matrix      = matrix,
+                           .row_weights = row_weights,
+                           .col_weights = col_weights,
+                           .sign        = sign,
+                           .num_blocks  = 1};
+
+  if (!sleqp_thread_pool_parallelize(sleqp_mat_nnz(matrix)))
+  {
+    scale_matrix_cols(&scaling, 0, sleqp_mat_num_cols(matrix));
+    return SLEQP_OKAY;
+  }
+
+  scaling.num_blocks = sleqp_thread_pool_active_tasks();
+
+  SLEQP_CALL(sleqp_thread_pool_run(sleqp_thread_pool_active(),
+                                   scaling.num_blocks,
+                                   scale_matrix_task,
+                                   (void*)&scaling));
+
+  return SLEQP_OKAY;
+}
+
 SLEQP_RETCODE
 sleqp_scaling_reset(SleqpScaling* scaling)
 {
@@ -247,6 +330,35 @@ sleqp_scaling_set_cons_weight_from_nominal(SleqpScaling* scaling,
   return SLEQP_OKAY;
 }
 
+bool
+sleqp_scaling_eq(SleqpScaling* first, SleqpScaling* second)
+{
+  if (first->num_variables != second->num_variables
+      || first->num_constraints != second->num_constraints
+      || first->obj_weight != second->obj_weight)
+  {
+    return false;
+  }
+
+  for (int j = 0; j < first->num_variables; ++j)
+  {
+    if (first->var_weights[j] != second->var_weights[j])
+    {
+      return false;
+    }
+  }
+
+  for (int i = 0; i < first->num_constraints; ++i)
+  {
+    if (first->cons_weights[i] != second->cons_weights[i])
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 int*
 sleqp_scaling_var_weights(SleqpScaling* scaling)
 {
@@ -362,27 +474,10 @@ sleqp_scale_cons_linear(SleqpScaling* scaling, SleqpVec* linear_val)
 SLEQP_RETCODE
 sleqp_scale_cons_jac(SleqpScaling* scaling, SleqpMat* cons_jac)
 {
-  int col = 0;
-
-  const int* cons_jac_cols = sleqp_mat_cols(cons_jac);
-  const int* cons_jac_rows = sleqp_mat_rows(cons_jac);
-  double* cons_jac_data    = sleqp_mat_data(cons_jac);
-
-  int cons_jac_nnz = sleqp_mat_nnz(cons_jac);
-
-  for (int index = 0; index < cons_jac_nnz; ++index)
-  {
-    while (index >= cons_jac_cols[col + 1])
-    {
-      ++col;
-    }
-
-    const int row = cons_jac_rows[index];
-
-    cons_jac_data[index]
-      = ldexp(cons_jac_data[index],
-              (-1) * scaling->cons_weights[row] + scaling->var_weights[col]);
-  }
+  SLEQP_CALL(scale_matrix(cons_jac,
+                          scaling->cons_weights,
+                          scaling->var_weights,
+                          1));
 
   return SLEQP_OKAY;
 }
@@ -390,32 +485,14 @@ sleqp_scale_cons_jac(SleqpScaling* scaling, SleqpMat* cons_jac)
 SLEQP_RETCODE
 sleqp_scale_linear_coeffs(SleqpScaling* scaling, SleqpMat* linear_coeffs)
 {
-  int col = 0;
-
   const int num_linear = sleqp_mat_num_rows(linear_coeffs);
 
   assert(num_linear <= scaling->num_constraints);
 
-  const int* linear_coeffs_cols = sleqp_mat_cols(linear_coeffs);
-  const int* linear_coeffs_rows = sleqp_mat_rows(linear_coeffs);
-  double* linear_coeffs_data    = sleqp_mat_data(linear_coeffs);
-
-  int linear_coeffs_nnz = sleqp_mat_nnz(linear_coeffs);
-
-  for (int index = 0; index < linear_coeffs_nnz; ++index)
-  {
-    while (index >= linear_coeffs_cols[col + 1])
-    {
-      ++col;
-    }
-
-    const int row = linear_coeffs_rows[index];
-
-    linear_coeffs_data[index]
-      = ldexp(linear_coeffs_data[index],
-              (-1) * scaling->cons_weights[num_linear + row]
-                + scaling->var_weights[col]);
-  }
+  SLEQP_CALL(scale_matrix(linear_coeffs,
+                          scaling->cons_weights + num_linear,
+                          scaling->var_weights,
+                          1));
 
   return SLEQP_OKAY;
 }
@@ -529,27 +606,10 @@ sleqp_unscale_cons_val(SleqpScaling* scaling, SleqpVec* scaled_cons_val)
 SLEQP_RETCODE
 sleqp_unscale_cons_jac(SleqpScaling* scaling, SleqpMat* scaled_cons_jac)
 {
-  int col = 0;
-
-  const int* cons_jac_cols = sleqp_mat_cols(scaled_cons_jac);
-  const int* cons_jac_rows = sleqp_mat_rows(scaled_cons_jac);
-  double* cons_jac_data    = sleqp_mat_data(scaled_cons_jac);
-
-  int cons_jac_nnz = sleqp_mat_nnz(scaled_cons_jac);
-
-  for (int index = 0; index < cons_jac_nnz; ++index)
-  {
-    while (index >= cons_jac_cols[col + 1])
-    {
-      ++col;
-    }
-
-    const int row = cons_jac_rows[index];
-
-    cons_jac_data[index]
-      = ldexp(cons_jac_data[index],
-              (-1) * (scaling->var_weights[col]) + scaling->cons_weights[row]);
-  }
+  SLEQP_CALL(scale_matrix(scaled_cons_jac,
+                          scaling->cons_weights,
+                          scaling->var_weights,
+                          -1));
 
   return SLEQP_OKAY;
 }
@@ -7,6 +7,12 @@ SLEQP_NODISCARD
 SLEQP_RETCODE
 sleqp_scaling_set_func(SleqpScaling* scaling, SleqpFunc* func);
 
+/**
+ * Returns whether both scalings use the same weights
+ **/
+bool
+sleqp_scaling_eq(SleqpScaling* first, SleqpScaling* second);
+
 SLEQP_NODISCARD
 SLEQP_RETCODE
 sleqp_scale_point(SleqpScaling* scaling, SleqpVec* point);
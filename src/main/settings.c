@@ -3,6 +3,7 @@
 #include <ctype.h>
 #include <fenv.h>
 #include <math.h>
+#include <stdatomic.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -43,6 +44,8 @@
 #define ENABLE_PREPROCESSOR_DEFAULT false
 #define ENABLE_RESTORATION_PHASE_DEFAULT true
 #define LP_RESOLVES_DEFAULT true
+#define SPECULATIVE_PARAMETRIC_CAUCHY_DEFAULT false
+#define MEMORY_POOL_DEFAULT true
 
 #define DERIV_CHECK_DEFAULT SLEQP_DERIV_CHECK_SKIP
 #define HESS_EVAL_DEFAULT SLEQP_HESS_EVAL_EXACT
@@ -57,10 +60,14 @@
 #define PARAMETRIC_CAUCHY_DEFAULT SLEQP_PARAMETRIC_CAUCHY_DISABLED
 #define INITIAL_TR_CHOICE_DEFAULT SLEQP_INITIAL_TR_CHOICE_NARROW
 #define AUG_JAC_METHOD_DEFAULT SLEQP_AUG_JAC_AUTO
+#define TR_PRECOND_DEFAULT SLEQP_TR_PRECOND_NONE
+#define DERIV_CHECK_SAMPLING_DEFAULT SLEQP_DERIV_CHECK_SAMPLING_NONE
 
 #define QUASI_NEWTON_SIZE_DEFAULT 5
 #define MAX_NEWTON_ITERATIONS_DEFAULT 100
 #define NUM_THREADS_DEFAULT SLEQP_NONE
+#define DERIV_CHECK_SAMPLES_DEFAULT 10
+#define PRECOND_MAX_BLOCK_SIZE_DEFAULT 100
 
 #define CHECK_FLOAT_ENV                                                        \
   do                                                                           \
@@ -74,7 +81,8 @@
 
 struct SleqpSettings
 {
-  int refcount;
+  // Settings may be shared among solvers running in parallel
+  atomic_int refcount;
 
   int enum_values[SLEQP_NUM_ENUM_SETTINGS];
   int int_values[SLEQP_NUM_INT_SETTINGS];
@@ -126,6 +134,17 @@ OptionInfo enum_option_info[SLEQP_NUM_ENUM_SETTINGS] = {
   [SLEQP_SETTINGS_ENUM_AUG_JAC_METHOD]
   = {.name = "augmented Jacobian method",
      .desc = "How to solve the augmented Jacobian systems"},
+  [SLEQP_SETTINGS_ENUM_TR_PRECOND]
+  = {.name = "tr_precond",
+     .desc = "Which preconditioner to use in the CG trust-region solver. "
+             "The incomplete Cholesky preconditioner assembles the Hessian "
+             "using one Hessian product per variable of its largest block "
+             "at each iterate, falling back to the diagonal one for blocks "
+             "larger than precond_max_block_size"},
+  [SLEQP_SETTINGS_ENUM_DERIV_CHECK_SAMPLING]
+  = {.name = "deriv_check_sampling",
+     .desc = "Whether to check derivatives along all coordinates, "
+             "a random subset of coordinates, or random directions"},
 };
 
 const OptionInfo real_option_info[SLEQP_NUM_REAL_SETTINGS] = {
@@ -227,8 +246,18 @@ OptionInfo int_option_info[SLEQP_NUM_INT_SETTINGS] = {
              "to be performed per iteration"},
   [SLEQP_SETTINGS_INT_NUM_THREADS]
   = {.name = "num_threads",
-     .desc = "The maximum number of threads to be used."
+     .desc = "The maximum number of threads to be used by the solver, "
+             "its LP solver and factorization. "
              "Set to SLEQP_NONE to remove restriction."},
+  [SLEQP_SETTINGS_INT_DERIV_CHECK_SAMPLES]
+  = {.name = "deriv_check_samples",
+     .desc = "Number of coordinates or directions checked "
+             "when sampling derivative checks"},
+  [SLEQP_SETTINGS_INT_PRECOND_MAX_BLOCK_SIZE]
+  = {.name = "precond_max_block_size",
+     .desc = "Largest block of the Hessian structure whose entries are "
+             "assembled by preconditioners, each variable of the block "
+             "requiring one Hessian product per iterate"},
 };
 
 const char*
@@ -271,7 +300,15 @@ OptionInfo bool_option_info[SLEQP_NUM_BOOL_SETTINGS]
         .desc = "Whether to enable the built-in preprocessor"},
      [SLEQP_SETTINGS_BOOL_LP_RESOLVES]
      = {.name = "lp_resolves",
-        .desc = "Enable LP resolves in case of ambiguous optimal bases"}};
+        .desc = "Enable LP resolves in case of ambiguous optimal bases"},
+     [SLEQP_SETTINGS_BOOL_SPECULATIVE_PARAMETRIC_CAUCHY]
+     = {.name = "speculative_parametric_cauchy",
+        .desc = "Whether to solve the LPs of the parametric Cauchy search "
+                "for several trust radii in parallel"},
+     [SLEQP_SETTINGS_BOOL_MEMORY_POOL]
+     = {.name = "memory_pool",
+        .desc = "Whether to retain the scratch memory of solves in a pool "
+                "owned by the solver"}};
 
 const char*
 sleqp_settings_bool_name(SLEQP_SETTINGS_BOOL option)
@@ -314,12 +351,19 @@ sleqp_settings_create(SleqpSettings** star)
        [SLEQP_SETTINGS_ENUM_LINESEARCH]          = LINESEARCH_DEFAULT,
        [SLEQP_SETTINGS_ENUM_PARAMETRIC_CAUCHY]   = PARAMETRIC_CAUCHY_DEFAULT,
        [SLEQP_SETTINGS_ENUM_INITIAL_TR_CHOICE]   = INITIAL_TR_CHOICE_DEFAULT,
-       [SLEQP_SETTINGS_ENUM_AUG_JAC_METHOD]      = AUG_JAC_METHOD_DEFAULT},
+       [SLEQP_SETTINGS_ENUM_AUG_JAC_METHOD]      = AUG_JAC_METHOD_DEFAULT,
+       [SLEQP_SETTINGS_ENUM_TR_PRECOND]          = TR_PRECOND_DEFAULT,
+       [SLEQP_SETTINGS_ENUM_DERIV_CHECK_SAMPLING]
+       = DERIV_CHECK_SAMPLING_DEFAULT},
     .int_values = {[SLEQP_SETTINGS_INT_NUM_QUASI_NEWTON_ITERATES]
                    = QUASI_NEWTON_SIZE_DEFAULT,
                    [SLEQP_SETTINGS_INT_MAX_NEWTON_ITERATIONS]
                    = MAX_NEWTON_ITERATIONS_DEFAULT,
-                   [SLEQP_SETTINGS_INT_NUM_THREADS] = NUM_THREADS_DEFAULT},
+                   [SLEQP_SETTINGS_INT_NUM_THREADS] = NUM_THREADS_DEFAULT,
+                   [SLEQP_SETTINGS_INT_DERIV_CHECK_SAMPLES]
+                   = DERIV_CHECK_SAMPLES_DEFAULT,
+                   [SLEQP_SETTINGS_INT_PRECOND_MAX_BLOCK_SIZE]
+                   = PRECOND_MAX_BLOCK_SIZE_DEFAULT},
     .bool_values
     = {[SLEQP_SETTINGS_BOOL_PERFORM_NEWTON_STEP] = PERFORM_NEWTON_DEFAULT,
        [SLEQP_SETTINGS_BOOL_GLOBAL_PENALTY_RESETS]
@@ -331,7 +375,10 @@ sleqp_settings_create(SleqpSettings** star)
        [SLEQP_SETTINGS_BOOL_ENABLE_RESTORATION_PHASE]
        = ENABLE_RESTORATION_PHASE_DEFAULT,
        [SLEQP_SETTINGS_BOOL_ENABLE_PREPROCESSOR] = ENABLE_PREPROCESSOR_DEFAULT,
-       [SLEQP_SETTINGS_BOOL_LP_RESOLVES]         = LP_RESOLVES_DEFAULT},
+       [SLEQP_SETTINGS_BOOL_LP_RESOLVES]         = LP_RESOLVES_DEFAULT,
+       [SLEQP_SETTINGS_BOOL_SPECULATIVE_PARAMETRIC_CAUCHY]
+       = SPECULATIVE_PARAMETRIC_CAUCHY_DEFAULT,
+       [SLEQP_SETTINGS_BOOL_MEMORY_POOL] = MEMORY_POOL_DEFAULT},
     .real_values
     = {[SLEQP_SETTINGS_REAL_ZERO_EPS]           = ZERO_EPS_DEFAULT,
        [SLEQP_SETTINGS_REAL_EPS]                = EPS_DEFAULT,
@@ -382,6 +429,10 @@ get_enum(SLEQP_SETTINGS_ENUM option)
     return sleqp_enum_initial_tr();
   case SLEQP_SETTINGS_ENUM_AUG_JAC_METHOD:
     return sleqp_enum_aug_jac_method();
+  case SLEQP_SETTINGS_ENUM_TR_PRECOND:
+    return sleqp_enum_tr_precond();
+  case SLEQP_SETTINGS_ENUM_DERIV_CHECK_SAMPLING:
+    return sleqp_enum_deriv_check_sampling();
   default:
     assert(0);
   }
@@ -11,6 +11,7 @@
 #include "func.h"
 #include "iterate.h"
 #include "mem.h"
+#include "mem_pool.h"
 #include "problem.h"
 #include "pub_mem.h"
 #include "pub_settings.h"
@@ -295,6 +296,15 @@ sleqp_solver_create(SleqpSolver** star,
   SLEQP_CALL(sleqp_settings_capture(settings));
   solver->settings = settings;
 
+  SLEQP_CALL(sleqp_thread_pool_create(
+    &solver->thread_pool,
+    sleqp_settings_int_value(settings, SLEQP_SETTINGS_INT_NUM_THREADS)));
+
+  if (sleqp_settings_bool_value(settings, SLEQP_SETTINGS_BOOL_MEMORY_POOL))
+  {
+    SLEQP_CALL(sleqp_mem_pool_create(&solver->allocator));
+  }
+
   const int num_orig_vars = sleqp_problem_num_vars(problem);
   const int num_orig_cons = sleqp_problem_num_cons(problem);
 
@@ -311,6 +321,8 @@ sleqp_solver_create(SleqpSolver** star,
 
   SLEQP_CALL(solver_create_problem(solver, problem));
 
+  solver->problem_version = sleqp_problem_version(problem);
+
   const int num_variables = sleqp_problem_num_vars(solver->problem);
 
   SLEQP_CALL(sleqp_vec_create_empty(&solver->scaled_primal, num_orig_vars));
@@ -421,6 +433,90 @@ sleqp_solver_reset(SleqpSolver* solver)
   return SLEQP_OKAY;
 }
 
+static bool
+solver_scaling_eq(const SleqpSolver* first, const SleqpSolver* second)
+{
+  if (!(first->scaling_data && second->scaling_data))
+  {
+    return !(first->scaling_data || second->scaling_data);
+  }
+
+  return sleqp_scaling_eq(first->scaling_data, second->scaling_data);
+}
+
+// Solvers without a preprocessor match those whose preprocessing failed
+static bool
+solver_preprocessing_eq(const SleqpSolver* first, const SleqpSolver* second)
+{
+  SleqpPreprocessor* first_preprocessor  = first->preprocessor;
+  SleqpPreprocessor* second_preprocessor = second->preprocessor;
+
+  if (first_preprocessor && second_preprocessor)
+  {
+    return sleqp_preprocessor_eq(first_preprocessor, second_preprocessor);
+  }
+
+  SleqpPreprocessor* preprocessor
+    = first_preprocessor ? first_preprocessor : second_preprocessor;
+
+  return !preprocessor
+         || (sleqp_preprocessor_result(preprocessor)
+             == SLEQP_PREPROCESSING_RESULT_FAILURE);
+}
+
+SLEQP_RETCODE
+sleqp_solver_warm_start(SleqpSolver* solver, const SleqpSolver* source)
+{
+  SleqpProblem* problem = solver->problem;
+
+  const int num_vars = sleqp_problem_num_vars(problem);
+  const int num_cons = sleqp_problem_num_cons(problem);
+
+  if (num_vars != sleqp_problem_num_vars(source->problem)
+      || num_cons != sleqp_problem_num_cons(source->problem))
+  {
+    sleqp_raise(SLEQP_ILLEGAL_ARGUMENT,
+                "Cannot warm start a problem with %d variables and %d "
+                "constraints from one with %d variables and %d constraints",
+                num_vars,
+                num_cons,
+                sleqp_problem_num_vars(source->problem),
+                sleqp_problem_num_cons(source->problem));
+  }
+
+  // Iterates are stored in the scaled and preprocessed space
+  if (!solver_scaling_eq(solver, source))
+  {
+    sleqp_raise(SLEQP_ILLEGAL_ARGUMENT,
+                "Cannot warm start from a solver with a different scaling");
+  }
+
+  if (!solver_preprocessing_eq(solver, source))
+  {
+    sleqp_raise(SLEQP_ILLEGAL_ARGUMENT,
+                "Cannot warm start from a solver with a different "
+                "preprocessing of the problem");
+  }
+
+  const SleqpIterate* source_iterate
+    = sleqp_problem_solver_iterate(source->problem_solver);
+
+  // Next solve starts from the final primal of the source
+  SLEQP_CALL(sleqp_vec_copy(sleqp_iterate_primal(source_iterate),
+                            solver->primal));
+
+  SLEQP_CALL(sleqp_problem_solver_warm_start(solver->problem_solver,
+                                             source->problem_solver));
+
+  if (solver->quasi_newton && source->quasi_newton)
+  {
+    SLEQP_CALL(
+      sleqp_quasi_newton_copy(source->quasi_newton, solver->quasi_newton));
+  }
+
+  return SLEQP_OKAY;
+}
+
 SLEQP_RETCODE
 sleqp_solver_abort(SleqpSolver* solver)
 {
@@ -437,12 +533,58 @@ sleqp_solver_iterations(const SleqpSolver* solver)
   return solver->iterations;
 }
 
+int
+sleqp_solver_lp_iterations(const SleqpSolver* solver)
+{
+  int lp_iterations
+    = sleqp_problem_solver_lp_iterations(solver->problem_solver);
+
+  if (solver->restoration_problem_solver)
+  {
+    lp_iterations
+      += sleqp_problem_solver_lp_iterations(solver->restoration_problem_solver);
+  }
+
+  return lp_iterations;
+}
+
 double
 sleqp_solver_elapsed_seconds(const SleqpSolver* solver)
 {
   return sleqp_timer_get_ttl(solver->elapsed_timer);
 }
 
+SLEQP_RETCODE
+sleqp_solver_set_trace_file(SleqpSolver* solver, const char* filename)
+{
+#ifndef SLEQP_ENABLE_TRACE
+  if (filename)
+  {
+    sleqp_raise(SLEQP_ILLEGAL_ARGUMENT,
+                "Iteration traces are disabled at compile time");
+  }
+#endif
+
+  SLEQP_CALL(sleqp_trace_release(&solver->trace));
+
+  if (filename)
+  {
+    SLEQP_CALL(sleqp_trace_create(&solver->trace, filename));
+  }
+
+  SLEQP_CALL(
+    sleqp_problem_solver_set_trace(solver->problem_solver, solver->trace));
+
+  if (solver->restoration_problem_solver)
+  {
+    SLEQP_CALL(
+      sleqp_problem_solver_set_trace(solver->restoration_problem_solver,
+                                     solver->trace));
+  }
+
+  return SLEQP_OKAY;
+}
+
 static SLEQP_RETCODE
 solver_free(SleqpSolver** star)
 {
@@ -460,6 +602,8 @@ solver_free(SleqpSolver** star)
 
   SLEQP_CALL(sleqp_polishing_release(&solver->polishing));
 
+  SLEQP_CALL(sleqp_trace_release(&solver->trace));
+
   SLEQP_CALL(sleqp_timer_free(&solver->elapsed_timer));
 
   SLEQP_CALL(sleqp_iterate_release(&solver->scaled_iterate));
@@ -494,6 +638,10 @@ solver_free(SleqpSolver** star)
 
   SLEQP_CALL(sleqp_problem_release(&solver->original_problem));
 
+  SLEQP_CALL(sleqp_thread_pool_release(&solver->thread_pool));
+
+  SLEQP_CALL(sleqp_allocator_release(&solver->allocator));
+
   SLEQP_CALL(sleqp_settings_release(&solver->settings));
 
   sleqp_free(star);
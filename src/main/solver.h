@@ -6,12 +6,14 @@
 #include "callback_handler.h"
 #include "deriv_check.h"
 #include "error.h"
+#include "mem.h"
 #include "merit.h"
 #include "polish.h"
 #include "problem_scaling.h"
 #include "trial_point.h"
 
 #include "problem_solver.h"
+#include "thread_pool.h"
 
 #include "quasi_newton/quasi_newton.h"
 #include "step/step_rule.h"
@@ -51,6 +53,11 @@ struct SleqpSolver
 
   SleqpSettings* settings;
 
+  SleqpThreadPool* thread_pool;
+
+  // Retains the scratch memory of solves, or NULL
+  SleqpAllocator* allocator;
+
   SleqpProblem* original_problem;
 
   double* dense_cache;
@@ -93,6 +100,11 @@ struct SleqpSolver
 
   SleqpQuasiNewton* quasi_newton;
 
+  SleqpTrace* trace;
+
+  // Version of the original problem the solver is up to date with
+  int problem_version;
+
   double time_limit;
 
   int iterations;
@@ -109,4 +121,8 @@ sleqp_solver_toggle_phase(SleqpSolver* solver);
 SLEQP_RETCODE
 sleqp_solver_restore_original_iterate(SleqpSolver* solver);
 
+// Propagates in-place updates of the original problem
+SLEQP_RETCODE
+sleqp_solver_update_problem(SleqpSolver* solver);
+
 #endif /* SLEQP_SOLVER_H */
@@ -0,0 +1,80 @@
+#include "solver.h"
+
+#include "thread_pool.h"
+
+typedef struct
+{
+  SleqpProblem** problems;
+  SleqpVec** primals;
+  SleqpScaling* scaling_data;
+
+  int max_num_iterations;
+  double time_limit;
+
+  SleqpSolver** solvers;
+  SLEQP_RETCODE* retcodes;
+} BatchData;
+
+static SLEQP_RETCODE
+solve_problem(BatchData* batch_data, int task)
+{
+  SLEQP_CALL(sleqp_solver_create(batch_data->solvers + task,
+                                 batch_data->problems[task],
+                                 batch_data->primals[task],
+                                 batch_data->scaling_data));
+
+  SLEQP_CALL(sleqp_solver_solve(batch_data->solvers[task],
+                                batch_data->max_num_iterations,
+                                batch_data->time_limit));
+
+  return SLEQP_OKAY;
+}
+
+// Failures are recorded per problem rather than aborting the batch
+static SLEQP_RETCODE
+solve_task(int task, void* data)
+{
+  BatchData* batch_data = (BatchData*)data;
+
+  batch_data->retcodes[task] = solve_problem(batch_data, task);
+
+  return SLEQP_OKAY;
+}
+
+SLEQP_RETCODE
+sleqp_solver_solve_batch(int num_problems,
+                         SleqpProblem** problems,
+                         SleqpVec** primals,
+                         SleqpScaling* scaling_data,
+                         int num_threads,
+                         int max_num_iterations,
+                         double time_limit,
+                         SleqpSolver** solvers,
+                         SLEQP_RETCODE* retcodes)
+{
+  for (int i = 0; i < num_problems; ++i)
+  {
+    solvers[i]  = NULL;
+    retcodes[i] = SLEQP_OKAY;
+  }
+
+  BatchData batch_data = {.problems           = problems,
+                          .primals            = primals,
+                          .scaling_data       = scaling_data,
+                          .max_num_iterations = max_num_iterations,
+                          .time_limit         = time_limit,
+                          .solvers            = solvers,
+                          .retcodes           = retcodes};
+
+  SleqpThreadPool* pool;
+
+  SLEQP_CALL(sleqp_thread_pool_create(&pool, num_threads));
+
+  // Solvers run their internal kernels serially within tasks
+  SLEQP_CALL(
+    sleqp_thread_pool_run(pool, num_problems, solve_task, &batch_data));
+
+  SLEQP_CALL(sleqp_thread_pool_release(&pool));
+
+  return SLEQP_OKAY;
+}
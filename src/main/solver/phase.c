@@ -92,6 +92,10 @@ create_restoration_solver(SleqpSolver* solver)
     on_restoration_solver_accepted_iterate,
     (void*)solver));
 
+  SLEQP_CALL(
+    sleqp_problem_solver_set_trace(solver->restoration_problem_solver,
+                                   solver->trace));
+
   return SLEQP_OKAY;
 }
 
@@ -253,11 +253,11 @@ run_solving_loop(SleqpSolver* solver, int max_num_iterations, double time_limit)
   return SLEQP_OKAY;
 }
 
-SLEQP_RETCODE
-sleqp_solver_solve(SleqpSolver* solver,
-                   int max_num_iterations,
-                   double time_limit)
+static SLEQP_RETCODE
+solve(SleqpSolver* solver, int max_num_iterations, double time_limit)
 {
+  SLEQP_CALL(sleqp_solver_update_problem(solver));
+
   if (solver->status == SLEQP_STATUS_INFEASIBLE)
   {
     sleqp_log_debug("Problem is infeasible, aborting");
@@ -292,7 +292,38 @@ sleqp_solver_solve(SleqpSolver* solver,
 
   SLEQP_CALL(sleqp_timer_stop(solver->elapsed_timer));
 
+  if (solver->trace)
+  {
+    SLEQP_CALL(sleqp_trace_flush(solver->trace));
+  }
+
   SLEQP_CALL(sleqp_solver_print_stats(solver, violation));
 
   return SLEQP_OKAY;
 }
+
+SLEQP_RETCODE
+sleqp_solver_solve(SleqpSolver* solver,
+                   int max_num_iterations,
+                   double time_limit)
+{
+  // Make the pool available to internal kernels for the duration of the solve
+  SleqpThreadPool* previous_pool
+    = sleqp_thread_pool_set_active(solver->thread_pool);
+
+  // Serve the scratch memory of the solve from the pool of the solver
+  SleqpAllocator* previous_allocator = sleqp_allocator_active();
+
+  if (solver->allocator)
+  {
+    sleqp_allocator_set_active(solver->allocator);
+  }
+
+  const SLEQP_RETCODE status = solve(solver, max_num_iterations, time_limit);
+
+  sleqp_allocator_set_active(previous_allocator);
+
+  sleqp_thread_pool_set_active(previous_pool);
+
+  return status;
+}
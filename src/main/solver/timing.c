@@ -0,0 +1,102 @@
+#include "solver.h"
+
+static SLEQP_RETCODE
+add_func_stats(SleqpFunc* func, SleqpTimingStats* stats)
+{
+  SLEQP_CALL(sleqp_timer_add_stats(sleqp_func_get_set_timer(func),
+                                   stats + SLEQP_SOLVER_TIMING_FUNC_SET));
+
+  SLEQP_CALL(sleqp_timer_add_stats(sleqp_func_get_val_timer(func),
+                                   stats + SLEQP_SOLVER_TIMING_FUNC_OBJ_VAL));
+
+  SLEQP_CALL(sleqp_timer_add_stats(sleqp_func_get_grad_timer(func),
+                                   stats + SLEQP_SOLVER_TIMING_FUNC_OBJ_GRAD));
+
+  SLEQP_CALL(
+    sleqp_timer_add_stats(sleqp_func_get_cons_val_timer(func),
+                          stats + SLEQP_SOLVER_TIMING_FUNC_CONS_VAL));
+
+  SLEQP_CALL(
+    sleqp_timer_add_stats(sleqp_func_get_cons_jac_timer(func),
+                          stats + SLEQP_SOLVER_TIMING_FUNC_CONS_JAC));
+
+  SLEQP_CALL(
+    sleqp_timer_add_stats(sleqp_func_get_hess_timer(func),
+                          stats + SLEQP_SOLVER_TIMING_FUNC_HESS_PROD));
+
+  return SLEQP_OKAY;
+}
+
+// Collects the same timings as displayed by sleqp_solver_print_stats
+static SLEQP_RETCODE
+collect_timing_stats(const SleqpSolver* solver, SleqpTimingStats* stats)
+{
+  SleqpFunc* orig_func = sleqp_problem_func(solver->original_problem);
+  SleqpFunc* func      = sleqp_problem_func(solver->problem);
+
+  for (int timing = 0; timing < SLEQP_SOLVER_NUM_TIMINGS; ++timing)
+  {
+    stats[timing] = (SleqpTimingStats){0};
+  }
+
+  SleqpTimingStats* total_stats = stats + SLEQP_SOLVER_TIMING_TOTAL;
+
+  SLEQP_CALL(sleqp_timer_add_stats(solver->elapsed_timer, total_stats));
+
+  if (solver->preprocessor)
+  {
+    SleqpTimingStats* preprocessing_stats
+      = stats + SLEQP_SOLVER_TIMING_PREPROCESSING;
+
+    SLEQP_CALL(
+      sleqp_timer_add_stats(sleqp_preprocessor_get_timer(solver->preprocessor),
+                            preprocessing_stats));
+
+    total_stats->wall_time += preprocessing_stats->wall_time;
+    total_stats->cpu_time += preprocessing_stats->cpu_time;
+  }
+
+  SLEQP_CALL(add_func_stats(orig_func, stats));
+
+  if (solver->quasi_newton)
+  {
+    SLEQP_CALL(
+      sleqp_timer_add_stats(sleqp_func_get_hess_timer(func),
+                            stats + SLEQP_SOLVER_TIMING_QUASI_NEWTON_PROD));
+
+    SLEQP_CALL(sleqp_timer_add_stats(
+      sleqp_quasi_newton_update_timer(solver->quasi_newton),
+      stats + SLEQP_SOLVER_TIMING_QUASI_NEWTON_UPDATE));
+  }
+
+  SLEQP_CALL(
+    sleqp_problem_solver_add_timing_stats(solver->problem_solver, stats));
+
+  if (solver->restoration_problem_solver)
+  {
+    SLEQP_CALL(
+      sleqp_problem_solver_add_timing_stats(solver->restoration_problem_solver,
+                                            stats));
+  }
+
+  return SLEQP_OKAY;
+}
+
+SLEQP_RETCODE
+sleqp_solver_timing_stats(const SleqpSolver* solver,
+                          SLEQP_SOLVER_TIMING timing,
+                          SleqpTimingStats* stats)
+{
+  SleqpTimingStats all_stats[SLEQP_SOLVER_NUM_TIMINGS];
+
+  if (timing < 0 || timing >= SLEQP_SOLVER_NUM_TIMINGS)
+  {
+    sleqp_raise(SLEQP_ILLEGAL_ARGUMENT, "Invalid timing %d", timing);
+  }
+
+  SLEQP_CALL(collect_timing_stats(solver, all_stats));
+
+  *stats = all_stats[timing];
+
+  return SLEQP_OKAY;
+}
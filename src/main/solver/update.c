@@ -0,0 +1,123 @@
+#include "solver.h"
+
+#include "problem.h"
+
+static bool
+is_transformed(SleqpPreprocessor* preprocessor)
+{
+  return preprocessor
+         && (sleqp_preprocessor_result(preprocessor)
+             != SLEQP_PREPROCESSING_RESULT_FAILURE);
+}
+
+static SLEQP_RETCODE
+update_scaled_problem(SleqpSolver* solver)
+{
+  SleqpProblem* source = solver->original_problem;
+  SleqpProblem* target = solver->scaled_problem;
+
+  if (solver->problem_scaling)
+  {
+    SLEQP_CALL(sleqp_problem_scaling_flush(solver->problem_scaling));
+
+    source = sleqp_problem_scaling_get_problem(solver->problem_scaling);
+  }
+
+  SLEQP_CALL(sleqp_problem_set_vars_bounds(target,
+                                           sleqp_problem_vars_lb(source),
+                                           sleqp_problem_vars_ub(source)));
+
+  SLEQP_CALL(
+    sleqp_problem_set_general_bounds(target,
+                                     sleqp_problem_general_lb(source),
+                                     sleqp_problem_general_ub(source)));
+
+  SLEQP_CALL(sleqp_problem_set_linear_bounds(target,
+                                             sleqp_problem_linear_lb(source),
+                                             sleqp_problem_linear_ub(source)));
+
+  SLEQP_CALL(
+    sleqp_problem_set_linear_coeffs(target,
+                                    sleqp_problem_linear_coeffs(source)));
+
+  return SLEQP_OKAY;
+}
+
+static SLEQP_RETCODE
+update_preprocessor(SleqpSolver* solver)
+{
+  SleqpPreprocessor* preprocessor;
+
+  SLEQP_CALL(sleqp_preprocessor_create(&preprocessor,
+                                       solver->scaled_problem,
+                                       solver->settings));
+
+  if (is_transformed(preprocessor))
+  {
+    SLEQP_CALL(sleqp_preprocessor_release(&preprocessor));
+
+    sleqp_raise(SLEQP_ILLEGAL_ARGUMENT,
+                "Updated problem requires preprocessing, create a new solver");
+  }
+
+  SLEQP_CALL(sleqp_preprocessor_release(&solver->preprocessor));
+
+  solver->preprocessor = preprocessor;
+
+  return SLEQP_OKAY;
+}
+
+// The restoration problem contains the bounds as variables,
+// it is recreated once it is needed again
+static SLEQP_RETCODE
+clear_restoration(SleqpSolver* solver)
+{
+  SLEQP_CALL(sleqp_problem_solver_release(&solver->restoration_problem_solver));
+
+  SLEQP_CALL(sleqp_problem_release(&solver->restoration_problem));
+
+  SLEQP_CALL(sleqp_vec_free(&solver->restoration_primal));
+
+  return SLEQP_OKAY;
+}
+
+SLEQP_RETCODE
+sleqp_solver_update_problem(SleqpSolver* solver)
+{
+  SleqpProblem* original_problem = solver->original_problem;
+
+  const int problem_version = sleqp_problem_version(original_problem);
+
+  if (problem_version == solver->problem_version)
+  {
+    return SLEQP_OKAY;
+  }
+
+  if (is_transformed(solver->preprocessor))
+  {
+    sleqp_raise(SLEQP_ILLEGAL_ARGUMENT,
+                "Cannot update preprocessed problems, create a new solver");
+  }
+
+  // The trial point solver is specialized to unconstrained problems
+  if (sleqp_problem_is_unconstrained(original_problem)
+      != sleqp_problem_is_unconstrained(solver->problem))
+  {
+    sleqp_raise(SLEQP_ILLEGAL_ARGUMENT,
+                "Cannot add bounds to an unconstrained problem or remove all "
+                "bounds of a constrained one, create a new solver");
+  }
+
+  SLEQP_CALL(update_scaled_problem(solver));
+
+  if (solver->preprocessor)
+  {
+    SLEQP_CALL(update_preprocessor(solver));
+  }
+
+  SLEQP_CALL(clear_restoration(solver));
+
+  solver->problem_version = problem_version;
+
+  return SLEQP_OKAY;
+}
@@ -1,12 +1,46 @@
 #include "mat.h"
 
+#include <limits.h>
 #include <math.h>
+#include <pthread.h>
+#include <string.h>
 
 #include "cmp.h"
 #include "error.h"
 #include "fail.h"
 #include "log.h"
 #include "mem.h"
+#include "thread_pool.h"
+#include "vec_kernels.h"
+
+// Largest number of entries reserved for matrices with unknown patterns
+#define DENSE_RESERVE_LIMIT (1 << 20)
+
+/*
+ * Row-wise (CSR) view of the pattern of a matrix, used to compute
+ * products in parallel without write conflicts. Values are not copied,
+ * instead, `entries` contains the position of each entry in the
+ * column-wise arrays.
+ */
+typedef struct
+{
+  uint64_t version;
+
+  // Number of entries of the matrix when the mirror was built
+  int matrix_nnz;
+
+  int num_rows;
+  int num_cols;
+  int nnz;
+
+  int* row_ptr;
+  int* col_indices;
+  int* entries;
+
+  // Dense copy of the vector being multiplied
+  double* dense_vec;
+
+} RowMirror;
 
 typedef struct SleqpMat
 {
@@ -22,8 +56,34 @@ typedef struct SleqpMat
   int* cols;
   int* rows;
 
+  // Incremented whenever the pattern is reset or changed other than
+  // by appending entries
+  uint64_t version;
+
+  RowMirror* mirror;
+  pthread_mutex_t mirror_lock;
+
 } SleqpMat;
 
+static void
+invalidate_pattern(SleqpMat* matrix)
+{
+  ++matrix->version;
+}
+
+int
+sleqp_mat_nnz_estimate(int num_rows, int num_cols)
+{
+  const long long dense_nnz = ((long long)num_rows) * num_cols;
+
+  if (dense_nnz <= DENSE_RESERVE_LIMIT)
+  {
+    return dense_nnz;
+  }
+
+  return num_rows + num_cols;
+}
+
 SLEQP_RETCODE
 sleqp_mat_create(SleqpMat** mstar, int num_rows, int num_cols, int nnz_max)
 {
@@ -41,6 +101,8 @@ sleqp_mat_create(SleqpMat** mstar, int num_rows, int num_cols, int nnz_max)
   matrix->num_cols = num_cols;
   matrix->num_rows = num_rows;
 
+  pthread_mutex_init(&matrix->mirror_lock, NULL);
+
   SLEQP_CALL(sleqp_alloc_array(&matrix->data, nnz_max));
   SLEQP_CALL(sleqp_alloc_array(&matrix->cols, num_cols + 1));
   SLEQP_CALL(sleqp_alloc_array(&matrix->rows, nnz_max));
@@ -77,6 +139,8 @@ sleqp_mat_resize(SleqpMat* matrix, int num_rows, int num_cols)
   assert(num_rows >= 0);
   assert(num_cols >= 0);
 
+  invalidate_pattern(matrix);
+
   if (matrix->num_cols < num_cols)
   {
     SLEQP_CALL(sleqp_realloc(&matrix->cols, num_cols + 1));
@@ -147,6 +211,7 @@ sleqp_mat_nnz_max(const SleqpMat* matrix)
 SLEQP_RETCODE
 sleqp_mat_set_nnz(SleqpMat* matrix, int nnz)
 {
+  invalidate_pattern(matrix);
   matrix->nnz = nnz;
   return SLEQP_OKAY;
 }
@@ -175,10 +240,28 @@ sleqp_mat_rows(const SleqpMat* matrix)
   return matrix->rows;
 }
 
+// Ensures capacity for the given number of additional entries,
+// at least doubling the capacity to amortize repeated pushes
+static SLEQP_RETCODE
+grow(SleqpMat* matrix, int count)
+{
+  const int nnz = matrix->nnz + count;
+
+  if (nnz <= matrix->nnz_max)
+  {
+    return SLEQP_OKAY;
+  }
+
+  const int nnz_max
+    = (matrix->nnz_max <= INT_MAX / 2) ? 2 * matrix->nnz_max : INT_MAX;
+
+  return sleqp_mat_reserve(matrix, SLEQP_MAX(nnz, nnz_max));
+}
+
 SLEQP_RETCODE
 sleqp_mat_push(SleqpMat* matrix, int row, int col, double value)
 {
-  assert(matrix->nnz < matrix->nnz_max);
+  SLEQP_CALL(grow(matrix, 1));
   assert(row < matrix->num_rows);
   assert(col < matrix->num_cols);
 
@@ -196,7 +279,7 @@ sleqp_mat_push_vec(SleqpMat* matrix, int col, SleqpVec* vec)
   assert(matrix->cols[col] == matrix->cols[col + 1]);
   assert(vec->dim == matrix->num_rows);
 
-  assert((matrix->nnz_max - matrix->nnz) >= vec->nnz);
+  SLEQP_CALL(grow(matrix, vec->nnz));
 
   for (int i = 0; i < vec->nnz; ++i)
   {
@@ -220,6 +303,7 @@ sleqp_mat_push_col(SleqpMat* matrix, int col)
   assert(col < matrix->num_cols);
 
   matrix->cols[col + 1] = matrix->cols[col];
+  invalidate_pattern(matrix);
 
   return SLEQP_OKAY;
 }
@@ -233,6 +317,7 @@ sleqp_mat_pop_col(SleqpMat* matrix, int col)
 
   matrix->cols[col + 1] = matrix->cols[col];
   matrix->nnz -= nnz;
+  invalidate_pattern(matrix);
 
   return SLEQP_OKAY;
 }
@@ -279,6 +364,233 @@ sleqp_mat_vstack(const SleqpMat* first,
   return SLEQP_OKAY;
 }
 
+SLEQP_RETCODE
+sleqp_mat_vstack_update(const SleqpMat* first, SleqpMat* result)
+{
+  assert(first->num_cols == result->num_cols);
+  assert(first->num_rows <= result->num_rows);
+
+  bool same_pattern = true;
+
+  for (int col = 0; col < first->num_cols; ++col)
+  {
+    const int begin = first->cols[col];
+    const int count = first->cols[col + 1] - begin;
+    const int pos   = result->cols[col];
+
+    assert(count <= result->cols[col + 1] - pos);
+
+    if (same_pattern)
+    {
+      same_pattern = (memcmp(result->rows + pos,
+                             first->rows + begin,
+                             sizeof(int) * count)
+                      == 0);
+    }
+
+    memcpy(result->rows + pos, first->rows + begin, sizeof(int) * count);
+    memcpy(result->data + pos, first->data + begin, sizeof(double) * count);
+  }
+
+  if (!same_pattern)
+  {
+    invalidate_pattern(result);
+  }
+
+  return SLEQP_OKAY;
+}
+
+uint64_t
+sleqp_mat_version(const SleqpMat* matrix)
+{
+  return matrix->version;
+}
+
+static SLEQP_RETCODE
+row_mirror_reserve(RowMirror* mirror, int num_rows, int num_cols, int nnz)
+{
+  if (num_rows > mirror->num_rows)
+  {
+    SLEQP_CALL(sleqp_realloc(&mirror->row_ptr, num_rows + 1));
+    mirror->num_rows = num_rows;
+  }
+
+  if (num_cols > mirror->num_cols)
+  {
+    SLEQP_CALL(sleqp_realloc(&mirror->dense_vec, num_cols));
+    mirror->num_cols = num_cols;
+  }
+
+  if (nnz > mirror->nnz)
+  {
+    SLEQP_CALL(sleqp_realloc(&mirror->col_indices, nnz));
+    SLEQP_CALL(sleqp_realloc(&mirror->entries, nnz));
+    mirror->nnz = nnz;
+  }
+
+  return SLEQP_OKAY;
+}
+
+static SLEQP_RETCODE
+row_mirror_update(const SleqpMat* matrix)
+{
+  RowMirror* mirror = matrix->mirror;
+
+  if (!mirror)
+  {
+    SLEQP_CALL(sleqp_malloc(&mirror));
+    *mirror = (RowMirror){0};
+
+    ((SleqpMat*)matrix)->mirror = mirror;
+  }
+  else if (mirror->version == matrix->version
+           && mirror->matrix_nnz == matrix->nnz)
+  {
+    return SLEQP_OKAY;
+  }
+
+  const int num_rows = matrix->num_rows;
+  const int num_cols = matrix->num_cols;
+
+  SLEQP_CALL(row_mirror_reserve(mirror, num_rows, num_cols, matrix->nnz));
+
+  int* row_ptr = mirror->row_ptr;
+
+  for (int row = 0; row <= num_rows; ++row)
+  {
+    row_ptr[row] = 0;
+  }
+
+  for (int k = 0; k < matrix->nnz; ++k)
+  {
+    ++row_ptr[matrix->rows[k] + 1];
+  }
+
+  for (int row = 0; row < num_rows; ++row)
+  {
+    row_ptr[row + 1] += row_ptr[row];
+  }
+
+  // Use row_ptr[row] as the insertion point of the next entry
+  // of the row, shifting it back afterwards
+  for (int col = 0; col < num_cols; ++col)
+  {
+    for (int k = matrix->cols[col]; k < matrix->cols[col + 1]; ++k)
+    {
+      const int pos = row_ptr[matrix->rows[k]]++;
+
+      mirror->col_indices[pos] = col;
+      mirror->entries[pos]     = k;
+    }
+  }
+
+  for (int row = num_rows; row > 0; --row)
+  {
+    row_ptr[row] = row_ptr[row - 1];
+  }
+
+  row_ptr[0] = 0;
+
+  mirror->version    = matrix->version;
+  mirror->matrix_nnz = matrix->nnz;
+
+  return SLEQP_OKAY;
+}
+
+static void
+row_mirror_free(RowMirror** star)
+{
+  RowMirror* mirror = *star;
+
+  if (!mirror)
+  {
+    return;
+  }
+
+  sleqp_free(&mirror->dense_vec);
+  sleqp_free(&mirror->entries);
+  sleqp_free(&mirror->col_indices);
+  sleqp_free(&mirror->row_ptr);
+
+  sleqp_free(star);
+}
+
+typedef struct
+{
+  const SleqpMat* matrix;
+  const double* dense_vec;
+  double* result;
+  int num_blocks;
+} RowProduct;
+
+static SLEQP_RETCODE
+row_product_task(int block, void* data)
+{
+  RowProduct* product     = (RowProduct*)data;
+  const SleqpMat* matrix  = product->matrix;
+  const RowMirror* mirror = matrix->mirror;
+
+  const int* row_ptr     = mirror->row_ptr;
+  const int* col_indices = mirror->col_indices;
+  const int* entries     = mirror->entries;
+
+  const double* values    = matrix->data;
+  const double* dense_vec = product->dense_vec;
+
+  int begin, end;
+
+  sleqp_thread_pool_partition(row_ptr,
+                              matrix->num_rows,
+                              block,
+                              product->num_blocks,
+                              &begin,
+                              &end);
+
+  for (int row = begin; row < end; ++row)
+  {
+    double sum = 0.;
+
+    for (int k = row_ptr[row]; k < row_ptr[row + 1]; ++k)
+    {
+      sum += values[entries[k]] * dense_vec[col_indices[k]];
+    }
+
+    product->result[row] = sum;
+  }
+
+  return SLEQP_OKAY;
+}
+
+static SLEQP_RETCODE
+mult_vec_parallel(const SleqpMat* matrix,
+                  const SleqpVec* vector,
+                  double* result)
+{
+  SLEQP_CALL(row_mirror_update(matrix));
+
+  RowMirror* mirror = matrix->mirror;
+
+  const double* dense_vec = vector->data;
+
+  if (!sleqp_vec_is_dense(vector))
+  {
+    SLEQP_CALL(sleqp_vec_to_raw(vector, mirror->dense_vec));
+    dense_vec = mirror->dense_vec;
+  }
+
+  RowProduct product = {.matrix     = matrix,
+                        .dense_vec  = dense_vec,
+                        .result     = result,
+                        .num_blocks = sleqp_thread_pool_active_tasks()};
+
+  SLEQP_CALL(sleqp_thread_pool_run(sleqp_thread_pool_active(),
+                                   product.num_blocks,
+                                   row_product_task,
+                                   (void*)&product));
+
+  return SLEQP_OKAY;
+}
+
 SLEQP_RETCODE
 sleqp_mat_mult_vec(const SleqpMat* matrix,
                    const SleqpVec* vector,
@@ -286,6 +598,28 @@ sleqp_mat_mult_vec(const SleqpMat* matrix,
 {
   assert(matrix->num_cols == vector->dim);
 
+  // Number of entries touched by the column-wise product
+  int work = 0;
+
+  for (int k = 0; k < vector->nnz; ++k)
+  {
+    const int col = vector->indices[k];
+    work += matrix->cols[col + 1] - matrix->cols[col];
+  }
+
+  // The row-wise product touches every entry, split among the threads
+  if (sleqp_thread_pool_parallelize(work)
+      && (matrix->nnz / sleqp_thread_pool_active_threads()) < work)
+  {
+    pthread_mutex_lock(&((SleqpMat*)matrix)->mirror_lock);
+
+    const SLEQP_RETCODE status = mult_vec_parallel(matrix, vector, result);
+
+    pthread_mutex_unlock(&((SleqpMat*)matrix)->mirror_lock);
+
+    return status;
+  }
+
   for (int index = 0; index < matrix->num_rows; ++index)
   {
     result[index] = 0.;
@@ -309,55 +643,110 @@ sleqp_mat_mult_vec(const SleqpMat* matrix,
   return SLEQP_OKAY;
 }
 
+typedef struct
+{
+  const SleqpMat* matrix;
+  const SleqpVec* vector;
+  double* result;
+  int num_blocks;
+} ColProduct;
+
+static void
+col_product(const SleqpMat* matrix,
+            const SleqpVec* vector,
+            int begin,
+            int end,
+            double* result)
+{
+  const int* cols      = matrix->cols;
+  const int* rows      = matrix->rows;
+  const double* values = matrix->data;
+
+  if (sleqp_vec_is_dense(vector))
+  {
+    for (int col = begin; col < end; ++col)
+    {
+      result[col] = sleqp_kernel_gather_dot(values + cols[col],
+                                            rows + cols[col],
+                                            cols[col + 1] - cols[col],
+                                            vector->data);
+    }
+  }
+  else
+  {
+    for (int col = begin; col < end; ++col)
+    {
+      result[col] = sleqp_kernel_sparse_dot(values + cols[col],
+                                            rows + cols[col],
+                                            cols[col + 1] - cols[col],
+                                            vector->data,
+                                            vector->indices,
+                                            vector->nnz);
+    }
+  }
+}
+
+static SLEQP_RETCODE
+col_product_task(int block, void* data)
+{
+  ColProduct* product    = (ColProduct*)data;
+  const SleqpMat* matrix = product->matrix;
+
+  int begin, end;
+
+  sleqp_thread_pool_partition(matrix->cols,
+                              matrix->num_cols,
+                              block,
+                              product->num_blocks,
+                              &begin,
+                              &end);
+
+  col_product(matrix, product->vector, begin, end, product->result);
+
+  return SLEQP_OKAY;
+}
+
 SLEQP_RETCODE
-sleqp_mat_mult_vec_trans(const SleqpMat* matrix,
-                         const SleqpVec* vector,
-                         double eps,
-                         SleqpVec* result)
+sleqp_mat_mult_vec_trans_dense(const SleqpMat* matrix,
+                               const SleqpVec* vector,
+                               double* result)
 {
   assert(matrix->num_rows == vector->dim);
-  assert(matrix->num_cols == result->dim);
-
-  int col_size = 0;
 
-  for (int col = 0; col < matrix->num_cols; ++col)
+  if (!sleqp_thread_pool_parallelize(matrix->nnz))
   {
-    col_size += (matrix->cols[col + 1] - matrix->cols[col]) > 0;
+    col_product(matrix, vector, 0, matrix->num_cols, result);
+    return SLEQP_OKAY;
   }
 
-  SLEQP_CALL(sleqp_vec_clear(result));
-  SLEQP_CALL(sleqp_vec_reserve(result, col_size));
+  ColProduct product = {.matrix     = matrix,
+                        .vector     = vector,
+                        .result     = result,
+                        .num_blocks = sleqp_thread_pool_active_tasks()};
 
-  for (int col = 0; col < matrix->num_cols; ++col)
-  {
-    int k_vec = 0, k_mat = matrix->cols[col];
+  SLEQP_CALL(sleqp_thread_pool_run(sleqp_thread_pool_active(),
+                                   product.num_blocks,
+                                   col_product_task,
+                                   (void*)&product));
 
-    double sum = 0.;
+  return SLEQP_OKAY;
+}
 
-    while (k_vec < vector->nnz && k_mat < matrix->cols[col + 1])
-    {
-      int vec_idx = vector->indices[k_vec];
-      int row_idx = matrix->rows[k_mat];
+SLEQP_RETCODE
+sleqp_mat_mult_vec_trans(const SleqpMat* matrix,
+                         const SleqpVec* vector,
+                         double eps,
+                         SleqpVec* result)
+{
+  assert(matrix->num_cols == result->dim);
+  assert(vector != result);
 
-      if (vec_idx < row_idx)
-      {
-        ++k_vec;
-      }
-      else if (vec_idx > row_idx)
-      {
-        ++k_mat;
-      }
-      else
-      {
-        sum += vector->data[k_vec++] * matrix->data[k_mat++];
-      }
-    }
+  // Column sums are stored densely, then compacted
+  SLEQP_CALL(sleqp_vec_reserve(result, matrix->num_cols));
 
-    if (!sleqp_is_zero(sum, eps))
-    {
-      SLEQP_CALL(sleqp_vec_push(result, col, sum));
-    }
-  }
+  SLEQP_CALL(sleqp_mat_mult_vec_trans_dense(matrix, vector, result->data));
+
+  sleqp_vec_finalize_dense(result, eps);
 
   return SLEQP_OKAY;
 }
@@ -487,6 +876,30 @@ sleqp_mat_eq(const SleqpMat* first, const SleqpMat* second, double eps)
   return true;
 }
 
+bool
+sleqp_mat_pattern_eq(const SleqpMat* first,
+                     const SleqpMat* second,
+                     int num_cols)
+{
+  assert(num_cols <= first->num_cols);
+  assert(num_cols <= second->num_cols);
+
+  if (first->num_rows != second->num_rows)
+  {
+    return false;
+  }
+
+  const int nnz = first->cols[num_cols];
+
+  if (nnz != second->cols[num_cols])
+  {
+    return false;
+  }
+
+  return (memcmp(first->cols, second->cols, sizeof(int) * num_cols) == 0)
+         && (memcmp(first->rows, second->rows, sizeof(int) * nnz) == 0);
+}
+
 SLEQP_RETCODE
 sleqp_mat_remove_rows(const SleqpMat* source,
                       SleqpMat* target,
@@ -651,6 +1064,8 @@ sleqp_mat_remove_cols(const SleqpMat* source,
 SLEQP_RETCODE
 sleqp_mat_clear(SleqpMat* matrix)
 {
+  invalidate_pattern(matrix);
+
   matrix->nnz = 0;
 
   for (int col = 0; col <= matrix->num_cols; ++col)
@@ -940,6 +1355,9 @@ sparse_matrix_free(SleqpMat** mstar)
     return SLEQP_OKAY;
   }
 
+  row_mirror_free(&matrix->mirror);
+  pthread_mutex_destroy(&matrix->mirror_lock);
+
   sleqp_free(&matrix->rows);
   sleqp_free(&matrix->cols);
   sleqp_free(&matrix->data);
@@ -1,6 +1,8 @@
 #ifndef SLEQP_MAT_H
 #define SLEQP_MAT_H
 
+#include <stdint.h>
+
 #include "pub_mat.h"
 
 #include "vec.h"
@@ -11,6 +13,35 @@ sleqp_mat_vstack(const SleqpMat* first,
                  const SleqpMat* second,
                  SleqpMat* result);
 
+/**
+ * Overwrites the upper block of a matrix previously computed by
+ * @ref sleqp_mat_vstack, leaving the entries of the lower block
+ * untouched. The number of entries in each column of the given
+ * block must equal that of the stacked upper block.
+ *
+ * @param[in]     first      The new upper block
+ * @param[in,out] result     The stacked matrix
+ **/
+SLEQP_NODISCARD
+SLEQP_RETCODE
+sleqp_mat_vstack_update(const SleqpMat* first, SleqpMat* result);
+
+/**
+ * Returns an initial number of nonzeros to reserve for a matrix
+ * of the given dimensions whose pattern is unknown. Small matrices
+ * are reserved densely, larger ones grow on demand when pushed to.
+ **/
+int
+sleqp_mat_nnz_estimate(int num_rows, int num_cols);
+
+/**
+ * Returns a counter which changes whenever the sparsity pattern
+ * of the given matrix is reset or modified other than by appending
+ * entries, which only change the number of nonzeros
+ **/
+uint64_t
+sleqp_mat_version(const SleqpMat* matrix);
+
 /**
  * Computes the product of the given matrix with the given vector
  * @param[in]  matrix     The matrix
@@ -42,6 +73,22 @@ sleqp_mat_mult_vec_trans(const SleqpMat* matrix,
                          double eps,
                          SleqpVec* result);
 
+/**
+ * Computes the product of the transposed matrix with the given vector,
+ * storing the result densely
+ *
+ * @param[in]  matrix     The matrix
+ * @param[in]  vector     The input vector (dimension equal to the number of
+ *rows of the matrix)
+ * @param[out] result     The result array (size equal to the number of
+ *columns of the matrix)
+ **/
+SLEQP_NODISCARD
+SLEQP_RETCODE
+sleqp_mat_mult_vec_trans_dense(const SleqpMat* matrix,
+                               const SleqpVec* vector,
+                               double* result);
+
 /**
  * Returns a pointer to the entry to the given element of the matrix
  *
@@ -86,6 +133,19 @@ sleqp_mat_is_lower(const SleqpMat* matrix);
 bool
 sleqp_mat_eq(const SleqpMat* first, const SleqpMat* second, double eps);
 
+/**
+ * Returns whether the leading columns of the given matrices have
+ * the same sparsity pattern, disregarding their values
+ *
+ * @param[in] first      The first matrix
+ * @param[in] second     The second matrix
+ * @param[in] num_cols   The number of leading columns to compare
+ **/
+bool
+sleqp_mat_pattern_eq(const SleqpMat* first,
+                     const SleqpMat* second,
+                     int num_cols);
+
 SLEQP_RETCODE
 sleqp_mat_remove_rows(const SleqpMat* source,
                       SleqpMat* target,
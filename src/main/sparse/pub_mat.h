@@ -84,7 +84,9 @@ SLEQP_EXPORT int
 sleqp_mat_nnz_max(const SleqpMat* matrix);
 
 /**
- * Sets the number of nonzeros of the given matrix
+ * Sets the number of nonzeros of the given matrix. Must be called
+ * after modifying the pattern through the arrays returned by
+ * @ref sleqp_mat_cols and @ref sleqp_mat_rows.
  **/
 SLEQP_EXPORT SLEQP_NODISCARD SLEQP_RETCODE
 sleqp_mat_set_nnz(SleqpMat* matrix, int nnz);
@@ -114,7 +116,8 @@ SLEQP_EXPORT int*
 sleqp_mat_rows(const SleqpMat* matrix);
 
 /**
- * Pushes a new entry to the matrix. Fails if the matrix is at capacity
+ * Pushes a new entry to the matrix. If the matrix is at capacity,
+ * its capacity is increased geometrically
  **/
 SLEQP_EXPORT SLEQP_NODISCARD SLEQP_RETCODE
 sleqp_mat_push(SleqpMat* matrix, int row, int col, double value);
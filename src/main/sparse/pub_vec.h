@@ -12,6 +12,13 @@
 /**
  * A sparse vector data structure. Indices
  * are stored in an ascending fashion.
+ *
+ * A vector with as many entries as its dimension is
+ * stored densely, i.e., its i-th entry is stored at
+ * position i (possibly with a value of zero). Operations
+ * choose dense kernels for dense operands and automatically
+ * produce dense results once a sufficient share of their
+ * entries is nonzero.
  **/
 typedef struct SleqpVec
 {
@@ -270,6 +277,33 @@ sleqp_vec_at(const SleqpVec* vec, int index);
 SLEQP_EXPORT double
 sleqp_vec_value_at(const SleqpVec* vec, int index);
 
+/**
+ * Returns whether the given vector is stored densely
+ *
+ * @param[in] vec   A pointer to the vector
+ **/
+SLEQP_EXPORT bool
+sleqp_vec_is_dense(const SleqpVec* vec);
+
+/**
+ * Converts the given vector into a dense representation,
+ * storing zeros explicitly
+ *
+ * @param[in,out] vec   A pointer to the vector
+ **/
+SLEQP_EXPORT SLEQP_NODISCARD SLEQP_RETCODE
+sleqp_vec_densify(SleqpVec* vec);
+
+/**
+ * Converts the given vector into a sparse representation,
+ * removing all entries whose absolute value is at most `eps`
+ *
+ * @param[in,out] vec   A pointer to the vector
+ * @param[in]     eps   The numerical tolerance
+ **/
+SLEQP_EXPORT SLEQP_NODISCARD SLEQP_RETCODE
+sleqp_vec_sparsify(SleqpVec* vec, double eps);
+
 /**
  * Returns whether this vector is boxed, i.e., \f$ lb \leq x \leq ub \f$
  * for all components.
@@ -8,6 +8,65 @@
 #include "fail.h"
 #include "log.h"
 #include "mem.h"
+#include "vec_kernels.h"
+
+// Results with at least this share of nonzeros are stored densely
+#define DENSE_THRESHOLD .5
+
+// Vectors of smaller dimension are always stored sparsely
+#define DENSE_MIN_DIM 32
+
+// A valid vector with `dim` nonzeros stores its entries
+// at the positions corresponding to their indices
+static bool
+vec_is_full(const SleqpVec* vec)
+{
+  return vec->nnz == vec->dim;
+}
+
+static bool
+should_be_dense(int nnz, int dim)
+{
+  return (dim >= DENSE_MIN_DIM) && (nnz >= DENSE_THRESHOLD * dim);
+}
+
+static void
+set_dense_indices(SleqpVec* vec)
+{
+  for (int i = 0; i < vec->dim; ++i)
+  {
+    vec->indices[i] = i;
+  }
+
+  vec->nnz = vec->dim;
+}
+
+// Turns the first `dim` values of the vector into either a dense or a
+// sparse representation, depending on the number of nonzeros.
+// Values below `eps` are discarded
+static void
+finalize_values(SleqpVec* vec, double eps, bool dense_indices)
+{
+  const int dim = vec->dim;
+
+  const int nnz = sleqp_kernel_flush_zeros(vec->data, dim, eps);
+
+  if (should_be_dense(nnz, dim))
+  {
+    if (dense_indices)
+    {
+      vec->nnz = dim;
+    }
+    else
+    {
+      set_dense_indices(vec);
+    }
+  }
+  else
+  {
+    vec->nnz = sleqp_kernel_compact(vec->data, vec->indices, dim, 0.);
+  }
+}
 
 SLEQP_RETCODE
 sleqp_vec_create(SleqpVec** vstar, int dim, int nnz_max)
@@ -84,6 +143,17 @@ sleqp_vec_set_from_raw(SleqpVec* vec, double* values, int dim, double zero_eps)
   SLEQP_CALL(sleqp_vec_clear(vec));
   SLEQP_CALL(sleqp_vec_resize(vec, dim));
 
+  if (should_be_dense(nnz, dim))
+  {
+    SLEQP_CALL(sleqp_vec_reserve(vec, dim));
+
+    sleqp_kernel_scale(values, 1., vec->data, dim);
+
+    finalize_values(vec, zero_eps, false);
+
+    return SLEQP_OKAY;
+  }
+
   SLEQP_CALL(sleqp_vec_reserve(vec, nnz));
 
   for (int i = 0; i < dim; ++i)
@@ -122,6 +192,20 @@ sleqp_vec_copy(const SleqpVec* source, SleqpVec* target)
 
   SLEQP_CALL(sleqp_vec_reserve(target, source->nnz));
 
+  if (vec_is_full(source))
+  {
+    const bool target_full = vec_is_full(target);
+
+    sleqp_kernel_scale(source->data, 1., target->data, source->dim);
+
+    if (!target_full)
+    {
+      set_dense_indices(target);
+    }
+
+    return SLEQP_OKAY;
+  }
+
   target->nnz = 0;
 
   for (int k = 0; k < source->nnz; ++k)
@@ -249,29 +333,35 @@ sleqp_vec_dot(const SleqpVec* first, const SleqpVec* second, double* product)
 {
   assert(first->dim == second->dim);
 
-  *product = 0.;
+  const bool first_full  = vec_is_full(first);
+  const bool second_full = vec_is_full(second);
 
-  int k_first = 0, k_second = 0;
-
-  while (k_first < first->nnz && k_second < second->nnz)
+  if (first_full && second_full)
   {
-    int i_first  = first->indices[k_first];
-    int i_second = second->indices[k_second];
-
-    if (i_first == i_second)
-    {
-      *product += first->data[k_first] * second->data[k_second];
-      ++k_first;
-      ++k_second;
-    }
-    else if (i_first < i_second)
-    {
-      ++k_first;
-    }
-    else
-    {
-      ++k_second;
-    }
+    *product = sleqp_kernel_dot(first->data, second->data, first->dim);
+  }
+  else if (first_full)
+  {
+    *product = sleqp_kernel_gather_dot(second->data,
+                                       second->indices,
+                                       second->nnz,
+                                       first->data);
+  }
+  else if (second_full)
+  {
+    *product = sleqp_kernel_gather_dot(first->data,
+                                       first->indices,
+                                       first->nnz,
+                                       second->data);
+  }
+  else
+  {
+    *product = sleqp_kernel_sparse_dot(first->data,
+                                       first->indices,
+                                       first->nnz,
+                                       second->data,
+                                       second->indices,
+                                       second->nnz);
   }
 
   return SLEQP_OKAY;
@@ -291,10 +381,7 @@ sleqp_vec_scale(SleqpVec* vector, const double factor)
     return SLEQP_OKAY;
   }
 
-  for (int k = 0; k < vector->nnz; ++k)
-  {
-    vector->data[k] *= factor;
-  }
+  sleqp_kernel_scale(vector->data, factor, vector->data, vector->nnz);
 
   return SLEQP_OKAY;
 }
@@ -310,46 +397,19 @@ sleqp_vec_norm(const SleqpVec* vec)
 double
 sleqp_vec_one_norm(const SleqpVec* vec)
 {
-  double one_norm = 0.;
-
-  for (int k = 0; k < vec->nnz; ++k)
-  {
-    double value = SLEQP_ABS(vec->data[k]);
-
-    one_norm += value;
-  }
-
-  return one_norm;
+  return sleqp_kernel_one_norm(vec->data, vec->nnz);
 }
 
 double
 sleqp_vec_norm_sq(const SleqpVec* vec)
 {
-  double normsq = 0.;
-
-  for (int k = 0; k < vec->nnz; ++k)
-  {
-    double value = vec->data[k];
-
-    normsq += value * value;
-  }
-
-  return normsq;
+  return sleqp_kernel_norm_sq(vec->data, vec->nnz);
 }
 
 double
 sleqp_vec_inf_norm(const SleqpVec* vec)
 {
-  double norminf = 0.;
-
-  for (int k = 0; k < vec->nnz; ++k)
-  {
-    double value = SLEQP_ABS(vec->data[k]);
-
-    norminf = SLEQP_MAX(value, norminf);
-  }
-
-  return norminf;
+  return sleqp_kernel_inf_norm(vec->data, vec->nnz);
 }
 
 SLEQP_RETCODE
@@ -363,6 +423,72 @@ sleqp_vec_add(const SleqpVec* first,
   return SLEQP_OKAY;
 }
 
+// Computes the weighted sum of two vectors using dense kernels
+static SLEQP_RETCODE
+add_scaled_dense(const SleqpVec* first,
+                 const SleqpVec* second,
+                 const double first_factor,
+                 const double second_factor,
+                 const double eps,
+                 SleqpVec* result)
+{
+  const int dim = first->dim;
+
+  const bool dense_indices = vec_is_full(result);
+
+  SLEQP_CALL(sleqp_vec_reserve(result, dim));
+
+  double* values = result->data;
+
+  const bool first_full  = vec_is_full(first);
+  const bool second_full = vec_is_full(second);
+
+  if (first_full && second_full)
+  {
+    sleqp_kernel_axpby(first->data,
+                       second->data,
+                       first_factor,
+                       second_factor,
+                       values,
+                       dim);
+  }
+  else if (first_full || second_full)
+  {
+    const SleqpVec* full   = first_full ? first : second;
+    const SleqpVec* sparse = first_full ? second : first;
+
+    const double full_factor   = first_full ? first_factor : second_factor;
+    const double sparse_factor = first_full ? second_factor : first_factor;
+
+    sleqp_kernel_scale(full->data, full_factor, values, dim);
+
+    for (int k = 0; k < sparse->nnz; ++k)
+    {
+      values[sparse->indices[k]] += sparse_factor * sparse->data[k];
+    }
+  }
+  else
+  {
+    sleqp_kernel_fill(values, 0., dim);
+
+    for (int k = 0; k < first->nnz; ++k)
+    {
+      values[first->indices[k]] += first_factor * first->data[k];
+    }
+
+    for (int k = 0; k < second->nnz; ++k)
+    {
+      values[second->indices[k]] += second_factor * second->data[k];
+    }
+  }
+
+  result->nnz = 0;
+
+  finalize_values(result, eps, dense_indices);
+
+  return SLEQP_OKAY;
+}
+
 SLEQP_RETCODE
 sleqp_vec_add_scaled(const SleqpVec* first,
                      const SleqpVec* second,
@@ -379,10 +505,26 @@ sleqp_vec_add_scaled(const SleqpVec* first,
   assert(first != result);
   assert(second != result);
 
-  SLEQP_CALL(sleqp_vec_clear(result));
-
   SLEQP_CALL(sleqp_vec_resize(result, first->dim));
 
+  const int max_nnz = SLEQP_MAX(first->nnz, second->nnz);
+
+  // The sum has at least as many nonzeros as the denser
+  // operand, unless entries cancel out
+  if (should_be_dense(max_nnz, first->dim))
+  {
+    SLEQP_CALL(add_scaled_dense(first,
+                                second,
+                                first_factor,
+                                second_factor,
+                                eps,
+                                result));
+
+    return SLEQP_OKAY;
+  }
+
+  SLEQP_CALL(sleqp_vec_clear(result));
+
   SLEQP_CALL(sleqp_vec_reserve(result, first->nnz + second->nnz));
 
   int k_first = 0, k_second = 0;
@@ -458,14 +600,32 @@ sleqp_vec_at(const SleqpVec* vec, int index)
 {
   assert(index < vec->dim);
 
-  for (int i = 0; i < vec->nnz; ++i)
+  if (vec_is_full(vec))
   {
-    if (vec->indices[i] == index)
+    return vec->data + index;
+  }
+
+  int lo = 0, hi = vec->nnz;
+
+  while (lo < hi)
+  {
+    const int mid = lo + (hi - lo) / 2;
+
+    if (vec->indices[mid] < index)
     {
-      return vec->data + i;
+      lo = mid + 1;
+    }
+    else
+    {
+      hi = mid;
     }
   }
 
+  if (lo < vec->nnz && vec->indices[lo] == index)
+  {
+    return vec->data + lo;
+  }
+
   return NULL;
 }
 
@@ -477,6 +637,78 @@ sleqp_vec_value_at(const SleqpVec* vec, int index)
   return ptr ? (*ptr) : 0.;
 }
 
+void
+sleqp_vec_finalize_dense(SleqpVec* vec, double eps)
+{
+  assert(vec->nnz_max >= vec->dim);
+
+  finalize_values(vec, eps, vec_is_full(vec));
+}
+
+bool
+sleqp_vec_is_dense(const SleqpVec* vec)
+{
+  return vec_is_full(vec);
+}
+
+SLEQP_RETCODE
+sleqp_vec_densify(SleqpVec* vec)
+{
+  if (vec_is_full(vec))
+  {
+    return SLEQP_OKAY;
+  }
+
+  const int dim = vec->dim;
+
+  SLEQP_CALL(sleqp_vec_reserve(vec, dim));
+
+  double* values = vec->data;
+
+  // Move entries backwards to their final positions. Since
+  // indices[k] >= k, no entry is overwritten before being moved
+  int next = dim;
+
+  for (int k = vec->nnz - 1; k >= 0; --k)
+  {
+    const int i = vec->indices[k];
+
+    values[i] = values[k];
+
+    sleqp_kernel_fill(values + i + 1, 0., next - i - 1);
+
+    next = i;
+  }
+
+  sleqp_kernel_fill(values, 0., next);
+
+  set_dense_indices(vec);
+
+  return SLEQP_OKAY;
+}
+
+SLEQP_RETCODE
+sleqp_vec_sparsify(SleqpVec* vec, double eps)
+{
+  int nnz = 0;
+
+  for (int k = 0; k < vec->nnz; ++k)
+  {
+    const double value = vec->data[k];
+
+    if (!sleqp_is_zero(value, eps))
+    {
+      vec->data[nnz]    = value;
+      vec->indices[nnz] = vec->indices[k];
+      ++nnz;
+    }
+  }
+
+  vec->nnz = nnz;
+
+  return SLEQP_OKAY;
+}
+
 bool
 sleqp_vec_is_boxed(const SleqpVec* x, const SleqpVec* lb, const SleqpVec* ub)
 {
@@ -23,4 +23,16 @@ sleqp_vec_remove_entries(const SleqpVec* source,
                          const int* entry_indices,
                          int num_entries);
 
+/**
+ * Turns the first `dim` values stored in the data array of the given
+ * vector into a valid vector, discarding values whose absolute value
+ * is at most `eps`. The vector must have reserved at least
+ * `dim` entries.
+ *
+ * @param[in,out] vec     A pointer to the vector
+ * @param[in]     eps     The numerical tolerance
+ **/
+void
+sleqp_vec_finalize_dense(SleqpVec* vec, double eps);
+
 #endif /* SLEQP_VEC_H */
@@ -0,0 +1,431 @@
+#include "vec_kernels.h"
+
+#include <assert.h>
+
+#include "cmp.h"
+#include "defs.h"
+
+#if defined(SLEQP_HAVE_ATTRIBUTE_TARGET_CLONES)
+#define SLEQP_KERNEL __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define SLEQP_KERNEL
+#endif
+
+// Number of independent accumulators used by reductions. Splitting
+// the reduction allows the compiler to map the loop body onto
+// vector registers without reassociating floating point operations
+#define KERNEL_WIDTH 8
+
+// Switch from merging to galloping if one of the operands
+// has more than this many times the nonzeros of the other one
+#define GALLOP_RATIO 16
+
+static double
+reduce_sum(const double* partial)
+{
+  double sum = 0.;
+
+  for (int j = 0; j < KERNEL_WIDTH; ++j)
+  {
+    sum += partial[j];
+  }
+
+  return sum;
+}
+
+SLEQP_KERNEL
+double
+sleqp_kernel_dot(const double* first, const double* second, int dim)
+{
+  double partial[KERNEL_WIDTH] = {0.};
+
+  int i = 0;
+
+  for (; i + KERNEL_WIDTH <= dim; i += KERNEL_WIDTH)
+  {
+    for (int j = 0; j < KERNEL_WIDTH; ++j)
+    {
+      partial[j] += first[i + j] * second[i + j];
+    }
+  }
+
+  for (int j = 0; i < dim; ++i, ++j)
+  {
+    partial[j] += first[i] * second[i];
+  }
+
+  return reduce_sum(partial);
+}
+
+SLEQP_KERNEL
+double
+sleqp_kernel_gather_dot(const double* values,
+                        const int* indices,
+                        int nnz,
+                        const double* dense)
+{
+  double partial[KERNEL_WIDTH] = {0.};
+
+  int k = 0;
+
+  for (; k + KERNEL_WIDTH <= nnz; k += KERNEL_WIDTH)
+  {
+    for (int j = 0; j < KERNEL_WIDTH; ++j)
+    {
+      partial[j] += values[k + j] * dense[indices[k + j]];
+    }
+  }
+
+  for (int j = 0; k < nnz; ++k, ++j)
+  {
+    partial[j] += values[k] * dense[indices[k]];
+  }
+
+  return reduce_sum(partial);
+}
+
+// Returns the smallest position k >= start with indices[k] >= index,
+// or nnz if there is none
+static int
+gallop(const int* indices, int start, int nnz, int index)
+{
+  int step = 1;
+  int lo   = start;
+  int hi   = start;
+
+  while (hi < nnz && indices[hi] < index)
+  {
+    lo = hi + 1;
+    hi += step;
+    step *= 2;
+  }
+
+  hi = SLEQP_MIN(hi, nnz);
+
+  while (lo < hi)
+  {
+    const int mid = lo + (hi - lo) / 2;
+
+    if (indices[mid] < index)
+    {
+      lo = mid + 1;
+    }
+    else
+    {
+      hi = mid;
+    }
+  }
+
+  return lo;
+}
+
+static double
+gallop_dot(const double* small_values,
+           const int* small_indices,
+           int small_nnz,
+           const double* large_values,
+           const int* large_indices,
+           int large_nnz)
+{
+  double product = 0.;
+
+  int k_large = 0;
+
+  for (int k_small = 0; k_small < small_nnz; ++k_small)
+  {
+    const int index = small_indices[k_small];
+
+    k_large = gallop(large_indices, k_large, large_nnz, index);
+
+    if (k_large == large_nnz)
+    {
+      break;
+    }
+
+    if (large_indices[k_large] == index)
+    {
+      product += small_values[k_small] * large_values[k_large];
+      ++k_large;
+    }
+  }
+
+  return product;
+}
+
+static double
+merge_dot(const double* first_values,
+          const int* first_indices,
+          int first_nnz,
+          const double* second_values,
+          const int* second_indices,
+          int second_nnz)
+{
+  double product = 0.;
+
+  int k_first = 0, k_second = 0;
+
+  // Advance without branching on the (unpredictable) order of indices
+  while (k_first < first_nnz && k_second < second_nnz)
+  {
+    const int i_first  = first_indices[k_first];
+    const int i_second = second_indices[k_second];
+
+    const double value = first_values[k_first] * second_values[k_second];
+
+    product += (i_first == i_second) ? value : 0.;
+
+    k_first += (i_first <= i_second);
+    k_second += (i_second <= i_first);
+  }
+
+  return product;
+}
+
+double
+sleqp_kernel_sparse_dot(const double* first_values,
+                        const int* first_indices,
+                        int first_nnz,
+                        const double* second_values,
+                        const int* second_indices,
+                        int second_nnz)
+{
+  if (first_nnz == 0 || second_nnz == 0)
+  {
+    return 0.;
+  }
+
+  if (first_nnz < second_nnz / GALLOP_RATIO)
+  {
+    return gallop_dot(first_values,
+                      first_indices,
+                      first_nnz,
+                      second_values,
+                      second_indices,
+                      second_nnz);
+  }
+
+  if (second_nnz < first_nnz / GALLOP_RATIO)
+  {
+    return gallop_dot(second_values,
+                      second_indices,
+                      second_nnz,
+                      first_values,
+                      first_indices,
+                      first_nnz);
+  }
+
+  return merge_dot(first_values,
+                   first_indices,
+                   first_nnz,
+                   second_values,
+                   second_indices,
+                   second_nnz);
+}
+
+SLEQP_KERNEL
+double
+sleqp_kernel_norm_sq(const double* values, int dim)
+{
+  double partial[KERNEL_WIDTH] = {0.};
+
+  int i = 0;
+
+  for (; i + KERNEL_WIDTH <= dim; i += KERNEL_WIDTH)
+  {
+    for (int j = 0; j < KERNEL_WIDTH; ++j)
+    {
+      partial[j] += values[i + j] * values[i + j];
+    }
+  }
+
+  for (int j = 0; i < dim; ++i, ++j)
+  {
+    partial[j] += values[i] * values[i];
+  }
+
+  return reduce_sum(partial);
+}
+
+SLEQP_KERNEL
+double
+sleqp_kernel_one_norm(const double* values, int dim)
+{
+  double partial[KERNEL_WIDTH] = {0.};
+
+  int i = 0;
+
+  for (; i + KERNEL_WIDTH <= dim; i += KERNEL_WIDTH)
+  {
+    for (int j = 0; j < KERNEL_WIDTH; ++j)
+    {
+      partial[j] += SLEQP_ABS(values[i + j]);
+    }
+  }
+
+  for (int j = 0; i < dim; ++i, ++j)
+  {
+    partial[j] += SLEQP_ABS(values[i]);
+  }
+
+  return reduce_sum(partial);
+}
+
+SLEQP_KERNEL
+double
+sleqp_kernel_inf_norm(const double* values, int dim)
+{
+  double partial[KERNEL_WIDTH] = {0.};
+
+  int i = 0;
+
+  for (; i + KERNEL_WIDTH <= dim; i += KERNEL_WIDTH)
+  {
+    for (int j = 0; j < KERNEL_WIDTH; ++j)
+    {
+      const double value = SLEQP_ABS(values[i + j]);
+      partial[j]         = SLEQP_MAX(value, partial[j]);
+    }
+  }
+
+  for (int j = 0; i < dim; ++i, ++j)
+  {
+    const double value = SLEQP_ABS(values[i]);
+    partial[j]         = SLEQP_MAX(value, partial[j]);
+  }
+
+  double norm = 0.;
+
+  for (int j = 0; j < KERNEL_WIDTH; ++j)
+  {
+    norm = SLEQP_MAX(partial[j], norm);
+  }
+
+  return norm;
+}
+
+SLEQP_KERNEL
+void
+sleqp_kernel_scale(const double* values,
+                   double factor,
+                   double* result,
+                   int dim)
+{
+  for (int i = 0; i < dim; ++i)
+  {
+    result[i] = factor * values[i];
+  }
+}
+
+SLEQP_KERNEL
+void
+sleqp_kernel_axpby(const double* first,
+                   const double* second,
+                   double first_factor,
+                   double second_factor,
+                   double* result,
+                   int dim)
+{
+  for (int i = 0; i < dim; ++i)
+  {
+    result[i] = first_factor * first[i] + second_factor * second[i];
+  }
+}
+
+void
+sleqp_kernel_gemv_trans(const double* matrix,
+                        int num_rows,
+                        int num_cols,
+                        const double* vector,
+                        double* result)
+{
+  for (int j = 0; j < num_cols; ++j)
+  {
+    result[j] = sleqp_kernel_dot(matrix + (size_t)j * num_rows,
+                                 vector,
+                                 num_rows);
+  }
+}
+
+SLEQP_KERNEL
+void
+sleqp_kernel_gemv(const double* matrix,
+                  int num_rows,
+                  int num_cols,
+                  const double* vector,
+                  double* result)
+{
+  int j = 0;
+
+  // Process pairs of columns to halve the passes over the result
+  for (; j + 2 <= num_cols; j += 2)
+  {
+    const double* first  = matrix + (size_t)j * num_rows;
+    const double* second = first + num_rows;
+
+    const double first_factor  = vector[j];
+    const double second_factor = vector[j + 1];
+
+    for (int i = 0; i < num_rows; ++i)
+    {
+      result[i] += first_factor * first[i] + second_factor * second[i];
+    }
+  }
+
+  for (; j < num_cols; ++j)
+  {
+    const double* column = matrix + (size_t)j * num_rows;
+    const double factor  = vector[j];
+
+    for (int i = 0; i < num_rows; ++i)
+    {
+      result[i] += factor * column[i];
+    }
+  }
+}
+
+SLEQP_KERNEL
+void
+sleqp_kernel_fill(double* values, double value, int dim)
+{
+  for (int i = 0; i < dim; ++i)
+  {
+    values[i] = value;
+  }
+}
+
+SLEQP_KERNEL
+int
+sleqp_kernel_flush_zeros(double* values, int dim, double eps)
+{
+  int nnz = 0;
+
+  for (int i = 0; i < dim; ++i)
+  {
+    const bool zero = SLEQP_ABS(values[i]) <= eps;
+
+    values[i] = zero ? 0. : values[i];
+    nnz += !zero;
+  }
+
+  return nnz;
+}
+
+int
+sleqp_kernel_compact(double* values, int* indices, int dim, double eps)
+{
+  int nnz = 0;
+
+  // Write unconditionally and only advance on nonzero values.
+  // Since nnz <= i, this never overwrites unread values
+  for (int i = 0; i < dim; ++i)
+  {
+    const double value = values[i];
+
+    values[nnz]  = value;
+    indices[nnz] = i;
+
+    nnz += (SLEQP_ABS(value) > eps);
+  }
+
+  return nnz;
+}
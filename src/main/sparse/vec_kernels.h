@@ -0,0 +1,128 @@
+#ifndef SLEQP_VEC_KERNELS_H
+#define SLEQP_VEC_KERNELS_H
+
+/**
+ * @file vec_kernels.h
+ * @brief Low-level kernels operating on the raw arrays of vectors.
+ *
+ * If supported by the compiler, the kernels are compiled for several
+ * instruction sets (AVX-512, AVX2, and the baseline of the target, which
+ * includes NEON on AArch64). The most suitable version is selected at
+ * load time based on the capabilities of the CPU.
+ **/
+
+#include "types.h"
+
+/**
+ * Computes the dot product of two dense arrays
+ **/
+double
+sleqp_kernel_dot(const double* first, const double* second, int dim);
+
+/**
+ * Computes the dot product of a sparse array with a dense one,
+ * i.e., \f$ \sum_{k} values_k \cdot dense_{indices_k} \f$
+ **/
+double
+sleqp_kernel_gather_dot(const double* values,
+                        const int* indices,
+                        int nnz,
+                        const double* dense);
+
+/**
+ * Computes the dot product of two sparse arrays with ascending indices.
+ * Intersects the indices by merging, or by galloping through the larger
+ * array if the number of nonzeros differs substantially
+ **/
+double
+sleqp_kernel_sparse_dot(const double* first_values,
+                        const int* first_indices,
+                        int first_nnz,
+                        const double* second_values,
+                        const int* second_indices,
+                        int second_nnz);
+
+/**
+ * Computes the squared 2-norm of a dense array
+ **/
+double
+sleqp_kernel_norm_sq(const double* values, int dim);
+
+/**
+ * Computes the 1-norm of a dense array
+ **/
+double
+sleqp_kernel_one_norm(const double* values, int dim);
+
+/**
+ * Computes the oo-norm of a dense array
+ **/
+double
+sleqp_kernel_inf_norm(const double* values, int dim);
+
+/**
+ * Scales the entries of a dense array, storing the result in `result`,
+ * which may coincide with `values`
+ **/
+void
+sleqp_kernel_scale(const double* values,
+                   double factor,
+                   double* result,
+                   int dim);
+
+/**
+ * Computes \f$ result = first\_factor \cdot first + second\_factor \cdot
+ * second \f$ for dense arrays
+ **/
+void
+sleqp_kernel_axpby(const double* first,
+                   const double* second,
+                   double first_factor,
+                   double second_factor,
+                   double* result,
+                   int dim);
+
+/**
+ * Computes \f$ result = A^{T} x \f$ for a dense column-major matrix
+ * \f$ A \f$ with leading dimension `num_rows`
+ **/
+void
+sleqp_kernel_gemv_trans(const double* matrix,
+                        int num_rows,
+                        int num_cols,
+                        const double* vector,
+                        double* result);
+
+/**
+ * Computes \f$ result \leftarrow result + A x \f$ for a dense column-major
+ * matrix \f$ A \f$ with leading dimension `num_rows`
+ **/
+void
+sleqp_kernel_gemv(const double* matrix,
+                  int num_rows,
+                  int num_cols,
+                  const double* vector,
+                  double* result);
+
+/**
+ * Sets all entries of a dense array to the given value
+ **/
+void
+sleqp_kernel_fill(double* values, double value, int dim);
+
+/**
+ * Sets all entries of a dense array whose absolute value is at most `eps`
+ * to zero. Returns the number of remaining nonzero entries.
+ **/
+int
+sleqp_kernel_flush_zeros(double* values, int dim, double eps);
+
+/**
+ * Compacts a dense array in place, removing all entries whose absolute value
+ * is at most `eps`. The positions of the remaining entries are written into
+ * `indices`. Returns the number of remaining entries.
+ **/
+int
+sleqp_kernel_compact(double* values, int* indices, int dim, double eps);
+
+#endif /* SLEQP_VEC_KERNELS_H */
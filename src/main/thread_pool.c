@@ -0,0 +1,414 @@
+#include "thread_pool.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "cmp.h"
+#include "fail.h"
+#include "log.h"
+#include "mem.h"
+
+#define ERROR_MSG_SIZE 2048
+
+struct SleqpThreadPool
+{
+  int refcount;
+
+  int num_threads;
+
+  int num_workers;
+  pthread_t* workers;
+
+  pthread_mutex_t lock;
+  pthread_cond_t work_cond;
+  pthread_cond_t done_cond;
+
+  int generation;
+  bool shutdown;
+
+  SLEQP_THREAD_TASK task;
+  void* data;
+  int num_tasks;
+
+  // Allocator active on the thread issuing the run
+  SleqpAllocator* allocator;
+
+  atomic_int next_task;
+  int num_busy;
+
+  bool failed;
+  SLEQP_ERROR_TYPE error_type;
+  char error_msg[ERROR_MSG_SIZE];
+};
+
+static _Thread_local SleqpThreadPool* active_pool = NULL;
+
+// Set while the current thread is executing tasks
+static _Thread_local bool in_task = false;
+
+static void
+record_failure(SleqpThreadPool* pool)
+{
+  pthread_mutex_lock(&pool->lock);
+
+  if (!pool->failed)
+  {
+    pool->failed     = true;
+    pool->error_type = sleqp_error_type();
+    strncpy(pool->error_msg, sleqp_error_msg(), ERROR_MSG_SIZE - 1);
+  }
+
+  pthread_mutex_unlock(&pool->lock);
+
+  // Skip remaining tasks
+  atomic_store(&pool->next_task, pool->num_tasks);
+}
+
+static void
+process_tasks(SleqpThreadPool* pool)
+{
+  in_task = true;
+
+  SleqpAllocator* previous_allocator
+    = sleqp_allocator_set_active(pool->allocator);
+
+  while (true)
+  {
+    const int task = atomic_fetch_add(&pool->next_task, 1);
+
+    if (task >= pool->num_tasks)
+    {
+      break;
+    }
+
+    if (pool->task(task, pool->data) != SLEQP_OKAY)
+    {
+      record_failure(pool);
+    }
+  }
+
+  sleqp_allocator_set_active(previous_allocator);
+
+  in_task = false;
+}
+
+static void*
+worker_main(void* data)
+{
+  SleqpThreadPool* pool = (SleqpThreadPool*)data;
+
+  int generation = 0;
+
+  pthread_mutex_lock(&pool->lock);
+
+  while (true)
+  {
+    while (!pool->shutdown && pool->generation == generation)
+    {
+      pthread_cond_wait(&pool->work_cond, &pool->lock);
+    }
+
+    if (pool->shutdown)
+    {
+      break;
+    }
+
+    generation = pool->generation;
+
+    pthread_mutex_unlock(&pool->lock);
+
+    process_tasks(pool);
+
+    pthread_mutex_lock(&pool->lock);
+
+    if (--pool->num_busy == 0)
+    {
+      pthread_cond_signal(&pool->done_cond);
+    }
+  }
+
+  pthread_mutex_unlock(&pool->lock);
+
+  return NULL;
+}
+
+static int
+available_processors()
+{
+  const long num_procs = sysconf(_SC_NPROCESSORS_ONLN);
+
+  return (num_procs > 0) ? ((int)num_procs) : 1;
+}
+
+SLEQP_RETCODE
+sleqp_thread_pool_create(SleqpThreadPool** star, int num_threads)
+{
+  SLEQP_CALL(sleqp_malloc(star));
+
+  SleqpThreadPool* pool = *star;
+
+  *pool = (SleqpThreadPool){0};
+
+  pool->refcount = 1;
+
+  if (num_threads == SLEQP_NONE)
+  {
+    num_threads = available_processors();
+  }
+
+  pool->num_threads = SLEQP_MAX(num_threads, 1);
+
+  pthread_mutex_init(&pool->lock, NULL);
+  pthread_cond_init(&pool->work_cond, NULL);
+  pthread_cond_init(&pool->done_cond, NULL);
+
+  return SLEQP_OKAY;
+}
+
+int
+sleqp_thread_pool_num_threads(const SleqpThreadPool* pool)
+{
+  return pool->num_threads;
+}
+
+static SLEQP_RETCODE
+start_workers(SleqpThreadPool* pool)
+{
+  const int num_workers = pool->num_threads - 1;
+
+  SLEQP_CALL(sleqp_alloc_array(&pool->workers, num_workers));
+
+  for (int i = 0; i < num_workers; ++i)
+  {
+    if (pthread_create(pool->workers + i, NULL, worker_main, pool) != 0)
+    {
+      sleqp_log_warn("Failed to start worker thread, continuing with %d",
+                     i + 1);
+      break;
+    }
+
+    ++pool->num_workers;
+  }
+
+  return SLEQP_OKAY;
+}
+
+static SLEQP_RETCODE
+run_serially(int num_tasks, SLEQP_THREAD_TASK task, void* data)
+{
+  for (int i = 0; i < num_tasks; ++i)
+  {
+    SLEQP_CALL(task(i, data));
+  }
+
+  return SLEQP_OKAY;
+}
+
+SLEQP_RETCODE
+sleqp_thread_pool_run(SleqpThreadPool* pool,
+                      int num_tasks,
+                      SLEQP_THREAD_TASK task,
+                      void* data)
+{
+  if (!pool || pool->num_threads == 1 || num_tasks <= 1 || in_task)
+  {
+    return run_serially(num_tasks, task, data);
+  }
+
+  if (!pool->workers)
+  {
+    SLEQP_CALL(start_workers(pool));
+  }
+
+  if (pool->num_workers == 0)
+  {
+    return run_serially(num_tasks, task, data);
+  }
+
+  pthread_mutex_lock(&pool->lock);
+
+  pool->task      = task;
+  pool->data      = data;
+  pool->num_tasks = num_tasks;
+  pool->allocator = sleqp_allocator_active();
+  pool->failed    = false;
+  pool->num_busy  = pool->num_workers;
+
+  atomic_store(&pool->next_task, 0);
+
+  ++pool->generation;
+
+  pthread_cond_broadcast(&pool->work_cond);
+
+  pthread_mutex_unlock(&pool->lock);
+
+  process_tasks(pool);
+
+  pthread_mutex_lock(&pool->lock);
+
+  while (pool->num_busy > 0)
+  {
+    pthread_cond_wait(&pool->done_cond, &pool->lock);
+  }
+
+  const bool failed = pool->failed;
+
+  pthread_mutex_unlock(&pool->lock);
+
+  if (failed)
+  {
+    sleqp_raise(pool->error_type, "%s", pool->error_msg);
+  }
+
+  return SLEQP_OKAY;
+}
+
+SleqpThreadPool*
+sleqp_thread_pool_active()
+{
+  return active_pool;
+}
+
+SleqpThreadPool*
+sleqp_thread_pool_set_active(SleqpThreadPool* pool)
+{
+  SleqpThreadPool* previous = active_pool;
+
+  active_pool = pool;
+
+  return previous;
+}
+
+int
+sleqp_thread_pool_active_threads()
+{
+  if (!active_pool || in_task)
+  {
+    return 1;
+  }
+
+  return active_pool->num_threads;
+}
+
+bool
+sleqp_thread_pool_parallelize(int work)
+{
+  return (work >= SLEQP_PARALLEL_MIN_WORK)
+         && (sleqp_thread_pool_active_threads() > 1);
+}
+
+int
+sleqp_thread_pool_active_tasks()
+{
+  return SLEQP_TASKS_PER_THREAD * sleqp_thread_pool_active_threads();
+}
+
+// Returns the first position in [0, size] whose offset is at least `target`
+static int
+partition_bound(const int* offsets, int size, long long target)
+{
+  int lo = 0, hi = size;
+
+  while (lo < hi)
+  {
+    const int mid = lo + (hi - lo) / 2;
+
+    if (offsets[mid] < target)
+    {
+      lo = mid + 1;
+    }
+    else
+    {
+      hi = mid;
+    }
+  }
+
+  return lo;
+}
+
+void
+sleqp_thread_pool_partition(const int* offsets,
+                            int size,
+                            int block,
+                            int num_blocks,
+                            int* begin,
+                            int* end)
+{
+  const long long first = offsets[0];
+  const long long total = offsets[size] - first;
+
+  *begin = (block == 0) ? 0
+                        : partition_bound(offsets,
+                                          size,
+                                          first + (total * block) / num_blocks);
+
+  *end = (block == num_blocks - 1)
+           ? size
+           : partition_bound(offsets,
+                             size,
+                             first + (total * (block + 1)) / num_blocks);
+}
+
+SLEQP_RETCODE
+sleqp_thread_pool_capture(SleqpThreadPool* pool)
+{
+  ++pool->refcount;
+
+  return SLEQP_OKAY;
+}
+
+static SLEQP_RETCODE
+thread_pool_free(SleqpThreadPool** star)
+{
+  SleqpThreadPool* pool = *star;
+
+  if (!pool)
+  {
+    return SLEQP_OKAY;
+  }
+
+  pthread_mutex_lock(&pool->lock);
+
+  pool->shutdown = true;
+
+  pthread_cond_broadcast(&pool->work_cond);
+
+  pthread_mutex_unlock(&pool->lock);
+
+  for (int i = 0; i < pool->num_workers; ++i)
+  {
+    pthread_join(pool->workers[i], NULL);
+  }
+
+  sleqp_free(&pool->workers);
+
+  pthread_cond_destroy(&pool->done_cond);
+  pthread_cond_destroy(&pool->work_cond);
+  pthread_mutex_destroy(&pool->lock);
+
+  sleqp_free(star);
+
+  return SLEQP_OKAY;
+}
+
+SLEQP_RETCODE
+sleqp_thread_pool_release(SleqpThreadPool** star)
+{
+  SleqpThreadPool* pool = *star;
+
+  if (!pool)
+  {
+    return SLEQP_OKAY;
+  }
+
+  if (--pool->refcount == 0)
+  {
+    SLEQP_CALL(thread_pool_free(star));
+  }
+
+  *star = NULL;
+
+  return SLEQP_OKAY;
+}
@@ -0,0 +1,130 @@
+#ifndef SLEQP_THREAD_POOL_H
+#define SLEQP_THREAD_POOL_H
+
+/**
+ * @file thread_pool.h
+ * @brief Definition of a fork-join thread pool.
+ *
+ * A pool runs a number of independent tasks on its worker threads,
+ * the calling thread participates in the work. Worker threads are
+ * started lazily on the first parallel run. A pool must only be used
+ * by one thread at a time. Runs issued from within a task are executed
+ * serially by the thread running the task.
+ **/
+
+#include "types.h"
+
+// Minimum amount of work (e.g., number of nonzeros) required
+// for internal kernels to run in parallel
+#define SLEQP_PARALLEL_MIN_WORK 100000
+
+// Number of tasks created per thread when splitting kernels into blocks
+#define SLEQP_TASKS_PER_THREAD 4
+
+typedef struct SleqpThreadPool SleqpThreadPool;
+
+/**
+ * A task to be run by a thread pool
+ *
+ * @param[in] task       The index of the task
+ * @param[in] data       The data passed to @ref sleqp_thread_pool_run
+ **/
+typedef SLEQP_RETCODE (*SLEQP_THREAD_TASK)(int task, void* data);
+
+/**
+ * Creates a new pool
+ *
+ * @param[out] star          The pool
+ * @param[in]  num_threads   The number of threads including the calling one,
+ *                           or @ref SLEQP_NONE to use all available processors
+ **/
+SLEQP_NODISCARD
+SLEQP_RETCODE
+sleqp_thread_pool_create(SleqpThreadPool** star, int num_threads);
+
+int
+sleqp_thread_pool_num_threads(const SleqpThreadPool* pool);
+
+/**
+ * Runs the given tasks in parallel and waits for their completion.
+ * If any task fails, the error of the first failing task is raised.
+ *
+ * @param[in] pool       The pool, may be `NULL` to run the tasks serially
+ * @param[in] num_tasks  The number of tasks
+ * @param[in] task       The task function
+ * @param[in] data       The data passed on to the task function
+ **/
+SLEQP_NODISCARD
+SLEQP_RETCODE
+sleqp_thread_pool_run(SleqpThreadPool* pool,
+                      int num_tasks,
+                      SLEQP_THREAD_TASK task,
+                      void* data);
+
+/**
+ * Returns the pool which is active on the calling thread, or `NULL`
+ **/
+SleqpThreadPool*
+sleqp_thread_pool_active();
+
+/**
+ * Sets the pool which is active on the calling thread. Internal kernels
+ * such as sparse matrix products use the active pool to parallelize
+ * their work.
+ *
+ * @param[in] pool       The pool, or `NULL`
+ *
+ * @return The previously active pool
+ **/
+SleqpThreadPool*
+sleqp_thread_pool_set_active(SleqpThreadPool* pool);
+
+/**
+ * Returns the number of threads of the active pool, or 1 if there is none
+ **/
+int
+sleqp_thread_pool_active_threads();
+
+/**
+ * Returns whether a kernel performing the given amount of work
+ * should use the active pool
+ **/
+bool
+sleqp_thread_pool_parallelize(int work);
+
+/**
+ * Returns the number of tasks into which kernels should split their
+ * work when using the active pool
+ **/
+int
+sleqp_thread_pool_active_tasks();
+
+/**
+ * Splits the range [0, size) into blocks containing similar amounts of work.
+ * The work up to (excluding) position i is given by the nondecreasing
+ * `offsets[i]`, e.g., the column pointers of a matrix.
+ *
+ * @param[in]  offsets     The offsets, of size `size + 1`
+ * @param[in]  size        The size of the range
+ * @param[in]  block       The index of the block
+ * @param[in]  num_blocks  The total number of blocks
+ * @param[out] begin       The begin of the block
+ * @param[out] end         The end (exclusive) of the block
+ **/
+void
+sleqp_thread_pool_partition(const int* offsets,
+                            int size,
+                            int block,
+                            int num_blocks,
+                            int* begin,
+                            int* end);
+
+SLEQP_NODISCARD
+SLEQP_RETCODE
+sleqp_thread_pool_capture(SleqpThreadPool* pool);
+
+SLEQP_NODISCARD
+SLEQP_RETCODE
+sleqp_thread_pool_release(SleqpThreadPool** star);
+
+#endif /* SLEQP_THREAD_POOL_H */
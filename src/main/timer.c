@@ -10,15 +10,23 @@
 
 #define BUF_SIZE 512
 
+/*
+ * Elapsed times are measured using a monotonic wall clock, which is
+ * unaffected by threads of the LP solvers and factorizations. The CPU
+ * time is measured for the thread starting and stopping the timer.
+ */
 struct SleqpTimer
 {
-  clock_t start;
+  struct timespec start;
+  struct timespec start_cpu;
   int num_runs;
   int running;
 
   double total_elapsed;
   double total_elapsed_squared;
 
+  double total_cpu;
+
   double last_elapsed;
 };
 
@@ -62,13 +70,26 @@ sleqp_timer_create(SleqpTimer** star)
   return SLEQP_OKAY;
 }
 
+static double
+seconds_since(clockid_t clock_id, const struct timespec* start)
+{
+  struct timespec end;
+
+  clock_gettime(clock_id, &end);
+
+  return (double)(end.tv_sec - start->tv_sec)
+         + 1e-9 * (double)(end.tv_nsec - start->tv_nsec);
+}
+
 SLEQP_RETCODE
 sleqp_timer_start(SleqpTimer* timer)
 {
   assert(!timer->running);
 
   timer->running = true;
-  timer->start   = clock();
+
+  clock_gettime(CLOCK_MONOTONIC, &timer->start);
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &timer->start_cpu);
 
   return SLEQP_OKAY;
 }
@@ -89,15 +110,24 @@ current_elapsed(SleqpTimer* timer)
     return 0.;
   }
 
-  clock_t end = clock();
-
-  double elapsed = ((double)(end - timer->start)) / CLOCKS_PER_SEC;
+  const double elapsed = seconds_since(CLOCK_MONOTONIC, &timer->start);
 
   assert(elapsed >= 0.);
 
   return elapsed;
 }
 
+static double
+current_cpu(SleqpTimer* timer)
+{
+  if (!timer->running)
+  {
+    return 0.;
+  }
+
+  return seconds_since(CLOCK_THREAD_CPUTIME_ID, &timer->start_cpu);
+}
+
 SLEQP_RETCODE
 sleqp_timer_stop(SleqpTimer* timer)
 {
@@ -112,24 +142,13 @@ sleqp_timer_stop(SleqpTimer* timer)
   timer->total_elapsed += elapsed;
   timer->total_elapsed_squared += elapsed * elapsed;
 
+  timer->total_cpu += current_cpu(timer);
+
   timer->running = false;
 
   return SLEQP_OKAY;
 }
 
-static double
-currently_elapsed(SleqpTimer* timer)
-{
-  if (!timer->running)
-  {
-    return 0.;
-  }
-
-  clock_t end = clock();
-
-  return ((double)(end - timer->start)) / CLOCKS_PER_SEC;
-}
-
 SLEQP_RETCODE
 sleqp_timer_add(SleqpTimer* timer, double value)
 {
@@ -144,7 +163,7 @@ sleqp_timer_add(SleqpTimer* timer, double value)
 double
 sleqp_timer_elapsed(SleqpTimer* timer)
 {
-  return timer->last_elapsed + currently_elapsed(timer);
+  return timer->last_elapsed + current_elapsed(timer);
 }
 
 double
@@ -163,7 +182,7 @@ sleqp_timer_get_avg(SleqpTimer* timer)
 double
 sleqp_timer_get_ttl(SleqpTimer* timer)
 {
-  return timer->total_elapsed + currently_elapsed(timer);
+  return timer->total_elapsed + current_elapsed(timer);
 }
 
 double
@@ -181,12 +200,28 @@ sleqp_timer_get_std(SleqpTimer* timer)
   return sqrt(var);
 }
 
+double
+sleqp_timer_get_cpu_ttl(SleqpTimer* timer)
+{
+  return timer->total_cpu + current_cpu(timer);
+}
+
 int
 sleqp_timer_get_num_runs(SleqpTimer* timer)
 {
   return timer->num_runs;
 }
 
+SLEQP_RETCODE
+sleqp_timer_add_stats(SleqpTimer* timer, SleqpTimingStats* stats)
+{
+  stats->num_runs += sleqp_timer_get_num_runs(timer);
+  stats->wall_time += sleqp_timer_get_ttl(timer);
+  stats->cpu_time += sleqp_timer_get_cpu_ttl(timer);
+
+  return SLEQP_OKAY;
+}
+
 static SLEQP_RETCODE
 round_up_time(double* time, const char** suffix, int* len)
 {
@@ -42,9 +42,23 @@ sleqp_timer_get_ttl(SleqpTimer* timer);
 double
 sleqp_timer_get_std(SleqpTimer* timer);
 
+/**
+ * Returns the total CPU time spent by the thread(s) running the timer
+ **/
+double
+sleqp_timer_get_cpu_ttl(SleqpTimer* timer);
+
 int
 sleqp_timer_get_num_runs(SleqpTimer* timer);
 
+/**
+ * Adds the number of runs, the total wall-clock and CPU time of
+ * the timer to the given statistics
+ **/
+SLEQP_NODISCARD
+SLEQP_RETCODE
+sleqp_timer_add_stats(SleqpTimer* timer, SleqpTimingStats* stats);
+
 SLEQP_NODISCARD
 SLEQP_RETCODE
 sleqp_timer_display(SleqpTimer* timer,
@@ -2,8 +2,19 @@
  * An iterative solver for the trust-region subproblem using projected Conjugate
  * Gradients (CG) with Steihaug's modification for the boundary case. The
  * augmented Jacobian system is used to project onto the nullspace of the active
- * set identified in the LP step. The (1,1)-block of the projector is currently
- * the identity, but could contain a Hessian preconditioner.
+ * set identified in the LP step. The (1,1)-block of the projector is the
+ * identity. If a preconditioner M is chosen, the projected residuals are
+ * computed as P[M^{-1} P[r]], which is a symmetric positive definite operator
+ * on the nullspace.
+ *
+ * Unlike in the Steihaug-Toint method, the trust region remains Euclidean
+ * when preconditioning, since the radius updates, the trust-region dual and
+ * the Newton-step checks elsewhere rely on ||p|| <= Delta. The price is
+ * that the Euclidean norms of the preconditioned iterates are no longer
+ * guaranteed to increase, and that the first iterate is a Cauchy step with
+ * respect to M only. Boundary steps are therefore cut off at the first
+ * iterate leaving the trust region, with a model decrease relative to the
+ * Cauchy decrease depending on the conditioning of M.
  */
 
 #include "steihaug_solver.h"
@@ -15,6 +26,7 @@
 #include "fail.h"
 #include "log.h"
 #include "mem.h"
+#include "precond/precond.h"
 #include "sparse/pub_vec.h"
 #include "tr/tr_util.h"
 
@@ -36,6 +48,8 @@ typedef struct
 
   SleqpVec* sparse_cache;
 
+  SleqpPrecond* precond;
+
   double min_rayleigh, max_rayleigh;
 
   SleqpTimer* timer;
@@ -53,6 +67,8 @@ steihaug_solver_free(void** star)
 
   SLEQP_CALL(sleqp_timer_free(&solver->timer));
 
+  SLEQP_CALL(sleqp_precond_release(&solver->precond));
+
   SLEQP_CALL(sleqp_vec_free(&solver->sparse_cache));
   SLEQP_CALL(sleqp_vec_free(&solver->z));
   SLEQP_CALL(sleqp_vec_free(&solver->r));
@@ -220,6 +236,31 @@ steihaug_tr_dual(SleqpSteihaugSolver* solver,
   return SLEQP_OKAY;
 }
 
+// Computes g = P[M^{-1} P[r]] and the squared norm of the projection P[r]
+static SLEQP_RETCODE
+steihaug_project_residual(SleqpSteihaugSolver* solver,
+                          SleqpAugJac* jacobian,
+                          double* res_nrm_sq)
+{
+  SLEQP_CALL(sleqp_aug_jac_project_nullspace(jacobian, solver->r, solver->g));
+
+  *res_nrm_sq = sleqp_vec_norm_sq(solver->g);
+
+  if (!solver->precond)
+  {
+    return SLEQP_OKAY;
+  }
+
+  SLEQP_CALL(
+    sleqp_precond_apply(solver->precond, solver->g, solver->sparse_cache));
+
+  SLEQP_CALL(sleqp_aug_jac_project_nullspace(jacobian,
+                                             solver->sparse_cache,
+                                             solver->g));
+
+  return SLEQP_OKAY;
+}
+
 static SLEQP_RETCODE
 steihaug_solver_solve(SleqpAugJac* jacobian,
                       const SleqpVec* multipliers,
@@ -255,7 +296,7 @@ steihaug_solver_solve(SleqpAugJac* jacobian,
   double dBd;
   double alpha;
   double beta;
-  double d_nrm_sq;
+  double res_nrm_sq;
   double gd;
   double zBd;
 
@@ -264,6 +305,11 @@ steihaug_solver_solve(SleqpAugJac* jacobian,
 
   SLEQP_CALL(sleqp_timer_start(solver->timer));
 
+  if (solver->precond)
+  {
+    SLEQP_CALL(sleqp_precond_update(solver->precond, multipliers));
+  }
+
   SLEQP_CALL(sleqp_vec_clear(newton_step));
 
   // set z0 such that P[z0] = 0
@@ -272,17 +318,15 @@ steihaug_solver_solve(SleqpAugJac* jacobian,
   // set r0 = nabla f_k
   SLEQP_CALL(sleqp_vec_copy(gradient, solver->r));
 
-  // set g0 = P[r0]
-  SLEQP_CALL(sleqp_aug_jac_project_nullspace(jacobian, solver->r, solver->g));
+  // set g0 = P[M^{-1} P[r0]]
+  SLEQP_CALL(steihaug_project_residual(solver, jacobian, &res_nrm_sq));
 
-  // set d0 = -P[r0] = - P[nabla f_k] = -g0
+  // set d0 = -g0
   SLEQP_CALL(sleqp_vec_copy(solver->g, solver->d));
   SLEQP_CALL(sleqp_vec_scale(solver->d, -1.));
 
-  // if ||d0|| < eps_k: return p_k = P[z_0] = 0
-  d_nrm_sq = sleqp_vec_norm_sq(solver->d);
-
-  if (d_nrm_sq < rel_tol_sq)
+  // if ||P[r0]|| < eps_k: return p_k = P[z_0] = 0
+  if (res_nrm_sq < rel_tol_sq)
   {
     SLEQP_CALL(sleqp_vec_copy(solver->z, newton_step));
     SLEQP_CALL(sleqp_timer_stop(solver->timer));
@@ -315,8 +359,8 @@ steihaug_solver_solve(SleqpAugJac* jacobian,
     SLEQP_CALL(check_projection(solver, jacobian, solver->d));
 #endif
 
-    // if |r_{j+1}^T * g_{j+1}| < eps_k:
-    if (fabs(r_dot_g) < rel_tol_sq)
+    // if ||P[r_{j+1}]|| < eps_k:
+    if (res_nrm_sq < rel_tol_sq)
     {
       sleqp_log_debug("CG solver found interior solution after %d iterations",
                       iteration);
@@ -399,6 +443,11 @@ steihaug_solver_solve(SleqpAugJac* jacobian,
       break;
     }
 
+    if (solver->precond)
+    {
+      SLEQP_CALL(sleqp_precond_push(solver->precond, solver->d, solver->Bd));
+    }
+
     // set alpha_j = (r_j^T * g_j) / (d_j^T * B_k * d_j)
     alpha = r_dot_g / dBd;
 
@@ -453,8 +502,8 @@ steihaug_solver_solve(SleqpAugJac* jacobian,
 
     SLEQP_CALL(sleqp_vec_copy(solver->sparse_cache, solver->r));
 
-    // set g_{j+1} = P[r_{j+1}]
-    SLEQP_CALL(sleqp_aug_jac_project_nullspace(jacobian, solver->r, solver->g));
+    // set g_{j+1} = P[M^{-1} P[r_{j+1}]]
+    SLEQP_CALL(steihaug_project_residual(solver, jacobian, &res_nrm_sq));
 
 #if SLEQP_DEBUG
     SLEQP_CALL(check_projection(solver, jacobian, solver->g));
@@ -524,6 +573,8 @@ sleqp_steihaug_solver_create(SleqpTRSolver** solver_star,
   SLEQP_CALL(sleqp_vec_create_empty(&solver->z, num_variables));
   SLEQP_CALL(sleqp_vec_create_empty(&solver->sparse_cache, num_variables));
 
+  SLEQP_CALL(sleqp_precond_create_default(&solver->precond, problem, settings));
+
   SLEQP_CALL(sleqp_timer_create(&solver->timer));
 
   SleqpTRCallbacks callbacks = {.solve    = steihaug_solver_solve,
@@ -3,6 +3,11 @@
 
 #include "tr_solver.h"
 
+/**
+ * Creates a projected CG trust-region solver, preconditioned according to
+ * @ref SLEQP_SETTINGS_ENUM_TR_PRECOND. The trust region is Euclidean even
+ * when preconditioning, see the notes in the implementation.
+ **/
 SLEQP_NODISCARD
 SLEQP_RETCODE
 sleqp_steihaug_solver_create(SleqpTRSolver** star,
@@ -0,0 +1,284 @@
+#include "trace.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "error.h"
+#include "fail.h"
+#include "mem.h"
+#include "timer.h"
+
+#define ROWS_PER_BLOCK 256
+
+static const char magic[] = "SLEQPTRC";
+
+typedef enum
+{
+  ColumnInt    = 0,
+  ColumnDouble = 1
+} ColumnType;
+
+typedef struct
+{
+  const char* name;
+  ColumnType type;
+  size_t offset;
+} Column;
+
+#define INT_COLUMN(field)                                                      \
+  {                                                                            \
+    .name = #field, .type = ColumnInt,                                         \
+    .offset = offsetof(SleqpTraceRow, field)                                   \
+  }
+
+#define DOUBLE_COLUMN(field)                                                   \
+  {                                                                            \
+    .name = #field, .type = ColumnDouble,                                      \
+    .offset = offsetof(SleqpTraceRow, field)                                   \
+  }
+
+static const Column columns[] = {INT_COLUMN(iteration),
+                                 INT_COLUMN(phase),
+                                 INT_COLUMN(step_type),
+                                 INT_COLUMN(boundary_step),
+                                 INT_COLUMN(num_active_vars),
+                                 INT_COLUMN(num_active_cons),
+                                 DOUBLE_COLUMN(obj_val),
+                                 DOUBLE_COLUMN(merit_val),
+                                 DOUBLE_COLUMN(feas_res),
+                                 DOUBLE_COLUMN(slack_res),
+                                 DOUBLE_COLUMN(stat_res),
+                                 DOUBLE_COLUMN(penalty_param),
+                                 DOUBLE_COLUMN(trust_radius),
+                                 DOUBLE_COLUMN(lp_trust_radius),
+                                 DOUBLE_COLUMN(primal_step),
+                                 DOUBLE_COLUMN(dual_step),
+                                 DOUBLE_COLUMN(func_time),
+                                 DOUBLE_COLUMN(lp_time),
+                                 DOUBLE_COLUMN(eqp_time),
+                                 DOUBLE_COLUMN(fact_time),
+                                 DOUBLE_COLUMN(linesearch_time),
+                                 DOUBLE_COLUMN(elapsed)};
+
+static const int num_columns = sizeof(columns) / sizeof(columns[0]);
+
+struct SleqpTrace
+{
+  int refcount;
+
+  FILE* file;
+
+  SleqpTimer* timer;
+
+  SleqpTraceRow* rows;
+  int num_rows;
+
+  // Column values of the current block
+  double* double_values;
+  int32_t* int_values;
+};
+
+static SLEQP_RETCODE
+write_values(SleqpTrace* trace, const void* values, size_t size, size_t count)
+{
+  if (fwrite(values, size, count, trace->file) != count)
+  {
+    sleqp_raise(SLEQP_INTERNAL_ERROR, "Failed to write trace file");
+  }
+
+  return SLEQP_OKAY;
+}
+
+static SLEQP_RETCODE
+write_header(SleqpTrace* trace)
+{
+  const int32_t version = SLEQP_TRACE_VERSION;
+  const int32_t count   = num_columns;
+
+  SLEQP_CALL(write_values(trace, magic, 1, strlen(magic)));
+  SLEQP_CALL(write_values(trace, &version, sizeof(int32_t), 1));
+  SLEQP_CALL(write_values(trace, &count, sizeof(int32_t), 1));
+
+  for (int j = 0; j < num_columns; ++j)
+  {
+    const uint8_t type   = columns[j].type;
+    const uint8_t length = strlen(columns[j].name);
+
+    SLEQP_CALL(write_values(trace, &type, 1, 1));
+    SLEQP_CALL(write_values(trace, &length, 1, 1));
+    SLEQP_CALL(write_values(trace, columns[j].name, 1, length));
+  }
+
+  return SLEQP_OKAY;
+}
+
+SLEQP_RETCODE
+sleqp_trace_create(SleqpTrace** star, const char* filename)
+{
+  SLEQP_CALL(sleqp_malloc(star));
+
+  SleqpTrace* trace = *star;
+
+  *trace = (SleqpTrace){0};
+
+  trace->refcount = 1;
+
+  SLEQP_CALL(sleqp_alloc_array(&trace->rows, ROWS_PER_BLOCK));
+  SLEQP_CALL(sleqp_alloc_array(&trace->double_values, ROWS_PER_BLOCK));
+  SLEQP_CALL(sleqp_alloc_array(&trace->int_values, ROWS_PER_BLOCK));
+
+  SLEQP_CALL(sleqp_timer_create(&trace->timer));
+  SLEQP_CALL(sleqp_timer_start(trace->timer));
+
+  trace->file = fopen(filename, "wb");
+
+  if (!trace->file)
+  {
+    sleqp_raise(SLEQP_ILLEGAL_ARGUMENT,
+                "Could not open trace file '%s'",
+                filename);
+  }
+
+  SLEQP_CALL(write_header(trace));
+
+  return SLEQP_OKAY;
+}
+
+SLEQP_RETCODE
+sleqp_trace_capture(SleqpTrace* trace)
+{
+  ++trace->refcount;
+
+  return SLEQP_OKAY;
+}
+
+double
+sleqp_trace_elapsed(SleqpTrace* trace)
+{
+  return sleqp_timer_elapsed(trace->timer);
+}
+
+static SLEQP_RETCODE
+write_column(SleqpTrace* trace, const Column* column)
+{
+  const int num_rows = trace->num_rows;
+
+  for (int i = 0; i < num_rows; ++i)
+  {
+    const char* row = (const char*)(trace->rows + i);
+
+    if (column->type == ColumnInt)
+    {
+      trace->int_values[i] = *(const int*)(row + column->offset);
+    }
+    else
+    {
+      trace->double_values[i] = *(const double*)(row + column->offset);
+    }
+  }
+
+  if (column->type == ColumnInt)
+  {
+    SLEQP_CALL(
+      write_values(trace, trace->int_values, sizeof(int32_t), num_rows));
+  }
+  else
+  {
+    SLEQP_CALL(
+      write_values(trace, trace->double_values, sizeof(double), num_rows));
+  }
+
+  return SLEQP_OKAY;
+}
+
+SLEQP_RETCODE
+sleqp_trace_flush(SleqpTrace* trace)
+{
+  if (trace->num_rows == 0)
+  {
+    return SLEQP_OKAY;
+  }
+
+  const int32_t num_rows = trace->num_rows;
+
+  SLEQP_CALL(write_values(trace, &num_rows, sizeof(int32_t), 1));
+
+  for (int j = 0; j < num_columns; ++j)
+  {
+    SLEQP_CALL(write_column(trace, columns + j));
+  }
+
+  trace->num_rows = 0;
+
+  if (fflush(trace->file) != 0)
+  {
+    sleqp_raise(SLEQP_INTERNAL_ERROR, "Failed to write trace file");
+  }
+
+  return SLEQP_OKAY;
+}
+
+SLEQP_RETCODE
+sleqp_trace_add_row(SleqpTrace* trace, const SleqpTraceRow* row)
+{
+  trace->rows[trace->num_rows++] = *row;
+
+  if (trace->num_rows == ROWS_PER_BLOCK)
+  {
+    SLEQP_CALL(sleqp_trace_flush(trace));
+  }
+
+  return SLEQP_OKAY;
+}
+
+static SLEQP_RETCODE
+trace_free(SleqpTrace** star)
+{
+  SleqpTrace* trace = *star;
+
+  if (!trace)
+  {
+    return SLEQP_OKAY;
+  }
+
+  SLEQP_RETCODE status = SLEQP_OKAY;
+
+  if (trace->file)
+  {
+    status = sleqp_trace_flush(trace);
+
+    fclose(trace->file);
+  }
+
+  SLEQP_CALL(sleqp_timer_free(&trace->timer));
+
+  sleqp_free(&trace->int_values);
+  sleqp_free(&trace->double_values);
+  sleqp_free(&trace->rows);
+
+  sleqp_free(star);
+
+  return status;
+}
+
+SLEQP_RETCODE
+sleqp_trace_release(SleqpTrace** star)
+{
+  SleqpTrace* trace = *star;
+
+  if (!trace)
+  {
+    return SLEQP_OKAY;
+  }
+
+  if (--trace->refcount == 0)
+  {
+    SLEQP_CALL(trace_free(star));
+  }
+
+  *star = NULL;
+
+  return SLEQP_OKAY;
+}
@@ -0,0 +1,101 @@
+#ifndef SLEQP_TRACE_H
+#define SLEQP_TRACE_H
+
+/**
+ * @file trace.h
+ * @brief Definition of per-iteration traces.
+ *
+ * A trace records one row per iteration in a binary columnar file.
+ * Rows are buffered in blocks of a fixed size, the memory and I/O
+ * overhead is therefore bounded independently of the number of
+ * iterations. All values are written in native byte order:
+ *
+ * - A header consisting of the magic string `SLEQPTRC`, the format
+ *   version and the number of columns as 32-bit integers,
+ *   followed by the type (0 for 32-bit integers, 1 for doubles)
+ *   and the length-prefixed name of each column, using one byte each
+ *   for type and length.
+ * - A sequence of blocks, each consisting of the number of rows
+ *   as a 32-bit integer, followed by the values of each column.
+ *
+ * Iteration traces are only recorded if `SLEQP_ENABLE_TRACE` is
+ * defined at compile time.
+ **/
+
+#include "types.h"
+
+#define SLEQP_TRACE_VERSION 1
+
+typedef struct SleqpTrace SleqpTrace;
+
+typedef struct
+{
+  int iteration;
+  int phase;
+  int step_type;
+  int boundary_step;
+  int num_active_vars;
+  int num_active_cons;
+
+  double obj_val;
+  double merit_val;
+  double feas_res;
+  double slack_res;
+  double stat_res;
+  double penalty_param;
+  double trust_radius;
+  double lp_trust_radius;
+  double primal_step;
+  double dual_step;
+
+  // Wall-clock times spent during the iteration
+  double func_time;
+  double lp_time;
+  double eqp_time;
+  double fact_time;
+  double linesearch_time;
+
+  // Wall-clock time since the creation of the trace
+  double elapsed;
+} SleqpTraceRow;
+
+/**
+ * Creates a new trace, truncating the given file
+ *
+ * @param[out] star      The trace
+ * @param[in]  filename  The name of the trace file
+ **/
+SLEQP_NODISCARD
+SLEQP_RETCODE
+sleqp_trace_create(SleqpTrace** star, const char* filename);
+
+SLEQP_NODISCARD
+SLEQP_RETCODE
+sleqp_trace_capture(SleqpTrace* trace);
+
+/**
+ * Returns the wall-clock time since the creation of the trace
+ **/
+double
+sleqp_trace_elapsed(SleqpTrace* trace);
+
+/**
+ * Appends a row to the trace, writing the buffered block
+ * once it is full
+ **/
+SLEQP_NODISCARD
+SLEQP_RETCODE
+sleqp_trace_add_row(SleqpTrace* trace, const SleqpTraceRow* row);
+
+/**
+ * Writes all buffered rows to the trace file
+ **/
+SLEQP_NODISCARD
+SLEQP_RETCODE
+sleqp_trace_flush(SleqpTrace* trace);
+
+SLEQP_NODISCARD
+SLEQP_RETCODE
+sleqp_trace_release(SleqpTrace** star);
+
+#endif /* SLEQP_TRACE_H */
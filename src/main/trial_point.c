@@ -506,6 +506,26 @@ sleqp_trial_point_solver_soc_step(SleqpTrialPointSolver* solver)
   return sleqp_direction_primal(solver->soc_direction);
 }
 
+int
+sleqp_trial_point_solver_lp_iterations(SleqpTrialPointSolver* solver)
+{
+  return sleqp_cauchy_lp_iterations(solver->cauchy_data);
+}
+
+SLEQP_RETCODE
+sleqp_trial_point_solver_copy_basis(const SleqpTrialPointSolver* source,
+                                    SleqpTrialPointSolver* target)
+{
+  if (!sleqp_cauchy_can_copy_basis(source->cauchy_data, target->cauchy_data))
+  {
+    return SLEQP_OKAY;
+  }
+
+  SLEQP_CALL(sleqp_cauchy_copy_basis(source->cauchy_data, target->cauchy_data));
+
+  return SLEQP_OKAY;
+}
+
 SLEQP_RETCODE
 sleqp_trial_point_solver_rayleigh(SleqpTrialPointSolver* solver,
                                   double* min_rayleigh,
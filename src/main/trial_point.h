@@ -161,6 +161,30 @@ SLEQP_RETCODE
 sleqp_trial_point_solver_print_stats(SleqpTrialPointSolver* solver,
                                      double elapsed_seconds);
 
+/**
+ * Adds the timing statistics of the trial point computations,
+ * indexed by @ref SLEQP_SOLVER_TIMING
+ **/
+SLEQP_NODISCARD
+SLEQP_RETCODE
+sleqp_trial_point_solver_add_timing_stats(SleqpTrialPointSolver* solver,
+                                          SleqpTimingStats* stats);
+
+/**
+ * Returns the total number of simplex iterations of the solved LPs
+ **/
+int
+sleqp_trial_point_solver_lp_iterations(SleqpTrialPointSolver* solver);
+
+/**
+ * Warm-starts the LPs of the target from the current basis of the source,
+ * provided that their Cauchy solvers support it
+ **/
+SLEQP_NODISCARD
+SLEQP_RETCODE
+sleqp_trial_point_solver_copy_basis(const SleqpTrialPointSolver* source,
+                                    SleqpTrialPointSolver* target);
+
 SLEQP_NODISCARD
 SLEQP_RETCODE
 sleqp_trial_point_solver_compute_cauchy_step(SleqpTrialPointSolver* solver,
@@ -395,6 +395,9 @@ sleqp_trial_point_solver_compute_cauchy_step(SleqpTrialPointSolver* solver,
 
   if (parametric_cauchy != SLEQP_PARAMETRIC_CAUCHY_DISABLED)
   {
+    SLEQP_CALL(sleqp_parametric_solver_set_time_limit(solver->parametric_solver,
+                                                      remaining_time));
+
     SLEQP_CALL(
       compute_cauchy_step_parametric(solver, cauchy_merit_value, full_step));
   }
@@ -24,3 +24,29 @@ sleqp_trial_point_solver_print_stats(SleqpTrialPointSolver* solver,
 
   return SLEQP_OKAY;
 }
+
+SLEQP_RETCODE
+sleqp_trial_point_solver_add_timing_stats(SleqpTrialPointSolver* solver,
+                                          SleqpTimingStats* stats)
+{
+  SLEQP_CALL(
+    sleqp_timer_add_stats(sleqp_aug_jac_creation_timer(solver->aug_jac),
+                          stats + SLEQP_SOLVER_TIMING_FACTORIZATION));
+
+  SLEQP_CALL(
+    sleqp_timer_add_stats(sleqp_aug_jac_solution_timer(solver->aug_jac),
+                          stats + SLEQP_SOLVER_TIMING_SUBSTITUTION));
+
+  SLEQP_CALL(
+    sleqp_timer_add_stats(sleqp_eqp_solver_get_timer(solver->eqp_solver),
+                          stats + SLEQP_SOLVER_TIMING_EQP));
+
+  SLEQP_CALL(sleqp_cauchy_lp_stats(solver->cauchy_data,
+                                   stats + SLEQP_SOLVER_TIMING_LP));
+
+  SLEQP_CALL(
+    sleqp_timer_add_stats(sleqp_linesearch_get_timer(solver->linesearch),
+                          stats + SLEQP_SOLVER_TIMING_LINESEARCH));
+
+  return SLEQP_OKAY;
+}
@@ -32,6 +32,14 @@ static const SleqpEnum deriv_check_enum
                  {"SecondCons", SLEQP_DERIV_CHECK_SECOND_CONS},
                  {NULL, 0}}};
 
+static const SleqpEnum deriv_check_sampling_enum
+  = {.name    = "DerivCheckSampling",
+     .flags   = false,
+     .entries = {{"None", SLEQP_DERIV_CHECK_SAMPLING_NONE},
+                 {"Coordinates", SLEQP_DERIV_CHECK_SAMPLING_COORDINATES},
+                 {"Directions", SLEQP_DERIV_CHECK_SAMPLING_DIRECTIONS},
+                 {NULL, 0}}};
+
 static const SleqpEnum hess_eval_enum
   = {.name    = "HessEval",
      .flags   = false,
@@ -122,6 +130,15 @@ static const SleqpEnum aug_jac_type_enum
                  {"Direct", SLEQP_AUG_JAC_DIRECT},
                  {NULL, 0}}};
 
+static const SleqpEnum tr_precond_enum
+  = {.name    = "TRPrecond",
+     .flags   = false,
+     .entries = {{"None", SLEQP_TR_PRECOND_NONE},
+                 {"Diagonal", SLEQP_TR_PRECOND_DIAGONAL},
+                 {"QuasiNewton", SLEQP_TR_PRECOND_QUASI_NEWTON},
+                 {"IncompleteCholesky", SLEQP_TR_PRECOND_INCOMPLETE_CHOLESKY},
+                 {NULL, 0}}};
+
 const SleqpEnum*
 sleqp_enum_active_state()
 {
@@ -140,6 +157,12 @@ sleqp_enum_deriv_check()
   return &deriv_check_enum;
 }
 
+const SleqpEnum*
+sleqp_enum_deriv_check_sampling()
+{
+  return &deriv_check_sampling_enum;
+}
+
 const SleqpEnum*
 sleqp_enum_hess_eval()
 {
@@ -205,3 +228,9 @@ sleqp_enum_aug_jac_method()
 {
   return &aug_jac_type_enum;
 }
+
+const SleqpEnum*
+sleqp_enum_tr_precond()
+{
+  return &tr_precond_enum;
+}
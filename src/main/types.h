@@ -21,6 +21,9 @@ sleqp_enum_status();
 const SleqpEnum*
 sleqp_enum_deriv_check();
 
+const SleqpEnum*
+sleqp_enum_deriv_check_sampling();
+
 const SleqpEnum*
 sleqp_enum_hess_eval();
 
@@ -54,4 +57,7 @@ sleqp_enum_step_rule();
 const SleqpEnum*
 sleqp_enum_aug_jac_method();
 
+const SleqpEnum*
+sleqp_enum_tr_precond();
+
 #endif /* SLEQP_TYPES_H */
@@ -0,0 +1,345 @@
+#include <check.h>
+#include <math.h>
+
+#include "aug_jac/standard_aug_jac.h"
+#include "cmp.h"
+#include "fact/fact.h"
+#include "mem.h"
+#include "util.h"
+#include "working_set.h"
+
+#include "test_common.h"
+#include "zero_func.h"
+
+const int num_variables   = 6;
+const int num_constraints = 4;
+
+const double tolerance = 1e-8;
+
+SleqpSettings* settings;
+SleqpFunc* func;
+SleqpProblem* problem;
+SleqpIterate* iterate;
+
+SleqpFact* updated_fact;
+SleqpAugJac* updated_jacobian;
+
+SleqpVec* primal_rhs;
+SleqpVec* primal_sol;
+SleqpVec* expected_primal_sol;
+
+void
+setup()
+{
+  ASSERT_CALL(sleqp_settings_create(&settings));
+
+  ASSERT_CALL(zero_func_create(&func, num_variables, 0));
+
+  SleqpVec* var_lb;
+  SleqpVec* var_ub;
+  SleqpVec* general_lb;
+  SleqpVec* general_ub;
+  SleqpVec* linear_lb;
+  SleqpVec* linear_ub;
+  SleqpVec* primal;
+
+  SleqpMat* linear_coeffs;
+
+  ASSERT_CALL(sleqp_vec_create_full(&var_lb, num_variables));
+  ASSERT_CALL(sleqp_vec_fill(var_lb, -10.));
+
+  ASSERT_CALL(sleqp_vec_create_full(&var_ub, num_variables));
+  ASSERT_CALL(sleqp_vec_fill(var_ub, 10.));
+
+  ASSERT_CALL(sleqp_vec_create_empty(&general_lb, 0));
+  ASSERT_CALL(sleqp_vec_create_empty(&general_ub, 0));
+
+  ASSERT_CALL(sleqp_vec_create_full(&linear_lb, num_constraints));
+  ASSERT_CALL(sleqp_vec_fill(linear_lb, -1.));
+
+  ASSERT_CALL(sleqp_vec_create_full(&linear_ub, num_constraints));
+  ASSERT_CALL(sleqp_vec_fill(linear_ub, 1.));
+
+  ASSERT_CALL(sleqp_vec_create_empty(&primal, num_variables));
+
+  ASSERT_CALL(sleqp_mat_create(&linear_coeffs,
+                               num_constraints,
+                               num_variables,
+                               num_constraints * num_variables));
+
+  for (int col = 0; col < num_variables; ++col)
+  {
+    ASSERT_CALL(sleqp_mat_push_col(linear_coeffs, col));
+
+    for (int row = 0; row < num_constraints; ++row)
+    {
+      if ((row + 2 * col) % 3 == 0)
+      {
+        continue;
+      }
+
+      ASSERT_CALL(sleqp_mat_push(linear_coeffs,
+                                 row,
+                                 col,
+                                 sin(1.7 * row + 3.1 * col * col + 0.3)));
+    }
+  }
+
+  ASSERT_CALL(sleqp_problem_create(&problem,
+                                   func,
+                                   var_lb,
+                                   var_ub,
+                                   general_lb,
+                                   general_ub,
+                                   linear_coeffs,
+                                   linear_lb,
+                                   linear_ub,
+                                   settings));
+
+  ASSERT_CALL(sleqp_iterate_create(&iterate, problem, primal));
+
+  ASSERT_CALL(
+    sleqp_set_and_evaluate(problem, iterate, SLEQP_VALUE_REASON_NONE, NULL));
+
+  ASSERT_CALL(sleqp_fact_create_default(&updated_fact, settings));
+
+  ASSERT_CALL(sleqp_standard_aug_jac_create(&updated_jacobian,
+                                            problem,
+                                            settings,
+                                            updated_fact));
+
+  ASSERT_CALL(sleqp_vec_create_full(&primal_rhs, num_variables));
+
+  for (int j = 0; j < num_variables; ++j)
+  {
+    ASSERT_CALL(sleqp_vec_push(primal_rhs, j, sin(3. * j + 1.)));
+  }
+
+  ASSERT_CALL(sleqp_vec_create_full(&primal_sol, num_variables));
+  ASSERT_CALL(sleqp_vec_create_full(&expected_primal_sol, num_variables));
+
+  ASSERT_CALL(sleqp_mat_release(&linear_coeffs));
+
+  ASSERT_CALL(sleqp_vec_free(&primal));
+
+  ASSERT_CALL(sleqp_vec_free(&linear_ub));
+  ASSERT_CALL(sleqp_vec_free(&linear_lb));
+  ASSERT_CALL(sleqp_vec_free(&general_ub));
+  ASSERT_CALL(sleqp_vec_free(&general_lb));
+  ASSERT_CALL(sleqp_vec_free(&var_ub));
+  ASSERT_CALL(sleqp_vec_free(&var_lb));
+}
+
+static void
+set_working_set(int num_vars, const int* vars, int num_cons, const int* cons)
+{
+  SleqpWorkingSet* working_set = sleqp_iterate_working_set(iterate);
+
+  ASSERT_CALL(sleqp_working_set_reset(working_set));
+
+  for (int k = 0; k < num_vars; ++k)
+  {
+    ASSERT_CALL(
+      sleqp_working_set_add_var(working_set, vars[k], SLEQP_ACTIVE_LOWER));
+  }
+
+  for (int k = 0; k < num_cons; ++k)
+  {
+    ASSERT_CALL(
+      sleqp_working_set_add_cons(working_set, cons[k], SLEQP_ACTIVE_UPPER));
+  }
+}
+
+// Compares the solutions of the updated system against a fresh factorization
+static void
+check_solutions()
+{
+  SleqpFact* fact;
+  SleqpAugJac* jacobian;
+
+  SleqpVec* dual_rhs;
+  SleqpVec* dual_sol;
+  SleqpVec* expected_dual_sol;
+
+  const int working_set_size
+    = sleqp_working_set_size(sleqp_iterate_working_set(iterate));
+
+  ASSERT_CALL(sleqp_fact_create_default(&fact, settings));
+
+  ASSERT_CALL(sleqp_standard_aug_jac_create(&jacobian, problem, settings, fact));
+
+  ASSERT_CALL(sleqp_aug_jac_set_iterate(updated_jacobian, iterate));
+  ASSERT_CALL(sleqp_aug_jac_set_iterate(jacobian, iterate));
+
+  ASSERT_CALL(sleqp_vec_create_full(&dual_rhs, working_set_size));
+  ASSERT_CALL(sleqp_vec_create_full(&dual_sol, working_set_size));
+  ASSERT_CALL(sleqp_vec_create_full(&expected_dual_sol, working_set_size));
+
+  for (int i = 0; i < working_set_size; ++i)
+  {
+    ASSERT_CALL(sleqp_vec_push(dual_rhs, i, cos(2. * i + .5)));
+  }
+
+  ASSERT_CALL(sleqp_aug_jac_solve_lsq(updated_jacobian, primal_rhs, dual_sol));
+  ASSERT_CALL(sleqp_aug_jac_solve_lsq(jacobian, primal_rhs, expected_dual_sol));
+
+  ck_assert(sleqp_vec_eq(dual_sol, expected_dual_sol, tolerance));
+
+  ASSERT_CALL(
+    sleqp_aug_jac_project_nullspace(updated_jacobian, primal_rhs, primal_sol));
+  ASSERT_CALL(
+    sleqp_aug_jac_project_nullspace(jacobian, primal_rhs, expected_primal_sol));
+
+  ck_assert(sleqp_vec_eq(primal_sol, expected_primal_sol, tolerance));
+
+  ASSERT_CALL(
+    sleqp_aug_jac_solve_min_norm(updated_jacobian, dual_rhs, primal_sol));
+  ASSERT_CALL(
+    sleqp_aug_jac_solve_min_norm(jacobian, dual_rhs, expected_primal_sol));
+
+  ck_assert(sleqp_vec_eq(primal_sol, expected_primal_sol, tolerance));
+
+  bool exact;
+  double condition;
+  double expected_condition;
+
+  ASSERT_CALL(sleqp_aug_jac_condition(updated_jacobian, &exact, &condition));
+  ASSERT_CALL(sleqp_aug_jac_condition(jacobian, &exact, &expected_condition));
+
+  // Estimates of the base matrix must not be reported for updates
+  ck_assert(condition == SLEQP_NONE || condition == expected_condition);
+
+  ASSERT_CALL(sleqp_vec_free(&expected_dual_sol));
+  ASSERT_CALL(sleqp_vec_free(&dual_sol));
+  ASSERT_CALL(sleqp_vec_free(&dual_rhs));
+
+  ASSERT_CALL(sleqp_aug_jac_release(&jacobian));
+
+  ASSERT_CALL(sleqp_fact_release(&fact));
+}
+
+START_TEST(test_added_rows)
+{
+  {
+    const int vars[] = {0};
+    const int cons[] = {0};
+
+    set_working_set(1, vars, 1, cons);
+    check_solutions();
+  }
+
+  {
+    const int vars[] = {0, 2};
+    const int cons[] = {0, 1, 3};
+
+    set_working_set(2, vars, 3, cons);
+    check_solutions();
+  }
+}
+END_TEST
+
+START_TEST(test_removed_rows)
+{
+  {
+    const int vars[] = {0, 1};
+    const int cons[] = {0, 1, 2};
+
+    set_working_set(2, vars, 3, cons);
+    check_solutions();
+  }
+
+  {
+    const int vars[] = {1};
+    const int cons[] = {2};
+
+    set_working_set(1, vars, 1, cons);
+    check_solutions();
+  }
+
+  {
+    set_working_set(0, NULL, 0, NULL);
+    check_solutions();
+  }
+}
+END_TEST
+
+START_TEST(test_exchanged_rows)
+{
+  {
+    const int vars[] = {0};
+    const int cons[] = {0, 1};
+
+    set_working_set(1, vars, 2, cons);
+    check_solutions();
+  }
+
+  {
+    const int vars[] = {2};
+    const int cons[] = {0, 2, 3};
+
+    set_working_set(1, vars, 3, cons);
+    check_solutions();
+  }
+
+  // Return to the base working set
+  {
+    const int vars[] = {0};
+    const int cons[] = {0, 1};
+
+    set_working_set(1, vars, 2, cons);
+    check_solutions();
+  }
+
+  // Too many changes, refactorization
+  {
+    const int vars[] = {1, 3, 4, 5};
+    const int cons[] = {2, 3};
+
+    set_working_set(4, vars, 2, cons);
+    check_solutions();
+  }
+}
+END_TEST
+
+void
+teardown()
+{
+  ASSERT_CALL(sleqp_vec_free(&expected_primal_sol));
+  ASSERT_CALL(sleqp_vec_free(&primal_sol));
+  ASSERT_CALL(sleqp_vec_free(&primal_rhs));
+
+  ASSERT_CALL(sleqp_aug_jac_release(&updated_jacobian));
+
+  ASSERT_CALL(sleqp_fact_release(&updated_fact));
+
+  ASSERT_CALL(sleqp_iterate_release(&iterate));
+
+  ASSERT_CALL(sleqp_problem_release(&problem));
+
+  ASSERT_CALL(sleqp_func_release(&func));
+
+  ASSERT_CALL(sleqp_settings_release(&settings));
+}
+
+Suite*
+aug_jac_update_test_suite()
+{
+  Suite* suite;
+  TCase* tc_update;
+
+  suite = suite_create("Augmented Jacobian update tests");
+
+  tc_update = tcase_create("Working set updates");
+
+  tcase_add_checked_fixture(tc_update, setup, teardown);
+
+  tcase_add_test(tc_update, test_added_rows);
+  tcase_add_test(tc_update, test_removed_rows);
+  tcase_add_test(tc_update, test_exchanged_rows);
+
+  suite_add_tcase(suite, tc_update);
+
+  return suite;
+}
+
+TEST_MAIN(aug_jac_update_test_suite)
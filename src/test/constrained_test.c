@@ -209,6 +209,107 @@ START_TEST(test_parametric_solve)
 }
 END_TEST
 
+START_TEST(test_speculative_parametric_solve)
+{
+  SleqpSolver* serial_solver;
+  SleqpSolver* solver;
+
+  ASSERT_CALL(sleqp_settings_set_enum_value(settings,
+                                           SLEQP_SETTINGS_ENUM_PARAMETRIC_CAUCHY,
+                                           SLEQP_PARAMETRIC_CAUCHY_FINE));
+
+  ASSERT_CALL(
+    sleqp_settings_set_int_value(settings, SLEQP_SETTINGS_INT_NUM_THREADS, 4));
+
+  ASSERT_CALL(sleqp_settings_set_bool_value(
+    settings,
+    SLEQP_SETTINGS_BOOL_SPECULATIVE_PARAMETRIC_CAUCHY,
+    false));
+
+  ASSERT_CALL(sleqp_solver_create(&serial_solver,
+                                  problem,
+                                  constrained_initial,
+                                  NULL));
+
+  ASSERT_CALL(sleqp_solver_solve(serial_solver, 1000, 60.));
+
+  ck_assert_int_eq(sleqp_solver_status(serial_solver), SLEQP_STATUS_OPTIMAL);
+
+  ASSERT_CALL(sleqp_settings_set_bool_value(
+    settings,
+    SLEQP_SETTINGS_BOOL_SPECULATIVE_PARAMETRIC_CAUCHY,
+    true));
+
+  ASSERT_CALL(sleqp_solver_create(&solver,
+                                  problem,
+                                  constrained_initial,
+                                  NULL));
+
+  ASSERT_CALL(sleqp_solver_solve(solver, 1000, 60.));
+
+  ck_assert_int_eq(sleqp_solver_status(solver), SLEQP_STATUS_OPTIMAL);
+
+  // Speculation must not change the search itself
+  ck_assert_int_eq(sleqp_solver_iterations(solver),
+                   sleqp_solver_iterations(serial_solver));
+
+  SleqpIterate* serial_iterate;
+  SleqpIterate* iterate;
+
+  ASSERT_CALL(sleqp_solver_solution(serial_solver, &serial_iterate));
+  ASSERT_CALL(sleqp_solver_solution(solver, &iterate));
+
+  ck_assert(sleqp_vec_eq(sleqp_iterate_primal(iterate),
+                         sleqp_iterate_primal(serial_iterate),
+                         1e-10));
+
+  ck_assert(
+    sleqp_vec_eq(sleqp_iterate_primal(iterate), constrained_optimum, 1e-6));
+
+  ASSERT_CALL(sleqp_solver_release(&solver));
+
+  ASSERT_CALL(sleqp_solver_release(&serial_solver));
+}
+END_TEST
+
+START_TEST(test_warm_start_lp_basis)
+{
+  SleqpSolver* cold_solver;
+  SleqpSolver* solver;
+
+  ASSERT_CALL(sleqp_solver_create(&cold_solver,
+                                  problem,
+                                  constrained_initial,
+                                  NULL));
+
+  ASSERT_CALL(sleqp_solver_solve(cold_solver, 1000, 60.));
+
+  ck_assert_int_eq(sleqp_solver_status(cold_solver), SLEQP_STATUS_OPTIMAL);
+
+  const int cold_lp_iterations = sleqp_solver_lp_iterations(cold_solver);
+
+  ck_assert_int_gt(cold_lp_iterations, 0);
+
+  ASSERT_CALL(sleqp_solver_create(&solver,
+                                  problem,
+                                  constrained_initial,
+                                  NULL));
+
+  ASSERT_CALL(sleqp_solver_warm_start(solver, cold_solver));
+
+  ASSERT_CALL(sleqp_solver_release(&cold_solver));
+
+  ASSERT_CALL(sleqp_solver_solve(solver, 1000, 60.));
+
+  // The first LP starts from the optimal basis of the source
+  ck_assert_int_lt(sleqp_solver_lp_iterations(solver), cold_lp_iterations);
+
+  ck_assert_int_eq(sleqp_solver_status(solver), SLEQP_STATUS_OPTIMAL);
+
+  ASSERT_CALL(sleqp_solver_release(&solver));
+}
+END_TEST
+
 START_TEST(test_sr1_solve)
 {
   ASSERT_CALL(sleqp_settings_set_enum_value(settings,
@@ -523,6 +624,10 @@ constrained_test_suite()
 
   tcase_add_test(tc_cons, test_parametric_solve);
 
+  tcase_add_test(tc_cons, test_speculative_parametric_solve);
+
+  tcase_add_test(tc_cons, test_warm_start_lp_basis);
+
   tcase_add_test(tc_cons, test_sr1_solve);
 
   tcase_add_test(tc_cons, test_bfgs_solve_no_sizing);
@@ -0,0 +1,352 @@
+#include "dense_quad_func.h"
+
+#include "mem.h"
+
+// Computes H d into the product buffer
+static void
+dense_quad_mult(DenseQuadData* data, const double* direction)
+{
+  const int num_variables = data->num_variables;
+
+  for (int i = 0; i < num_variables; ++i)
+  {
+    data->product[i] = 0.;
+
+    for (int j = 0; j < num_variables; ++j)
+    {
+      data->product[i] += data->hess_entry(i, j) * direction[j];
+    }
+  }
+}
+
+static SLEQP_RETCODE
+dense_quad_prod(DenseQuadData* data,
+                const double* direction,
+                double factor,
+                SleqpVec* product)
+{
+  const int num_variables = data->num_variables;
+
+  dense_quad_mult(data, direction);
+
+  for (int i = 0; i < num_variables; ++i)
+  {
+    data->product[i] *= factor;
+  }
+
+  SLEQP_CALL(
+    sleqp_vec_set_from_raw(product, data->product, num_variables, 0.));
+
+  return SLEQP_OKAY;
+}
+
+static double
+dense_quad_form(DenseQuadData* data)
+{
+  const int num_variables = data->num_variables;
+  const double* x         = data->x;
+
+  double value = 0.;
+
+  for (int i = 0; i < num_variables; ++i)
+  {
+    for (int j = 0; j < num_variables; ++j)
+    {
+      value += .5 * x[i] * data->hess_entry(i, j) * x[j];
+    }
+  }
+
+  return value;
+}
+
+// Factor of the Hessian of the Lagrangian
+static double
+lagrangian_factor(const SleqpVec* cons_duals)
+{
+  double factor = 1.;
+
+  for (int k = 0; k < cons_duals->nnz; ++k)
+  {
+    factor += cons_duals->data[k];
+  }
+
+  return factor;
+}
+
+static SLEQP_RETCODE
+dense_quad_set(SleqpFunc* func,
+               SleqpVec* value,
+               SLEQP_VALUE_REASON reason,
+               bool* reject,
+               void* func_data)
+{
+  DenseQuadData* data = (DenseQuadData*)func_data;
+
+  SLEQP_CALL(sleqp_vec_to_raw(value, data->x));
+
+  return SLEQP_OKAY;
+}
+
+static SLEQP_RETCODE
+dense_quad_nonzeros(SleqpFunc* func,
+                    int* obj_grad_nnz,
+                    int* cons_val_nnz,
+                    int* cons_jac_nnz,
+                    int* hess_prod_nnz,
+                    void* func_data)
+{
+  DenseQuadData* data = (DenseQuadData*)func_data;
+
+  *obj_grad_nnz  = data->num_variables;
+  *cons_val_nnz  = data->num_constraints;
+  *cons_jac_nnz  = data->num_variables * data->num_constraints;
+  *hess_prod_nnz = data->num_variables;
+
+  return SLEQP_OKAY;
+}
+
+static SLEQP_RETCODE
+dense_quad_obj_val(SleqpFunc* func, double* obj_val, void* func_data)
+{
+  DenseQuadData* data = (DenseQuadData*)func_data;
+
+  *obj_val = dense_quad_form(data);
+
+  for (int j = 0; j < data->num_variables; ++j)
+  {
+    *obj_val += data->linear * data->x[j];
+  }
+
+  return SLEQP_OKAY;
+}
+
+static SLEQP_RETCODE
+dense_quad_obj_grad(SleqpFunc* func, SleqpVec* obj_grad, void* func_data)
+{
+  DenseQuadData* data = (DenseQuadData*)func_data;
+
+  dense_quad_mult(data, data->x);
+
+  SLEQP_CALL(sleqp_vec_clear(obj_grad));
+  SLEQP_CALL(sleqp_vec_reserve(obj_grad, data->num_variables));
+
+  for (int j = 0; j < data->num_variables; ++j)
+  {
+    SLEQP_CALL(sleqp_vec_push(obj_grad,
+                              j,
+                              data->grad_factor
+                                * (data->product[j] + data->linear)));
+  }
+
+  return SLEQP_OKAY;
+}
+
+static SLEQP_RETCODE
+dense_quad_cons_val(SleqpFunc* func, SleqpVec* cons_val, void* func_data)
+{
+  DenseQuadData* data = (DenseQuadData*)func_data;
+
+  const double value = dense_quad_form(data);
+
+  SLEQP_CALL(sleqp_vec_clear(cons_val));
+  SLEQP_CALL(sleqp_vec_reserve(cons_val, data->num_constraints));
+
+  for (int i = 0; i < data->num_constraints; ++i)
+  {
+    SLEQP_CALL(sleqp_vec_push(cons_val, i, value));
+  }
+
+  return SLEQP_OKAY;
+}
+
+static SLEQP_RETCODE
+dense_quad_cons_jac(SleqpFunc* func, SleqpMat* cons_jac, void* func_data)
+{
+  DenseQuadData* data = (DenseQuadData*)func_data;
+
+  const int num_variables   = data->num_variables;
+  const int num_constraints = data->num_constraints;
+
+  dense_quad_mult(data, data->x);
+
+  SLEQP_CALL(sleqp_mat_reserve(cons_jac, num_variables * num_constraints));
+
+  for (int j = 0; j < num_variables; ++j)
+  {
+    SLEQP_CALL(sleqp_mat_push_col(cons_jac, j));
+
+    for (int i = 0; i < num_constraints; ++i)
+    {
+      SLEQP_CALL(sleqp_mat_push(cons_jac, i, j, data->product[j]));
+    }
+  }
+
+  return SLEQP_OKAY;
+}
+
+static SLEQP_RETCODE
+dense_quad_hess_prod(SleqpFunc* func,
+                     const SleqpVec* direction,
+                     const SleqpVec* cons_duals,
+                     SleqpVec* product,
+                     void* func_data)
+{
+  DenseQuadData* data = (DenseQuadData*)func_data;
+
+  ++data->num_single_calls;
+  ++data->num_products;
+
+  SLEQP_CALL(sleqp_vec_to_raw(direction, data->direction));
+
+  return dense_quad_prod(data,
+                         data->direction,
+                         lagrangian_factor(cons_duals),
+                         product);
+}
+
+static SLEQP_RETCODE
+dense_quad_hess_prods(SleqpFunc* func,
+                      const SleqpMat* directions,
+                      const SleqpVec* cons_duals,
+                      SleqpMat* products,
+                      void* func_data)
+{
+  DenseQuadData* data = (DenseQuadData*)func_data;
+
+  const int num_variables = data->num_variables;
+  const int num_cols      = sleqp_mat_num_cols(directions);
+
+  const int* cols      = sleqp_mat_cols(directions);
+  const int* rows      = sleqp_mat_rows(directions);
+  const double* values = sleqp_mat_data(directions);
+
+  const double factor = lagrangian_factor(cons_duals);
+
+  ++data->num_batch_calls;
+  data->num_products += num_cols;
+
+  SLEQP_CALL(sleqp_mat_reserve(products, num_cols * num_variables));
+
+  for (int col = 0; col < num_cols; ++col)
+  {
+    SLEQP_CALL(sleqp_mat_push_col(products, col));
+
+    for (int i = 0; i < num_variables; ++i)
+    {
+      double value = 0.;
+
+      for (int k = cols[col]; k < cols[col + 1]; ++k)
+      {
+        value += data->hess_entry(i, rows[k]) * values[k];
+      }
+
+      SLEQP_CALL(sleqp_mat_push(products, i, col, factor * value));
+    }
+  }
+
+  return SLEQP_OKAY;
+}
+
+static SLEQP_RETCODE
+dense_quad_free(void* func_data)
+{
+  DenseQuadData* data = (DenseQuadData*)func_data;
+
+  sleqp_free(&data->product);
+  sleqp_free(&data->direction);
+  sleqp_free(&data->x);
+
+  sleqp_free(&data);
+
+  return SLEQP_OKAY;
+}
+
+static SLEQP_RETCODE
+dense_quad_clone(SleqpFunc* func, SleqpFunc** clone, void* func_data)
+{
+  DenseQuadData* data = (DenseQuadData*)func_data;
+
+  ++data->num_clones;
+
+  SLEQP_CALL(dense_quad_func_create(clone,
+                                    data->num_variables,
+                                    data->num_constraints,
+                                    data->hess_entry,
+                                    data->linear));
+
+  dense_quad_func_data(*clone)->grad_factor = data->grad_factor;
+
+  return SLEQP_OKAY;
+}
+
+static SleqpFuncCallbacks dense_quad_callbacks
+  = {.set_value  = dense_quad_set,
+     .nonzeros   = dense_quad_nonzeros,
+     .obj_val    = dense_quad_obj_val,
+     .obj_grad   = dense_quad_obj_grad,
+     .cons_val   = dense_quad_cons_val,
+     .cons_jac   = dense_quad_cons_jac,
+     .hess_prod  = dense_quad_hess_prod,
+     .hess_prods = dense_quad_hess_prods,
+     .func_free  = dense_quad_free,
+     .clone      = dense_quad_clone};
+
+SLEQP_RETCODE
+dense_quad_func_create(SleqpFunc** star,
+                       int num_variables,
+                       int num_constraints,
+                       DENSE_QUAD_ENTRY hess_entry,
+                       double linear)
+{
+  DenseQuadData* data;
+
+  SLEQP_CALL(sleqp_malloc(&data));
+
+  *data = (DenseQuadData){.num_variables   = num_variables,
+                          .num_constraints = num_constraints,
+                          .hess_entry      = hess_entry,
+                          .linear          = linear,
+                          .grad_factor     = 1.};
+
+  SLEQP_CALL(sleqp_alloc_array(&data->x, num_variables));
+  SLEQP_CALL(sleqp_alloc_array(&data->direction, num_variables));
+  SLEQP_CALL(sleqp_alloc_array(&data->product, num_variables));
+
+  SLEQP_CALL(sleqp_func_create(star,
+                               &dense_quad_callbacks,
+                               num_variables,
+                               num_constraints,
+                               data));
+
+  return SLEQP_OKAY;
+}
+
+DenseQuadData*
+dense_quad_func_data(SleqpFunc* func)
+{
+  return (DenseQuadData*)sleqp_func_get_data(func);
+}
+
+SLEQP_RETCODE
+dense_quad_func_disable_batches(SleqpFunc* func)
+{
+  SleqpFuncCallbacks callbacks = dense_quad_callbacks;
+
+  callbacks.hess_prods = NULL;
+
+  SLEQP_CALL(sleqp_func_set_callbacks(func, &callbacks));
+
+  return SLEQP_OKAY;
+}
+
+SLEQP_RETCODE
+dense_quad_func_product(SleqpFunc* func,
+                        const SleqpVec* direction,
+                        SleqpVec* product)
+{
+  DenseQuadData* data = dense_quad_func_data(func);
+
+  SLEQP_CALL(sleqp_vec_to_raw(direction, data->direction));
+
+  return dense_quad_prod(data, data->direction, 1., product);
+}
@@ -0,0 +1,55 @@
+#ifndef DENSE_QUAD_FUNC_H
+#define DENSE_QUAD_FUNC_H
+
+#include "func.h"
+
+/*
+ * Quadratic objective f(x) = 1/2 x^T H x + c 1^T x with a dense Hessian H
+ * given entry-wise. Each constraint is given by c_i(x) = 1/2 x^T H x.
+ */
+typedef double (*DENSE_QUAD_ENTRY)(int i, int j);
+
+typedef struct
+{
+  int num_variables;
+  int num_constraints;
+
+  DENSE_QUAD_ENTRY hess_entry;
+  double linear;
+
+  // Factor applied to the returned objective gradients
+  double grad_factor;
+
+  double* x;
+  double* direction;
+  double* product;
+
+  // Number of directions multiplied by the Hessian
+  int num_products;
+
+  int num_single_calls;
+  int num_batch_calls;
+  int num_clones;
+} DenseQuadData;
+
+SLEQP_RETCODE
+dense_quad_func_create(SleqpFunc** star,
+                       int num_variables,
+                       int num_constraints,
+                       DENSE_QUAD_ENTRY hess_entry,
+                       double linear);
+
+DenseQuadData*
+dense_quad_func_data(SleqpFunc* func);
+
+// Removes the callback for batched Hessian products
+SLEQP_RETCODE
+dense_quad_func_disable_batches(SleqpFunc* func);
+
+// Computes H d without counting it as a Hessian product
+SLEQP_RETCODE
+dense_quad_func_product(SleqpFunc* func,
+                        const SleqpVec* direction,
+                        SleqpVec* product);
+
+#endif /* DENSE_QUAD_FUNC_H */
@@ -0,0 +1,244 @@
+#include <check.h>
+
+#include "deriv_check.h"
+#include "func.h"
+#include "problem.h"
+#include "thread_pool.h"
+#include "util.h"
+
+#include "dense_quad_func.h"
+#include "test_common.h"
+
+const int num_variables   = 100;
+const int num_constraints = 1;
+
+const int num_threads = 4;
+
+DenseQuadData* func_data;
+
+SleqpSettings* settings;
+SleqpFunc* func;
+SleqpProblem* problem;
+SleqpIterate* iterate;
+
+SleqpThreadPool* pool;
+SleqpThreadPool* previous_pool;
+
+/*
+ * f(x) = sum_j 1/2 (j + 1) x_j^2 + x_j,
+ * c(x) = sum_j 1/2 (j + 1) x_j^2
+ */
+static double
+hess_entry(int i, int j)
+{
+  return (i == j) ? (j + 1.) : 0.;
+}
+
+static void
+set_cons_dual()
+{
+  SleqpVec* cons_dual = sleqp_iterate_cons_dual(iterate);
+
+  ASSERT_CALL(sleqp_vec_clear(cons_dual));
+  ASSERT_CALL(sleqp_vec_reserve(cons_dual, 1));
+  ASSERT_CALL(sleqp_vec_push(cons_dual, 0, .5));
+}
+
+void
+setup()
+{
+  ASSERT_CALL(sleqp_settings_create(&settings));
+
+  ASSERT_CALL(dense_quad_func_create(&func,
+                                     num_variables,
+                                     num_constraints,
+                                     hess_entry,
+                                     1.));
+
+  func_data = dense_quad_func_data(func);
+
+  SleqpVec* var_lb;
+  SleqpVec* var_ub;
+  SleqpVec* cons_lb;
+  SleqpVec* cons_ub;
+  SleqpVec* primal;
+
+  ASSERT_CALL(sleqp_vec_create_full(&var_lb, num_variables));
+  ASSERT_CALL(sleqp_vec_fill(var_lb, -10.));
+
+  ASSERT_CALL(sleqp_vec_create_full(&var_ub, num_variables));
+  ASSERT_CALL(sleqp_vec_fill(var_ub, 10.));
+
+  ASSERT_CALL(sleqp_vec_create_full(&cons_lb, num_constraints));
+  ASSERT_CALL(sleqp_vec_fill(cons_lb, 0.));
+
+  ASSERT_CALL(sleqp_vec_create_full(&cons_ub, num_constraints));
+  ASSERT_CALL(sleqp_vec_fill(cons_ub, 1000.));
+
+  ASSERT_CALL(sleqp_vec_create_full(&primal, num_variables));
+  ASSERT_CALL(sleqp_vec_fill(primal, 1.));
+
+  ASSERT_CALL(sleqp_problem_create_simple(&problem,
+                                          func,
+                                          var_lb,
+                                          var_ub,
+                                          cons_lb,
+                                          cons_ub,
+                                          settings));
+
+  ASSERT_CALL(sleqp_iterate_create(&iterate, problem, primal));
+
+  ASSERT_CALL(
+    sleqp_set_and_evaluate(problem, iterate, SLEQP_VALUE_REASON_INIT, NULL));
+
+  set_cons_dual();
+
+  ASSERT_CALL(sleqp_thread_pool_create(&pool, num_threads));
+
+  previous_pool = sleqp_thread_pool_set_active(pool);
+
+  ASSERT_CALL(sleqp_vec_free(&primal));
+  ASSERT_CALL(sleqp_vec_free(&cons_ub));
+  ASSERT_CALL(sleqp_vec_free(&cons_lb));
+  ASSERT_CALL(sleqp_vec_free(&var_ub));
+  ASSERT_CALL(sleqp_vec_free(&var_lb));
+}
+
+static SLEQP_RETCODE
+perform_check(SLEQP_DERIV_CHECK_SAMPLING sampling, SLEQP_DERIV_CHECK flags)
+{
+  SleqpDerivChecker* deriv_checker;
+
+  ASSERT_CALL(
+    sleqp_settings_set_enum_value(settings,
+                                  SLEQP_SETTINGS_ENUM_DERIV_CHECK_SAMPLING,
+                                  sampling));
+
+  ASSERT_CALL(sleqp_deriv_checker_create(&deriv_checker, problem, settings));
+
+  const SLEQP_RETCODE status
+    = sleqp_deriv_check_perform(deriv_checker, iterate, flags);
+
+  ASSERT_CALL(sleqp_deriv_checker_free(&deriv_checker));
+
+  return status;
+}
+
+static void
+use_wrong_grad()
+{
+  func_data->grad_factor = 2.;
+
+  // Recompute the gradient at the iterate
+  ASSERT_CALL(
+    sleqp_set_and_evaluate(problem, iterate, SLEQP_VALUE_REASON_INIT, NULL));
+
+  set_cons_dual();
+}
+
+START_TEST(test_parallel_check)
+{
+  const SLEQP_DERIV_CHECK flags = SLEQP_DERIV_CHECK_FIRST
+                                  | SLEQP_DERIV_CHECK_SECOND_EXHAUSTIVE
+                                  | SLEQP_DERIV_CHECK_SECOND_SIMPLE;
+
+  ck_assert_int_eq(perform_check(SLEQP_DERIV_CHECK_SAMPLING_NONE, flags),
+                   SLEQP_OKAY);
+
+  ck_assert_int_eq(func_data->num_clones, num_threads - 1);
+}
+END_TEST
+
+START_TEST(test_serial_check)
+{
+  sleqp_thread_pool_set_active(NULL);
+
+  ck_assert_int_eq(perform_check(SLEQP_DERIV_CHECK_SAMPLING_NONE,
+                                 SLEQP_DERIV_CHECK_FIRST
+                                   | SLEQP_DERIV_CHECK_SECOND_SIMPLE),
+                   SLEQP_OKAY);
+
+  ck_assert_int_eq(func_data->num_clones, 0);
+}
+END_TEST
+
+START_TEST(test_sampled_coordinates)
+{
+  ck_assert_int_eq(perform_check(SLEQP_DERIV_CHECK_SAMPLING_COORDINATES,
+                                 SLEQP_DERIV_CHECK_FIRST
+                                   | SLEQP_DERIV_CHECK_SECOND_EXHAUSTIVE),
+                   SLEQP_OKAY);
+}
+END_TEST
+
+START_TEST(test_sampled_directions)
+{
+  ck_assert_int_eq(perform_check(SLEQP_DERIV_CHECK_SAMPLING_DIRECTIONS,
+                                 SLEQP_DERIV_CHECK_FIRST
+                                   | SLEQP_DERIV_CHECK_SECOND_EXHAUSTIVE
+                                   | SLEQP_DERIV_CHECK_SECOND_SIMPLE),
+                   SLEQP_OKAY);
+}
+END_TEST
+
+START_TEST(test_wrong_grad)
+{
+  sleqp_log_set_level(SLEQP_LOG_SILENT);
+
+  use_wrong_grad();
+
+  const SLEQP_DERIV_CHECK_SAMPLING samplings[]
+    = {SLEQP_DERIV_CHECK_SAMPLING_NONE,
+       SLEQP_DERIV_CHECK_SAMPLING_COORDINATES,
+       SLEQP_DERIV_CHECK_SAMPLING_DIRECTIONS};
+
+  for (int k = 0; k < 3; ++k)
+  {
+    ck_assert_int_eq(perform_check(samplings[k], SLEQP_DERIV_CHECK_FIRST_OBJ),
+                     SLEQP_ERROR);
+
+    ck_assert_int_eq(sleqp_error_type(), SLEQP_INVALID_DERIV);
+  }
+}
+END_TEST
+
+void
+teardown()
+{
+  sleqp_thread_pool_set_active(previous_pool);
+
+  ASSERT_CALL(sleqp_thread_pool_release(&pool));
+
+  ASSERT_CALL(sleqp_iterate_release(&iterate));
+
+  ASSERT_CALL(sleqp_problem_release(&problem));
+
+  ASSERT_CALL(sleqp_func_release(&func));
+
+  ASSERT_CALL(sleqp_settings_release(&settings));
+}
+
+Suite*
+deriv_check_test_suite()
+{
+  Suite* suite;
+  TCase* tc_check;
+
+  suite = suite_create("Derivative check tests");
+
+  tc_check = tcase_create("Derivative checks");
+
+  tcase_add_checked_fixture(tc_check, setup, teardown);
+
+  tcase_add_test(tc_check, test_parallel_check);
+  tcase_add_test(tc_check, test_serial_check);
+  tcase_add_test(tc_check, test_sampled_coordinates);
+  tcase_add_test(tc_check, test_sampled_directions);
+  tcase_add_test(tc_check, test_wrong_grad);
+
+  suite_add_tcase(suite, tc_check);
+
+  return suite;
+}
+
+TEST_MAIN(deriv_check_test_suite)
@@ -0,0 +1,178 @@
+#include <check.h>
+
+#include "cmp.h"
+#include "mem.h"
+
+#include "fact/fact.h"
+
+#include "test_common.h"
+
+typedef struct
+{
+  int num_analyses;
+  int num_refactors;
+} CountingData;
+
+static SLEQP_RETCODE
+counting_set_matrix(void* fact_data, SleqpMat* matrix)
+{
+  CountingData* data = (CountingData*)fact_data;
+
+  ++data->num_analyses;
+
+  return SLEQP_OKAY;
+}
+
+static SLEQP_RETCODE
+counting_refactor(void* fact_data, SleqpMat* matrix)
+{
+  CountingData* data = (CountingData*)fact_data;
+
+  ++data->num_refactors;
+
+  return SLEQP_OKAY;
+}
+
+static SLEQP_RETCODE
+counting_solve(void* fact_data, const SleqpVec* rhs)
+{
+  return SLEQP_OKAY;
+}
+
+static SLEQP_RETCODE
+counting_solution(void* fact_data,
+                  SleqpVec* sol,
+                  int begin,
+                  int end,
+                  double zero_eps)
+{
+  return SLEQP_OKAY;
+}
+
+static SLEQP_RETCODE
+counting_free(void** star)
+{
+  *star = NULL;
+
+  return SLEQP_OKAY;
+}
+
+SleqpSettings* settings;
+
+CountingData counting_data;
+
+SleqpFact* fact;
+
+SleqpMat* matrix;
+
+const int size = 4;
+
+void
+setup()
+{
+  ASSERT_CALL(sleqp_settings_create(&settings));
+
+  SleqpFactCallbacks callbacks = {.set_matrix = counting_set_matrix,
+                                  .refactor   = counting_refactor,
+                                  .solve      = counting_solve,
+                                  .solution   = counting_solution,
+                                  .condition  = NULL,
+                                  .free       = counting_free};
+
+  counting_data = (CountingData){0};
+
+  ASSERT_CALL(sleqp_fact_create(&fact,
+                                "counting",
+                                "",
+                                settings,
+                                &callbacks,
+                                SLEQP_FACT_FLAGS_NONE,
+                                (void*)&counting_data));
+
+  ASSERT_CALL(sleqp_mat_create(&matrix, size, size, size));
+
+  for (int col = 0; col < size; ++col)
+  {
+    ASSERT_CALL(sleqp_mat_push_col(matrix, col));
+    ASSERT_CALL(sleqp_mat_push(matrix, col, col, 1.));
+  }
+}
+
+START_TEST(test_refactor_same_pattern)
+{
+  ASSERT_CALL(sleqp_fact_set_matrix(fact, matrix));
+
+  ck_assert_int_eq(counting_data.num_analyses, 1);
+  ck_assert_int_eq(counting_data.num_refactors, 0);
+
+  ASSERT_CALL(sleqp_mat_scale(matrix, 2.));
+
+  ASSERT_CALL(sleqp_fact_set_matrix(fact, matrix));
+  ASSERT_CALL(sleqp_fact_set_matrix(fact, matrix));
+
+  ck_assert_int_eq(counting_data.num_analyses, 1);
+  ck_assert_int_eq(counting_data.num_refactors, 2);
+}
+END_TEST
+
+START_TEST(test_analyze_changed_pattern)
+{
+  ASSERT_CALL(sleqp_fact_set_matrix(fact, matrix));
+
+  // Same number of nonzeros, different rows
+  int* rows = sleqp_mat_rows(matrix);
+
+  rows[0] = 1;
+  rows[1] = 0;
+
+  ASSERT_CALL(sleqp_fact_set_matrix(fact, matrix));
+
+  ck_assert_int_eq(counting_data.num_analyses, 2);
+  ck_assert_int_eq(counting_data.num_refactors, 0);
+
+  // Additional nonzero
+  ASSERT_CALL(sleqp_mat_reserve(matrix, size + 1));
+  ASSERT_CALL(sleqp_mat_pop_col(matrix, size - 1));
+
+  ASSERT_CALL(sleqp_mat_push_col(matrix, size - 1));
+  ASSERT_CALL(sleqp_mat_push(matrix, 0, size - 1, 1.));
+  ASSERT_CALL(sleqp_mat_push(matrix, size - 1, size - 1, 1.));
+
+  ASSERT_CALL(sleqp_fact_set_matrix(fact, matrix));
+
+  ck_assert_int_eq(counting_data.num_analyses, 3);
+  ck_assert_int_eq(counting_data.num_refactors, 0);
+}
+END_TEST
+
+void
+teardown()
+{
+  ASSERT_CALL(sleqp_mat_release(&matrix));
+
+  ASSERT_CALL(sleqp_fact_release(&fact));
+
+  ASSERT_CALL(sleqp_settings_release(&settings));
+}
+
+Suite*
+fact_test_suite()
+{
+  Suite* suite;
+  TCase* tc_fact;
+
+  suite = suite_create("Factorization tests");
+
+  tc_fact = tcase_create("Symbolic factorization reuse");
+
+  tcase_add_checked_fixture(tc_fact, setup, teardown);
+
+  tcase_add_test(tc_fact, test_refactor_same_pattern);
+  tcase_add_test(tc_fact, test_analyze_changed_pattern);
+
+  suite_add_tcase(suite, tc_fact);
+
+  return suite;
+}
+
+TEST_MAIN(fact_test_suite)
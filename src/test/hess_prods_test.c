@@ -0,0 +1,207 @@
+#include <check.h>
+
+#include "deriv_check.h"
+#include "func.h"
+#include "problem.h"
+#include "util.h"
+
+#include "sparse/mat.h"
+
+#include "dense_quad_func.h"
+#include "test_common.h"
+
+// Large enough to require several blocks during derivative checks
+const int num_variables = 40;
+const int num_directions = 3;
+
+const double tolerance = 1e-8;
+
+DenseQuadData* func_data;
+
+SleqpSettings* settings;
+SleqpFunc* func;
+SleqpProblem* problem;
+SleqpIterate* iterate;
+
+SleqpMat* directions;
+SleqpMat* products;
+
+SleqpVec* direction;
+SleqpVec* product;
+SleqpVec* expected_product;
+
+// Hessian of the quadratic f(x) = 1/2 x^T H x
+static double
+hess_entry(int i, int j)
+{
+  return 1. / (1. + i + j);
+}
+
+void
+setup()
+{
+  ASSERT_CALL(sleqp_settings_create(&settings));
+
+  ASSERT_CALL(dense_quad_func_create(&func, num_variables, 0, hess_entry, 0.));
+
+  func_data = dense_quad_func_data(func);
+
+  SleqpVec* var_lb;
+  SleqpVec* var_ub;
+  SleqpVec* cons_lb;
+  SleqpVec* cons_ub;
+  SleqpVec* primal;
+
+  ASSERT_CALL(sleqp_vec_create_full(&var_lb, num_variables));
+  ASSERT_CALL(sleqp_vec_fill(var_lb, -10.));
+
+  ASSERT_CALL(sleqp_vec_create_full(&var_ub, num_variables));
+  ASSERT_CALL(sleqp_vec_fill(var_ub, 10.));
+
+  ASSERT_CALL(sleqp_vec_create_empty(&cons_lb, 0));
+  ASSERT_CALL(sleqp_vec_create_empty(&cons_ub, 0));
+
+  ASSERT_CALL(sleqp_vec_create_full(&primal, num_variables));
+  ASSERT_CALL(sleqp_vec_fill(primal, 1.));
+
+  ASSERT_CALL(sleqp_problem_create_simple(&problem,
+                                          func,
+                                          var_lb,
+                                          var_ub,
+                                          cons_lb,
+                                          cons_ub,
+                                          settings));
+
+  ASSERT_CALL(sleqp_iterate_create(&iterate, problem, primal));
+
+  ASSERT_CALL(
+    sleqp_set_and_evaluate(problem, iterate, SLEQP_VALUE_REASON_INIT, NULL));
+
+  ASSERT_CALL(sleqp_mat_create(&directions,
+                               num_variables,
+                               num_directions,
+                               num_directions * num_variables));
+
+  for (int col = 0; col < num_directions; ++col)
+  {
+    ASSERT_CALL(sleqp_mat_push_col(directions, col));
+
+    for (int row = col; row < num_variables; row += (col + 1))
+    {
+      ASSERT_CALL(sleqp_mat_push(directions, row, col, 1. + row - col));
+    }
+  }
+
+  ASSERT_CALL(sleqp_mat_create(&products, num_variables, num_directions, 0));
+
+  ASSERT_CALL(sleqp_vec_create_empty(&direction, num_variables));
+  ASSERT_CALL(sleqp_vec_create_empty(&product, num_variables));
+  ASSERT_CALL(sleqp_vec_create_empty(&expected_product, num_variables));
+
+  ASSERT_CALL(sleqp_vec_free(&primal));
+  ASSERT_CALL(sleqp_vec_free(&cons_ub));
+  ASSERT_CALL(sleqp_vec_free(&cons_lb));
+  ASSERT_CALL(sleqp_vec_free(&var_ub));
+  ASSERT_CALL(sleqp_vec_free(&var_lb));
+}
+
+static void
+check_products()
+{
+  SleqpVec* cons_duals = sleqp_iterate_cons_dual(iterate);
+
+  ASSERT_CALL(sleqp_func_hess_prods(func, directions, cons_duals, products));
+
+  ck_assert_int_eq(sleqp_mat_num_cols(products), num_directions);
+
+  for (int col = 0; col < num_directions; ++col)
+  {
+    ASSERT_CALL(sleqp_mat_col(directions, col, direction));
+    ASSERT_CALL(sleqp_mat_col(products, col, product));
+
+    ASSERT_CALL(dense_quad_func_product(func, direction, expected_product));
+
+    ck_assert(sleqp_vec_eq(product, expected_product, tolerance));
+  }
+}
+
+START_TEST(test_batched_products)
+{
+  check_products();
+
+  ck_assert_int_eq(func_data->num_batch_calls, 1);
+  ck_assert_int_eq(func_data->num_single_calls, 0);
+}
+END_TEST
+
+START_TEST(test_fallback_products)
+{
+  ASSERT_CALL(dense_quad_func_disable_batches(func));
+
+  check_products();
+
+  ck_assert_int_eq(func_data->num_batch_calls, 0);
+  ck_assert_int_eq(func_data->num_single_calls, num_directions);
+}
+END_TEST
+
+START_TEST(test_deriv_check)
+{
+  SleqpDerivChecker* deriv_checker;
+
+  ASSERT_CALL(sleqp_deriv_checker_create(&deriv_checker, problem, settings));
+
+  ASSERT_CALL(sleqp_deriv_check_perform(deriv_checker,
+                                        iterate,
+                                        SLEQP_DERIV_CHECK_SECOND_SIMPLE
+                                          | SLEQP_DERIV_CHECK_SECOND_OBJ));
+
+  // Two blocks for each kind of second order check
+  ck_assert_int_eq(func_data->num_batch_calls, 4);
+  ck_assert_int_eq(func_data->num_single_calls, 0);
+
+  ASSERT_CALL(sleqp_deriv_checker_free(&deriv_checker));
+}
+END_TEST
+
+void
+teardown()
+{
+  ASSERT_CALL(sleqp_vec_free(&expected_product));
+  ASSERT_CALL(sleqp_vec_free(&product));
+  ASSERT_CALL(sleqp_vec_free(&direction));
+
+  ASSERT_CALL(sleqp_mat_release(&products));
+  ASSERT_CALL(sleqp_mat_release(&directions));
+
+  ASSERT_CALL(sleqp_iterate_release(&iterate));
+
+  ASSERT_CALL(sleqp_problem_release(&problem));
+
+  ASSERT_CALL(sleqp_func_release(&func));
+
+  ASSERT_CALL(sleqp_settings_release(&settings));
+}
+
+Suite*
+hess_prods_test_suite()
+{
+  Suite* suite;
+  TCase* tc_prods;
+
+  suite = suite_create("Batched Hessian product tests");
+
+  tc_prods = tcase_create("Batched Hessian products");
+
+  tcase_add_checked_fixture(tc_prods, setup, teardown);
+
+  tcase_add_test(tc_prods, test_batched_products);
+  tcase_add_test(tc_prods, test_fallback_products);
+  tcase_add_test(tc_prods, test_deriv_check);
+
+  suite_add_tcase(suite, tc_prods);
+
+  return suite;
+}
+
+TEST_MAIN(hess_prods_test_suite)
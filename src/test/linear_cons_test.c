@@ -0,0 +1,338 @@
+#include <check.h>
+
+#include "cmp.h"
+#include "iterate.h"
+#include "mem.h"
+#include "problem.h"
+#include "util.h"
+
+#include "sparse/mat.h"
+
+#include "quadcons_fixture.h"
+#include "test_common.h"
+
+const int num_linear = 3;
+
+const double tolerance = 1e-10;
+
+SleqpSettings* settings;
+
+SleqpFunc* func;
+
+SleqpMat* linear_coeffs;
+SleqpVec* linear_lb;
+SleqpVec* linear_ub;
+
+SleqpProblem* problem;
+SleqpIterate* iterate;
+
+SleqpMat* general_jac;
+SleqpMat* expected_jac;
+
+SleqpVec* general_val;
+SleqpVec* linear_val;
+SleqpVec* expected_val;
+
+double* dense_cache;
+
+// Delegates to the fixture, additionally reporting the number of nonzeros
+static SLEQP_RETCODE
+func_set(SleqpFunc* f,
+         SleqpVec* value,
+         SLEQP_VALUE_REASON reason,
+         bool* reject,
+         void* func_data)
+{
+  return sleqp_func_set_value(quadconsfunc, value, reason, reject);
+}
+
+static SLEQP_RETCODE
+func_nonzeros(SleqpFunc* f,
+              int* obj_grad_nnz,
+              int* cons_val_nnz,
+              int* cons_jac_nnz,
+              int* hess_prod_nnz,
+              void* func_data)
+{
+  const int num_vars = quadconsfunc_num_variables;
+  const int num_cons = quadconsfunc_num_constraints;
+
+  *obj_grad_nnz  = num_vars;
+  *cons_val_nnz  = num_cons;
+  *cons_jac_nnz  = num_vars * num_cons;
+  *hess_prod_nnz = num_vars;
+
+  return SLEQP_OKAY;
+}
+
+static SLEQP_RETCODE
+func_obj_val(SleqpFunc* f, double* obj_val, void* func_data)
+{
+  return sleqp_func_obj_val(quadconsfunc, obj_val);
+}
+
+static SLEQP_RETCODE
+func_obj_grad(SleqpFunc* f, SleqpVec* obj_grad, void* func_data)
+{
+  return sleqp_func_obj_grad(quadconsfunc, obj_grad);
+}
+
+static SLEQP_RETCODE
+func_cons_val(SleqpFunc* f, SleqpVec* cons_val, void* func_data)
+{
+  return sleqp_func_cons_val(quadconsfunc, cons_val);
+}
+
+static SLEQP_RETCODE
+func_cons_jac(SleqpFunc* f, SleqpMat* cons_jac, void* func_data)
+{
+  return sleqp_func_cons_jac(quadconsfunc, cons_jac);
+}
+
+static SLEQP_RETCODE
+func_hess_prod(SleqpFunc* f,
+               const SleqpVec* direction,
+               const SleqpVec* cons_duals,
+               SleqpVec* product,
+               void* func_data)
+{
+  return sleqp_func_hess_prod(quadconsfunc, direction, cons_duals, product);
+}
+
+void
+setup()
+{
+  quadconsfunc_setup();
+
+  ASSERT_CALL(sleqp_settings_create(&settings));
+
+  const int num_vars = quadconsfunc_num_variables;
+  const int num_cons = quadconsfunc_num_constraints + num_linear;
+
+  ASSERT_CALL(
+    sleqp_mat_create(&linear_coeffs, num_linear, num_vars, 2 * num_linear));
+
+  // Dense first column, sparse second column
+  ASSERT_CALL(sleqp_mat_push_col(linear_coeffs, 0));
+
+  for (int i = 0; i < num_linear; ++i)
+  {
+    ASSERT_CALL(sleqp_mat_push(linear_coeffs, i, 0, 1. + i));
+  }
+
+  ASSERT_CALL(sleqp_mat_push_col(linear_coeffs, 1));
+  ASSERT_CALL(sleqp_mat_push(linear_coeffs, 1, 1, -1.));
+
+  ASSERT_CALL(sleqp_vec_create_full(&linear_lb, num_linear));
+  ASSERT_CALL(sleqp_vec_fill(linear_lb, -10.));
+
+  ASSERT_CALL(sleqp_vec_create_full(&linear_ub, num_linear));
+  ASSERT_CALL(sleqp_vec_fill(linear_ub, 10.));
+
+  SleqpFuncCallbacks callbacks = {.set_value = func_set,
+                                  .nonzeros  = func_nonzeros,
+                                  .obj_val   = func_obj_val,
+                                  .obj_grad  = func_obj_grad,
+                                  .cons_val  = func_cons_val,
+                                  .cons_jac  = func_cons_jac,
+                                  .hess_prod = func_hess_prod,
+                                  .func_free = NULL};
+
+  ASSERT_CALL(sleqp_func_create(&func,
+                                &callbacks,
+                                quadconsfunc_num_variables,
+                                quadconsfunc_num_constraints,
+                                NULL));
+
+  ASSERT_CALL(sleqp_problem_create(&problem,
+                                   func,
+                                   quadconsfunc_var_lb,
+                                   quadconsfunc_var_ub,
+                                   quadconsfunc_cons_lb,
+                                   quadconsfunc_cons_ub,
+                                   linear_coeffs,
+                                   linear_lb,
+                                   linear_ub,
+                                   settings));
+
+  ASSERT_CALL(sleqp_iterate_create(&iterate, problem, quadconsfunc_x));
+
+  ASSERT_CALL(sleqp_mat_create(&general_jac,
+                               quadconsfunc_num_constraints,
+                               num_vars,
+                               num_vars * quadconsfunc_num_constraints));
+
+  ASSERT_CALL(sleqp_mat_create(&expected_jac, num_cons, num_vars, 0));
+
+  ASSERT_CALL(sleqp_vec_create_full(&general_val,
+                                    quadconsfunc_num_constraints));
+  ASSERT_CALL(sleqp_vec_create_empty(&linear_val, num_linear));
+  ASSERT_CALL(sleqp_vec_create_empty(&expected_val, num_cons));
+
+  ASSERT_CALL(sleqp_alloc_array(&dense_cache, num_linear));
+}
+
+static void
+evaluate_at(double value)
+{
+  SleqpVec* primal = sleqp_iterate_primal(iterate);
+
+  ASSERT_CALL(sleqp_vec_fill(primal, value));
+
+  ASSERT_CALL(
+    sleqp_set_and_evaluate(problem, iterate, SLEQP_VALUE_REASON_NONE, NULL));
+}
+
+static void
+check_jac()
+{
+  ASSERT_CALL(sleqp_func_cons_jac(quadconsfunc, general_jac));
+
+  ASSERT_CALL(sleqp_mat_vstack(general_jac, linear_coeffs, expected_jac));
+
+  SleqpMat* cons_jac = sleqp_iterate_cons_jac(iterate);
+
+  ck_assert(sleqp_mat_is_valid(cons_jac));
+  ck_assert(sleqp_mat_eq(cons_jac, expected_jac, tolerance));
+}
+
+static void
+check_val()
+{
+  SleqpVec* primal = sleqp_iterate_primal(iterate);
+
+  ASSERT_CALL(sleqp_func_cons_val(quadconsfunc, general_val));
+
+  ASSERT_CALL(sleqp_mat_mult_vec(linear_coeffs, primal, dense_cache));
+
+  ASSERT_CALL(sleqp_vec_set_from_raw(linear_val, dense_cache, num_linear, 0.));
+
+  ASSERT_CALL(sleqp_vec_concat(general_val, linear_val, expected_val));
+
+  ck_assert(
+    sleqp_vec_eq(sleqp_iterate_cons_val(iterate), expected_val, tolerance));
+}
+
+START_TEST(test_repeated_evaluation)
+{
+  const double values[] = {0.25, 0.5, 0.75};
+
+  for (int k = 0; k < 3; ++k)
+  {
+    evaluate_at(values[k]);
+
+    check_jac();
+    check_val();
+  }
+}
+END_TEST
+
+START_TEST(test_modified_jac)
+{
+  evaluate_at(0.25);
+
+  SleqpMat* cons_jac = sleqp_iterate_cons_jac(iterate);
+
+  // Invalidates the stacked linear rows
+  ASSERT_CALL(sleqp_mat_clear(cons_jac));
+
+  evaluate_at(0.5);
+
+  check_jac();
+}
+END_TEST
+
+START_TEST(test_copied_jac)
+{
+  SleqpIterate* other_iterate;
+
+  ASSERT_CALL(sleqp_iterate_create(&other_iterate, problem, quadconsfunc_x));
+
+  evaluate_at(0.25);
+
+  ASSERT_CALL(sleqp_iterate_copy(iterate, other_iterate));
+
+  evaluate_at(0.5);
+
+  ASSERT_CALL(sleqp_iterate_copy(other_iterate, iterate));
+
+  evaluate_at(0.75);
+
+  check_jac();
+
+  ASSERT_CALL(sleqp_iterate_release(&other_iterate));
+}
+END_TEST
+
+START_TEST(test_updated_coeffs)
+{
+  evaluate_at(0.25);
+
+  double* data = sleqp_mat_data(linear_coeffs);
+
+  for (int k = 0; k < sleqp_mat_nnz(linear_coeffs); ++k)
+  {
+    data[k] *= 2.;
+  }
+
+  // Keeps the sparsity pattern, invalidating the stacked linear rows
+  ASSERT_CALL(sleqp_problem_set_linear_coeffs(problem, linear_coeffs));
+
+  evaluate_at(0.5);
+
+  check_jac();
+  check_val();
+}
+END_TEST
+
+void
+teardown()
+{
+  sleqp_free(&dense_cache);
+
+  ASSERT_CALL(sleqp_vec_free(&expected_val));
+  ASSERT_CALL(sleqp_vec_free(&linear_val));
+  ASSERT_CALL(sleqp_vec_free(&general_val));
+
+  ASSERT_CALL(sleqp_mat_release(&expected_jac));
+  ASSERT_CALL(sleqp_mat_release(&general_jac));
+
+  ASSERT_CALL(sleqp_iterate_release(&iterate));
+
+  ASSERT_CALL(sleqp_problem_release(&problem));
+
+  ASSERT_CALL(sleqp_func_release(&func));
+
+  ASSERT_CALL(sleqp_vec_free(&linear_ub));
+  ASSERT_CALL(sleqp_vec_free(&linear_lb));
+
+  ASSERT_CALL(sleqp_mat_release(&linear_coeffs));
+
+  ASSERT_CALL(sleqp_settings_release(&settings));
+
+  quadconsfunc_teardown();
+}
+
+Suite*
+linear_cons_test_suite()
+{
+  Suite* suite;
+  TCase* tc_linear_cons;
+
+  suite = suite_create("Linear constraint tests");
+
+  tc_linear_cons = tcase_create("Stacked constraint Jacobian");
+
+  tcase_add_checked_fixture(tc_linear_cons, setup, teardown);
+
+  tcase_add_test(tc_linear_cons, test_repeated_evaluation);
+  tcase_add_test(tc_linear_cons, test_modified_jac);
+  tcase_add_test(tc_linear_cons, test_copied_jac);
+  tcase_add_test(tc_linear_cons, test_updated_coeffs);
+
+  suite_add_tcase(suite, tc_linear_cons);
+
+  return suite;
+}
+
+TEST_MAIN(linear_cons_test_suite)
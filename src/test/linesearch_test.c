@@ -0,0 +1,375 @@
+#include <check.h>
+#include <stdlib.h>
+
+#include "cmp.h"
+#include "direction.h"
+#include "linesearch.h"
+#include "merit.h"
+#include "mem.h"
+
+#include "test_common.h"
+#include "zero_func.h"
+
+SleqpSettings* settings;
+
+#define NUM_CONSTRAINTS 4
+
+const int num_variables   = 1;
+const int num_constraints = NUM_CONSTRAINTS;
+
+const double penalty_parameter = 1.;
+const double trust_radius      = 10.;
+
+SleqpFunc* func;
+
+SleqpVec* var_lb;
+SleqpVec* var_ub;
+SleqpVec* cons_lb;
+SleqpVec* cons_ub;
+SleqpVec* primal;
+
+SleqpProblem* problem;
+SleqpIterate* iterate;
+
+SleqpVec* multipliers;
+
+SleqpDirection* cauchy_direction;
+SleqpDirection* newton_direction;
+SleqpDirection* trial_direction;
+
+SleqpMerit* merit;
+SleqpLineSearch* linesearch;
+
+void
+linesearch_setup()
+{
+  const double inf = sleqp_infinity();
+
+  ASSERT_CALL(sleqp_settings_create(&settings));
+
+  ASSERT_CALL(zero_func_create(&func, num_variables, num_constraints));
+
+  ASSERT_CALL(sleqp_vec_create_full(&var_lb, num_variables));
+  ASSERT_CALL(sleqp_vec_fill(var_lb, -inf));
+
+  ASSERT_CALL(sleqp_vec_create_full(&var_ub, num_variables));
+  ASSERT_CALL(sleqp_vec_fill(var_ub, inf));
+
+  ASSERT_CALL(sleqp_vec_create_full(&cons_lb, num_constraints));
+  ASSERT_CALL(sleqp_vec_fill(cons_lb, -inf));
+
+  ASSERT_CALL(sleqp_vec_create_empty(&cons_ub, num_constraints));
+
+  ASSERT_CALL(sleqp_vec_create_empty(&primal, num_variables));
+
+  ASSERT_CALL(sleqp_problem_create_simple(&problem,
+                                          func,
+                                          var_lb,
+                                          var_ub,
+                                          cons_lb,
+                                          cons_ub,
+                                          settings));
+
+  ASSERT_CALL(sleqp_iterate_create(&iterate, problem, primal));
+
+  ASSERT_CALL(sleqp_vec_create_empty(&multipliers, num_constraints));
+
+  ASSERT_CALL(sleqp_direction_create(&cauchy_direction, problem, settings));
+  ASSERT_CALL(sleqp_direction_create(&newton_direction, problem, settings));
+  ASSERT_CALL(sleqp_direction_create(&trial_direction, problem, settings));
+
+  ASSERT_CALL(sleqp_merit_create(&merit, problem, settings));
+
+  ASSERT_CALL(sleqp_linesearch_create(&linesearch, problem, settings, merit));
+}
+
+// Merit of the step alpha * d, where d = 1 with the given Jacobian product
+static double
+merit_value(const double* cons_vals,
+            const double* cons_jac,
+            double obj_grad,
+            double hess,
+            double alpha)
+{
+  double value = obj_grad * alpha + .5 * hess * alpha * alpha;
+
+  for (int i = 0; i < num_constraints; ++i)
+  {
+    value += penalty_parameter
+             * SLEQP_MAX(cons_vals[i] + alpha * cons_jac[i], 0.);
+  }
+
+  return value;
+}
+
+static int
+compare_points(const void* first, const void* second)
+{
+  const double first_point  = *((const double*)first);
+  const double second_point = *((const double*)second);
+
+  if (first_point < second_point)
+  {
+    return -1;
+  }
+  else if (first_point > second_point)
+  {
+    return 1;
+  }
+
+  return 0;
+}
+
+// Reference line search, scanning all sorted breakpoints in [0, 1]
+static void
+reference_linesearch(const double* cons_vals,
+                     const double* cons_jac,
+                     double obj_grad,
+                     double hess,
+                     double* min_alpha,
+                     double* min_value)
+{
+  double points[NUM_CONSTRAINTS + 2];
+  int num_points = 0;
+
+  points[num_points++] = 0.;
+  points[num_points++] = 1.;
+
+  for (int i = 0; i < num_constraints; ++i)
+  {
+    if (cons_jac[i] == 0.)
+    {
+      continue;
+    }
+
+    const double point = (-1.) * cons_vals[i] / cons_jac[i];
+
+    if (point >= 0. && point <= 1.)
+    {
+      points[num_points++] = point;
+    }
+  }
+
+  qsort(points, num_points, sizeof(double), compare_points);
+
+  *min_alpha = 0.;
+  *min_value = merit_value(cons_vals, cons_jac, obj_grad, hess, 0.);
+
+  for (int k = 0; k < num_points; ++k)
+  {
+    const double value
+      = merit_value(cons_vals, cons_jac, obj_grad, hess, points[k]);
+
+    if (value < *min_value)
+    {
+      *min_alpha = points[k];
+      *min_value = value;
+    }
+
+    if (k == 0 || hess <= 0. || points[k] == points[k - 1])
+    {
+      continue;
+    }
+
+    // The merit is quadratic between consecutive breakpoints
+    const double lower = points[k - 1];
+    const double upper = points[k];
+
+    const double lower_value
+      = merit_value(cons_vals, cons_jac, obj_grad, hess, lower);
+
+    const double slope = (value - lower_value) / (upper - lower)
+                         - .5 * hess * (upper + lower);
+
+    const double alpha = (-1.) * slope / hess;
+
+    if (lower < alpha && alpha < upper)
+    {
+      const double alpha_value
+        = merit_value(cons_vals, cons_jac, obj_grad, hess, alpha);
+
+      if (alpha_value < *min_value)
+      {
+        *min_alpha = alpha;
+        *min_value = alpha_value;
+      }
+    }
+  }
+}
+
+// Line search from a zero Cauchy step to a unit Newton step
+static void
+check_linesearch(double* cons_vals,
+                 double* cons_jac,
+                 double obj_grad,
+                 double hess,
+                 double expected_alpha)
+{
+  const double eps = sleqp_settings_real_value(settings, SLEQP_SETTINGS_REAL_EPS);
+
+  const double zero_eps
+    = sleqp_settings_real_value(settings, SLEQP_SETTINGS_REAL_ZERO_EPS);
+
+  ASSERT_CALL(sleqp_vec_set_from_raw(sleqp_iterate_cons_val(iterate),
+                                     cons_vals,
+                                     num_constraints,
+                                     zero_eps));
+
+  ASSERT_CALL(sleqp_vec_set_from_raw(sleqp_iterate_obj_grad(iterate),
+                                     &obj_grad,
+                                     num_variables,
+                                     zero_eps));
+
+  ASSERT_CALL(sleqp_direction_set_zero(cauchy_direction));
+
+  ASSERT_CALL(sleqp_vec_fill(sleqp_direction_primal(newton_direction), 1.));
+
+  *sleqp_direction_obj_grad(newton_direction) = obj_grad;
+
+  ASSERT_CALL(sleqp_vec_set_from_raw(sleqp_direction_cons_jac(newton_direction),
+                                     cons_jac,
+                                     num_constraints,
+                                     zero_eps));
+
+  ASSERT_CALL(sleqp_vec_set_from_raw(sleqp_direction_hess(newton_direction),
+                                     &hess,
+                                     num_variables,
+                                     zero_eps));
+
+  ASSERT_CALL(sleqp_linesearch_set_iterate(linesearch,
+                                           iterate,
+                                           penalty_parameter,
+                                           trust_radius));
+
+  double step_length, trial_value;
+
+  ASSERT_CALL(sleqp_linesearch_trial_step_exact(
+    linesearch,
+    cauchy_direction,
+    merit_value(cons_vals, cons_jac, obj_grad, hess, 0.),
+    newton_direction,
+    multipliers,
+    trial_direction,
+    &step_length,
+    &trial_value));
+
+  double reference_alpha, reference_value;
+
+  reference_linesearch(cons_vals,
+                       cons_jac,
+                       obj_grad,
+                       hess,
+                       &reference_alpha,
+                       &reference_value);
+
+  ck_assert(sleqp_is_eq(reference_alpha, expected_alpha, eps));
+
+  ck_assert(sleqp_is_eq(step_length, reference_alpha, eps));
+  ck_assert(sleqp_is_eq(trial_value, reference_value, eps));
+
+  ck_assert(sleqp_is_eq(sleqp_vec_value_at(sleqp_direction_primal(trial_direction),
+                                           0),
+                        reference_alpha,
+                        eps));
+}
+
+// Tied breakpoints at 0.2, minimizer at a convex breakpoint, where the scan
+// stops before reaching the final breakpoint
+START_TEST(test_tied_breakpoints)
+{
+  double cons_vals[] = {-.2, -.2, -.5, .3};
+  double cons_jac[]  = {1., 1., 1., -1.};
+
+  check_linesearch(cons_vals, cons_jac, -3., 1., .5);
+}
+END_TEST
+
+// Breakpoints added in decreasing order, tied at 0.4 and at the final
+// breakpoint 1, which is the minimizer
+START_TEST(test_last_breakpoint)
+{
+  double cons_vals[] = {-1., -.8, -.4, -.4};
+  double cons_jac[]  = {1., 1., 1., 1.};
+
+  check_linesearch(cons_vals, cons_jac, -5., 1., 1.);
+}
+END_TEST
+
+// Convex merit with its minimizer between breakpoints
+START_TEST(test_interior_minimizer)
+{
+  double cons_vals[] = {-.8, -.8, -.9, .1};
+  double cons_jac[]  = {1., 1., 1., -1.};
+
+  check_linesearch(cons_vals, cons_jac, -1., 2., .5);
+}
+END_TEST
+
+// Concave merit, scanning all breakpoints
+START_TEST(test_nonconvex_breakpoints)
+{
+  double cons_vals[] = {-.6, -.6, -.9, .1};
+  double cons_jac[]  = {1., 1., 2., -1.};
+
+  check_linesearch(cons_vals, cons_jac, .2, -1., .45);
+}
+END_TEST
+
+void
+linesearch_teardown()
+{
+  ASSERT_CALL(sleqp_linesearch_release(&linesearch));
+
+  ASSERT_CALL(sleqp_merit_release(&merit));
+
+  ASSERT_CALL(sleqp_direction_release(&trial_direction));
+  ASSERT_CALL(sleqp_direction_release(&newton_direction));
+  ASSERT_CALL(sleqp_direction_release(&cauchy_direction));
+
+  ASSERT_CALL(sleqp_vec_free(&multipliers));
+
+  ASSERT_CALL(sleqp_iterate_release(&iterate));
+
+  ASSERT_CALL(sleqp_problem_release(&problem));
+
+  ASSERT_CALL(sleqp_vec_free(&primal));
+
+  ASSERT_CALL(sleqp_vec_free(&cons_ub));
+  ASSERT_CALL(sleqp_vec_free(&cons_lb));
+
+  ASSERT_CALL(sleqp_vec_free(&var_ub));
+  ASSERT_CALL(sleqp_vec_free(&var_lb));
+
+  ASSERT_CALL(sleqp_func_release(&func));
+
+  ASSERT_CALL(sleqp_settings_release(&settings));
+}
+
+Suite*
+linesearch_test_suite()
+{
+  Suite* suite;
+  TCase* tc_linesearch;
+
+  suite = suite_create("Line search tests");
+
+  tc_linesearch = tcase_create("Exact line search");
+
+  tcase_add_checked_fixture(tc_linesearch,
+                            linesearch_setup,
+                            linesearch_teardown);
+
+  tcase_add_test(tc_linesearch, test_tied_breakpoints);
+
+  tcase_add_test(tc_linesearch, test_last_breakpoint);
+
+  tcase_add_test(tc_linesearch, test_interior_minimizer);
+
+  tcase_add_test(tc_linesearch, test_nonconvex_breakpoints);
+
+  suite_add_tcase(suite, tc_linesearch);
+
+  return suite;
+}
+
+TEST_MAIN(linesearch_test_suite)
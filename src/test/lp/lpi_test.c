@@ -132,6 +132,69 @@ START_TEST(test_basis_roundtrip)
 }
 END_TEST
 
+START_TEST(test_changed_coeffs)
+{
+  const double tolerance = 1e-8;
+
+  double solution[]      = {-1, -1};
+  double objective_value = 0;
+
+  ASSERT_CALL(sleqp_lpi_solve(lp_interface));
+
+  ASSERT_CALL(sleqp_lpi_primal_sol(lp_interface, &objective_value, solution));
+
+  ck_assert(sleqp_is_eq(solution[0], 1., tolerance));
+
+  double* cons_data = sleqp_mat_data(cons_matrix);
+
+  // Same pattern, with the second coefficient becoming zero
+  cons_data[0] = 2;
+  cons_data[1] = 0;
+
+  ASSERT_CALL(
+    sleqp_lpi_change_coeffs(lp_interface, cons_matrix, num_variables));
+
+  ASSERT_CALL(sleqp_lpi_solve(lp_interface));
+
+  ASSERT_CALL(sleqp_lpi_primal_sol(lp_interface, &objective_value, solution));
+
+  ck_assert(sleqp_is_eq(objective_value, -.5, tolerance));
+
+  ck_assert(sleqp_is_eq(solution[0], .5, tolerance));
+  ck_assert(sleqp_is_eq(solution[1], 0., tolerance));
+
+  // Zero coefficients must be restored as well
+  cons_data[0] = 1;
+  cons_data[1] = 1;
+
+  ASSERT_CALL(
+    sleqp_lpi_change_coeffs(lp_interface, cons_matrix, num_variables));
+
+  ASSERT_CALL(sleqp_lpi_solve(lp_interface));
+
+  ASSERT_CALL(sleqp_lpi_primal_sol(lp_interface, &objective_value, solution));
+
+  ck_assert(sleqp_is_eq(objective_value, -1., tolerance));
+
+  ck_assert(sleqp_is_eq(solution[0], 1., tolerance));
+  ck_assert(sleqp_is_eq(solution[1], 0., tolerance));
+
+  // Only the leading column changes
+  cons_data[0] = .5;
+
+  ASSERT_CALL(sleqp_lpi_change_coeffs(lp_interface, cons_matrix, 1));
+
+  ASSERT_CALL(sleqp_lpi_solve(lp_interface));
+
+  ASSERT_CALL(sleqp_lpi_primal_sol(lp_interface, &objective_value, solution));
+
+  ck_assert(sleqp_is_eq(objective_value, -2., tolerance));
+
+  ck_assert(sleqp_is_eq(solution[0], 2., tolerance));
+  ck_assert(sleqp_is_eq(solution[1], 0., tolerance));
+}
+END_TEST
+
 Suite*
 lpi_suite()
 {
@@ -146,6 +209,7 @@ lpi_suite()
 
   tcase_add_test(tc_solve, test_solve);
   tcase_add_test(tc_solve, test_basis_roundtrip);
+  tcase_add_test(tc_solve, test_changed_coeffs);
 
   suite_add_tcase(suite, tc_solve);
 
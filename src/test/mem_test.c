@@ -1,12 +1,18 @@
+#include <check.h>
 #include <limits.h>
 #include <stdlib.h>
 
-#include <check.h>
-
 #include "mem.h"
+#include "mem_pool.h"
+#include "solver.h"
 
 #include "test_common.h"
 
+#include "rosenbrock_fixture.h"
+
+#define MAX_NUM_ITERATIONS 100
+#define NUM_WARMUP_SOLVES 2
+
 START_TEST(test_alloc)
 {
   int* ptr;
@@ -96,12 +102,290 @@ END_TEST
   END_TEST
 */
 
+// Forwards to the C library, counting allocations
+typedef struct
+{
+  int num_allocations;
+  int num_blocks;
+  size_t num_bytes;
+} CountingData;
+
+static void*
+counting_allocate(size_t size, void* allocator_data)
+{
+  CountingData* data = (CountingData*)allocator_data;
+
+  ++data->num_allocations;
+  ++data->num_blocks;
+  data->num_bytes += size;
+
+  return malloc(size);
+}
+
+static void*
+counting_reallocate(void* ptr, size_t size, size_t new_size, void* allocator_data)
+{
+  CountingData* data = (CountingData*)allocator_data;
+
+  ++data->num_allocations;
+  data->num_bytes += new_size;
+  data->num_bytes -= size;
+
+  return realloc(ptr, new_size);
+}
+
+static void
+counting_deallocate(void* ptr, size_t size, void* allocator_data)
+{
+  CountingData* data = (CountingData*)allocator_data;
+
+  --data->num_blocks;
+  data->num_bytes -= size;
+
+  free(ptr);
+}
+
+CountingData counting_data;
+SleqpAllocator* counting_allocator;
+
+void
+setup()
+{
+  rosenbrock_setup();
+
+  counting_data = (CountingData){0};
+
+  SleqpAllocatorCallbacks callbacks
+    = {.allocate   = counting_allocate,
+       .reallocate = counting_reallocate,
+       .deallocate = counting_deallocate,
+       .free       = NULL};
+
+  ASSERT_CALL(
+    sleqp_allocator_create(&counting_allocator, &callbacks, &counting_data));
+}
+
+START_TEST(test_ownership)
+{
+  double* values;
+
+  SleqpAllocator* previous = sleqp_allocator_set_active(counting_allocator);
+
+  ASSERT_CALL(sleqp_alloc_array(&values, 10));
+
+  ck_assert_int_eq(counting_data.num_blocks, 1);
+
+  sleqp_allocator_set_active(previous);
+
+  // Resizing moves the block to the active allocator
+  ASSERT_CALL(sleqp_realloc(&values, 20));
+
+  ck_assert_int_eq(counting_data.num_blocks, 0);
+
+  sleqp_allocator_set_active(counting_allocator);
+
+  ASSERT_CALL(sleqp_realloc(&values, 30));
+
+  ck_assert_int_eq(counting_data.num_blocks, 1);
+
+  sleqp_allocator_set_active(previous);
+
+  // Blocks are returned to their allocator
+  sleqp_free(&values);
+
+  ck_assert_int_eq(counting_data.num_blocks, 0);
+}
+END_TEST
+
+START_TEST(test_pool_reuse)
+{
+  SleqpAllocator* pool;
+
+  SleqpAllocator* previous = sleqp_allocator_set_active(counting_allocator);
+
+  ASSERT_CALL(sleqp_mem_pool_create(&pool));
+
+  sleqp_allocator_set_active(pool);
+
+  double* first;
+  int* second;
+
+  ASSERT_CALL(sleqp_alloc_array(&first, 100));
+  ASSERT_CALL(sleqp_alloc_array(&second, 10));
+
+  const int num_allocations = counting_data.num_allocations;
+
+  double* first_ptr = first;
+
+  sleqp_free(&first);
+  sleqp_free(&second);
+
+  // Blocks are retained by the pool and handed out again
+  ASSERT_CALL(sleqp_alloc_array(&first, 90));
+  ASSERT_CALL(sleqp_alloc_array(&second, 10));
+
+  ck_assert_ptr_eq(first, first_ptr);
+
+  // Resizing within the size class keeps the block
+  ASSERT_CALL(sleqp_realloc(&first, 100));
+
+  ck_assert_ptr_eq(first, first_ptr);
+
+  ck_assert_int_eq(counting_data.num_allocations, num_allocations);
+
+  sleqp_allocator_set_active(previous);
+
+  ASSERT_CALL(sleqp_allocator_release(&pool));
+
+  // The pool is kept alive by its remaining blocks
+  ck_assert(counting_data.num_blocks > 0);
+
+  sleqp_free(&first);
+  sleqp_free(&second);
+}
+END_TEST
+
+// Block headers do not double the size of power-of-two arrays
+START_TEST(test_pool_power_of_two)
+{
+  SleqpAllocator* pool;
+
+  SleqpAllocator* previous = sleqp_allocator_set_active(counting_allocator);
+
+  ASSERT_CALL(sleqp_mem_pool_create(&pool));
+
+  sleqp_allocator_set_active(pool);
+
+  const int size = 512;
+
+  double* values;
+
+  const size_t num_bytes = counting_data.num_bytes;
+
+  ASSERT_CALL(sleqp_alloc_array(&values, size));
+
+  ck_assert_int_lt(counting_data.num_bytes - num_bytes,
+                   2 * size * sizeof(double));
+
+  sleqp_free(&values);
+
+  sleqp_allocator_set_active(previous);
+
+  ASSERT_CALL(sleqp_allocator_release(&pool));
+
+  ck_assert_int_eq(counting_data.num_blocks, 0);
+}
+END_TEST
+
+// Shrunk blocks are returned to the class they were taken from
+START_TEST(test_pool_shrink)
+{
+  SleqpAllocator* pool;
+
+  SleqpAllocator* previous = sleqp_allocator_set_active(counting_allocator);
+
+  ASSERT_CALL(sleqp_mem_pool_create(&pool));
+
+  sleqp_allocator_set_active(pool);
+
+  double* values;
+
+  ASSERT_CALL(sleqp_alloc_array(&values, 512));
+
+  double* values_ptr = values;
+
+  ASSERT_CALL(sleqp_realloc(&values, 8));
+
+  sleqp_free(&values);
+
+  const int num_allocations = counting_data.num_allocations;
+
+  ASSERT_CALL(sleqp_alloc_array(&values, 512));
+
+  ck_assert_ptr_eq(values, values_ptr);
+
+  ck_assert_int_eq(counting_data.num_allocations, num_allocations);
+
+  sleqp_free(&values);
+
+  sleqp_allocator_set_active(previous);
+
+  ASSERT_CALL(sleqp_allocator_release(&pool));
+
+  ck_assert_int_eq(counting_data.num_blocks, 0);
+}
+END_TEST
+
+START_TEST(test_solver_steady_state)
+{
+  SleqpSettings* settings;
+  SleqpProblem* problem;
+  SleqpSolver* solver;
+
+  SleqpAllocator* previous = sleqp_allocator_set_active(counting_allocator);
+
+  ASSERT_CALL(sleqp_settings_create(&settings));
+
+  ASSERT_CALL(sleqp_problem_create_simple(&problem,
+                                          rosenbrock_func,
+                                          rosenbrock_var_lb,
+                                          rosenbrock_var_ub,
+                                          rosenbrock_cons_lb,
+                                          rosenbrock_cons_ub,
+                                          settings));
+
+  ASSERT_CALL(sleqp_solver_create(&solver,
+                                  problem,
+                                  rosenbrock_initial,
+                                  NULL));
+
+  // Warm up the pool. Solves restart from the initial point, the first
+  // one additionally sets up state retained by the solver
+  for (int solve = 0; solve < NUM_WARMUP_SOLVES; ++solve)
+  {
+    ASSERT_CALL(sleqp_solver_solve(solver, MAX_NUM_ITERATIONS, -1));
+
+    ck_assert_int_eq(sleqp_solver_status(solver), SLEQP_STATUS_OPTIMAL);
+  }
+
+  const int num_allocations = counting_data.num_allocations;
+
+  ASSERT_CALL(sleqp_solver_solve(solver, MAX_NUM_ITERATIONS, -1));
+
+  ck_assert_int_eq(sleqp_solver_status(solver), SLEQP_STATUS_OPTIMAL);
+
+  ck_assert_int_gt(sleqp_solver_iterations(solver), 0);
+
+  // All iterations are served from the pool of the solver
+  ck_assert_int_eq(counting_data.num_allocations, num_allocations);
+
+  sleqp_allocator_set_active(previous);
+
+  ASSERT_CALL(sleqp_solver_release(&solver));
+
+  ASSERT_CALL(sleqp_problem_release(&problem));
+
+  ASSERT_CALL(sleqp_settings_release(&settings));
+
+  ck_assert_int_eq(counting_data.num_blocks, 0);
+}
+END_TEST
+
+void
+teardown()
+{
+  ASSERT_CALL(sleqp_allocator_release(&counting_allocator));
+
+  rosenbrock_teardown();
+}
+
 Suite*
 mem_test_suite()
 {
   Suite* suite;
   TCase* tc_alloc;
   TCase* tc_realloc;
+  TCase* tc_allocator;
 
   suite = suite_create("Memory tests");
 
@@ -121,10 +405,26 @@ mem_test_suite()
 
   // tcase_add_test(tc_alloc, test_realloc_nomem);
 
+  tc_allocator = tcase_create("Allocators");
+
+  tcase_add_checked_fixture(tc_allocator, setup, teardown);
+
+  tcase_add_test(tc_allocator, test_ownership);
+
+  tcase_add_test(tc_allocator, test_pool_reuse);
+
+  tcase_add_test(tc_allocator, test_pool_power_of_two);
+
+  tcase_add_test(tc_allocator, test_pool_shrink);
+
+  tcase_add_test(tc_allocator, test_solver_steady_state);
+
   suite_add_tcase(suite, tc_alloc);
 
   suite_add_tcase(suite, tc_realloc);
 
+  suite_add_tcase(suite, tc_allocator);
+
   return suite;
 }
 
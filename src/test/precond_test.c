@@ -0,0 +1,546 @@
+#include <check.h>
+#include <math.h>
+
+#include "aug_jac/standard_aug_jac.h"
+#include "cmp.h"
+#include "fact/fact.h"
+#include "precond/precond.h"
+#include "tr/steihaug_solver.h"
+#include "util.h"
+#include "working_set.h"
+
+#include "dense_quad_func.h"
+#include "test_common.h"
+
+const int num_variables = 6;
+
+const double tolerance = 1e-8;
+
+SleqpSettings* settings;
+SleqpFunc* func;
+SleqpProblem* problem;
+SleqpIterate* iterate;
+
+SleqpFact* fact;
+SleqpAugJac* jacobian;
+
+SleqpVec* direction;
+SleqpVec* product;
+SleqpVec* result;
+
+// Entries across blocks of this size vanish
+int block_size;
+
+/*
+ * Badly scaled tridiagonal quadratic f(x) = 1/2 x^T D T D x + 1^T x,
+ * where T = tridiag(-1, 4, -1) and D = diag(10^(j/2))
+ */
+static double
+scale(int j)
+{
+  return pow(10., .5 * j);
+}
+
+static double
+hess_entry(int i, int j)
+{
+  if (i / block_size != j / block_size)
+  {
+    return 0.;
+  }
+
+  if (i == j)
+  {
+    return 4. * scale(i) * scale(j);
+  }
+  else if (abs(i - j) == 1)
+  {
+    return -scale(i) * scale(j);
+  }
+
+  return 0.;
+}
+
+// Number of Hessian products computed
+static int
+num_products()
+{
+  return dense_quad_func_data(func)->num_products;
+}
+
+void
+setup()
+{
+  ASSERT_CALL(sleqp_settings_create(&settings));
+
+  block_size = num_variables;
+
+  ASSERT_CALL(dense_quad_func_create(&func, num_variables, 0, hess_entry, 1.));
+
+  SleqpVec* var_lb;
+  SleqpVec* var_ub;
+  SleqpVec* cons_lb;
+  SleqpVec* cons_ub;
+  SleqpVec* primal;
+
+  ASSERT_CALL(sleqp_vec_create_full(&var_lb, num_variables));
+  ASSERT_CALL(sleqp_vec_fill(var_lb, -100.));
+
+  ASSERT_CALL(sleqp_vec_create_full(&var_ub, num_variables));
+  ASSERT_CALL(sleqp_vec_fill(var_ub, 100.));
+
+  ASSERT_CALL(sleqp_vec_create_empty(&cons_lb, 0));
+  ASSERT_CALL(sleqp_vec_create_empty(&cons_ub, 0));
+
+  ASSERT_CALL(sleqp_vec_create_empty(&primal, num_variables));
+
+  ASSERT_CALL(sleqp_problem_create_simple(&problem,
+                                          func,
+                                          var_lb,
+                                          var_ub,
+                                          cons_lb,
+                                          cons_ub,
+                                          settings));
+
+  ASSERT_CALL(sleqp_iterate_create(&iterate, problem, primal));
+
+  ASSERT_CALL(
+    sleqp_set_and_evaluate(problem, iterate, SLEQP_VALUE_REASON_INIT, NULL));
+
+  ASSERT_CALL(sleqp_working_set_reset(sleqp_iterate_working_set(iterate)));
+
+  ASSERT_CALL(sleqp_fact_create_default(&fact, settings));
+
+  ASSERT_CALL(
+    sleqp_standard_aug_jac_create(&jacobian, problem, settings, fact));
+
+  ASSERT_CALL(sleqp_aug_jac_set_iterate(jacobian, iterate));
+
+  ASSERT_CALL(sleqp_vec_create_full(&direction, num_variables));
+  ASSERT_CALL(sleqp_vec_create_full(&product, num_variables));
+  ASSERT_CALL(sleqp_vec_create_full(&result, num_variables));
+
+  ASSERT_CALL(sleqp_vec_free(&primal));
+  ASSERT_CALL(sleqp_vec_free(&cons_ub));
+  ASSERT_CALL(sleqp_vec_free(&cons_lb));
+  ASSERT_CALL(sleqp_vec_free(&var_ub));
+  ASSERT_CALL(sleqp_vec_free(&var_lb));
+}
+
+static void
+create_precond(SleqpPrecond** precond, SLEQP_TR_PRECOND type)
+{
+  ASSERT_CALL(sleqp_settings_set_enum_value(settings,
+                                            SLEQP_SETTINGS_ENUM_TR_PRECOND,
+                                            type));
+
+  ASSERT_CALL(sleqp_precond_create_default(precond, problem, settings));
+
+  ck_assert_ptr_nonnull(*precond);
+
+  ASSERT_CALL(
+    sleqp_precond_update(*precond, sleqp_iterate_cons_dual(iterate)));
+}
+
+static void
+fill_direction(int offset)
+{
+  ASSERT_CALL(sleqp_vec_clear(direction));
+
+  for (int j = 0; j < num_variables; ++j)
+  {
+    ASSERT_CALL(sleqp_vec_push(direction, j, sin(j + offset + 1.)));
+  }
+}
+
+START_TEST(test_no_precond)
+{
+  SleqpPrecond* precond;
+
+  ASSERT_CALL(sleqp_settings_set_enum_value(settings,
+                                            SLEQP_SETTINGS_ENUM_TR_PRECOND,
+                                            SLEQP_TR_PRECOND_NONE));
+
+  ASSERT_CALL(sleqp_precond_create_default(&precond, problem, settings));
+
+  ck_assert_ptr_null(precond);
+}
+END_TEST
+
+// Small problems use the exact diagonal
+START_TEST(test_diag_precond)
+{
+  SleqpPrecond* precond;
+
+  create_precond(&precond, SLEQP_TR_PRECOND_DIAGONAL);
+
+  for (int j = 0; j < num_variables; ++j)
+  {
+    ASSERT_CALL(sleqp_vec_clear(direction));
+    ASSERT_CALL(sleqp_vec_push(direction, j, 1.));
+
+    ASSERT_CALL(sleqp_precond_apply(precond, direction, result));
+
+    ck_assert(sleqp_is_eq(sleqp_vec_value_at(result, j),
+                          1. / hess_entry(j, j),
+                          tolerance));
+  }
+
+  ASSERT_CALL(sleqp_precond_release(&precond));
+}
+END_TEST
+
+// The diagonal is kept until the point changes
+START_TEST(test_diag_precond_reuse)
+{
+  SleqpPrecond* precond;
+
+  create_precond(&precond, SLEQP_TR_PRECOND_DIAGONAL);
+
+  ck_assert_int_eq(num_products(), num_variables);
+
+  ASSERT_CALL(sleqp_precond_update(precond, sleqp_iterate_cons_dual(iterate)));
+
+  ck_assert_int_eq(num_products(), num_variables);
+
+  ASSERT_CALL(sleqp_precond_release(&precond));
+}
+END_TEST
+
+// The exact diagonal of a block structure requires one product
+// per variable of the largest block
+START_TEST(test_diag_block_precond)
+{
+  SleqpPrecond* precond;
+
+  block_size = num_variables / 2;
+
+  SleqpHessStruct* hess_struct = sleqp_func_hess_struct(func);
+
+  ASSERT_CALL(sleqp_hess_struct_clear(hess_struct));
+  ASSERT_CALL(sleqp_hess_struct_push_block(hess_struct, block_size));
+  ASSERT_CALL(sleqp_hess_struct_push_block(hess_struct, num_variables));
+
+  create_precond(&precond, SLEQP_TR_PRECOND_DIAGONAL);
+
+  ck_assert_int_eq(num_products(), block_size);
+
+  for (int j = 0; j < num_variables; ++j)
+  {
+    ASSERT_CALL(sleqp_vec_clear(direction));
+    ASSERT_CALL(sleqp_vec_push(direction, j, 1.));
+
+    ASSERT_CALL(sleqp_precond_apply(precond, direction, result));
+
+    ck_assert(sleqp_is_eq(sleqp_vec_value_at(result, j),
+                          1. / hess_entry(j, j),
+                          tolerance));
+  }
+
+  ASSERT_CALL(sleqp_precond_release(&precond));
+}
+END_TEST
+
+// The factorization of a tridiagonal matrix has no fill-in
+START_TEST(test_ichol_precond)
+{
+  SleqpPrecond* precond;
+
+  create_precond(&precond, SLEQP_TR_PRECOND_INCOMPLETE_CHOLESKY);
+
+  fill_direction(0);
+
+  ASSERT_CALL(dense_quad_func_product(func, direction, product));
+
+  ASSERT_CALL(sleqp_precond_apply(precond, product, result));
+
+  ck_assert(sleqp_vec_eq(result, direction, tolerance));
+
+  ASSERT_CALL(sleqp_precond_release(&precond));
+}
+END_TEST
+
+// The factor is kept until the point changes
+START_TEST(test_ichol_precond_reuse)
+{
+  SleqpPrecond* precond;
+  SleqpVec* point;
+
+  create_precond(&precond, SLEQP_TR_PRECOND_INCOMPLETE_CHOLESKY);
+
+  ck_assert_int_eq(num_products(), num_variables);
+
+  ASSERT_CALL(sleqp_precond_update(precond, sleqp_iterate_cons_dual(iterate)));
+
+  ck_assert_int_eq(num_products(), num_variables);
+
+  ASSERT_CALL(sleqp_vec_create_full(&point, num_variables));
+  ASSERT_CALL(sleqp_vec_push(point, 0, 1.));
+
+  bool reject;
+
+  ASSERT_CALL(sleqp_problem_set_value(problem,
+                                      point,
+                                      SLEQP_VALUE_REASON_TRYING_ITERATE,
+                                      &reject));
+
+  ASSERT_CALL(sleqp_precond_update(precond, sleqp_iterate_cons_dual(iterate)));
+
+  ck_assert_int_eq(num_products(), 2 * num_variables);
+
+  fill_direction(0);
+
+  ASSERT_CALL(dense_quad_func_product(func, direction, product));
+
+  ASSERT_CALL(sleqp_precond_apply(precond, product, result));
+
+  ck_assert(sleqp_vec_eq(result, direction, tolerance));
+
+  ASSERT_CALL(sleqp_vec_free(&point));
+
+  ASSERT_CALL(sleqp_precond_release(&precond));
+}
+END_TEST
+
+// Blocks of the Hessian structure are assembled simultaneously
+START_TEST(test_ichol_block_precond)
+{
+  SleqpPrecond* precond;
+
+  block_size = num_variables / 2;
+
+  SleqpHessStruct* hess_struct = sleqp_func_hess_struct(func);
+
+  ASSERT_CALL(sleqp_hess_struct_clear(hess_struct));
+  ASSERT_CALL(sleqp_hess_struct_push_block(hess_struct, block_size));
+  ASSERT_CALL(sleqp_hess_struct_push_block(hess_struct, num_variables));
+
+  create_precond(&precond, SLEQP_TR_PRECOND_INCOMPLETE_CHOLESKY);
+
+  ck_assert_int_eq(num_products(), block_size);
+
+  fill_direction(0);
+
+  ASSERT_CALL(dense_quad_func_product(func, direction, product));
+
+  ASSERT_CALL(sleqp_precond_apply(precond, product, result));
+
+  ck_assert(sleqp_vec_eq(result, direction, tolerance));
+
+  ASSERT_CALL(sleqp_precond_release(&precond));
+}
+END_TEST
+
+// Blocks above the size limit are not assembled
+START_TEST(test_ichol_precond_fallback)
+{
+  SleqpPrecond* precond;
+
+  ASSERT_CALL(
+    sleqp_settings_set_int_value(settings,
+                                 SLEQP_SETTINGS_INT_PRECOND_MAX_BLOCK_SIZE,
+                                 num_variables - 1));
+
+  create_precond(&precond, SLEQP_TR_PRECOND_INCOMPLETE_CHOLESKY);
+
+  // Scaling by the inverse diagonal rather than the inverse Hessian
+  for (int j = 0; j < num_variables; ++j)
+  {
+    ASSERT_CALL(sleqp_vec_clear(direction));
+    ASSERT_CALL(sleqp_vec_push(direction, j, 1.));
+
+    ASSERT_CALL(sleqp_precond_apply(precond, direction, result));
+
+    ck_assert(sleqp_is_eq(sleqp_vec_value_at(result, j),
+                          1. / hess_entry(j, j),
+                          tolerance));
+  }
+
+  ASSERT_CALL(sleqp_precond_release(&precond));
+}
+END_TEST
+
+// The newest curvature pair satisfies the secant equation
+START_TEST(test_lbfgs_precond)
+{
+  SleqpPrecond* precond;
+
+  create_precond(&precond, SLEQP_TR_PRECOND_QUASI_NEWTON);
+
+  for (int offset = 0; offset < 3; ++offset)
+  {
+    fill_direction(offset);
+
+    ASSERT_CALL(dense_quad_func_product(func, direction, product));
+
+    ASSERT_CALL(sleqp_precond_push(precond, direction, product));
+  }
+
+  ASSERT_CALL(sleqp_precond_update(precond, sleqp_iterate_cons_dual(iterate)));
+
+  ASSERT_CALL(sleqp_precond_apply(precond, product, result));
+
+  ck_assert(sleqp_vec_eq(result, direction, tolerance));
+
+  ASSERT_CALL(sleqp_precond_release(&precond));
+}
+END_TEST
+
+START_TEST(test_steihaug_precond)
+{
+  const SLEQP_TR_PRECOND types[] = {SLEQP_TR_PRECOND_NONE,
+                                    SLEQP_TR_PRECOND_DIAGONAL,
+                                    SLEQP_TR_PRECOND_QUASI_NEWTON,
+                                    SLEQP_TR_PRECOND_INCOMPLETE_CHOLESKY};
+
+  const double trust_radius = 1e3;
+
+  const SleqpVec* gradient = sleqp_iterate_obj_grad(iterate);
+
+  for (int k = 0; k < 4; ++k)
+  {
+    SleqpTRSolver* solver;
+    double tr_dual;
+
+    ASSERT_CALL(sleqp_settings_set_enum_value(settings,
+                                              SLEQP_SETTINGS_ENUM_TR_PRECOND,
+                                              types[k]));
+
+    ASSERT_CALL(sleqp_steihaug_solver_create(&solver, problem, settings));
+
+    // Solve twice so that recorded quasi-Newton pairs are used
+    for (int solve = 0; solve < 2; ++solve)
+    {
+      ASSERT_CALL(sleqp_tr_solver_solve(solver,
+                                        jacobian,
+                                        sleqp_iterate_cons_dual(iterate),
+                                        gradient,
+                                        direction,
+                                        trust_radius,
+                                        &tr_dual));
+
+      // Interior solution satisfies H d + g = 0
+      ASSERT_CALL(dense_quad_func_product(func, direction, product));
+
+      ASSERT_CALL(sleqp_vec_add(product, gradient, 0., result));
+
+      ck_assert(sleqp_vec_norm(result) <= 1e-6);
+    }
+
+    ASSERT_CALL(sleqp_tr_solver_release(&solver));
+  }
+}
+END_TEST
+
+// Preconditioned boundary steps stay within the Euclidean trust region
+// and still improve on the Cauchy decrease of the badly scaled problem
+START_TEST(test_steihaug_precond_boundary)
+{
+  const SLEQP_TR_PRECOND types[] = {SLEQP_TR_PRECOND_NONE,
+                                    SLEQP_TR_PRECOND_DIAGONAL,
+                                    SLEQP_TR_PRECOND_QUASI_NEWTON,
+                                    SLEQP_TR_PRECOND_INCOMPLETE_CHOLESKY};
+
+  const double trust_radius = 1e-2;
+
+  const SleqpVec* gradient = sleqp_iterate_obj_grad(iterate);
+
+  double grad_nrm_sq, grad_curvature;
+
+  ASSERT_CALL(dense_quad_func_product(func, gradient, product));
+
+  ASSERT_CALL(sleqp_vec_dot(gradient, gradient, &grad_nrm_sq));
+  ASSERT_CALL(sleqp_vec_dot(gradient, product, &grad_curvature));
+
+  const double cauchy_length
+    = SLEQP_MIN(trust_radius / sqrt(grad_nrm_sq), grad_nrm_sq / grad_curvature);
+
+  const double cauchy_model
+    = -cauchy_length * grad_nrm_sq
+      + .5 * cauchy_length * cauchy_length * grad_curvature;
+
+  for (int k = 0; k < 4; ++k)
+  {
+    SleqpTRSolver* solver;
+    double tr_dual;
+
+    ASSERT_CALL(sleqp_settings_set_enum_value(settings,
+                                              SLEQP_SETTINGS_ENUM_TR_PRECOND,
+                                              types[k]));
+
+    ASSERT_CALL(sleqp_steihaug_solver_create(&solver, problem, settings));
+
+    ASSERT_CALL(sleqp_tr_solver_solve(solver,
+                                      jacobian,
+                                      sleqp_iterate_cons_dual(iterate),
+                                      gradient,
+                                      direction,
+                                      trust_radius,
+                                      &tr_dual));
+
+    ck_assert(sleqp_is_eq(sleqp_vec_norm(direction), trust_radius, tolerance));
+
+    double linear_term, curvature;
+
+    ASSERT_CALL(dense_quad_func_product(func, direction, product));
+
+    ASSERT_CALL(sleqp_vec_dot(gradient, direction, &linear_term));
+    ASSERT_CALL(sleqp_vec_dot(direction, product, &curvature));
+
+    ck_assert(linear_term + .5 * curvature <= cauchy_model);
+
+    ASSERT_CALL(sleqp_tr_solver_release(&solver));
+  }
+}
+END_TEST
+
+void
+teardown()
+{
+  ASSERT_CALL(sleqp_vec_free(&result));
+  ASSERT_CALL(sleqp_vec_free(&product));
+  ASSERT_CALL(sleqp_vec_free(&direction));
+
+  ASSERT_CALL(sleqp_aug_jac_release(&jacobian));
+
+  ASSERT_CALL(sleqp_fact_release(&fact));
+
+  ASSERT_CALL(sleqp_iterate_release(&iterate));
+
+  ASSERT_CALL(sleqp_problem_release(&problem));
+
+  ASSERT_CALL(sleqp_func_release(&func));
+
+  ASSERT_CALL(sleqp_settings_release(&settings));
+}
+
+Suite*
+precond_test_suite()
+{
+  Suite* suite;
+  TCase* tc_precond;
+
+  suite = suite_create("Preconditioner tests");
+
+  tc_precond = tcase_create("Preconditioners");
+
+  tcase_add_checked_fixture(tc_precond, setup, teardown);
+
+  tcase_add_test(tc_precond, test_no_precond);
+  tcase_add_test(tc_precond, test_diag_precond);
+  tcase_add_test(tc_precond, test_diag_precond_reuse);
+  tcase_add_test(tc_precond, test_diag_block_precond);
+  tcase_add_test(tc_precond, test_ichol_precond);
+  tcase_add_test(tc_precond, test_ichol_precond_reuse);
+  tcase_add_test(tc_precond, test_ichol_block_precond);
+  tcase_add_test(tc_precond, test_ichol_precond_fallback);
+  tcase_add_test(tc_precond, test_lbfgs_precond);
+  tcase_add_test(tc_precond, test_steihaug_precond);
+  tcase_add_test(tc_precond, test_steihaug_precond_boundary);
+
+  suite_add_tcase(suite, tc_precond);
+
+  return suite;
+}
+
+TEST_MAIN(precond_test_suite)
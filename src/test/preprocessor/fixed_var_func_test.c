@@ -260,6 +260,43 @@ START_TEST(test_cons_jac)
 }
 END_TEST
 
+START_TEST(test_learned_nonzeros)
+{
+  bool reject;
+
+  int obj_grad_nnz  = SLEQP_NONE;
+  int cons_val_nnz  = SLEQP_NONE;
+  int cons_jac_nnz  = SLEQP_NONE;
+  int hess_prod_nnz = SLEQP_NONE;
+
+  ASSERT_CALL(sleqp_func_nonzeros(quadconsfunc,
+                                  &obj_grad_nnz,
+                                  &cons_val_nnz,
+                                  &cons_jac_nnz,
+                                  &hess_prod_nnz));
+
+  ck_assert_int_eq(cons_jac_nnz, SLEQP_NONE);
+
+  ASSERT_CALL(sleqp_func_set_value(quadconsfunc,
+                                   value,
+                                   SLEQP_VALUE_REASON_NONE,
+                                   &reject));
+
+  ASSERT_CALL(sleqp_func_cons_val(quadconsfunc, cons_val));
+  ASSERT_CALL(sleqp_func_cons_jac(quadconsfunc, cons_jac));
+
+  // Nonzeros of the underlying function are learned from its evaluations
+  ASSERT_CALL(sleqp_func_nonzeros(fixed_var_func,
+                                  &obj_grad_nnz,
+                                  &cons_val_nnz,
+                                  &cons_jac_nnz,
+                                  &hess_prod_nnz));
+
+  ck_assert_int_eq(cons_val_nnz, cons_val->nnz);
+  ck_assert_int_eq(cons_jac_nnz, sleqp_mat_nnz(cons_jac));
+}
+END_TEST
+
 START_TEST(test_hess_prod)
 {
   bool reject;
@@ -309,6 +346,8 @@ fixed_var_test_suite()
 
   tcase_add_test(tc_eval, test_hess_prod);
 
+  tcase_add_test(tc_eval, test_learned_nonzeros);
+
   suite_add_tcase(suite, tc_eval);
 
   return suite;
@@ -0,0 +1,745 @@
+#include <check.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cmp.h"
+#include "mem.h"
+#include "problem.h"
+
+#include "quasi_newton/quasi_newton.h"
+#include "thread_pool.h"
+
+#include "dense_quad_func.h"
+#include "test_common.h"
+
+/*
+ * Quadratic objective \f$ f(x) = 1/2 x^{T} A x \f$ with a block-diagonal
+ * Hessian consisting of a 4x4 and a 2x2 block
+ */
+
+#define NUM_VARS 6
+#define NUM_STEPS 6
+
+static const double hessian[NUM_VARS][NUM_VARS]
+  = {{4., 1., 0., .5, 0., 0.},
+     {1., 3., .5, 0., 0., 0.},
+     {0., .5, 2., .25, 0., 0.},
+     {.5, 0., .25, 5., 0., 0.},
+     {0., 0., 0., 0., 2., -1.},
+     {0., 0., 0., 0., -1., 3.}};
+
+static const double steps[NUM_STEPS][NUM_VARS]
+  = {{1., 0., .5, 0., 1., .5},
+     {0., 1., 0., -.5, -.5, 1.},
+     {.5, -1., 1., 0., 1., 1.},
+     {0., .5, -.5, 1., .25, -1.},
+     {1., 1., 0., 0., -1., .5},
+     {0., 0., 1., 1., .5, .5}};
+
+SleqpSettings* settings;
+SleqpFunc* func;
+SleqpProblem* problem;
+
+SleqpVec* multipliers;
+
+SleqpIterate* previous_iterate;
+SleqpIterate* current_iterate;
+
+SleqpVec* direction;
+SleqpVec* product;
+
+static double
+hess_entry(int i, int j)
+{
+  return hessian[i][j];
+}
+
+static SLEQP_RETCODE
+set_iterate(SleqpIterate* iterate, const double* x)
+{
+  double grad[NUM_VARS] = {0.};
+
+  for (int i = 0; i < NUM_VARS; ++i)
+  {
+    for (int j = 0; j < NUM_VARS; ++j)
+    {
+      grad[i] += hessian[i][j] * x[j];
+    }
+  }
+
+  SLEQP_CALL(sleqp_vec_set_from_raw(sleqp_iterate_primal(iterate),
+                                    (double*)x,
+                                    NUM_VARS,
+                                    0.));
+
+  SLEQP_CALL(sleqp_vec_set_from_raw(sleqp_iterate_obj_grad(iterate),
+                                    grad,
+                                    NUM_VARS,
+                                    0.));
+
+  return SLEQP_OKAY;
+}
+
+// Pushes the given number of steps, starting from the origin
+static SLEQP_RETCODE
+push_steps(SleqpQuasiNewton* quasi_newton, int num_steps)
+{
+  double x[NUM_VARS] = {0.};
+
+  for (int k = 0; k < num_steps; ++k)
+  {
+    SLEQP_CALL(set_iterate(previous_iterate, x));
+
+    for (int i = 0; i < NUM_VARS; ++i)
+    {
+      x[i] += steps[k][i];
+    }
+
+    SLEQP_CALL(set_iterate(current_iterate, x));
+
+    SLEQP_CALL(sleqp_quasi_newton_push(quasi_newton,
+                                       previous_iterate,
+                                       current_iterate,
+                                       multipliers));
+  }
+
+  return SLEQP_OKAY;
+}
+
+static SLEQP_RETCODE
+hess_prod(SleqpQuasiNewton* quasi_newton, const double* values)
+{
+  SLEQP_CALL(sleqp_vec_set_from_raw(direction, (double*)values, NUM_VARS, 0.));
+
+  SLEQP_CALL(sleqp_quasi_newton_hess_prod(quasi_newton, direction, product));
+
+  return SLEQP_OKAY;
+}
+
+static double
+hess_bilinear(SleqpQuasiNewton* quasi_newton,
+              const double* first,
+              const double* second)
+{
+  double bilinear;
+
+  ASSERT_CALL(hess_prod(quasi_newton, first));
+
+  ASSERT_CALL(sleqp_vec_set_from_raw(direction, (double*)second, NUM_VARS, 0.));
+
+  ASSERT_CALL(sleqp_vec_dot(direction, product, &bilinear));
+
+  return bilinear;
+}
+
+// Checks that \f$ B s = A s \f$ for the step with the given index
+static void
+assert_secant(SleqpQuasiNewton* quasi_newton, int index, double tolerance)
+{
+  ASSERT_CALL(hess_prod(quasi_newton, steps[index]));
+
+  for (int i = 0; i < NUM_VARS; ++i)
+  {
+    double expected = 0.;
+
+    for (int j = 0; j < NUM_VARS; ++j)
+    {
+      expected += hessian[i][j] * steps[index][j];
+    }
+
+    ck_assert(
+      sleqp_is_eq(sleqp_vec_value_at(product, i), expected, tolerance));
+  }
+}
+
+static void
+assert_symmetric(SleqpQuasiNewton* quasi_newton)
+{
+  for (int k = 0; k < NUM_STEPS; ++k)
+  {
+    for (int l = 0; l < k; ++l)
+    {
+      const double first  = hess_bilinear(quasi_newton, steps[k], steps[l]);
+      const double second = hess_bilinear(quasi_newton, steps[l], steps[k]);
+
+      ck_assert(sleqp_is_eq(first, second, 1e-10));
+    }
+  }
+}
+
+void
+setup()
+{
+  ASSERT_CALL(sleqp_settings_create(&settings));
+
+  ASSERT_CALL(dense_quad_func_create(&func, NUM_VARS, 0, hess_entry, 0.));
+
+  SleqpHessStruct* hess_struct = sleqp_func_hess_struct(func);
+
+  ASSERT_CALL(sleqp_hess_struct_clear(hess_struct));
+
+  ASSERT_CALL(sleqp_hess_struct_push_block(hess_struct, 4));
+  ASSERT_CALL(sleqp_hess_struct_push_block(hess_struct, NUM_VARS));
+
+  SleqpVec* var_lb;
+  SleqpVec* var_ub;
+  SleqpVec* cons_lb;
+  SleqpVec* cons_ub;
+
+  const double inf = sleqp_infinity();
+
+  ASSERT_CALL(sleqp_vec_create_full(&var_lb, NUM_VARS));
+  ASSERT_CALL(sleqp_vec_fill(var_lb, -inf));
+
+  ASSERT_CALL(sleqp_vec_create_full(&var_ub, NUM_VARS));
+  ASSERT_CALL(sleqp_vec_fill(var_ub, inf));
+
+  ASSERT_CALL(sleqp_vec_create_empty(&cons_lb, 0));
+  ASSERT_CALL(sleqp_vec_create_empty(&cons_ub, 0));
+
+  ASSERT_CALL(sleqp_problem_create_simple(&problem,
+                                          func,
+                                          var_lb,
+                                          var_ub,
+                                          cons_lb,
+                                          cons_ub,
+                                          settings));
+
+  ASSERT_CALL(sleqp_iterate_create(&previous_iterate, problem, var_lb));
+  ASSERT_CALL(sleqp_iterate_create(&current_iterate, problem, var_lb));
+
+  ASSERT_CALL(sleqp_vec_free(&cons_ub));
+  ASSERT_CALL(sleqp_vec_free(&cons_lb));
+  ASSERT_CALL(sleqp_vec_free(&var_ub));
+  ASSERT_CALL(sleqp_vec_free(&var_lb));
+
+  ASSERT_CALL(sleqp_vec_create_empty(&multipliers, 0));
+
+  ASSERT_CALL(sleqp_vec_create_full(&direction, NUM_VARS));
+  ASSERT_CALL(sleqp_vec_create_full(&product, NUM_VARS));
+}
+
+START_TEST(test_sr1_quadratic)
+{
+  SleqpQuasiNewton* quasi_newton;
+
+  ASSERT_CALL(sleqp_settings_set_enum_value(settings,
+                                            SLEQP_SETTINGS_ENUM_HESS_EVAL,
+                                            SLEQP_HESS_EVAL_SR1));
+
+  ASSERT_CALL(sleqp_sr1_create(&quasi_newton, func, settings));
+
+  // No information yet, identity
+  ASSERT_CALL(hess_prod(quasi_newton, steps[0]));
+
+  for (int i = 0; i < NUM_VARS; ++i)
+  {
+    ck_assert(sleqp_is_eq(sleqp_vec_value_at(product, i), steps[0][i], 0.));
+  }
+
+  ASSERT_CALL(push_steps(quasi_newton, 2));
+
+  // Hereditary property
+  assert_secant(quasi_newton, 0, 1e-8);
+  assert_secant(quasi_newton, 1, 1e-8);
+
+  ASSERT_CALL(sleqp_quasi_newton_reset(quasi_newton));
+
+  ASSERT_CALL(push_steps(quasi_newton, 4));
+
+  // Both blocks are recovered exactly
+  for (int k = 0; k < NUM_STEPS; ++k)
+  {
+    assert_secant(quasi_newton, k, 1e-8);
+  }
+
+  assert_symmetric(quasi_newton);
+
+  ASSERT_CALL(sleqp_quasi_newton_release(&quasi_newton));
+}
+END_TEST
+
+START_TEST(test_bfgs_quadratic)
+{
+  SleqpQuasiNewton* quasi_newton;
+
+  ASSERT_CALL(sleqp_settings_set_enum_value(settings,
+                                            SLEQP_SETTINGS_ENUM_HESS_EVAL,
+                                            SLEQP_HESS_EVAL_SIMPLE_BFGS));
+
+  ASSERT_CALL(sleqp_settings_set_enum_value(settings,
+                                            SLEQP_SETTINGS_ENUM_BFGS_SIZING,
+                                            SLEQP_BFGS_SIZING_NONE));
+
+  ASSERT_CALL(sleqp_bfgs_create(&quasi_newton, func, settings));
+
+  for (int num_steps = 1; num_steps <= NUM_STEPS; ++num_steps)
+  {
+    ASSERT_CALL(sleqp_quasi_newton_reset(quasi_newton));
+
+    ASSERT_CALL(push_steps(quasi_newton, num_steps));
+
+    // Secant equation of the most recent step
+    assert_secant(quasi_newton, num_steps - 1, 1e-8);
+
+    assert_symmetric(quasi_newton);
+
+    for (int k = 0; k < NUM_STEPS; ++k)
+    {
+      ck_assert(hess_bilinear(quasi_newton, steps[k], steps[k]) > 0.);
+    }
+  }
+
+  ASSERT_CALL(sleqp_quasi_newton_release(&quasi_newton));
+}
+END_TEST
+
+START_TEST(test_damped_bfgs_sized)
+{
+  SleqpQuasiNewton* quasi_newton;
+
+  ASSERT_CALL(sleqp_settings_set_enum_value(settings,
+                                            SLEQP_SETTINGS_ENUM_HESS_EVAL,
+                                            SLEQP_HESS_EVAL_DAMPED_BFGS));
+
+  ASSERT_CALL(
+    sleqp_settings_set_enum_value(settings,
+                                  SLEQP_SETTINGS_ENUM_BFGS_SIZING,
+                                  SLEQP_BFGS_SIZING_CENTERED_OL));
+
+  ASSERT_CALL(sleqp_bfgs_create(&quasi_newton, func, settings));
+
+  // Exceeds the memory of the quasi-Newton method
+  ASSERT_CALL(push_steps(quasi_newton, NUM_STEPS));
+
+  assert_symmetric(quasi_newton);
+
+  for (int k = 0; k < NUM_STEPS; ++k)
+  {
+    ck_assert(hess_bilinear(quasi_newton, steps[k], steps[k]) > 0.);
+  }
+
+  ASSERT_CALL(sleqp_quasi_newton_release(&quasi_newton));
+}
+END_TEST
+
+// Fills new blocks with garbage to expose uninitialized reads
+static void*
+poisoning_allocate(size_t size, void* allocator_data)
+{
+  void* ptr = malloc(size);
+
+  if (ptr)
+  {
+    memset(ptr, 0x41, size);
+  }
+
+  return ptr;
+}
+
+static void
+poisoning_deallocate(void* ptr, size_t size, void* allocator_data)
+{
+  free(ptr);
+}
+
+static void
+assert_linear_range_zero(SleqpQuasiNewton* quasi_newton)
+{
+  const double values[NUM_VARS] = {1., 0., 0., 0., 0., 1.};
+
+  ASSERT_CALL(push_steps(quasi_newton, 2));
+
+  ASSERT_CALL(hess_prod(quasi_newton, values));
+
+  ck_assert(sleqp_is_eq(sleqp_vec_value_at(product, 4), 0., 0.));
+  ck_assert(sleqp_is_eq(sleqp_vec_value_at(product, 5), 0., 0.));
+}
+
+START_TEST(test_linear_range)
+{
+  SleqpAllocator* allocator;
+  SleqpQuasiNewton* sr1;
+  SleqpQuasiNewton* bfgs;
+
+  SleqpAllocatorCallbacks callbacks = {.allocate   = poisoning_allocate,
+                                       .reallocate = NULL,
+                                       .deallocate = poisoning_deallocate,
+                                       .free       = NULL};
+
+  ASSERT_CALL(sleqp_allocator_create(&allocator, &callbacks, NULL));
+
+  SleqpHessStruct* hess_struct = sleqp_func_hess_struct(func);
+
+  // The last two variables are not part of any block
+  ASSERT_CALL(sleqp_hess_struct_clear(hess_struct));
+  ASSERT_CALL(sleqp_hess_struct_push_block(hess_struct, 4));
+
+  SleqpAllocator* previous = sleqp_allocator_set_active(allocator);
+
+  ASSERT_CALL(sleqp_settings_set_enum_value(settings,
+                                            SLEQP_SETTINGS_ENUM_HESS_EVAL,
+                                            SLEQP_HESS_EVAL_SR1));
+
+  ASSERT_CALL(sleqp_sr1_create(&sr1, func, settings));
+
+  ASSERT_CALL(sleqp_settings_set_enum_value(settings,
+                                            SLEQP_SETTINGS_ENUM_HESS_EVAL,
+                                            SLEQP_HESS_EVAL_DAMPED_BFGS));
+
+  ASSERT_CALL(sleqp_bfgs_create(&bfgs, func, settings));
+
+  sleqp_allocator_set_active(previous);
+
+  assert_linear_range_zero(sr1);
+  assert_linear_range_zero(bfgs);
+
+  ASSERT_CALL(sleqp_quasi_newton_release(&bfgs));
+  ASSERT_CALL(sleqp_quasi_newton_release(&sr1));
+
+  ASSERT_CALL(sleqp_allocator_release(&allocator));
+}
+END_TEST
+
+START_TEST(test_copy)
+{
+  SleqpQuasiNewton* source;
+  SleqpQuasiNewton* target;
+
+  ASSERT_CALL(sleqp_settings_set_enum_value(settings,
+                                            SLEQP_SETTINGS_ENUM_HESS_EVAL,
+                                            SLEQP_HESS_EVAL_SR1));
+
+  ASSERT_CALL(sleqp_sr1_create(&source, func, settings));
+  ASSERT_CALL(sleqp_sr1_create(&target, func, settings));
+
+  ASSERT_CALL(push_steps(source, 3));
+
+  ASSERT_CALL(sleqp_quasi_newton_copy(source, target));
+
+  for (int k = 0; k < NUM_STEPS; ++k)
+  {
+    const double expected = hess_bilinear(source, steps[k], steps[k]);
+    const double actual   = hess_bilinear(target, steps[k], steps[k]);
+
+    ck_assert(sleqp_is_eq(expected, actual, 0.));
+  }
+
+  ASSERT_CALL(sleqp_quasi_newton_release(&target));
+  ASSERT_CALL(sleqp_quasi_newton_release(&source));
+}
+END_TEST
+
+/*
+ * Separable quadratic with many small blocks, large enough
+ * for the blocks to be processed in parallel
+ */
+
+#define NUM_SMALL_BLOCKS 2000
+#define SMALL_BLOCK_DIM 5
+#define NUM_LARGE_VARS (NUM_SMALL_BLOCKS * SMALL_BLOCK_DIM)
+
+static double
+large_step(int k, int i)
+{
+  return (((7 * i + 3 * k) % 11) - 5.) / 5.;
+}
+
+// Tridiagonal within each block
+static void
+large_hess_prod(const double* x, double* result)
+{
+  for (int i = 0; i < NUM_LARGE_VARS; ++i)
+  {
+    const int pos = i % SMALL_BLOCK_DIM;
+
+    result[i] = (2. + pos) * x[i];
+
+    if (pos > 0)
+    {
+      result[i] += .5 * x[i - 1];
+    }
+
+    if (pos < SMALL_BLOCK_DIM - 1)
+    {
+      result[i] += .5 * x[i + 1];
+    }
+  }
+}
+
+static double
+large_hess_entry(int i, int j)
+{
+  if (i / SMALL_BLOCK_DIM != j / SMALL_BLOCK_DIM)
+  {
+    return 0.;
+  }
+
+  if (i == j)
+  {
+    return 2. + (i % SMALL_BLOCK_DIM);
+  }
+  else if (abs(i - j) == 1)
+  {
+    return .5;
+  }
+
+  return 0.;
+}
+
+static SLEQP_RETCODE
+set_large_iterate(SleqpIterate* iterate, const double* x, double* grad)
+{
+  large_hess_prod(x, grad);
+
+  SLEQP_CALL(sleqp_vec_set_from_raw(sleqp_iterate_primal(iterate),
+                                    (double*)x,
+                                    NUM_LARGE_VARS,
+                                    0.));
+
+  SLEQP_CALL(sleqp_vec_set_from_raw(sleqp_iterate_obj_grad(iterate),
+                                    grad,
+                                    NUM_LARGE_VARS,
+                                    0.));
+
+  return SLEQP_OKAY;
+}
+
+static SLEQP_RETCODE
+create_large_quasi_newton(SleqpQuasiNewton** star,
+                          SleqpFunc* large_func,
+                          SleqpProblem* large_problem,
+                          SleqpThreadPool* pool,
+                          int num_steps)
+{
+  SleqpIterate* previous;
+  SleqpIterate* current;
+
+  double* x;
+  double* grad;
+
+  if (sleqp_settings_enum_value(settings, SLEQP_SETTINGS_ENUM_HESS_EVAL)
+      == SLEQP_HESS_EVAL_SR1)
+  {
+    SLEQP_CALL(sleqp_sr1_create(star, large_func, settings));
+  }
+  else
+  {
+    SLEQP_CALL(sleqp_bfgs_create(star, large_func, settings));
+  }
+
+  SleqpVec* primal = sleqp_problem_vars_lb(large_problem);
+
+  SLEQP_CALL(sleqp_iterate_create(&previous, large_problem, primal));
+  SLEQP_CALL(sleqp_iterate_create(&current, large_problem, primal));
+
+  SLEQP_CALL(sleqp_alloc_array(&x, NUM_LARGE_VARS));
+  SLEQP_CALL(sleqp_alloc_array(&grad, NUM_LARGE_VARS));
+
+  for (int i = 0; i < NUM_LARGE_VARS; ++i)
+  {
+    x[i] = 0.;
+  }
+
+  SleqpThreadPool* previous_pool = sleqp_thread_pool_set_active(pool);
+
+  for (int k = 0; k < num_steps; ++k)
+  {
+    SLEQP_CALL(set_large_iterate(previous, x, grad));
+
+    for (int i = 0; i < NUM_LARGE_VARS; ++i)
+    {
+      x[i] += large_step(k, i);
+    }
+
+    SLEQP_CALL(set_large_iterate(current, x, grad));
+
+    SLEQP_CALL(
+      sleqp_quasi_newton_push(*star, previous, current, multipliers));
+  }
+
+  sleqp_thread_pool_set_active(previous_pool);
+
+  sleqp_free(&grad);
+  sleqp_free(&x);
+
+  SLEQP_CALL(sleqp_iterate_release(&current));
+  SLEQP_CALL(sleqp_iterate_release(&previous));
+
+  return SLEQP_OKAY;
+}
+
+static void
+assert_parallel_blocks(SLEQP_HESS_EVAL hess_eval)
+{
+  SleqpFunc* large_func;
+  SleqpProblem* large_problem;
+
+  SleqpVec* large_direction;
+  SleqpVec* expected_product;
+  SleqpVec* actual_product;
+
+  SleqpQuasiNewton* serial;
+  SleqpQuasiNewton* parallel;
+
+  SleqpThreadPool* pool;
+
+  ASSERT_CALL(sleqp_settings_set_enum_value(settings,
+                                            SLEQP_SETTINGS_ENUM_HESS_EVAL,
+                                            hess_eval));
+
+  ASSERT_CALL(dense_quad_func_create(&large_func,
+                                     NUM_LARGE_VARS,
+                                     0,
+                                     large_hess_entry,
+                                     0.));
+
+  SleqpHessStruct* hess_struct = sleqp_func_hess_struct(large_func);
+
+  ASSERT_CALL(sleqp_hess_struct_clear(hess_struct));
+
+  for (int block = 1; block <= NUM_SMALL_BLOCKS; ++block)
+  {
+    ASSERT_CALL(
+      sleqp_hess_struct_push_block(hess_struct, block * SMALL_BLOCK_DIM));
+  }
+
+  {
+    SleqpVec* var_lb;
+    SleqpVec* var_ub;
+    SleqpVec* cons_lb;
+    SleqpVec* cons_ub;
+
+    const double inf = sleqp_infinity();
+
+    ASSERT_CALL(sleqp_vec_create_full(&var_lb, NUM_LARGE_VARS));
+    ASSERT_CALL(sleqp_vec_fill(var_lb, -inf));
+
+    ASSERT_CALL(sleqp_vec_create_full(&var_ub, NUM_LARGE_VARS));
+    ASSERT_CALL(sleqp_vec_fill(var_ub, inf));
+
+    ASSERT_CALL(sleqp_vec_create_empty(&cons_lb, 0));
+    ASSERT_CALL(sleqp_vec_create_empty(&cons_ub, 0));
+
+    ASSERT_CALL(sleqp_problem_create_simple(&large_problem,
+                                            large_func,
+                                            var_lb,
+                                            var_ub,
+                                            cons_lb,
+                                            cons_ub,
+                                            settings));
+
+    ASSERT_CALL(sleqp_vec_free(&cons_ub));
+    ASSERT_CALL(sleqp_vec_free(&cons_lb));
+    ASSERT_CALL(sleqp_vec_free(&var_ub));
+    ASSERT_CALL(sleqp_vec_free(&var_lb));
+  }
+
+  ASSERT_CALL(sleqp_thread_pool_create(&pool, 4));
+
+  const int num_steps = 3;
+
+  ASSERT_CALL(create_large_quasi_newton(&serial,
+                                        large_func,
+                                        large_problem,
+                                        NULL,
+                                        num_steps));
+
+  ASSERT_CALL(create_large_quasi_newton(&parallel,
+                                        large_func,
+                                        large_problem,
+                                        pool,
+                                        num_steps));
+
+  ASSERT_CALL(sleqp_vec_create_full(&large_direction, NUM_LARGE_VARS));
+  ASSERT_CALL(sleqp_vec_create_full(&expected_product, NUM_LARGE_VARS));
+  ASSERT_CALL(sleqp_vec_create_full(&actual_product, NUM_LARGE_VARS));
+
+  for (int i = 0; i < NUM_LARGE_VARS; ++i)
+  {
+    ASSERT_CALL(sleqp_vec_push(large_direction, i, large_step(num_steps, i)));
+  }
+
+  ASSERT_CALL(sleqp_quasi_newton_hess_prod(serial,
+                                           large_direction,
+                                           expected_product));
+
+  SleqpThreadPool* previous_pool = sleqp_thread_pool_set_active(pool);
+
+  ASSERT_CALL(sleqp_quasi_newton_hess_prod(parallel,
+                                           large_direction,
+                                           actual_product));
+
+  sleqp_thread_pool_set_active(previous_pool);
+
+  ck_assert(sleqp_vec_eq(expected_product, actual_product, 1e-10));
+
+  ASSERT_CALL(sleqp_vec_free(&actual_product));
+  ASSERT_CALL(sleqp_vec_free(&expected_product));
+  ASSERT_CALL(sleqp_vec_free(&large_direction));
+
+  ASSERT_CALL(sleqp_quasi_newton_release(&parallel));
+  ASSERT_CALL(sleqp_quasi_newton_release(&serial));
+
+  ASSERT_CALL(sleqp_thread_pool_release(&pool));
+
+  ASSERT_CALL(sleqp_problem_release(&large_problem));
+  ASSERT_CALL(sleqp_func_release(&large_func));
+}
+
+START_TEST(test_parallel_blocks)
+{
+  assert_parallel_blocks(SLEQP_HESS_EVAL_SR1);
+
+  assert_parallel_blocks(SLEQP_HESS_EVAL_DAMPED_BFGS);
+}
+END_TEST
+
+void
+teardown()
+{
+  ASSERT_CALL(sleqp_vec_free(&product));
+  ASSERT_CALL(sleqp_vec_free(&direction));
+
+  ASSERT_CALL(sleqp_vec_free(&multipliers));
+
+  ASSERT_CALL(sleqp_iterate_release(&current_iterate));
+  ASSERT_CALL(sleqp_iterate_release(&previous_iterate));
+
+  ASSERT_CALL(sleqp_problem_release(&problem));
+
+  ASSERT_CALL(sleqp_func_release(&func));
+
+  ASSERT_CALL(sleqp_settings_release(&settings));
+}
+
+Suite*
+quasi_newton_test_suite()
+{
+  Suite* suite;
+  TCase* tc_quasi_newton;
+
+  suite = suite_create("Quasi-Newton tests");
+
+  tc_quasi_newton = tcase_create("Quasi-Newton test");
+
+  tcase_add_checked_fixture(tc_quasi_newton, setup, teardown);
+
+  tcase_add_test(tc_quasi_newton, test_sr1_quadratic);
+
+  tcase_add_test(tc_quasi_newton, test_bfgs_quadratic);
+
+  tcase_add_test(tc_quasi_newton, test_damped_bfgs_sized);
+
+  tcase_add_test(tc_quasi_newton, test_linear_range);
+
+  tcase_add_test(tc_quasi_newton, test_copy);
+
+  tcase_add_test(tc_quasi_newton, test_parallel_blocks);
+
+  suite_add_tcase(suite, tc_quasi_newton);
+
+  return suite;
+}
+
+TEST_MAIN(quasi_newton_test_suite)
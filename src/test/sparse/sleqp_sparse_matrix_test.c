@@ -6,6 +6,8 @@
 #include "cmp.h"
 #include "mem.h"
 
+#include "thread_pool.h"
+
 #include "sparse/mat.h"
 #include "sparse/vec.h"
 
@@ -55,6 +57,135 @@ START_TEST(test_sparse_matrix_vector_product)
 }
 END_TEST
 
+static SLEQP_RETCODE
+compute_products(const SleqpMat* matrix,
+                 const SleqpVec* vector,
+                 const SleqpVec* trans_vector,
+                 double* product,
+                 SleqpVec* trans_product)
+{
+  SLEQP_CALL(sleqp_mat_mult_vec(matrix, vector, product));
+
+  SLEQP_CALL(sleqp_mat_mult_vec_trans(matrix, trans_vector, 0., trans_product));
+
+  return SLEQP_OKAY;
+}
+
+START_TEST(test_sparse_parallel_product)
+{
+  SleqpMat* matrix;
+
+  const int num_rows  = 2000;
+  const int num_cols  = 1000;
+  const int bandwidth = 150;
+
+  ASSERT_CALL(
+    sleqp_mat_create(&matrix, num_rows, num_cols, num_cols * bandwidth));
+
+  for (int col = 0; col < num_cols; ++col)
+  {
+    ASSERT_CALL(sleqp_mat_push_col(matrix, col));
+
+    for (int row = col; row < col + bandwidth; ++row)
+    {
+      ASSERT_CALL(sleqp_mat_push(matrix, row, col, 1. + (row % 7) - col % 3));
+    }
+  }
+
+  SleqpVec* vector;
+  SleqpVec* trans_vector;
+
+  ASSERT_CALL(sleqp_vec_create_full(&vector, num_cols));
+  ASSERT_CALL(sleqp_vec_create_full(&trans_vector, num_rows));
+
+  for (int col = 0; col < num_cols; ++col)
+  {
+    ASSERT_CALL(sleqp_vec_push(vector, col, 1. / (1. + col)));
+  }
+
+  for (int row = 0; row < num_rows; row += 3)
+  {
+    ASSERT_CALL(sleqp_vec_push(trans_vector, row, (row % 5) - 2.));
+  }
+
+  double* expected_product;
+  double* actual_product;
+
+  ASSERT_CALL(sleqp_alloc_array(&expected_product, num_rows));
+  ASSERT_CALL(sleqp_alloc_array(&actual_product, num_rows));
+
+  SleqpVec* expected_trans_product;
+  SleqpVec* actual_trans_product;
+
+  ASSERT_CALL(sleqp_vec_create_empty(&expected_trans_product, num_cols));
+  ASSERT_CALL(sleqp_vec_create_empty(&actual_trans_product, num_cols));
+
+  SleqpThreadPool* pool;
+
+  ASSERT_CALL(sleqp_thread_pool_create(&pool, 4));
+
+  const double tolerance = 1e-8;
+
+  for (int round = 0; round < 3; ++round)
+  {
+    ASSERT_CALL(compute_products(matrix,
+                                 vector,
+                                 trans_vector,
+                                 expected_product,
+                                 expected_trans_product));
+
+    SleqpThreadPool* previous = sleqp_thread_pool_set_active(pool);
+
+    ASSERT_CALL(compute_products(matrix,
+                                 vector,
+                                 trans_vector,
+                                 actual_product,
+                                 actual_trans_product));
+
+    sleqp_thread_pool_set_active(previous);
+
+    for (int row = 0; row < num_rows; ++row)
+    {
+      ck_assert(
+        sleqp_is_eq(actual_product[row], expected_product[row], tolerance));
+    }
+
+    ck_assert(sleqp_vec_is_valid(actual_trans_product));
+    ck_assert(
+      sleqp_vec_eq(actual_trans_product, expected_trans_product, tolerance));
+
+    if (round == 0)
+    {
+      // Changed values must be picked up by the cached row-wise pattern
+      ASSERT_CALL(sleqp_mat_scale(matrix, -2.));
+    }
+    else
+    {
+      // So must entries appended to the last column
+      const int col = num_cols - 1;
+
+      for (int row = col + bandwidth; row < num_rows; row += 2)
+      {
+        ASSERT_CALL(sleqp_mat_push(matrix, row, col, 3.));
+      }
+    }
+  }
+
+  ASSERT_CALL(sleqp_thread_pool_release(&pool));
+
+  ASSERT_CALL(sleqp_vec_free(&actual_trans_product));
+  ASSERT_CALL(sleqp_vec_free(&expected_trans_product));
+
+  sleqp_free(&actual_product);
+  sleqp_free(&expected_product);
+
+  ASSERT_CALL(sleqp_vec_free(&trans_vector));
+  ASSERT_CALL(sleqp_vec_free(&vector));
+
+  ASSERT_CALL(sleqp_mat_release(&matrix));
+}
+END_TEST
+
 START_TEST(test_sparse_reserve)
 {
   SleqpMat* matrix;
@@ -72,6 +203,48 @@ START_TEST(test_sparse_reserve)
 }
 END_TEST
 
+START_TEST(test_sparse_push_grow)
+{
+  SleqpMat* matrix;
+
+  int size = 5;
+
+  ASSERT_CALL(sleqp_mat_create(&matrix, size, size, 0));
+
+  for (int col = 0; col < size; ++col)
+  {
+    ASSERT_CALL(sleqp_mat_push_col(matrix, col));
+
+    for (int row = 0; row < size; ++row)
+    {
+      ASSERT_CALL(sleqp_mat_push(matrix, row, col, 1. + row + col));
+    }
+  }
+
+  ck_assert_int_eq(sleqp_mat_nnz(matrix), size * size);
+  ck_assert(sleqp_mat_nnz_max(matrix) >= size * size);
+  ck_assert(sleqp_mat_is_valid(matrix));
+
+  const double* data = sleqp_mat_data(matrix);
+
+  ck_assert(data[size * size - 1] == 2. * size - 1.);
+
+  ASSERT_CALL(sleqp_mat_release(&matrix));
+}
+END_TEST
+
+START_TEST(test_sparse_nnz_estimate)
+{
+  const int small_size = 10, large_size = 100000;
+
+  ck_assert_int_eq(sleqp_mat_nnz_estimate(small_size, small_size),
+                   small_size * small_size);
+
+  ck_assert_int_eq(sleqp_mat_nnz_estimate(large_size, large_size),
+                   2 * large_size);
+}
+END_TEST
+
 START_TEST(test_sparse_increase_size)
 {
   SleqpMat* matrix;
@@ -222,11 +395,14 @@ sparse_test_suite()
   tc_sparse_operations = tcase_create("Sparse matrix operations");
 
   tcase_add_test(tc_sparse_modification, test_sparse_reserve);
+  tcase_add_test(tc_sparse_modification, test_sparse_push_grow);
+  tcase_add_test(tc_sparse_modification, test_sparse_nnz_estimate);
   tcase_add_test(tc_sparse_modification, test_sparse_increase_size);
   tcase_add_test(tc_sparse_modification, test_sparse_decrease_size);
   tcase_add_test(tc_sparse_modification, test_sparse_pop_column);
 
   tcase_add_test(tc_sparse_operations, test_sparse_matrix_vector_product);
+  tcase_add_test(tc_sparse_operations, test_sparse_parallel_product);
 
   suite_add_tcase(suite, tc_sparse_construction);
 
@@ -0,0 +1,242 @@
+#include <check.h>
+#include <stdlib.h>
+
+#include "test_common.h"
+
+#include "cmp.h"
+#include "mem.h"
+
+#include "sparse/vec.h"
+
+static const int dim = 101;
+
+static const double tolerance = 1e-10;
+
+// Creates a vector with entries at all indices divisible by `stride`
+static SLEQP_RETCODE
+create_strided(SleqpVec** vec, int stride, double offset)
+{
+  SLEQP_CALL(sleqp_vec_create_full(vec, dim));
+
+  for (int i = 0; i < dim; i += stride)
+  {
+    SLEQP_CALL(sleqp_vec_push(*vec, i, offset + i));
+  }
+
+  return SLEQP_OKAY;
+}
+
+static SleqpVec* vecs[4];
+static const int num_vecs    = 4;
+static const int strides[]   = {1, 2, 3, 50};
+static double* first_values  = NULL;
+static double* second_values = NULL;
+
+void
+setup()
+{
+  for (int j = 0; j < num_vecs; ++j)
+  {
+    ASSERT_CALL(create_strided(vecs + j, strides[j], 1. - 0.5 * j));
+  }
+
+  ASSERT_CALL(sleqp_alloc_array(&first_values, dim));
+  ASSERT_CALL(sleqp_alloc_array(&second_values, dim));
+}
+
+START_TEST(test_dot)
+{
+  for (int j = 0; j < num_vecs; ++j)
+  {
+    for (int l = 0; l < num_vecs; ++l)
+    {
+      ASSERT_CALL(sleqp_vec_to_raw(vecs[j], first_values));
+      ASSERT_CALL(sleqp_vec_to_raw(vecs[l], second_values));
+
+      double expected = 0.;
+
+      for (int i = 0; i < dim; ++i)
+      {
+        expected += first_values[i] * second_values[i];
+      }
+
+      double actual;
+
+      ASSERT_CALL(sleqp_vec_dot(vecs[j], vecs[l], &actual));
+
+      ck_assert(sleqp_is_eq(actual, expected, tolerance));
+    }
+  }
+}
+END_TEST
+
+START_TEST(test_add_scaled)
+{
+  SleqpVec* result;
+
+  ASSERT_CALL(sleqp_vec_create_empty(&result, dim));
+
+  const double first_factor  = 2.;
+  const double second_factor = -3.;
+
+  for (int j = 0; j < num_vecs; ++j)
+  {
+    for (int l = 0; l < num_vecs; ++l)
+    {
+      ASSERT_CALL(sleqp_vec_add_scaled(vecs[j],
+                                       vecs[l],
+                                       first_factor,
+                                       second_factor,
+                                       tolerance,
+                                       result));
+
+      ck_assert(sleqp_vec_is_valid(result));
+
+      ASSERT_CALL(sleqp_vec_to_raw(vecs[j], first_values));
+      ASSERT_CALL(sleqp_vec_to_raw(vecs[l], second_values));
+
+      int expected_nnz = 0;
+
+      for (int i = 0; i < dim; ++i)
+      {
+        const double expected
+          = first_factor * first_values[i] + second_factor * second_values[i];
+
+        if (!sleqp_is_zero(expected, tolerance))
+        {
+          ++expected_nnz;
+        }
+
+        ck_assert(
+          sleqp_is_eq(sleqp_vec_value_at(result, i), expected, tolerance));
+      }
+
+      // Dense results store zeros explicitly
+      ASSERT_CALL(sleqp_vec_sparsify(result, 0.));
+
+      ck_assert_int_eq(result->nnz, expected_nnz);
+    }
+  }
+
+  ASSERT_CALL(sleqp_vec_free(&result));
+}
+END_TEST
+
+START_TEST(test_norms)
+{
+  for (int j = 0; j < num_vecs; ++j)
+  {
+    ASSERT_CALL(sleqp_vec_to_raw(vecs[j], first_values));
+
+    double norm_sq = 0., one_norm = 0., inf_norm = 0.;
+
+    for (int i = 0; i < dim; ++i)
+    {
+      const double value = first_values[i];
+
+      norm_sq += value * value;
+      one_norm += SLEQP_ABS(value);
+      inf_norm = SLEQP_MAX(inf_norm, SLEQP_ABS(value));
+    }
+
+    ck_assert(sleqp_is_eq(sleqp_vec_norm_sq(vecs[j]), norm_sq, tolerance));
+    ck_assert(sleqp_is_eq(sleqp_vec_one_norm(vecs[j]), one_norm, tolerance));
+    ck_assert(sleqp_is_eq(sleqp_vec_inf_norm(vecs[j]), inf_norm, tolerance));
+  }
+}
+END_TEST
+
+START_TEST(test_dense_promotion)
+{
+  SleqpVec* result;
+
+  ASSERT_CALL(sleqp_vec_create_empty(&result, dim));
+
+  // stride 2 and 3 cover more than half of the indices
+  ASSERT_CALL(
+    sleqp_vec_add_scaled(vecs[1], vecs[2], 1., 1., tolerance, result));
+
+  ck_assert(sleqp_vec_is_dense(result));
+  ck_assert(sleqp_vec_is_valid(result));
+
+  for (int i = 0; i < dim; ++i)
+  {
+    const double expected
+      = sleqp_vec_value_at(vecs[1], i) + sleqp_vec_value_at(vecs[2], i);
+
+    ck_assert(sleqp_is_eq(sleqp_vec_value_at(result, i), expected, tolerance));
+  }
+
+  // cancels out all but the entries at indices divisible by 3
+  ASSERT_CALL(
+    sleqp_vec_add_scaled(result, vecs[1], 1., -1., tolerance, vecs[0]));
+
+  ck_assert(!sleqp_vec_is_dense(vecs[0]));
+  ck_assert(sleqp_vec_eq(vecs[0], vecs[2], tolerance));
+
+  ASSERT_CALL(sleqp_vec_free(&result));
+}
+END_TEST
+
+START_TEST(test_densify)
+{
+  SleqpVec* copy;
+
+  ASSERT_CALL(sleqp_vec_create_empty(&copy, dim));
+
+  for (int j = 0; j < num_vecs; ++j)
+  {
+    ASSERT_CALL(sleqp_vec_copy(vecs[j], copy));
+
+    ASSERT_CALL(sleqp_vec_densify(copy));
+
+    ck_assert(sleqp_vec_is_dense(copy));
+    ck_assert(sleqp_vec_is_valid(copy));
+    ck_assert(sleqp_vec_eq(copy, vecs[j], tolerance));
+
+    ASSERT_CALL(sleqp_vec_sparsify(copy, tolerance));
+
+    ck_assert(sleqp_vec_is_valid(copy));
+    ck_assert(sleqp_vec_eq(copy, vecs[j], tolerance));
+  }
+
+  ASSERT_CALL(sleqp_vec_free(&copy));
+}
+END_TEST
+
+void
+teardown()
+{
+  sleqp_free(&second_values);
+  sleqp_free(&first_values);
+
+  for (int j = 0; j < num_vecs; ++j)
+  {
+    ASSERT_CALL(sleqp_vec_free(vecs + j));
+  }
+}
+
+Suite*
+vec_test_suite()
+{
+  Suite* suite;
+  TCase* tc_vec_operations;
+
+  suite = suite_create("Sparse vector tests");
+
+  tc_vec_operations = tcase_create("Sparse vector operations");
+
+  tcase_add_checked_fixture(tc_vec_operations, setup, teardown);
+
+  tcase_add_test(tc_vec_operations, test_dot);
+  tcase_add_test(tc_vec_operations, test_add_scaled);
+  tcase_add_test(tc_vec_operations, test_norms);
+  tcase_add_test(tc_vec_operations, test_dense_promotion);
+  tcase_add_test(tc_vec_operations, test_densify);
+
+  suite_add_tcase(suite, tc_vec_operations);
+
+  return suite;
+}
+
+TEST_MAIN(vec_test_suite)
@@ -110,6 +110,201 @@ START_TEST(test_thread)
 }
 END_TEST
 
+START_TEST(test_batch)
+{
+  SleqpFunc* funcs[NUM_THREADS];
+  SleqpProblem* problems[NUM_THREADS];
+  SleqpVec* initials[NUM_THREADS];
+  SleqpVec* opts[NUM_THREADS];
+  SleqpSolver* solvers[NUM_THREADS];
+  SLEQP_RETCODE retcodes[NUM_THREADS];
+
+  SleqpVec* var_lb;
+  SleqpVec* var_ub;
+  SleqpVec* cons_lb;
+  SleqpVec* cons_ub;
+
+  SleqpSettings* settings;
+
+  ASSERT_CALL(sleqp_settings_create(&settings));
+
+  // Settings are shared among all problems
+  for (int i = 0; i < NUM_THREADS; ++i)
+  {
+    rosenbrock_create(funcs + i,
+                      &var_lb,
+                      &var_ub,
+                      &cons_lb,
+                      &cons_ub,
+                      initials + i,
+                      opts + i);
+
+    ASSERT_CALL(sleqp_problem_create_simple(problems + i,
+                                            funcs[i],
+                                            var_lb,
+                                            var_ub,
+                                            cons_lb,
+                                            cons_ub,
+                                            settings));
+
+    ASSERT_CALL(sleqp_vec_free(&cons_ub));
+    ASSERT_CALL(sleqp_vec_free(&cons_lb));
+
+    ASSERT_CALL(sleqp_vec_free(&var_ub));
+    ASSERT_CALL(sleqp_vec_free(&var_lb));
+  }
+
+  ASSERT_CALL(sleqp_solver_solve_batch(NUM_THREADS,
+                                       problems,
+                                       initials,
+                                       NULL,
+                                       NUM_THREADS,
+                                       100,
+                                       SLEQP_NONE,
+                                       solvers,
+                                       retcodes));
+
+  for (int i = 0; i < NUM_THREADS; ++i)
+  {
+    SleqpIterate* solution;
+
+    ck_assert_int_eq(retcodes[i], SLEQP_OKAY);
+
+    ck_assert_int_eq(sleqp_solver_status(solvers[i]), SLEQP_STATUS_OPTIMAL);
+
+    ASSERT_CALL(sleqp_solver_solution(solvers[i], &solution));
+
+    ck_assert(sleqp_vec_eq(sleqp_iterate_primal(solution), opts[i], 1e-6));
+  }
+
+  for (int i = 0; i < NUM_THREADS; ++i)
+  {
+    ASSERT_CALL(sleqp_solver_release(solvers + i));
+    ASSERT_CALL(sleqp_problem_release(problems + i));
+
+    ASSERT_CALL(sleqp_vec_free(opts + i));
+    ASSERT_CALL(sleqp_vec_free(initials + i));
+
+    ASSERT_CALL(sleqp_func_release(funcs + i));
+  }
+
+  ASSERT_CALL(sleqp_settings_release(&settings));
+}
+END_TEST
+
+static SLEQP_RETCODE
+failing_set(SleqpFunc* func,
+            SleqpVec* x,
+            SLEQP_VALUE_REASON reason,
+            bool* reject,
+            void* func_data)
+{
+  sleqp_raise(SLEQP_FUNC_EVAL_ERROR, "Failing evaluation");
+}
+
+START_TEST(test_batch_failure)
+{
+  const int failing = NUM_THREADS / 2;
+
+  SleqpFunc* funcs[NUM_THREADS];
+  SleqpProblem* problems[NUM_THREADS];
+  SleqpVec* initials[NUM_THREADS];
+  SleqpVec* opts[NUM_THREADS];
+  SleqpSolver* solvers[NUM_THREADS];
+  SLEQP_RETCODE retcodes[NUM_THREADS];
+
+  SleqpVec* var_lb;
+  SleqpVec* var_ub;
+  SleqpVec* cons_lb;
+  SleqpVec* cons_ub;
+
+  SleqpSettings* settings;
+
+  ASSERT_CALL(sleqp_settings_create(&settings));
+
+  for (int i = 0; i < NUM_THREADS; ++i)
+  {
+    rosenbrock_create(funcs + i,
+                      &var_lb,
+                      &var_ub,
+                      &cons_lb,
+                      &cons_ub,
+                      initials + i,
+                      opts + i);
+
+    if (i == failing)
+    {
+      ASSERT_CALL(sleqp_func_release(funcs + i));
+
+      SleqpFuncCallbacks callbacks = {.set_value = failing_set,
+                                      .obj_val   = rosenbrock_obj_val,
+                                      .obj_grad  = rosenbrock_obj_grad,
+                                      .cons_val  = NULL,
+                                      .cons_jac  = NULL,
+                                      .hess_prod = rosenbrock_hess_prod,
+                                      .func_free = NULL};
+
+      ASSERT_CALL(sleqp_func_create(funcs + i,
+                                    &callbacks,
+                                    rosenbrock_num_vars,
+                                    rosenbrock_num_cons,
+                                    NULL));
+    }
+
+    ASSERT_CALL(sleqp_problem_create_simple(problems + i,
+                                            funcs[i],
+                                            var_lb,
+                                            var_ub,
+                                            cons_lb,
+                                            cons_ub,
+                                            settings));
+
+    ASSERT_CALL(sleqp_vec_free(&cons_ub));
+    ASSERT_CALL(sleqp_vec_free(&cons_lb));
+
+    ASSERT_CALL(sleqp_vec_free(&var_ub));
+    ASSERT_CALL(sleqp_vec_free(&var_lb));
+  }
+
+  // A failing problem must not abort the remaining solves
+  ASSERT_CALL(sleqp_solver_solve_batch(NUM_THREADS,
+                                       problems,
+                                       initials,
+                                       NULL,
+                                       NUM_THREADS,
+                                       100,
+                                       SLEQP_NONE,
+                                       solvers,
+                                       retcodes));
+
+  for (int i = 0; i < NUM_THREADS; ++i)
+  {
+    if (i == failing)
+    {
+      ck_assert_int_ne(retcodes[i], SLEQP_OKAY);
+      continue;
+    }
+
+    ck_assert_int_eq(retcodes[i], SLEQP_OKAY);
+
+    ck_assert_int_eq(sleqp_solver_status(solvers[i]), SLEQP_STATUS_OPTIMAL);
+  }
+
+  for (int i = 0; i < NUM_THREADS; ++i)
+  {
+    ASSERT_CALL(sleqp_solver_release(solvers + i));
+    ASSERT_CALL(sleqp_problem_release(problems + i));
+
+    ASSERT_CALL(sleqp_vec_free(opts + i));
+    ASSERT_CALL(sleqp_vec_free(initials + i));
+
+    ASSERT_CALL(sleqp_func_release(funcs + i));
+  }
+
+  ASSERT_CALL(sleqp_settings_release(&settings));
+}
+END_TEST
+
 Suite*
 thread_test_suite()
 {
@@ -121,6 +316,8 @@ thread_test_suite()
   tc_thread = tcase_create("Thread test");
 
   tcase_add_test(tc_thread, test_thread);
+  tcase_add_test(tc_thread, test_batch);
+  tcase_add_test(tc_thread, test_batch_failure);
   suite_add_tcase(suite, tc_thread);
 
   return suite;
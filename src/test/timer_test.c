@@ -0,0 +1,140 @@
+#include <check.h>
+#include <time.h>
+
+#include "timer.h"
+
+#include "test_common.h"
+
+const double sleep_time = 0.05;
+
+SleqpTimer* timer;
+
+void
+setup()
+{
+  ASSERT_CALL(sleqp_timer_create(&timer));
+}
+
+static void
+sleep_seconds(double seconds)
+{
+  struct timespec duration
+    = {.tv_sec = (time_t)seconds,
+       .tv_nsec = (long)((seconds - (time_t)seconds) * 1e9)};
+
+  while (nanosleep(&duration, &duration) != 0)
+  {
+  }
+}
+
+static double
+busy_work(double seconds)
+{
+  struct timespec start, current;
+  volatile double value = 0.;
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+
+  do
+  {
+    for (int i = 0; i < 1000; ++i)
+    {
+      value += 1e-3 * i;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &current);
+  } while ((current.tv_sec - start.tv_sec)
+             + 1e-9 * (current.tv_nsec - start.tv_nsec)
+           < seconds);
+
+  return value;
+}
+
+START_TEST(test_wall_time)
+{
+  ASSERT_CALL(sleqp_timer_start(timer));
+
+  sleep_seconds(sleep_time);
+
+  ASSERT_CALL(sleqp_timer_stop(timer));
+
+  ck_assert_int_eq(sleqp_timer_get_num_runs(timer), 1);
+
+  // Sleeping advances the wall clock, but not the CPU clock
+  ck_assert(sleqp_timer_get_ttl(timer) >= sleep_time);
+  ck_assert(sleqp_timer_get_cpu_ttl(timer) < sleep_time);
+}
+END_TEST
+
+START_TEST(test_cpu_time)
+{
+  ASSERT_CALL(sleqp_timer_start(timer));
+
+  (void)busy_work(sleep_time);
+
+  ASSERT_CALL(sleqp_timer_stop(timer));
+
+  ck_assert(sleqp_timer_get_ttl(timer) >= sleep_time);
+  ck_assert(sleqp_timer_get_cpu_ttl(timer) > 0.);
+  ck_assert(sleqp_timer_get_cpu_ttl(timer)
+            <= sleqp_timer_get_ttl(timer) + 1e-3);
+}
+END_TEST
+
+START_TEST(test_stats)
+{
+  const int num_runs = 3;
+
+  for (int run = 0; run < num_runs; ++run)
+  {
+    ASSERT_CALL(sleqp_timer_start(timer));
+
+    sleep_seconds(sleep_time / num_runs);
+
+    ASSERT_CALL(sleqp_timer_stop(timer));
+  }
+
+  SleqpTimingStats stats = {.num_runs = 1, .wall_time = 1., .cpu_time = 1.};
+
+  ASSERT_CALL(sleqp_timer_add_stats(timer, &stats));
+
+  ck_assert_int_eq(stats.num_runs, num_runs + 1);
+  ck_assert(stats.wall_time == 1. + sleqp_timer_get_ttl(timer));
+  ck_assert(stats.cpu_time == 1. + sleqp_timer_get_cpu_ttl(timer));
+
+  ASSERT_CALL(sleqp_timer_reset(timer));
+
+  ck_assert_int_eq(sleqp_timer_get_num_runs(timer), 0);
+  ck_assert(sleqp_timer_get_ttl(timer) == 0.);
+  ck_assert(sleqp_timer_get_cpu_ttl(timer) == 0.);
+}
+END_TEST
+
+void
+teardown()
+{
+  ASSERT_CALL(sleqp_timer_free(&timer));
+}
+
+Suite*
+timer_test_suite()
+{
+  Suite* suite;
+  TCase* tc_timer;
+
+  suite = suite_create("Timer tests");
+
+  tc_timer = tcase_create("Timer");
+
+  tcase_add_checked_fixture(tc_timer, setup, teardown);
+
+  tcase_add_test(tc_timer, test_wall_time);
+  tcase_add_test(tc_timer, test_cpu_time);
+  tcase_add_test(tc_timer, test_stats);
+
+  suite_add_tcase(suite, tc_timer);
+
+  return suite;
+}
+
+TEST_MAIN(timer_test_suite)
@@ -0,0 +1,207 @@
+#include <check.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "error.h"
+#include "mem.h"
+#include "trace.h"
+
+#include "test_common.h"
+
+// Spans more than one block
+const int num_rows = 300;
+
+const int num_int_columns    = 6;
+const int num_double_columns = 16;
+
+const char filename_template[] = "/tmp/sleqp_trace_XXXXXX";
+
+char filename[sizeof(filename_template)];
+
+void
+setup()
+{
+  strcpy(filename, filename_template);
+
+  int fd = mkstemp(filename);
+
+  ck_assert_int_ne(fd, -1);
+
+  fclose(fdopen(fd, "w"));
+}
+
+static SleqpTraceRow
+create_row(int i)
+{
+  return (SleqpTraceRow){.iteration       = i,
+                         .phase           = i % 2,
+                         .step_type       = i % 3,
+                         .num_active_vars = 2 * i,
+                         .trust_radius    = 1. / (i + 1.),
+                         .lp_time         = 1e-3 * i,
+                         .elapsed         = 1. * i};
+}
+
+static void
+read_values(FILE* file, void* values, size_t size, size_t count)
+{
+  ck_assert_int_eq(fread(values, size, count, file), count);
+}
+
+START_TEST(test_write)
+{
+  SleqpTrace* trace;
+
+  ASSERT_CALL(sleqp_trace_create(&trace, filename));
+
+  for (int i = 0; i < num_rows; ++i)
+  {
+    SleqpTraceRow row = create_row(i);
+    ASSERT_CALL(sleqp_trace_add_row(trace, &row));
+  }
+
+  ASSERT_CALL(sleqp_trace_release(&trace));
+
+  FILE* file = fopen(filename, "rb");
+
+  ck_assert_ptr_nonnull(file);
+
+  char magic[8];
+  int32_t version, num_columns;
+
+  read_values(file, magic, 1, 8);
+  read_values(file, &version, sizeof(int32_t), 1);
+  read_values(file, &num_columns, sizeof(int32_t), 1);
+
+  ck_assert(memcmp(magic, "SLEQPTRC", 8) == 0);
+  ck_assert_int_eq(version, SLEQP_TRACE_VERSION);
+  ck_assert_int_eq(num_columns, num_int_columns + num_double_columns);
+
+  for (int j = 0; j < num_columns; ++j)
+  {
+    uint8_t type, length;
+    char name[256];
+
+    read_values(file, &type, 1, 1);
+    read_values(file, &length, 1, 1);
+    read_values(file, name, 1, length);
+
+    name[length] = '\0';
+
+    ck_assert_int_eq(type, (j < num_int_columns) ? 0 : 1);
+
+    if (j == 0)
+    {
+      ck_assert_str_eq(name, "iteration");
+    }
+  }
+
+  int32_t* int_values;
+  double* double_values;
+
+  ASSERT_CALL(sleqp_alloc_array(&int_values, num_rows));
+  ASSERT_CALL(sleqp_alloc_array(&double_values, num_rows));
+
+  int offset = 0;
+  int32_t block_rows;
+
+  while (fread(&block_rows, sizeof(int32_t), 1, file) == 1)
+  {
+    ck_assert_int_gt(block_rows, 0);
+    ck_assert_int_le(offset + block_rows, num_rows);
+
+    for (int j = 0; j < num_columns; ++j)
+    {
+      if (j < num_int_columns)
+      {
+        read_values(file, int_values, sizeof(int32_t), block_rows);
+      }
+      else
+      {
+        read_values(file, double_values, sizeof(double), block_rows);
+      }
+
+      for (int k = 0; k < block_rows; ++k)
+      {
+        const SleqpTraceRow row = create_row(offset + k);
+
+        // Columns are written in the order of the row fields
+        if (j == 0)
+        {
+          ck_assert_int_eq(int_values[k], row.iteration);
+        }
+        else if (j == 4)
+        {
+          ck_assert_int_eq(int_values[k], row.num_active_vars);
+        }
+        else if (j == 12)
+        {
+          ck_assert(double_values[k] == row.trust_radius);
+        }
+        else if (j == num_columns - 1)
+        {
+          ck_assert(double_values[k] == row.elapsed);
+        }
+      }
+    }
+
+    offset += block_rows;
+  }
+
+  ck_assert_int_eq(offset, num_rows);
+
+  sleqp_free(&double_values);
+  sleqp_free(&int_values);
+
+  fclose(file);
+}
+END_TEST
+
+START_TEST(test_invalid_file)
+{
+  SleqpTrace* trace = NULL;
+
+  ASSERT_CALL(sleqp_trace_create(&trace, filename));
+  ASSERT_CALL(sleqp_trace_release(&trace));
+
+  SleqpTrace* invalid_trace = NULL;
+
+  ck_assert_int_eq(
+    sleqp_trace_create(&invalid_trace, "/nonexistent/sleqp_trace"),
+    SLEQP_ERROR);
+
+  ck_assert_int_eq(sleqp_error_type(), SLEQP_ILLEGAL_ARGUMENT);
+
+  ASSERT_CALL(sleqp_trace_release(&invalid_trace));
+}
+END_TEST
+
+void
+teardown()
+{
+  remove(filename);
+}
+
+Suite*
+trace_test_suite()
+{
+  Suite* suite;
+  TCase* tc_trace;
+
+  suite = suite_create("Trace tests");
+
+  tc_trace = tcase_create("Trace");
+
+  tcase_add_checked_fixture(tc_trace, setup, teardown);
+
+  tcase_add_test(tc_trace, test_write);
+  tcase_add_test(tc_trace, test_invalid_file);
+
+  suite_add_tcase(suite, tc_trace);
+
+  return suite;
+}
+
+TEST_MAIN(trace_test_suite)
@@ -3,6 +3,7 @@
 
 #include "cmp.h"
 #include "mem.h"
+#include "scale.h"
 #include "solver.h"
 
 #include "test_common.h"
@@ -51,6 +52,123 @@ START_TEST(test_unconstrained_solve)
 }
 END_TEST
 
+START_TEST(test_unconstrained_warm_start)
+{
+  SleqpSettings* settings;
+  SleqpProblem* problem;
+  SleqpSolver* solver;
+  SleqpSolver* warm_solver;
+
+  ASSERT_CALL(sleqp_settings_create(&settings));
+
+  ASSERT_CALL(sleqp_settings_set_enum_value(settings,
+                                            SLEQP_SETTINGS_ENUM_HESS_EVAL,
+                                            SLEQP_HESS_EVAL_DAMPED_BFGS));
+
+  ASSERT_CALL(sleqp_problem_create_simple(&problem,
+                                          rosenbrock_func,
+                                          rosenbrock_var_lb,
+                                          rosenbrock_var_ub,
+                                          rosenbrock_cons_lb,
+                                          rosenbrock_cons_ub,
+                                          settings));
+
+  ASSERT_CALL(sleqp_solver_create(&solver,
+                                  problem,
+                                  rosenbrock_initial,
+                                  NULL));
+
+  ASSERT_CALL(sleqp_solver_solve(solver, 100, -1));
+
+  ck_assert_int_eq(sleqp_solver_status(solver), SLEQP_STATUS_OPTIMAL);
+
+  const int cold_iterations = sleqp_solver_iterations(solver);
+
+  ASSERT_CALL(sleqp_solver_create(&warm_solver,
+                                  problem,
+                                  rosenbrock_initial,
+                                  NULL));
+
+  ASSERT_CALL(sleqp_solver_warm_start(warm_solver, solver));
+
+  ASSERT_CALL(sleqp_solver_solve(warm_solver, 100, -1));
+
+  ck_assert_int_eq(sleqp_solver_status(warm_solver), SLEQP_STATUS_OPTIMAL);
+
+  ck_assert_int_lt(sleqp_solver_iterations(warm_solver), cold_iterations);
+
+  SleqpIterate* solution_iterate;
+
+  ASSERT_CALL(sleqp_solver_solution(warm_solver, &solution_iterate));
+
+  SleqpVec* actual_solution = sleqp_iterate_primal(solution_iterate);
+
+  // BFGS only converges up to the stationarity tolerance
+  ck_assert(sleqp_vec_eq(actual_solution, rosenbrock_optimum, 1e-4));
+
+  ASSERT_CALL(sleqp_solver_release(&warm_solver));
+
+  ASSERT_CALL(sleqp_solver_release(&solver));
+
+  ASSERT_CALL(sleqp_problem_release(&problem));
+
+  ASSERT_CALL(sleqp_settings_release(&settings));
+}
+END_TEST
+
+START_TEST(test_unconstrained_warm_start_scaled)
+{
+  SleqpSettings* settings;
+  SleqpProblem* problem;
+  SleqpScaling* scaling;
+  SleqpSolver* solver;
+  SleqpSolver* scaled_solver;
+
+  ASSERT_CALL(sleqp_settings_create(&settings));
+
+  ASSERT_CALL(sleqp_problem_create_simple(&problem,
+                                          rosenbrock_func,
+                                          rosenbrock_var_lb,
+                                          rosenbrock_var_ub,
+                                          rosenbrock_cons_lb,
+                                          rosenbrock_cons_ub,
+                                          settings));
+
+  ASSERT_CALL(
+    sleqp_scaling_create(&scaling, rosenbrock_num_vars, rosenbrock_num_cons));
+
+  ASSERT_CALL(sleqp_scaling_set_var_weight(scaling, 0, -5));
+
+  ASSERT_CALL(sleqp_solver_create(&solver,
+                                  problem,
+                                  rosenbrock_initial,
+                                  NULL));
+
+  ASSERT_CALL(sleqp_solver_create(&scaled_solver,
+                                  problem,
+                                  rosenbrock_initial,
+                                  scaling));
+
+  ASSERT_CALL(sleqp_solver_solve(solver, 100, -1));
+
+  // Iterates of differently scaled solvers are incompatible
+  ck_assert_int_eq(sleqp_solver_warm_start(scaled_solver, solver),
+                   SLEQP_ERROR);
+
+  ck_assert_int_eq(sleqp_error_type(), SLEQP_ILLEGAL_ARGUMENT);
+
+  ASSERT_CALL(sleqp_solver_release(&scaled_solver));
+
+  ASSERT_CALL(sleqp_solver_release(&solver));
+
+  ASSERT_CALL(sleqp_scaling_release(&scaling));
+
+  ASSERT_CALL(sleqp_problem_release(&problem));
+
+  ASSERT_CALL(sleqp_settings_release(&settings));
+}
+END_TEST
+
 Suite*
 unconstrained_test_suite()
 {
@@ -64,6 +182,10 @@ unconstrained_test_suite()
   tcase_add_checked_fixture(tc_uncons, rosenbrock_setup, rosenbrock_teardown);
 
   tcase_add_test(tc_uncons, test_unconstrained_solve);
+
+  tcase_add_test(tc_uncons, test_unconstrained_warm_start);
+
+  tcase_add_test(tc_uncons, test_unconstrained_warm_start_scaled);
   suite_add_tcase(suite, tc_uncons);
 
   return suite;
@@ -0,0 +1,420 @@
+#include <check.h>
+#include <stdlib.h>
+
+#include "cmp.h"
+#include "mem.h"
+#include "problem.h"
+#include "solver.h"
+
+#include "sparse/mat.h"
+
+#include "test_common.h"
+
+#include "rosenbrock_fixture.h"
+
+SleqpSettings* settings;
+
+SleqpVec* var_lb;
+SleqpVec* var_ub;
+
+// Single constraint on the first variable, cutting
+// off the unconstrained optimum
+SleqpVec* cons_lb;
+SleqpVec* cons_ub;
+
+SleqpMat* linear_coeffs;
+
+// General constraint c(x) = x_0 on top of the Rosenbrock function
+SleqpFunc* cons_func;
+SleqpVec* rosenbrock_duals;
+double first_var;
+
+static SLEQP_RETCODE
+cons_func_set(SleqpFunc* func,
+              SleqpVec* value,
+              SLEQP_VALUE_REASON reason,
+              bool* reject,
+              void* func_data)
+{
+  first_var = sleqp_vec_value_at(value, 0);
+
+  return sleqp_func_set_value(rosenbrock_func, value, reason, reject);
+}
+
+static SLEQP_RETCODE
+cons_func_obj_val(SleqpFunc* func, double* obj_val, void* func_data)
+{
+  return sleqp_func_obj_val(rosenbrock_func, obj_val);
+}
+
+static SLEQP_RETCODE
+cons_func_obj_grad(SleqpFunc* func, SleqpVec* obj_grad, void* func_data)
+{
+  return sleqp_func_obj_grad(rosenbrock_func, obj_grad);
+}
+
+static SLEQP_RETCODE
+cons_func_cons_val(SleqpFunc* func, SleqpVec* cons_val, void* func_data)
+{
+  SLEQP_CALL(sleqp_vec_push(cons_val, 0, first_var));
+
+  return SLEQP_OKAY;
+}
+
+static SLEQP_RETCODE
+cons_func_cons_jac(SleqpFunc* func, SleqpMat* cons_jac, void* func_data)
+{
+  SLEQP_CALL(sleqp_mat_push_col(cons_jac, 0));
+  SLEQP_CALL(sleqp_mat_push(cons_jac, 0, 0, 1.));
+  SLEQP_CALL(sleqp_mat_push_col(cons_jac, 1));
+
+  return SLEQP_OKAY;
+}
+
+// The constraint is linear and does not contribute
+static SLEQP_RETCODE
+cons_func_hess_prod(SleqpFunc* func,
+                    const SleqpVec* direction,
+                    const SleqpVec* cons_duals,
+                    SleqpVec* product,
+                    void* func_data)
+{
+  return sleqp_func_hess_prod(rosenbrock_func,
+                              direction,
+                              rosenbrock_duals,
+                              product);
+}
+
+void
+setup()
+{
+  rosenbrock_setup();
+
+  ASSERT_CALL(sleqp_settings_create(&settings));
+
+  ASSERT_CALL(sleqp_settings_set_enum_value(settings,
+                                            SLEQP_SETTINGS_ENUM_HESS_EVAL,
+                                            SLEQP_HESS_EVAL_DAMPED_BFGS));
+
+  ASSERT_CALL(sleqp_vec_create_full(&var_lb, rosenbrock_num_vars));
+  ASSERT_CALL(sleqp_vec_fill(var_lb, -10.));
+
+  ASSERT_CALL(sleqp_vec_create_full(&var_ub, rosenbrock_num_vars));
+  ASSERT_CALL(sleqp_vec_fill(var_ub, 10.));
+
+  ASSERT_CALL(sleqp_vec_create_full(&cons_lb, 1));
+  ASSERT_CALL(sleqp_vec_fill(cons_lb, -10.));
+
+  ASSERT_CALL(sleqp_vec_create_full(&cons_ub, 1));
+  ASSERT_CALL(sleqp_vec_fill(cons_ub, .5));
+
+  ASSERT_CALL(sleqp_mat_create(&linear_coeffs, 1, rosenbrock_num_vars, 1));
+
+  ASSERT_CALL(sleqp_mat_push_col(linear_coeffs, 0));
+  ASSERT_CALL(sleqp_mat_push(linear_coeffs, 0, 0, 1.));
+  ASSERT_CALL(sleqp_mat_push_col(linear_coeffs, 1));
+
+  SleqpFuncCallbacks callbacks = {.set_value = cons_func_set,
+                                  .obj_val   = cons_func_obj_val,
+                                  .obj_grad  = cons_func_obj_grad,
+                                  .cons_val  = cons_func_cons_val,
+                                  .cons_jac  = cons_func_cons_jac,
+                                  .hess_prod = cons_func_hess_prod,
+                                  .func_free = NULL};
+
+  ASSERT_CALL(sleqp_func_create(&cons_func,
+                                &callbacks,
+                                rosenbrock_num_vars,
+                                1,
+                                NULL));
+
+  ASSERT_CALL(sleqp_vec_create_empty(&rosenbrock_duals, rosenbrock_num_cons));
+}
+
+// Solves and checks that the optimum lies on the constraint
+// x_0 = value, where the Rosenbrock function has its minimum
+// at (value, value^2) for value < 1
+static void
+solve_on_constraint(SleqpSolver* solver, double value)
+{
+  SleqpIterate* solution_iterate;
+
+  ASSERT_CALL(sleqp_solver_solve(solver, 100, -1));
+
+  ck_assert_int_eq(sleqp_solver_status(solver), SLEQP_STATUS_OPTIMAL);
+
+  ASSERT_CALL(sleqp_solver_solution(solver, &solution_iterate));
+
+  SleqpVec* actual_solution = sleqp_iterate_primal(solution_iterate);
+
+  ck_assert(sleqp_is_eq(sleqp_vec_value_at(actual_solution, 0), value, 1e-4));
+  ck_assert(
+    sleqp_is_eq(sleqp_vec_value_at(actual_solution, 1), value * value, 1e-4));
+}
+
+START_TEST(test_update_var_bounds)
+{
+  SleqpProblem* problem;
+  SleqpSolver* solver;
+  SleqpIterate* solution_iterate;
+
+  ASSERT_CALL(sleqp_problem_create_simple(&problem,
+                                          rosenbrock_func,
+                                          var_lb,
+                                          var_ub,
+                                          rosenbrock_cons_lb,
+                                          rosenbrock_cons_ub,
+                                          settings));
+
+  ASSERT_CALL(sleqp_solver_create(&solver,
+                                  problem,
+                                  rosenbrock_initial,
+                                  NULL));
+
+  ASSERT_CALL(sleqp_solver_solve(solver, 100, -1));
+
+  ck_assert_int_eq(sleqp_solver_status(solver), SLEQP_STATUS_OPTIMAL);
+
+  ASSERT_CALL(sleqp_solver_solution(solver, &solution_iterate));
+
+  ck_assert(sleqp_vec_eq(sleqp_iterate_primal(solution_iterate),
+                         rosenbrock_optimum,
+                         1e-4));
+
+  // Cut off the unconstrained optimum
+  ASSERT_CALL(sleqp_vec_clear(var_ub));
+  ASSERT_CALL(sleqp_vec_push(var_ub, 0, .5));
+  ASSERT_CALL(sleqp_vec_push(var_ub, 1, 10.));
+
+  ASSERT_CALL(sleqp_problem_set_vars_bounds(problem, var_lb, var_ub));
+
+  ASSERT_CALL(sleqp_solver_solve(solver, 100, -1));
+
+  ck_assert_int_eq(sleqp_solver_status(solver), SLEQP_STATUS_OPTIMAL);
+
+  ASSERT_CALL(sleqp_solver_solution(solver, &solution_iterate));
+
+  SleqpVec* actual_solution = sleqp_iterate_primal(solution_iterate);
+
+  ck_assert(sleqp_is_eq(sleqp_vec_value_at(actual_solution, 0), .5, 1e-4));
+  ck_assert(sleqp_is_eq(sleqp_vec_value_at(actual_solution, 1), .25, 1e-4));
+
+  ASSERT_CALL(sleqp_solver_release(&solver));
+
+  ASSERT_CALL(sleqp_problem_release(&problem));
+}
+END_TEST
+
+START_TEST(test_update_general_bounds)
+{
+  SleqpProblem* problem;
+  SleqpSolver* solver;
+
+  ASSERT_CALL(sleqp_problem_create_simple(&problem,
+                                          cons_func,
+                                          var_lb,
+                                          var_ub,
+                                          cons_lb,
+                                          cons_ub,
+                                          settings));
+
+  ASSERT_CALL(sleqp_solver_create(&solver,
+                                  problem,
+                                  rosenbrock_initial,
+                                  NULL));
+
+  solve_on_constraint(solver, .5);
+
+  ASSERT_CALL(sleqp_vec_fill(cons_ub, .25));
+
+  ASSERT_CALL(sleqp_problem_set_general_bounds(problem, cons_lb, cons_ub));
+
+  solve_on_constraint(solver, .25);
+
+  ASSERT_CALL(sleqp_solver_release(&solver));
+
+  ASSERT_CALL(sleqp_problem_release(&problem));
+}
+END_TEST
+
+static void
+create_linear_problem(SleqpProblem** problem)
+{
+  SleqpVec* general_bounds;
+
+  ASSERT_CALL(sleqp_vec_create_empty(&general_bounds, 0));
+
+  ASSERT_CALL(sleqp_problem_create(problem,
+                                   rosenbrock_func,
+                                   var_lb,
+                                   var_ub,
+                                   general_bounds,
+                                   general_bounds,
+                                   linear_coeffs,
+                                   cons_lb,
+                                   cons_ub,
+                                   settings));
+
+  ASSERT_CALL(sleqp_vec_free(&general_bounds));
+}
+
+START_TEST(test_update_linear_bounds)
+{
+  SleqpProblem* problem;
+  SleqpSolver* solver;
+
+  create_linear_problem(&problem);
+
+  ASSERT_CALL(sleqp_solver_create(&solver,
+                                  problem,
+                                  rosenbrock_initial,
+                                  NULL));
+
+  solve_on_constraint(solver, .5);
+
+  ASSERT_CALL(sleqp_vec_fill(cons_ub, .25));
+
+  ASSERT_CALL(sleqp_problem_set_linear_bounds(problem, cons_lb, cons_ub));
+
+  solve_on_constraint(solver, .25);
+
+  ASSERT_CALL(sleqp_solver_release(&solver));
+
+  ASSERT_CALL(sleqp_problem_release(&problem));
+}
+END_TEST
+
+START_TEST(test_update_linear_coeffs)
+{
+  SleqpProblem* problem;
+  SleqpSolver* solver;
+
+  create_linear_problem(&problem);
+
+  ASSERT_CALL(sleqp_solver_create(&solver,
+                                  problem,
+                                  rosenbrock_initial,
+                                  NULL));
+
+  solve_on_constraint(solver, .5);
+
+  // Turns the constraint into 2 x_0 <= .5, keeping the sparsity pattern
+  // and the working set. Factorizations of the fixed Jacobian must be
+  // recomputed nonetheless
+  double* data = sleqp_mat_data(linear_coeffs);
+  data[0]      = 2.;
+
+  ASSERT_CALL(sleqp_problem_set_linear_coeffs(problem, linear_coeffs));
+
+  solve_on_constraint(solver, .25);
+
+  ASSERT_CALL(sleqp_solver_release(&solver));
+
+  ASSERT_CALL(sleqp_problem_release(&problem));
+}
+END_TEST
+
+START_TEST(test_update_unconstrained)
+{
+  SleqpProblem* problem;
+  SleqpSolver* solver;
+
+  ASSERT_CALL(sleqp_problem_create_simple(&problem,
+                                          rosenbrock_func,
+                                          rosenbrock_var_lb,
+                                          rosenbrock_var_ub,
+                                          rosenbrock_cons_lb,
+                                          rosenbrock_cons_ub,
+                                          settings));
+
+  ASSERT_CALL(sleqp_solver_create(&solver,
+                                  problem,
+                                  rosenbrock_initial,
+                                  NULL));
+
+  ASSERT_CALL(sleqp_problem_set_vars_bounds(problem, var_lb, var_ub));
+
+  // Bounds cannot be added to solvers of unconstrained problems
+  ck_assert_int_eq(sleqp_solver_solve(solver, 100, -1), SLEQP_ERROR);
+
+  ck_assert_int_eq(sleqp_error_type(), SLEQP_ILLEGAL_ARGUMENT);
+
+  ASSERT_CALL(sleqp_solver_release(&solver));
+
+  ASSERT_CALL(sleqp_problem_release(&problem));
+}
+END_TEST
+
+START_TEST(test_update_inconsistent_bounds)
+{
+  SleqpProblem* problem;
+
+  ASSERT_CALL(sleqp_problem_create_simple(&problem,
+                                          rosenbrock_func,
+                                          var_lb,
+                                          var_ub,
+                                          rosenbrock_cons_lb,
+                                          rosenbrock_cons_ub,
+                                          settings));
+
+  ck_assert_int_eq(sleqp_problem_set_vars_bounds(problem, var_ub, var_lb),
+                   SLEQP_ERROR);
+
+  ck_assert(sleqp_vec_eq(sleqp_problem_vars_lb(problem), var_lb, 0.));
+  ck_assert(sleqp_vec_eq(sleqp_problem_vars_ub(problem), var_ub, 0.));
+
+  ASSERT_CALL(sleqp_problem_release(&problem));
+}
+END_TEST
+
+void
+teardown()
+{
+  ASSERT_CALL(sleqp_vec_free(&rosenbrock_duals));
+
+  ASSERT_CALL(sleqp_func_release(&cons_func));
+
+  ASSERT_CALL(sleqp_mat_release(&linear_coeffs));
+
+  ASSERT_CALL(sleqp_vec_free(&cons_ub));
+  ASSERT_CALL(sleqp_vec_free(&cons_lb));
+
+  ASSERT_CALL(sleqp_vec_free(&var_ub));
+
+  ASSERT_CALL(sleqp_vec_free(&var_lb));
+
+  ASSERT_CALL(sleqp_settings_release(&settings));
+
+  rosenbrock_teardown();
+}
+
+Suite*
+update_test_suite()
+{
+  Suite* suite;
+  TCase* tc_update;
+
+  suite = suite_create("Problem update tests");
+
+  tc_update = tcase_create("Problem update test");
+
+  tcase_add_checked_fixture(tc_update, setup, teardown);
+
+  tcase_add_test(tc_update, test_update_var_bounds);
+
+  tcase_add_test(tc_update, test_update_general_bounds);
+
+  tcase_add_test(tc_update, test_update_linear_bounds);
+
+  tcase_add_test(tc_update, test_update_linear_coeffs);
+
+  tcase_add_test(tc_update, test_update_unconstrained);
+
+  tcase_add_test(tc_update, test_update_inconsistent_bounds);
+
+  suite_add_tcase(suite, tc_update);
+
+  return suite;
+}
+
+TEST_MAIN(update_test_suite)